@@ -0,0 +1,64 @@
+"""
+Compare two runs of the FastLED benchmark suite.
+
+The benchmark target is built by tests/CMakeLists.txt, record a run with
+    tests/.build/bin/benchmark --json before.json
+then again after a change and compare the ns/pixel of every benchmark and
+matrix size that appears in both files.
+
+Usage:
+    uv run ci/benchmark_compare.py before.json after.json --threshold 10
+"""
+
+import argparse
+import json
+import sys
+from pathlib import Path
+from typing import Dict, Tuple
+
+
+Key = Tuple[str, int, int]
+
+
+def load(path: Path) -> Dict[Key, float]:
+    data = json.loads(path.read_text())
+    out: Dict[Key, float] = {}
+    for entry in data["benchmarks"]:
+        key = (entry["name"], entry["width"], entry["height"])
+        out[key] = float(entry["ns_per_pixel"])
+    return out
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("before", type=Path, help="baseline benchmark json")
+    parser.add_argument("after", type=Path, help="benchmark json to compare")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=10.0,
+        help="percent slowdown reported as a regression (default 10)",
+    )
+    args = parser.parse_args()
+    before = load(args.before)
+    after = load(args.after)
+    regressions = 0
+    print(f"{'benchmark':<32} {'size':>9} {'before':>10} {'after':>10} {'change':>8}")
+    for key in sorted(before.keys() & after.keys()):
+        name, width, height = key
+        old, new = before[key], after[key]
+        change = (new - old) / old * 100.0 if old > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        size = f"{width}x{height}"
+        print(f"{name:<32} {size:>9} {old:>10.3f} {new:>10.3f} {change:>+7.1f}%{flag}")
+    for key in sorted(before.keys() ^ after.keys()):
+        where = "before" if key in before else "after"
+        print(f"{key[0]} {key[1]}x{key[2]}: only in {where}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,128 @@
+"""
+Offline encoder for the compressed FastLED video container (FLCV).
+
+Converts a raw RGB8 video, as played by fl::Video, into keyframes plus
+delta/RLE frames that PixelStream decodes on the fly. The layout is documented
+in src/fx/video/compressed_video.h and must stay in sync with
+CompressedVideoEncoder.
+
+Usage:
+    uv run ci/video_encode.py input.rgb output.flcv --pixels 1024
+"""
+
+import argparse
+import struct
+import sys
+from pathlib import Path
+from typing import List, Optional
+
+
+MAGIC = b"FLCV"
+VERSION = 1
+HEADER_SIZE = 24
+KEY_FRAME = 0
+DELTA_FRAME = 1
+OP_SKIP = 0
+OP_RUN = 1
+OP_LITERAL = 2
+MAX_OP_COUNT = 64
+
+Pixel = bytes
+
+
+def encode_ops(prev: Optional[List[Pixel]], curr: List[Pixel]) -> bytearray:
+    """Ops that turn prev into curr, prev None is a black frame."""
+    black = b"\x00\x00\x00"
+    n_pixels = len(curr)
+    out = bytearray()
+
+    def unchanged(i: int) -> bool:
+        return curr[i] == (prev[i] if prev is not None else black)
+
+    i = 0
+    while i < n_pixels:
+        n = 1
+        if unchanged(i):
+            while i + n < n_pixels and n < MAX_OP_COUNT and unchanged(i + n):
+                n += 1
+            out.append((OP_SKIP << 6) | (n - 1))
+        elif i + 1 < n_pixels and curr[i + 1] == curr[i]:
+            while i + n < n_pixels and n < MAX_OP_COUNT and curr[i + n] == curr[i]:
+                n += 1
+            out.append((OP_RUN << 6) | (n - 1))
+            out += curr[i]
+        else:
+            while (
+                i + n < n_pixels
+                and n < MAX_OP_COUNT
+                and not unchanged(i + n)
+                and not (i + n + 1 < n_pixels and curr[i + n + 1] == curr[i + n])
+            ):
+                n += 1
+            out.append((OP_LITERAL << 6) | (n - 1))
+            for k in range(n):
+                out += curr[i + k]
+        i += n
+    return out
+
+
+def encode(raw: bytes, pixels_per_frame: int, keyframe_interval: int) -> bytes:
+    frame_bytes = pixels_per_frame * 3
+    if len(raw) % frame_bytes:
+        print(
+            f"warning: dropping {len(raw) % frame_bytes} trailing bytes",
+            file=sys.stderr,
+        )
+    frame_count = len(raw) // frame_bytes
+    records = bytearray()
+    keyframes: List[int] = []
+    prev: Optional[List[Pixel]] = None
+    for f in range(frame_count):
+        start = f * frame_bytes
+        curr = [raw[start + i * 3 : start + i * 3 + 3] for i in range(pixels_per_frame)]
+        key = f % keyframe_interval == 0
+        if key:
+            keyframes.append(HEADER_SIZE + len(records))
+        ops = encode_ops(None if key else prev, curr)
+        records.append(KEY_FRAME if key else DELTA_FRAME)
+        records += struct.pack("<I", len(ops))
+        records += ops
+        prev = curr
+    header = MAGIC + struct.pack(
+        "<BBHIIII",
+        VERSION,
+        0,
+        0,
+        pixels_per_frame,
+        frame_count,
+        keyframe_interval,
+        HEADER_SIZE + len(records),
+    )
+    index = b"".join(struct.pack("<I", k) for k in keyframes)
+    return header + bytes(records) + index
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("input", type=Path, help="raw RGB8 video")
+    parser.add_argument("output", type=Path, help="compressed video to write")
+    parser.add_argument("--pixels", type=int, required=True, help="pixels per frame")
+    parser.add_argument(
+        "--keyframe-interval",
+        type=int,
+        default=30,
+        help="frames between keyframes, bounds the cost of a seek (default 30)",
+    )
+    args = parser.parse_args()
+    if args.pixels <= 0 or args.keyframe_interval <= 0:
+        parser.error("--pixels and --keyframe-interval must be positive")
+    raw = args.input.read_bytes()
+    encoded = encode(raw, args.pixels, args.keyframe_interval)
+    args.output.write_bytes(encoded)
+    ratio = len(raw) / len(encoded) if encoded else 0.0
+    print(f"{args.output}: {len(raw)} -> {len(encoded)} bytes ({ratio:.1f}x)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -4,6 +4,8 @@
 #include "fl/engine_events.h"
 #include "fl/compiler_control.h"
 #include "fl/int.h"
+#include "fl/frame_profiler.h"
+#include "fl/thread_pool.h"
 
 /// @file FastLED.cpp
 /// Central source file for FastLED, implements the CFastLED class/object
@@ -86,6 +88,7 @@ CFastLED::CFastLED() {
 	m_pPowerFunc = NULL;
 	m_nPowerData = 0xFFFFFFFF;
 	m_nMinMicros = 0;
+	m_bParallelShow = false;
 }
 
 int CFastLED::size() {
@@ -134,29 +137,70 @@ void CFastLED::show(uint8_t scale) {
 	CLEDController *pCur = CLEDController::head();
 
 	while(pCur && length < MAX_CLED_CONTROLLERS) {
-		if (pCur->getEnabled()) {
+#if FASTLED_SKIP_UNCHANGED_FRAMES
+		// Controllers that opted in are left alone for the whole frame when
+		// their data is identical to what was last transmitted.
+		pCur->m_skipFrame = pCur->getEnabled() && pCur->frameUnchanged(scale);
+#endif
+		if (pCur->getEnabled() && !pCur->skippingFrame()) {
 			gControllersData[length] = pCur->beginShowLeds(pCur->size());
 		} else {
 			gControllersData[length] = nullptr;
 		}
 		length++;
-		if (m_nFPS < 100) { pCur->setDither(0); }
+		if (m_nFPS < 100 && !pCur->skippingFrame()) { pCur->setDither(0); }
 		pCur = pCur->next();
 	}
 
-	pCur = CLEDController::head();
-	for (length = 0; length < MAX_CLED_CONTROLLERS && pCur; length++) {
-		if (pCur->getEnabled()) {
-			pCur->showLedsInternal(scale);
+	fl::FrameProfiler *profiler = fl::FrameProfiler::active();
+#if FASTLED_MULTITHREADED
+	if (m_bParallelShow) {
+		// parallelFor() returns once every controller is done, which is the
+		// barrier in front of endShowLeds() below.
+		CLEDController *active[MAX_CLED_CONTROLLERS];
+		fl::u32 numActive = 0;
+		pCur = CLEDController::head();
+		for (length = 0; length < MAX_CLED_CONTROLLERS && pCur; length++) {
+			if (pCur->getEnabled() && !pCur->skippingFrame()) {
+				active[numActive++] = pCur;
+			}
+			pCur = pCur->next();
 		}
-		pCur = pCur->next();
+		// The profiler is not thread safe, workers only fill in elapsed[].
+		fl::u32 elapsed[MAX_CLED_CONTROLLERS];
+		fl::ThreadPool::global().parallelFor(numActive, [&](fl::u32 i) {
+			const fl::u32 start = profiler ? micros() : 0;
+			active[i]->showLedsInternal(scale);
+			if (profiler) { elapsed[i] = micros() - start; }
+		});
+		if (profiler) {
+			for (fl::u32 i = 0; i < numActive; i++) {
+				profiler->recordStrip(active[i], elapsed[i]);
+			}
+		}
+	} else
+#endif
+	{
+		pCur = CLEDController::head();
+		for (length = 0; length < MAX_CLED_CONTROLLERS && pCur; length++) {
+			if (pCur->getEnabled() && !pCur->skippingFrame()) {
+				if (profiler) {
+					const fl::u32 start = micros();
+					pCur->showLedsInternal(scale);
+					profiler->recordStrip(pCur, micros() - start);
+				} else {
+					pCur->showLedsInternal(scale);
+				}
+			}
+			pCur = pCur->next();
 
+		}
 	}
 
 	length = 0;  // Reset length to 0 and iterate again.
 	pCur = CLEDController::head();
 	while(pCur && length < MAX_CLED_CONTROLLERS) {
-		if (pCur->getEnabled()) {
+		if (pCur->getEnabled() && !pCur->skippingFrame()) {
 			pCur->endShowLeds(gControllersData[length]);
 		}
 		length++;
@@ -207,6 +251,7 @@ void CFastLED::showColor(const struct CRGB & color, uint8_t scale) {
 	int length = 0;
 	CLEDController *pCur = CLEDController::head();
 	while(pCur && length < MAX_CLED_CONTROLLERS) {
+		pCur->invalidateFrameHash();
 		if (pCur->getEnabled()) {
 			gControllersData[length] = pCur->beginShowLeds(pCur->size());
 		} else {
@@ -380,6 +380,7 @@ class CFastLED {
 	fl::u32 m_nMinMicros;    ///< minimum µs between frames, used for capping frame rates
 	fl::u32 m_nPowerData;    ///< max power use parameter
 	power_func m_pPowerFunc;  ///< function for overriding brightness when using FastLED.show();
+	bool m_bParallelShow;     ///< encode controllers on fl::ThreadPool::global() during show()
 
 public:
 	CFastLED();
@@ -816,6 +817,19 @@ public:
 	/// Update all our controllers with the current led colors
 	void show() { show(m_Scale); }
 
+	/// Encode and output the controllers in parallel on a worker pool, so that
+	/// show() takes as long as the largest strip instead of the sum of all strips.
+	/// Every controller is finished before endShowLeds() and onEndShowLeds() run.
+	/// Only available with FASTLED_MULTITHREADED, otherwise show() stays serial.
+	/// The output is the same as a serial show(): each controller keeps its own
+	/// binary dither counter. A custom controller's showPixels() must not share
+	/// state with other controllers.
+	/// @param enabled true to show the controllers in parallel
+	void setParallelShow(bool enabled) { m_bParallelShow = enabled; }
+
+	/// @returns whether show() runs the controllers in parallel
+	bool getParallelShow() const { return m_bParallelShow; }
+
 	// Called automatically at the end of show().
 	void onEndFrame();
 
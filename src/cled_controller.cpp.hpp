@@ -9,7 +9,7 @@
 #include "fl/memfill.h"
 FASTLED_NAMESPACE_BEGIN
 
-CLEDController::~CLEDController() = default;
+CLEDController::~CLEDController() { fl::EngineEvents::onStripRemoved(this); }
 
 /// Create an led controller object, add it to the chain of controllers
 CLEDController::CLEDController() : m_Data(NULL), m_ColorCorrection(UncorrectedColor), m_ColorTemperature(UncorrectedTemperature), m_DitherMode(BINARY_DITHER), m_nLeds(0) {
@@ -30,6 +30,43 @@ void CLEDController::clearLedDataInternal(int nLeds) {
 
 }
 
+#if FASTLED_SKIP_UNCHANGED_FRAMES
+namespace {
+// FNV-1a over whole pixels, one multiply per led keeps this far cheaper than
+// pushing the frame out over the wire.
+inline fl::u32 frameHashMix(fl::u32 hash, fl::u32 value) {
+    return (hash ^ value) * 16777619u;
+}
+inline fl::u32 frameHashMix(fl::u32 hash, const CRGB &c) {
+    return frameHashMix(hash, fl::u32(c.r) | (fl::u32(c.g) << 8) | (fl::u32(c.b) << 16));
+}
+} // namespace
+#endif
+
+bool CLEDController::frameUnchanged(fl::u8 brightness) {
+#if FASTLED_SKIP_UNCHANGED_FRAMES
+    if (!m_skipUnchanged || !m_Data) {
+        return false;
+    }
+    fl::u32 hash = 2166136261u;
+    hash = frameHashMix(hash, fl::u32(m_nLeds));
+    hash = frameHashMix(hash, fl::u32(fl::ptr_to_int(m_Data)));
+    hash = frameHashMix(hash, fl::u32(brightness) | (fl::u32(m_DitherMode) << 8));
+    hash = frameHashMix(hash, m_ColorCorrection);
+    hash = frameHashMix(hash, m_ColorTemperature);
+    for (int i = 0; i < m_nLeds; ++i) {
+        hash = frameHashMix(hash, m_Data[i]);
+    }
+    const bool unchanged = m_hasFrameHash && hash == m_frameHash;
+    m_frameHash = hash;
+    m_hasFrameHash = true;
+    return unchanged;
+#else
+    FASTLED_UNUSED(brightness);
+    return false;
+#endif
+}
+
 ColorAdjustment CLEDController::getAdjustmentData(uint8_t brightness) {
     // *premixed = getAdjustment(brightness);
     // if (color_correction) {
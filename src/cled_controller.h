@@ -19,6 +19,13 @@
 #include "fl/virtual_if_not_avr.h"
 #include "fl/int.h"
 #include "fl/bit_cast.h"
+#include "fl/sketch_macros.h"
+
+/// Allows controllers to skip re-transmitting frames that are identical to the
+/// previously shown one, see CLEDController::setSkipUnchangedFrames().
+#ifndef FASTLED_SKIP_UNCHANGED_FRAMES
+#define FASTLED_SKIP_UNCHANGED_FRAMES SKETCH_HAS_LOTS_OF_MEMORY
+#endif
 
 FASTLED_NAMESPACE_BEGIN
 
@@ -44,8 +51,15 @@ protected:
     EDitherMode m_DitherMode;  ///< the current dither mode of the controller
     bool m_enabled = true;
     int m_nLeds;               ///< the number of LEDs in the LED data array
+    fl::u8 m_DitherPhase = 0;  ///< binary dither counter, advanced once per show
     static CLEDController *m_pHead;  ///< pointer to the first LED controller in the linked list
     static CLEDController *m_pTail;  ///< pointer to the last LED controller in the linked list
+#if FASTLED_SKIP_UNCHANGED_FRAMES
+    bool m_skipUnchanged = false;    ///< opt-in, see setSkipUnchangedFrames()
+    bool m_skipFrame = false;        ///< true while CFastLED::show() is skipping this controller
+    bool m_hasFrameHash = false;     ///< m_frameHash is valid
+    fl::u32 m_frameHash = 0;         ///< hash of the last transmitted frame
+#endif
 
 public:
 
@@ -97,6 +111,7 @@ public:
 
     // Compatibility with the 3.8.x codebase.
     VIRTUAL_IF_NOT_AVR void showLeds(fl::u8 brightness) {
+        invalidateFrameHash();
         void* data = beginShowLeds(m_nLeds);
         showLedsInternal(brightness);
         endShowLeds(data);
@@ -112,6 +127,7 @@ public:
     /// @param brightness the brightness of the LEDs
     /// @see show(const struct CRGB*, int, CRGB)
     void showInternal(const struct CRGB *data, int nLeds, fl::u8 brightness) {
+        invalidateFrameHash();
         if (m_enabled) {
            show(data, nLeds,brightness);
         }
@@ -125,6 +141,7 @@ public:
     /// @param brightness the brightness of the LEDs
     /// @see showColor(const struct CRGB&, int, CRGB)
     void showColorInternal(const struct CRGB &data, int nLeds, fl::u8 brightness) {
+        invalidateFrameHash();
         if (m_enabled) {
             showColor(data, nLeds, brightness);
         }
@@ -145,11 +162,61 @@ public:
     /// @param brightness the brightness of the LEDs
     /// @see showColor(const struct CRGB&, int, CRGB)
     void showColorInternal(const struct CRGB & data, fl::u8 brightness) {
+        invalidateFrameHash();
         if (m_enabled) {
             showColor(data, m_nLeds, brightness);
         }
     }
 
+    /// Skip re-transmitting frames that are identical to the last frame shown by
+    /// FastLED.show(). The led data is hashed together with the brightness, color
+    /// correction, temperature and dither mode, and when nothing changed the
+    /// controller is not touched at all for that frame. Useful for scenes that
+    /// hold still for long periods. Note that temporal dithering is frozen while
+    /// frames are being skipped. Has no effect if FASTLED_SKIP_UNCHANGED_FRAMES is 0.
+    /// @param skip true to skip unchanged frames
+    /// @returns a reference to the controller
+    CLEDController& setSkipUnchangedFrames(bool skip) {
+#if FASTLED_SKIP_UNCHANGED_FRAMES
+        m_skipUnchanged = skip;
+        m_hasFrameHash = false;
+#else
+        FASTLED_UNUSED(skip);
+#endif
+        return *this;
+    }
+
+    /// Whether unchanged frames are skipped, see setSkipUnchangedFrames()
+    bool getSkipUnchangedFrames() const {
+#if FASTLED_SKIP_UNCHANGED_FRAMES
+        return m_skipUnchanged;
+#else
+        return false;
+#endif
+    }
+
+    /// True while FastLED.show() is skipping this controller because its frame is unchanged.
+    bool skippingFrame() const {
+#if FASTLED_SKIP_UNCHANGED_FRAMES
+        return m_skipFrame;
+#else
+        return false;
+#endif
+    }
+
+    /// Forget the last transmitted frame so that the next show() is never skipped.
+    void invalidateFrameHash() {
+#if FASTLED_SKIP_UNCHANGED_FRAMES
+        m_hasFrameHash = false;
+#endif
+    }
+
+    /// Hashes the current led data and output settings and compares them against the
+    /// last frame. Returns true if the frame is identical and can be skipped. Always
+    /// returns false unless setSkipUnchangedFrames(true) was called.
+    /// @param brightness the brightness the frame will be shown with
+    bool frameUnchanged(fl::u8 brightness);
+
     /// Get the first LED controller in the linked list of controllers
     /// @returns CLEDController::m_pHead
     static CLEDController *head() { return m_pHead; }
@@ -219,6 +286,11 @@ public:
     /// @return the currently set dithering option (CLEDController::m_DitherMode)
     inline fl::u8 getDither() { return m_DitherMode; }
 
+    /// Advance this controller's dither counter for the next frame.
+    /// Kept per controller so that parallel shows don't share it.
+    /// @return the dither phase to pass to PixelController
+    inline fl::u8 nextDitherPhase() { return ++m_DitherPhase; }
+
     virtual void* beginShowLeds(int size) {
         FASTLED_UNUSED(size);
         // By default, emit an integer. This integer will, by default, be passed back.
@@ -35,7 +35,8 @@ protected:
         // getAdjustmentData(brightness, &premixed, &color_correction);
         // ColorAdjustment color_adjustment = {premixed, color_correction, brightness};
         ColorAdjustment color_adjustment = getAdjustmentData(brightness);
-        PixelController<RGB_ORDER, LANES, MASK> pixels(data, nLeds, color_adjustment, getDither());
+        PixelController<RGB_ORDER, LANES, MASK> pixels(data, nLeds, color_adjustment, getDither(),
+                                                 nextDitherPhase());
         showPixels(pixels);
     }
 
@@ -45,7 +46,8 @@ protected:
     /// @param scale_pre_mixed the RGB scaling of color adjustment + global brightness to apply to each LED (in RGB8 mode).
     virtual void show(const struct CRGB *data, int nLeds, fl::u8 brightness) override {
         ColorAdjustment color_adjustment = getAdjustmentData(brightness);
-        PixelController<RGB_ORDER, LANES, MASK> pixels(data, nLeds < 0 ? -nLeds : nLeds, color_adjustment, getDither());
+        PixelController<RGB_ORDER, LANES, MASK> pixels(data, nLeds < 0 ? -nLeds : nLeds, color_adjustment, getDither(),
+                                                 nextDitherPhase());
         if(nLeds < 0) {
             // nLeds < 0 implies that we want to show them in reverse
             pixels.mAdvance = -pixels.mAdvance;
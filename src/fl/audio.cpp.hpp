@@ -1,5 +1,6 @@
 
 #include "audio.h"
+#include "fl/audio_fixed.h"
 #include "fl/thread_local.h"
 #include "fl/int.h"
 
@@ -101,6 +102,10 @@ SoundLevelMeter::SoundLevelMeter(double spl_floor, double smoothing_alpha)
 
 void SoundLevelMeter::processBlock(const fl::i16 *samples, fl::size count) {
     // 1) compute block power → dBFS
+#if FASTLED_AUDIO_FIXED_POINT
+    // Integer power and log, one conversion per block.
+    double dbfs = dbfsQ16(samples, count) / 65536.0;
+#else
     double sum_sq = 0.0;
     for (fl::size i = 0; i < count; ++i) {
         double s = samples[i] / 32768.0; // normalize to ±1
@@ -108,6 +113,7 @@ void SoundLevelMeter::processBlock(const fl::i16 *samples, fl::size count) {
     }
     double p = sum_sq / count; // mean power
     double dbfs = 10.0 * log10(p + 1e-12);
+#endif
     current_dbfs_ = dbfs;
 
     // 2) update global floor (with optional smoothing)
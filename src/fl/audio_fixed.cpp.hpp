@@ -0,0 +1,97 @@
+#include "fl/audio_fixed.h"
+
+namespace fl {
+
+fl::u32 isqrt32(fl::u32 x) {
+    fl::u32 root = 0;
+    fl::u32 bit = fl::u32(1) << 30;
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+fl::u32 isqrt64(fl::u64 x) {
+    if (x <= 0xffffffffu) {
+        return isqrt32(fl::u32(x));
+    }
+    fl::u64 root = 0;
+    fl::u64 bit = fl::u64(1) << 62;
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return fl::u32(root);
+}
+
+fl::i32 log2Q16(fl::u32 x) {
+    if (x == 0) {
+        return 0;
+    }
+    int msb = 31;
+    while (!(x & (fl::u32(1) << msb))) {
+        --msb;
+    }
+    // Mantissa in [1, 2) as Q1.30, then one result bit per squaring.
+    fl::u32 m = msb >= 30 ? x >> (msb - 30) : x << (30 - msb);
+    fl::i32 result = fl::i32(msb) << 16;
+    for (int bit = 15; bit >= 0; --bit) {
+        m = fl::u32((fl::u64(m) * m) >> 30);
+        if (m >= (fl::u32(1) << 31)) {
+            m >>= 1;
+            result |= fl::i32(1) << bit;
+        }
+    }
+    return result;
+}
+
+fl::u32 rmsI16(const fl::i16 *samples, fl::size count) {
+    if (count == 0) {
+        return 0;
+    }
+    fl::u64 sumSq = 0;
+    for (fl::size i = 0; i < count; ++i) {
+        const fl::i32 s = samples[i];
+        sumSq += fl::u32(s * s);
+    }
+    return isqrt64(sumSq / count);
+}
+
+fl::i32 dbfsQ16(const fl::i16 *samples, fl::size count) {
+    const fl::i32 kFloor = -120 * 65536;
+    if (count == 0) {
+        return kFloor;
+    }
+    fl::u64 sumSq = 0;
+    for (fl::size i = 0; i < count; ++i) {
+        const fl::i32 s = samples[i];
+        sumSq += fl::u32(s * s);
+    }
+    const fl::u32 mean = fl::u32(sumSq / count);
+    if (mean == 0) {
+        return kFloor;
+    }
+    // 10 * log10(mean / 32768^2) = 10 * log10(2) * (log2(mean) - 30).
+    const fl::i64 log2Power = fl::i64(log2Q16(mean)) - (fl::i64(30) << 16);
+    const fl::i32 db = fl::i32((log2Power * 197283) / 65536);
+    return db < kFloor ? kFloor : db;
+}
+
+} // namespace fl
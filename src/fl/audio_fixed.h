@@ -0,0 +1,32 @@
+#pragma once
+
+#include "fl/int.h"
+
+// Integer only audio analysis for targets without an FPU (Cortex-M0+,
+// RP2040, AVR). When set, AudioReactive and SoundLevelMeter run their per
+// sample math on these helpers and only convert the final results to float.
+#ifndef FASTLED_AUDIO_FIXED_POINT
+#if defined(__ARM_ARCH_6M__) || defined(__AVR__)
+#define FASTLED_AUDIO_FIXED_POINT 1
+#else
+#define FASTLED_AUDIO_FIXED_POINT 0
+#endif
+#endif
+
+namespace fl {
+
+// floor(sqrt(x)).
+fl::u32 isqrt32(fl::u32 x);
+fl::u32 isqrt64(fl::u64 x);
+
+// log2(x) in Q16.16, within 2^-15 of the exact value. x must be non zero.
+fl::i32 log2Q16(fl::u32 x);
+
+// floor(rms) of a block of samples.
+fl::u32 rmsI16(const fl::i16 *samples, fl::size count);
+
+// Mean power of a block in dB full scale, Q16.16. A silent block gives
+// -120 dB, the same floor as the float SoundLevelMeter.
+fl::i32 dbfsQ16(const fl::i16 *samples, fl::size count);
+
+} // namespace fl
@@ -1,4 +1,5 @@
 #include "fl/audio_reactive.h"
+#include "fl/fft_impl.h"
 #include "fl/math.h"
 #include "fl/span.h"
 #include "fl/int.h"
@@ -6,6 +7,30 @@
 
 namespace fl {
 
+namespace {
+
+// Approximate center frequency of each bin, based on WLED frequency mapping
+const float kBinCenterFrequencies[16] = {
+    64.5f,   // Bin 0: 43-86 Hz
+    107.5f,  // Bin 1: 86-129 Hz  
+    172.5f,  // Bin 2: 129-216 Hz
+    258.5f,  // Bin 3: 216-301 Hz
+    365.5f,  // Bin 4: 301-430 Hz
+    495.0f,  // Bin 5: 430-560 Hz
+    689.0f,  // Bin 6: 560-818 Hz
+    969.0f,  // Bin 7: 818-1120 Hz
+    1270.5f, // Bin 8: 1120-1421 Hz
+    1658.0f, // Bin 9: 1421-1895 Hz
+    2153.5f, // Bin 10: 1895-2412 Hz
+    2713.5f, // Bin 11: 2412-3015 Hz
+    3359.5f, // Bin 12: 3015-3704 Hz
+    4091.5f, // Bin 13: 3704-4479 Hz
+    5792.5f, // Bin 14: 4479-7106 Hz
+    8182.5f  // Bin 15: 7106-9259 Hz
+};
+
+} // namespace
+
 AudioReactive::AudioReactive() 
     : mFFTBins(16)  // Initialize with 16 frequency bins
 {
@@ -16,12 +41,14 @@ AudioReactive::~AudioReactive() = default;
 
 void AudioReactive::begin(const AudioConfig& config) {
     setConfig(config);
+#if FASTLED_AUDIO_FIXED_POINT
+    mFixed.begin(config);
+#endif
     
     // Reset state
     mCurrentData = AudioData{};
     mSmoothedData = AudioData{};
-    mLastBeatTime = 0;
-    mPreviousVolume = 0.0f;
+    mBeatDetector.reset();
     mAGCMultiplier = 1.0f;
     mMaxSample = 0.0f;
     mAverageLevel = 0.0f;
@@ -29,6 +56,9 @@ void AudioReactive::begin(const AudioConfig& config) {
 
 void AudioReactive::setConfig(const AudioConfig& config) {
     mConfig = config;
+#if FASTLED_AUDIO_FIXED_POINT
+    mFixed.setConfig(config);
+#endif
 }
 
 void AudioReactive::processSample(const AudioSample& sample) {
@@ -36,6 +66,11 @@ void AudioReactive::processSample(const AudioSample& sample) {
         return; // Invalid sample, ignore
     }
     
+#if FASTLED_AUDIO_FIXED_POINT
+    mFixed.processSample(sample);
+    mCurrentData = mFixed.getData();
+    mSmoothedData = mFixed.getSmoothedData();
+#else
     // Extract timestamp from the AudioSample
     fl::u32 currentTimeMs = sample.timestamp();
     
@@ -48,6 +83,7 @@ void AudioReactive::processSample(const AudioSample& sample) {
     smoothResults();
     
     mCurrentData.timestamp = currentTimeMs;
+#endif
 }
 
 void AudioReactive::update(fl::u32 currentTimeMs) {
@@ -94,28 +130,7 @@ void AudioReactive::mapFFTBinsToFrequencyChannels() {
         }
     }
     
-    // Convert bin index to approximate frequency
-    // Rough approximation based on WLED frequency mapping
-    const float binCenterFrequencies[16] = {
-        64.5f,   // Bin 0: 43-86 Hz
-        107.5f,  // Bin 1: 86-129 Hz  
-        172.5f,  // Bin 2: 129-216 Hz
-        258.5f,  // Bin 3: 216-301 Hz
-        365.5f,  // Bin 4: 301-430 Hz
-        495.0f,  // Bin 5: 430-560 Hz
-        689.0f,  // Bin 6: 560-818 Hz
-        969.0f,  // Bin 7: 818-1120 Hz
-        1270.5f, // Bin 8: 1120-1421 Hz
-        1658.0f, // Bin 9: 1421-1895 Hz
-        2153.5f, // Bin 10: 1895-2412 Hz
-        2713.5f, // Bin 11: 2412-3015 Hz
-        3359.5f, // Bin 12: 3015-3704 Hz
-        4091.5f, // Bin 13: 3704-4479 Hz
-        5792.5f, // Bin 14: 4479-7106 Hz
-        8182.5f  // Bin 15: 7106-9259 Hz
-    };
-    
-    mCurrentData.dominantFrequency = binCenterFrequencies[maxBin];
+    mCurrentData.dominantFrequency = kBinCenterFrequencies[maxBin];
     mCurrentData.magnitude = maxMagnitude;
 }
 
@@ -182,35 +197,13 @@ void AudioReactive::updateVolumeAndPeak(const AudioSample& sample) {
 }
 
 void AudioReactive::detectBeat(fl::u32 currentTimeMs) {
-    // Need minimum time since last beat
-    if (currentTimeMs - mLastBeatTime < BEAT_COOLDOWN) {
-        mCurrentData.beatDetected = false;
-        return;
-    }
-    
-    // Simple beat detection based on volume increase
-    float currentVolume = mCurrentData.volume;
-    
-    // Beat detected if volume significantly increased
-    if (currentVolume > mPreviousVolume + mVolumeThreshold && 
-        currentVolume > 5.0f) {  // Minimum volume threshold
-        mCurrentData.beatDetected = true;
-        mLastBeatTime = currentTimeMs;
-    } else {
-        mCurrentData.beatDetected = false;
-    }
-    
-    // Update previous volume for next comparison using attack/decay
-    float beatAttackRate = mConfig.attack / 255.0f * 0.5f + 0.1f;   // 0.1 to 0.6
-    float beatDecayRate = mConfig.decay / 255.0f * 0.3f + 0.05f;    // 0.05 to 0.35
-    
-    if (currentVolume > mPreviousVolume) {
-        // Rising volume - use attack rate (faster tracking)
-        mPreviousVolume = mPreviousVolume * (1.0f - beatAttackRate) + currentVolume * beatAttackRate;
-    } else {
-        // Falling volume - use decay rate (slower tracking)
-        mPreviousVolume = mPreviousVolume * (1.0f - beatDecayRate) + currentVolume * beatDecayRate;
-    }
+    // Onsets come from the raw bands, before gain and AGC, so level changes
+    // from the AGC do not register as beats.
+    mCurrentData.beatDetected = mBeatDetector.update(
+        mFFTBins.bins_raw.data(), static_cast<int>(mFFTBins.bins_raw.size()),
+        currentTimeMs);
+    mCurrentData.bpm = mBeatDetector.bpm();
+    mCurrentData.nextBeatTime = mBeatDetector.nextBeatTime();
 }
 
 void AudioReactive::applyGain() {
@@ -324,6 +317,8 @@ void AudioReactive::smoothResults() {
     
     // Copy non-smoothed values
     mSmoothedData.beatDetected = mCurrentData.beatDetected;
+    mSmoothedData.bpm = mCurrentData.bpm;
+    mSmoothedData.nextBeatTime = mCurrentData.nextBeatTime;
     mSmoothedData.dominantFrequency = mCurrentData.dominantFrequency;
     mSmoothedData.magnitude = mCurrentData.magnitude;
     mSmoothedData.timestamp = mCurrentData.timestamp;
@@ -360,6 +355,14 @@ bool AudioReactive::isBeat() const {
     return mCurrentData.beatDetected;
 }
 
+float AudioReactive::getBPM() const {
+    return mCurrentData.bpm;
+}
+
+fl::u32 AudioReactive::getNextBeatTime() const {
+    return mCurrentData.nextBeatTime;
+}
+
 fl::u8 AudioReactive::volumeToScale255() const {
     float vol = (mCurrentData.volume < 0.0f) ? 0.0f : ((mCurrentData.volume > 255.0f) ? 255.0f : mCurrentData.volume);
     return static_cast<fl::u8>(vol);
@@ -407,4 +410,202 @@ float AudioReactive::computeRMS(const fl::vector<fl::i16>& samples) {
     return sqrtf(sumSquares / samples.size());
 }
 
+// AudioReactiveFixed. Levels are Q24.8, rates and factors Q16.16, and every
+// constant below is the float pipeline's constant in that format.
+
+namespace {
+
+const fl::u32 kOneQ16 = 65536;
+
+// PINK_NOISE_COMPENSATION in Q8.
+const fl::u16 kPinkNoiseQ8[16] = {435, 438, 443, 456, 430, 399, 397, 417,
+                                  458, 415, 461, 527, 632, 858, 1748, 2445};
+
+fl::u32 mulQ16(fl::u32 value, fl::u32 factor) {
+    const fl::u64 out = (fl::u64(value) * factor) >> 16;
+    return out > 0xffffffffu ? 0xffffffffu : fl::u32(out);
+}
+
+// a * (1 - f) + b * f
+fl::u32 lerpQ16(fl::u32 a, fl::u32 b, fl::u32 f) {
+    return fl::u32((fl::u64(a) * (kOneQ16 - f) + fl::u64(b) * f) >> 16);
+}
+
+float fromQ8(fl::u32 v) { return float(v) * (1.0f / 256.0f); }
+
+} // namespace
+
+AudioReactiveFixed::AudioReactiveFixed() {}
+
+AudioReactiveFixed::~AudioReactiveFixed() {}
+
+void AudioReactiveFixed::begin(const AudioConfig& config) {
+    setConfig(config);
+    mCurrent = Levels();
+    mSmoothed = Levels();
+    mCurrentData = AudioData{};
+    mSmoothedData = AudioData{};
+    mBeatDetector.reset();
+    mAGCMultiplier = kOneQ16;
+    mMaxSample = 0;
+}
+
+void AudioReactiveFixed::processSample(const AudioSample& sample) {
+    if (!sample.isValid()) {
+        return;
+    }
+    const fl::u32 currentTimeMs = sample.timestamp();
+    processFFT(sample);
+    updateVolumeAndPeak(sample);
+    detectBeat(currentTimeMs);
+    applyGain();
+    applyScaling();
+    smoothResults();
+    toAudioData(mCurrent, &mCurrentData);
+    toAudioData(mSmoothed, &mSmoothedData);
+    mCurrentData.timestamp = currentTimeMs;
+    mSmoothedData.timestamp = currentTimeMs;
+}
+
+void AudioReactiveFixed::processFFT(const AudioSample& sample) {
+    const auto& pcm = sample.pcm();
+    if (pcm.empty()) {
+        return;
+    }
+    if (!mFFT || mFFT->sampleSize() != pcm.size()) {
+        mFFT.reset(new FFTImpl(FFT_Args(int(pcm.size()), 16)));
+    }
+    fl::u32 magnitudes[16] = {0};
+    mFFT->runMagnitudes(span<const fl::i16>(pcm.data(), pcm.size()),
+                        magnitudes);
+    for (int i = 0; i < 16; ++i) {
+        mMagnitudes[i] = magnitudes[i];
+    }
+    fl::u32 maxMagnitude = 0;
+    int maxBin = 0;
+    for (int i = 0; i < 16; ++i) {
+        mCurrent.bins[i] =
+            fl::u32((fl::u64(magnitudes[i]) * kPinkNoiseQ8[i]) >> 8);
+        if (mCurrent.bins[i] > maxMagnitude) {
+            maxMagnitude = mCurrent.bins[i];
+            maxBin = i;
+        }
+    }
+    mCurrentData.dominantFrequency = kBinCenterFrequencies[maxBin];
+    mCurrentData.magnitude = fromQ8(maxMagnitude);
+}
+
+void AudioReactiveFixed::updateVolumeAndPeak(const AudioSample& sample) {
+    const auto& pcm = sample.pcm();
+    if (pcm.empty()) {
+        mCurrent.volume = 0;
+        mCurrent.volumeRaw = 0;
+        mCurrent.peak = 0;
+        return;
+    }
+    const fl::u32 rms = rmsI16(pcm.data(), pcm.size());
+    fl::u32 maxSample = 0;
+    for (fl::i16 s : pcm) {
+        const fl::u32 a = fl::u32(s < 0 ? -fl::i32(s) : fl::i32(s));
+        maxSample = maxSample > a ? maxSample : a;
+    }
+    mCurrent.volumeRaw = rms * 2; // rms / 128
+    mCurrent.volume = mCurrent.volumeRaw;
+    mCurrent.peak = maxSample * 255 / 128; // maxSample / 32768 * 255
+
+    if (mConfig.agcEnabled) {
+        const fl::u32 attackRate = mConfig.attack * 13107u / 255 + 655;
+        const fl::u32 decayRate = mConfig.decay * 3277u / 255 + 66;
+        const fl::u32 maxQ8 = maxSample << 8;
+        mMaxSample = lerpQ16(mMaxSample, maxQ8,
+                             maxQ8 > mMaxSample ? attackRate : decayRate);
+        if (mMaxSample > (1000u << 8)) {
+            // 16384 / mMaxSample in Q16.16.
+            const fl::u32 target =
+                fl::u32((fl::u64(16384) << 24) / mMaxSample);
+            mAGCMultiplier =
+                lerpQ16(mAGCMultiplier, target,
+                        target > mAGCMultiplier ? attackRate : decayRate);
+            const fl::u32 lo = 6554;   // 0.1
+            const fl::u32 hi = 655360; // 10.0
+            mAGCMultiplier = mAGCMultiplier < lo
+                                 ? lo
+                                 : (mAGCMultiplier > hi ? hi : mAGCMultiplier);
+        }
+    }
+}
+
+void AudioReactiveFixed::detectBeat(fl::u32 currentTimeMs) {
+    mCurrentData.beatDetected =
+        mBeatDetector.update(mMagnitudes, 16, currentTimeMs);
+    mCurrentData.bpm = mBeatDetector.bpm();
+    mCurrentData.nextBeatTime = mBeatDetector.nextBeatTime();
+}
+
+void AudioReactiveFixed::applyGain() {
+    // gain / 128, times the AGC multiplier when enabled.
+    fl::u32 factor = fl::u32(mConfig.gain) << 9;
+    if (mConfig.agcEnabled) {
+        factor = mulQ16(factor, mAGCMultiplier);
+    }
+    mCurrent.volume = mulQ16(mCurrent.volume, factor);
+    mCurrent.volumeRaw = mulQ16(mCurrent.volumeRaw, factor);
+    mCurrent.peak = mulQ16(mCurrent.peak, factor);
+    for (int i = 0; i < 16; ++i) {
+        mCurrent.bins[i] = mulQ16(mCurrent.bins[i], factor);
+    }
+}
+
+void AudioReactiveFixed::applyScaling() {
+    for (int i = 0; i < 16; ++i) {
+        fl::u32 &value = mCurrent.bins[i];
+        switch (mConfig.scalingMode) {
+        case 1: // logf(value) * 20
+            if (value > 256) {
+                const fl::i64 log2v = fl::i64(log2Q16(value)) - (8 << 16);
+                // 20 * ln(2) = 13.8629 = 3549 in Q8.
+                value = fl::u32((log2v * 3549) >> 16);
+            } else {
+                value = 0;
+            }
+            break;
+        case 3: // sqrtf(value) * 8
+            value = isqrt64(fl::u64(value) << 14);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void AudioReactiveFixed::smoothResults() {
+    const fl::u32 attack = kOneQ16 - mConfig.attack * 58982u / 255;
+    const fl::u32 decay = kOneQ16 - mConfig.decay * 62259u / 255;
+    auto smooth = [&](fl::u32 *smoothed, fl::u32 current) {
+        *smoothed =
+            lerpQ16(*smoothed, current, current > *smoothed ? attack : decay);
+    };
+    smooth(&mSmoothed.volume, mCurrent.volume);
+    smooth(&mSmoothed.volumeRaw, mCurrent.volumeRaw);
+    smooth(&mSmoothed.peak, mCurrent.peak);
+    for (int i = 0; i < 16; ++i) {
+        smooth(&mSmoothed.bins[i], mCurrent.bins[i]);
+    }
+    mSmoothedData.beatDetected = mCurrentData.beatDetected;
+    mSmoothedData.bpm = mCurrentData.bpm;
+    mSmoothedData.nextBeatTime = mCurrentData.nextBeatTime;
+    mSmoothedData.dominantFrequency = mCurrentData.dominantFrequency;
+    mSmoothedData.magnitude = mCurrentData.magnitude;
+}
+
+void AudioReactiveFixed::toAudioData(const Levels& levels,
+                                     AudioData* out) const {
+    out->volume = fromQ8(levels.volume);
+    out->volumeRaw = fromQ8(levels.volumeRaw);
+    out->peak = fromQ8(levels.peak);
+    for (int i = 0; i < 16; ++i) {
+        out->frequencyBins[i] = fromQ8(levels.bins[i]);
+    }
+}
+
 } // namespace fl
@@ -6,6 +6,9 @@
 #include "fl/stdint.h"
 #include "fl/int.h"
 #include "fl/audio.h"
+#include "fl/audio_fixed.h"
+#include "fl/beat_detector.h"
+#include "fl/scoped_ptr.h"
 #include "crgb.h"
 #include "fl/colorutils.h"
 
@@ -17,6 +20,8 @@ struct AudioData {
     float volumeRaw = 0.0f;                 // Raw volume without smoothing
     float peak = 0.0f;                      // Peak level (0-255) 
     bool beatDetected = false;              // Beat detection flag
+    float bpm = 0.0f;                       // Estimated tempo, 0 until locked
+    fl::u32 nextBeatTime = 0;               // Predicted next beat (ms), 0 if unknown
     float frequencyBins[16] = {0};          // 16 frequency bins (matches WLED NUM_GEQ_CHANNELS)
     float dominantFrequency = 0.0f;         // Major peak frequency (Hz)
     float magnitude = 0.0f;                 // FFT magnitude of dominant frequency
@@ -34,6 +39,54 @@ struct AudioConfig {
     fl::u8 scalingMode = 3;         // 0=none, 1=log, 2=linear, 3=sqrt
 };
 
+class FFTImpl;
+
+// Integer version of the AudioReactive pipeline: Q15 FFT and constant-Q
+// bands, integer RMS, AGC, gain, scaling, smoothing and beat detection, all
+// kept in Q24.8. Only the finished AudioData is converted to float, so it
+// runs without an FPU and tracks the float pipeline closely.
+// AudioReactive uses it when FASTLED_AUDIO_FIXED_POINT is set.
+class AudioReactiveFixed {
+public:
+    AudioReactiveFixed();
+    ~AudioReactiveFixed();
+
+    void begin(const AudioConfig& config = AudioConfig{});
+    void setConfig(const AudioConfig& config) { mConfig = config; }
+    void processSample(const AudioSample& sample);
+
+    const AudioData& getData() const { return mCurrentData; }
+    const AudioData& getSmoothedData() const { return mSmoothedData; }
+
+private:
+    // Q24.8 counterpart of AudioData.
+    struct Levels {
+        fl::u32 volume = 0;
+        fl::u32 volumeRaw = 0;
+        fl::u32 peak = 0;
+        fl::u32 bins[16] = {0};
+    };
+
+    void processFFT(const AudioSample& sample);
+    void updateVolumeAndPeak(const AudioSample& sample);
+    void detectBeat(fl::u32 currentTimeMs);
+    void applyGain();
+    void applyScaling();
+    void smoothResults();
+    void toAudioData(const Levels& levels, AudioData* out) const;
+
+    AudioConfig mConfig;
+    fl::scoped_ptr<FFTImpl> mFFT;
+    Levels mCurrent;
+    Levels mSmoothed;
+    AudioData mCurrentData;
+    AudioData mSmoothedData;
+    BeatDetector mBeatDetector;
+    fl::u32 mMagnitudes[16] = {0}; // Band magnitudes before compensation.
+    fl::u32 mAGCMultiplier = 65536; // Q16.16
+    fl::u32 mMaxSample = 0; // Q24.8
+};
+
 class AudioReactive {
 public:
     AudioReactive();
@@ -59,6 +112,8 @@ public:
     float getMid() const;     // Average of bins 6-7 
     float getTreble() const;  // Average of bins 14-15
     bool isBeat() const;
+    float getBPM() const;              // 0 until a tempo is found
+    fl::u32 getNextBeatTime() const;   // Predicted next beat (ms), 0 if unknown
     
     // Effect helpers
     fl::u8 volumeToScale255() const;
@@ -90,13 +145,8 @@ private:
     AudioData mCurrentData;
     AudioData mSmoothedData;
     
-    // Processing state  
-    fl::u32 mLastBeatTime = 0;
-    static constexpr fl::u32 BEAT_COOLDOWN = 100;   // 100ms minimum between beats
-    
-    // Volume tracking for beat detection
-    float mPreviousVolume = 0.0f;
-    float mVolumeThreshold = 10.0f;
+    // Spectral flux beat and tempo tracking on mFFTBins
+    BeatDetector mBeatDetector;
     
     // Pink noise compensation (from WLED)
     static constexpr float PINK_NOISE_COMPENSATION[16] = {
@@ -108,6 +158,10 @@ private:
     float mAGCMultiplier = 1.0f;
     float mMaxSample = 0.0f;
     float mAverageLevel = 0.0f;
+
+#if FASTLED_AUDIO_FIXED_POINT
+    AudioReactiveFixed mFixed;
+#endif
 };
 
 
@@ -0,0 +1,5 @@
+#include "fl/compiler_control.h"
+
+#if !FASTLED_ALL_SRC
+#include "fl/beat_detector.cpp.hpp"
+#endif
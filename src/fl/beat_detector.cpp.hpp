@@ -0,0 +1,205 @@
+#include "fl/beat_detector.h"
+
+#include "fl/audio_fixed.h"
+
+namespace fl {
+
+namespace {
+
+// A beat needs at least this much flux, one band doubling its energy.
+const fl::i32 kMinFlux = 256;
+// Running mean and deviation follow the flux with a 1/16 step.
+const int kStatsShift = 4;
+// The autocorrelation forgets with a time constant of 64 frames. Products
+// of two u16 onsets are scaled down so the sum stays below 2^32 >> 2.
+const int kAcfShift = 6;
+const int kAcfProductShift = 8;
+
+// log2(1 + v) of a Q24.8 value, in Q16.16.
+fl::u32 compress(fl::u32 v) {
+    if (v > 0xffffffffu - 256) {
+        v = 0xffffffffu - 256;
+    }
+    return fl::u32(log2Q16(v + 256) - (8 << 16));
+}
+
+} // namespace
+
+BeatDetector::BeatDetector(fl::u16 minBpm, fl::u16 maxBpm)
+    : mMinBpm(minBpm ? minBpm : 1),
+      mMaxBpm(maxBpm > minBpm ? maxBpm : fl::u16(minBpm + 1)) {
+    reset();
+}
+
+void BeatDetector::reset() {
+    for (int i = 0; i < kMaxBands; ++i) {
+        mPrevBands[i] = 0;
+    }
+    for (int i = 0; i < FASTLED_BEAT_HISTORY; ++i) {
+        mOnsets[i] = 0;
+        mAcf[i] = 0;
+    }
+    mHead = 0;
+    mFrames = 0;
+    mMean = 0;
+    mDev = 0;
+    mLastTime = 0;
+    mFrameMsQ8 = 0;
+    mLastBeat = 0;
+    mNextBeat = 0;
+    mPeriodMs = 0;
+    mBpmQ8 = 0;
+    mFlux = 0;
+    mBeat = false;
+    mHaveFrame = false;
+    mHaveBeat = false;
+}
+
+bool BeatDetector::update(const float *bands, int numBands, fl::u32 timeMs) {
+    fl::u32 q8[kMaxBands];
+    numBands = numBands < kMaxBands ? numBands : kMaxBands;
+    for (int i = 0; i < numBands; ++i) {
+        const float v = bands[i] * 256.0f;
+        q8[i] = v <= 0.0f ? 0
+                          : (v >= 4294967040.0f ? 0xffffff00u : fl::u32(v));
+    }
+    return update(q8, numBands, timeMs);
+}
+
+bool BeatDetector::update(const fl::u32 *bands, int numBands,
+                          fl::u32 timeMs) {
+    numBands = numBands < kMaxBands ? numBands : kMaxBands;
+    mBeat = false;
+    if (!mHaveFrame) {
+        for (int i = 0; i < numBands; ++i) {
+            mPrevBands[i] = compress(bands[i]);
+        }
+        mHaveFrame = true;
+        mLastTime = timeMs;
+        return false;
+    }
+
+    // Frame period, needed to turn lags into BPM.
+    const fl::u32 dtQ8 = (timeMs - mLastTime) << 8;
+    mLastTime = timeMs;
+    if (mFrameMsQ8 == 0) {
+        mFrameMsQ8 = dtQ8;
+    } else {
+        mFrameMsQ8 = fl::u32(fl::i32(mFrameMsQ8) +
+                             (fl::i32(dtQ8) - fl::i32(mFrameMsQ8)) / 8);
+    }
+
+    // Half wave rectified spectral flux of the log band energies.
+    fl::u32 flux = 0;
+    for (int i = 0; i < numBands; ++i) {
+        const fl::u32 c = compress(bands[i]);
+        if (c > mPrevBands[i]) {
+            flux += c - mPrevBands[i];
+        }
+        mPrevBands[i] = c;
+    }
+    mFlux = flux >> 8;
+    const fl::i32 fluxQ8 = fl::i32(mFlux);
+
+    // Adaptive threshold: mean plus twice the mean deviation.
+    const fl::i32 threshold = mMean + 2 * mDev;
+    const fl::u32 minInterval = 30000u / mMaxBpm;
+    if (mFrames >= 4 && fluxQ8 > threshold && fluxQ8 >= kMinFlux &&
+        (!mHaveBeat || timeMs - mLastBeat >= minInterval)) {
+        mBeat = true;
+    }
+    const fl::i32 above = fluxQ8 - mMean;
+    const fl::i32 deviation = above < 0 ? -above : above;
+    mMean += above / (1 << kStatsShift);
+    mDev += (deviation - mDev) / (1 << kStatsShift);
+
+    // Onset history and the running autocorrelation of it.
+    const fl::u16 onset =
+        fl::u16(above <= 0 ? 0 : (above > 0xffff ? 0xffff : above));
+    const fl::u32 size = FASTLED_BEAT_HISTORY;
+    mOnsets[mHead] = onset;
+    for (fl::u32 lag = 1; lag < size && lag <= mFrames; ++lag) {
+        const fl::u16 past = mOnsets[(mHead + size - lag) % size];
+        mAcf[lag] -= mAcf[lag] >> kAcfShift;
+        mAcf[lag] += (fl::u32(onset) * past) >> kAcfProductShift;
+    }
+    mHead = (mHead + 1) % size;
+    if (mFrames < size) {
+        ++mFrames;
+    }
+    updateTempo();
+
+    // Beat phase, coasting on the tempo between detected beats.
+    if (mBeat) {
+        mHaveBeat = true;
+        mLastBeat = timeMs;
+        mNextBeat = mPeriodMs ? timeMs + mPeriodMs : 0;
+    } else if (mPeriodMs && mHaveBeat) {
+        if (mNextBeat == 0) {
+            mNextBeat = mLastBeat + mPeriodMs;
+        }
+        while (fl::i32(timeMs - mNextBeat) >= 0) {
+            mNextBeat += mPeriodMs;
+        }
+    }
+    return mBeat;
+}
+
+void BeatDetector::updateTempo() {
+    const fl::u32 dt = mFrameMsQ8;
+    if (dt == 0) {
+        return;
+    }
+    const fl::u32 msQ8 = 60000u << 8;
+    fl::u32 minLag = (msQ8 + mMaxBpm * dt - 1) / (mMaxBpm * dt);
+    fl::u32 maxLag = msQ8 / (mMinBpm * dt);
+    minLag = minLag < 2 ? 2 : minLag;
+    maxLag = maxLag > FASTLED_BEAT_HISTORY - 2 ? FASTLED_BEAT_HISTORY - 2
+                                               : maxLag;
+    if (minLag > maxLag || mFrames <= maxLag + 1) {
+        return;
+    }
+    fl::u32 best = minLag;
+    for (fl::u32 lag = minLag + 1; lag <= maxLag; ++lag) {
+        if (mAcf[lag] > mAcf[best]) {
+            best = lag;
+        }
+    }
+    if (mAcf[best] == 0) {
+        return;
+    }
+    // When the onsets do not land on whole frames the energy at the true lag
+    // is split between two bins, and the peak at twice the lag can win. Prefer
+    // the faster tempo if there is a strong peak at half the lag.
+    const fl::u32 half = (best + 1) / 2;
+    if (half - 1 >= minLag) {
+        fl::u32 alt = half - 1;
+        for (fl::u32 lag = half; lag <= half + 1; ++lag) {
+            if (mAcf[lag] > mAcf[alt]) {
+                alt = lag;
+            }
+        }
+        if (mAcf[alt] * 2 >= mAcf[best]) {
+            best = alt;
+        }
+    }
+    // Parabolic interpolation of the peak for a sub frame lag.
+    const fl::i64 a = fl::i64(mAcf[best - 1]);
+    const fl::i64 b = fl::i64(mAcf[best]);
+    const fl::i64 c = fl::i64(mAcf[best + 1]);
+    const fl::i64 denom = a - 2 * b + c;
+    fl::i64 offsetQ8 = 0;
+    if (denom < 0) {
+        offsetQ8 = ((a - c) * 128) / denom;
+        offsetQ8 = offsetQ8 > 128 ? 128 : (offsetQ8 < -128 ? -128 : offsetQ8);
+    }
+    const fl::i64 lagQ8 = fl::i64(best) * 256 + offsetQ8;
+    const fl::u64 periodQ8 = fl::u64(lagQ8) * dt >> 8;
+    if (periodQ8 == 0) {
+        return;
+    }
+    mPeriodMs = fl::u32((periodQ8 + 128) >> 8);
+    mBpmQ8 = fl::u32((fl::u64(60000) << 16) / periodQ8);
+}
+
+} // namespace fl
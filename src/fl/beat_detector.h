@@ -0,0 +1,84 @@
+#pragma once
+
+#include "fl/int.h"
+
+// Frames of onset history, bounds the slowest tempo that can be detected:
+// maxLag * frame period must fit, e.g. 128 frames of 23ms reach 26 BPM and
+// 64 frames reach 42 BPM. Each frame of history costs 6 bytes and one
+// multiply-accumulate per update.
+#ifndef FASTLED_BEAT_HISTORY
+#if defined(__AVR__) || defined(__ARM_ARCH_6M__)
+#define FASTLED_BEAT_HISTORY 64
+#else
+#define FASTLED_BEAT_HISTORY 128
+#endif
+#endif
+
+namespace fl {
+
+// Onset and tempo tracker fed with one set of band magnitudes per audio
+// frame.
+//
+// Onsets are the spectral flux: the summed increase of log band energy since
+// the previous frame. A steady bass line has no flux, while a kick or a
+// hi-hat in any band does. A beat fires when the flux clears an adaptive
+// threshold (running mean plus deviations), at most once per half the
+// shortest beat period.
+//
+// The tempo comes from an autocorrelation of the onset history, kept as
+// exponentially decaying sums per lag so each update costs the same no
+// matter how long it has been running. Once a tempo is found the detector
+// predicts the next beat, and keeps predicting through frames without
+// onsets, so effects can schedule ahead of the beat.
+//
+// Integer only, the same code runs for the float and the fixed point
+// AudioReactive pipelines.
+class BeatDetector {
+  public:
+    enum { kMaxBands = 16 };
+
+    BeatDetector(fl::u16 minBpm = 70, fl::u16 maxBpm = 180);
+
+    void reset();
+
+    // Bands in Q24.8. Returns true if this frame is a beat.
+    bool update(const fl::u32 *bands, int numBands, fl::u32 timeMs);
+    bool update(const float *bands, int numBands, fl::u32 timeMs);
+
+    bool beat() const { return mBeat; }
+    // Spectral flux of the last frame, Q24.8.
+    fl::u32 onsetStrength() const { return mFlux; }
+    // Estimated tempo in Q24.8 BPM, 0 until enough history has been seen.
+    fl::u32 bpmQ8() const { return mBpmQ8; }
+    float bpm() const { return float(mBpmQ8) * (1.0f / 256.0f); }
+    // Milliseconds per beat, 0 while the tempo is unknown.
+    fl::u32 beatPeriodMs() const { return mPeriodMs; }
+    // Predicted time of the next beat, 0 while the tempo is unknown.
+    fl::u32 nextBeatTime() const { return mNextBeat; }
+
+  private:
+    void updateTempo();
+
+    fl::u16 mMinBpm;
+    fl::u16 mMaxBpm;
+    fl::u32 mPrevBands[kMaxBands];
+    fl::u16 mOnsets[FASTLED_BEAT_HISTORY];
+    // Decaying sum of o[t] * o[t - lag] >> 8, at most 2^30.
+    fl::u32 mAcf[FASTLED_BEAT_HISTORY];
+    fl::u32 mHead;   // Next slot in mOnsets.
+    fl::u32 mFrames; // Saturates at FASTLED_BEAT_HISTORY.
+    fl::i32 mMean;   // Running flux mean and mean deviation, Q24.8.
+    fl::i32 mDev;
+    fl::u32 mLastTime;
+    fl::u32 mFrameMsQ8; // Running frame period.
+    fl::u32 mLastBeat;
+    fl::u32 mNextBeat;
+    fl::u32 mPeriodMs;
+    fl::u32 mBpmQ8;
+    fl::u32 mFlux;
+    bool mBeat;
+    bool mHaveFrame;
+    bool mHaveBeat;
+};
+
+} // namespace fl
@@ -1,5 +1,7 @@
 
 
+#include <string.h>
+
 #include "fl/stdint.h"
 
 #define FASTLED_INTERNAL
@@ -10,6 +12,7 @@
 #include "fl/colorutils_misc.h"
 #include "fl/deprecated.h"
 #include "fl/unused.h"
+#include "fl/vector.h"
 #include "fl/xymap.h"
 #include "lib8tion/scale8.h"
 #include "fl/int.h"
@@ -81,6 +84,17 @@ void blur2d(CRGB *leds, fl::u8 width, fl::u8 height, fract8 blur_amount) {
     blur2d(leds, width, height, blur_amount, xy);
 }
 
+namespace {
+
+// Serpentine and line by line maps of this size have every row in one run
+// of the led buffer, so rows and columns can be walked by pointer.
+bool blurHasRowSpans(const XYMap &xyMap, fl::u8 width, fl::u8 height) {
+    return (xyMap.isSerpentine() || xyMap.isLineByLine()) &&
+           xyMap.getWidth() == width && xyMap.getHeight() == height;
+}
+
+} // namespace
+
 void blurRows(CRGB *leds, fl::u8 width, fl::u8 height, fract8 blur_amount,
               const XYMap &xyMap) {
 
@@ -92,6 +106,17 @@ void blurRows(CRGB *leds, fl::u8 width, fl::u8 height, fract8 blur_amount,
     // blur rows same as columns, for irregular matrix
     fl::u8 keep = 255 - blur_amount;
     fl::u8 seep = blur_amount >> 1;
+    if (blurHasRowSpans(xyMap, width, height)) {
+        // The blur spreads equally both ways, so a row that runs backwards
+        // in memory is blurred in memory order with the same result.
+        for (fl::u8 row = 0; row < height; row++) {
+            const XYSpan span = xyMap.spanAt(0, row);
+            CRGB *first = leds + span.index;
+            blur1d(span.step > 0 ? first : first - (width - 1), width,
+                   blur_amount);
+        }
+        return;
+    }
     for (fl::u8 row = 0; row < height; row++) {
         CRGB carryover = CRGB::Black;
         for (fl::u8 i = 0; i < width; i++) {
@@ -114,6 +139,39 @@ void blurColumns(CRGB *leds, fl::u8 width, fl::u8 height, fract8 blur_amount,
     // blur columns
     fl::u8 keep = 255 - blur_amount;
     fl::u8 seep = blur_amount >> 1;
+    if (blurHasRowSpans(xyMap, width, height)) {
+        // Up to 32 columns at once, a row at a time, with the carryover of
+        // each column on the stack. Nothing is allocated for any width.
+        CRGB carryover[32];
+        for (fl::u8 first = 0; first < width;) {
+            const fl::u8 count = width - first < 32 ? width - first : 32;
+            for (fl::u8 col = 0; col < count; ++col) {
+                carryover[col] = CRGB::Black;
+            }
+            CRGB *prev = nullptr;
+            int prevStep = 0;
+            for (fl::u8 i = 0; i < height; ++i) {
+                const XYSpan span = xyMap.spanAt(0, i);
+                const int step = span.step;
+                CRGB *row = leds + span.index + step * first;
+                for (fl::u8 col = 0; col < count; ++col) {
+                    CRGB cur = row[step * col];
+                    CRGB part = cur;
+                    part.nscale8(seep);
+                    cur.nscale8(keep);
+                    cur += carryover[col];
+                    if (i)
+                        prev[prevStep * col] += part;
+                    row[step * col] = cur;
+                    carryover[col] = part;
+                }
+                prev = row;
+                prevStep = step;
+            }
+            first += count;
+        }
+        return;
+    }
     for (fl::u8 col = 0; col < width; ++col) {
         CRGB carryover = CRGB::Black;
         for (fl::u8 i = 0; i < height; ++i) {
@@ -130,4 +188,134 @@ void blurColumns(CRGB *leds, fl::u8 width, fl::u8 height, fract8 blur_amount,
     }
 }
 
+namespace {
+
+// x / d rounded to nearest, as (x + d / 2) * mul >> kBoxShift. Matches the
+// integer division for every sum of d bytes up to d = 181, i.e. radius 90.
+// Above that the rounded up multiplier overshoots by up to 255 * d / 2^23,
+// under one step for radii below 16k, so the result is saturated to a byte.
+const int kBoxShift = 23;
+
+fl::u32 boxMultiplier(fl::u32 d) {
+    return ((fl::u32(1) << kBoxShift) + d - 1) / d;
+}
+
+FASTLED_FORCE_INLINE fl::u8 boxAverage(fl::u32 sum, fl::u32 half,
+                                       fl::u32 mul) {
+    const fl::u32 v = ((sum + half) * mul) >> kBoxShift;
+    return fl::u8(v < 255 ? v : 255);
+}
+
+// Horizontal running sum over one row of interleaved rgb bytes.
+void boxBlurRow(const fl::u8 *in, fl::u8 *out, int width, int radius,
+                fl::u32 mul) {
+    const fl::u32 half = fl::u32(radius);
+    const int last = width - 1;
+    fl::u32 s0 = fl::u32(radius + 1) * in[0];
+    fl::u32 s1 = fl::u32(radius + 1) * in[1];
+    fl::u32 s2 = fl::u32(radius + 1) * in[2];
+    for (int k = 1; k <= radius; ++k) {
+        const fl::u8 *p = in + 3 * (k < last ? k : last);
+        s0 += p[0];
+        s1 += p[1];
+        s2 += p[2];
+    }
+    for (int x = 0; x < width; ++x) {
+        out[0] = boxAverage(s0, half, mul);
+        out[1] = boxAverage(s1, half, mul);
+        out[2] = boxAverage(s2, half, mul);
+        out += 3;
+        const int add = x + radius + 1;
+        const int sub = x - radius;
+        const fl::u8 *a = in + 3 * (add < last ? add : last);
+        const fl::u8 *b = in + 3 * (sub > 0 ? sub : 0);
+        s0 += fl::u32(a[0]) - b[0];
+        s1 += fl::u32(a[1]) - b[1];
+        s2 += fl::u32(a[2]) - b[2];
+    }
+}
+
+// Vertical running sum. sums holds one accumulator per byte of a row, so
+// every inner loop is a straight run over contiguous memory.
+void boxBlurColumns(const fl::u8 *in, fl::u8 *out, fl::u32 *sums,
+                    int rowBytes, int height, int radius, fl::u32 mul) {
+    const fl::u32 half = fl::u32(radius);
+    const int last = height - 1;
+    for (int i = 0; i < rowBytes; ++i) {
+        sums[i] = fl::u32(radius + 1) * in[i];
+    }
+    for (int k = 1; k <= radius; ++k) {
+        const fl::u8 *row = in + rowBytes * (k < last ? k : last);
+        for (int i = 0; i < rowBytes; ++i) {
+            sums[i] += row[i];
+        }
+    }
+    for (int y = 0; y < height; ++y) {
+        fl::u8 *dst = out + rowBytes * y;
+        for (int i = 0; i < rowBytes; ++i) {
+            dst[i] = boxAverage(sums[i], half, mul);
+        }
+        const int add = y + radius + 1;
+        const int sub = y - radius;
+        const fl::u8 *a = in + rowBytes * (add < last ? add : last);
+        const fl::u8 *b = in + rowBytes * (sub > 0 ? sub : 0);
+        for (int i = 0; i < rowBytes; ++i) {
+            sums[i] += fl::u32(a[i]) - b[i];
+        }
+    }
+}
+
+} // namespace
+
+void BoxBlur2d::apply(CRGB *leds, const XYMap &xymap) {
+    const int width = xymap.getWidth();
+    const int height = xymap.getHeight();
+    if (mRadius == 0 || mPasses == 0 || width == 0 || height == 0) {
+        return;
+    }
+    const int radius = mRadius;
+    const fl::u32 mul = boxMultiplier(2 * fl::u32(radius) + 1);
+    const int total = width * height;
+    mImage.resize(total);
+    mScratch.resize(total);
+    mRow.resize(width);
+    mColumnSums.resize(3 * width);
+
+    // A rectangular grid is already row major, so the copies are memcpy's.
+    const bool rect = xymap.isRectangularGrid();
+    CRGB *base = rect ? leds + xymap.mapToIndex(0, 0) : nullptr;
+    if (rect) {
+        memcpy(static_cast<void *>(mImage.data()), base, sizeof(CRGB) * total);
+    } else {
+        for (const XYSpan &span : xymap.spans()) {
+            readSpan(leds, span, mImage.data() + span.y * width + span.x);
+        }
+    }
+
+    for (fl::u8 pass = 0; pass < mPasses; ++pass) {
+        for (int y = 0; y < height; ++y) {
+            CRGB *row = mImage.data() + y * width;
+            memcpy(static_cast<void *>(mRow.data()), row, sizeof(CRGB) * width);
+            boxBlurRow(&mRow[0].raw[0], &row->raw[0], width, radius, mul);
+        }
+        boxBlurColumns(&mImage[0].raw[0], &mScratch[0].raw[0],
+                       mColumnSums.data(), 3 * width, height, radius, mul);
+        mImage.swap(mScratch);
+    }
+
+    if (rect) {
+        memcpy(static_cast<void *>(base), mImage.data(), sizeof(CRGB) * total);
+    } else {
+        for (const XYSpan &span : xymap.spans()) {
+            writeSpan(leds, span, mImage.data() + span.y * width + span.x);
+        }
+    }
+}
+
+void boxBlur2d(CRGB *leds, const XYMap &xymap, fl::u16 radius,
+               fl::u8 passes) {
+    BoxBlur2d blur(radius, passes);
+    blur.apply(leds, xymap);
+}
+
 } // namespace fl
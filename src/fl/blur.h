@@ -5,6 +5,7 @@
 #include "fl/int.h"
 #include "crgb.h"
 #include "fl/deprecated.h"
+#include "fl/vector.h"
 
 namespace fl {
 
@@ -66,6 +67,46 @@ void blurRows(CRGB *leds, fl::u8 width, fl::u8 height, fract8 blur_amount,
 void blurColumns(CRGB *leds, fl::u8 width, fl::u8 height, fract8 blur_amount,
                  const fl::XYMap &xymap);
 
+/// Separable box blur with an arbitrary radius.
+/// Every output pixel is the average of the (2 * radius + 1)^2 square around
+/// it, with the edge pixels repeated past the border. The rows and columns
+/// are filtered with running sums, so the cost per pixel does not depend on
+/// the radius. Unlike blur2d() the total light is conserved, up to rounding.
+///
+/// The pixels are copied out through the XYMap once into a row major scratch
+/// buffer, filtered there and written back once. Keep the object around
+/// between frames to reuse the scratch buffers.
+///
+/// Each extra pass is another box blur on top of the previous one, so
+/// 3 passes are close to a gaussian with sigma ~= radius.
+class BoxBlur2d {
+  public:
+    explicit BoxBlur2d(fl::u16 radius = 1, fl::u8 passes = 1)
+        : mRadius(radius), mPasses(passes) {}
+    void setRadius(fl::u16 radius) { mRadius = radius; }
+    void setPasses(fl::u8 passes) { mPasses = passes; }
+    fl::u16 radius() const { return mRadius; }
+    fl::u8 passes() const { return mPasses; }
+
+    void apply(CRGB *leds, const fl::XYMap &xymap);
+
+  private:
+    fl::u16 mRadius;
+    fl::u8 mPasses;
+    fl::vector<CRGB> mImage;   // Row major copy of the pixels.
+    fl::vector<CRGB> mScratch; // Vertical pass output, swapped with mImage.
+    fl::vector<CRGB> mRow;     // Input of the horizontal pass.
+    fl::vector<fl::u32> mColumnSums;
+};
+
+/// One shot version of BoxBlur2d, allocates its scratch buffers every call.
+/// @param leds a pointer to the LED array to blur
+/// @param xymap the layout of the matrix
+/// @param radius half the box size, 0 leaves the pixels unchanged
+/// @param passes number of box blurs applied in a row
+void boxBlur2d(CRGB *leds, const fl::XYMap &xymap, fl::u16 radius,
+               fl::u8 passes = 1);
+
 /// @} ColorBlurs
 
 } // namespace fl
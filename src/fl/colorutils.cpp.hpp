@@ -387,6 +387,100 @@ CRGB ColorFromPalette(const CRGBPalette16 &pal, fl::u8 index,
     return CRGB(red1, green1, blue1);
 }
 
+// Batched ColorFromPalette() for CRGBPalette16. Blending with lo4 == 0 and
+// brightness 255 are the identity in the scale8 FIXED arithmetic, so the
+// per pixel branches go away: f2 is forced to 0 for NOBLEND and brightness
+// becomes one multiplier for the whole call. Red and blue share a 32 bit
+// multiply as two 16 bit fields. Other configurations call the scalar
+// version per pixel.
+#if (FASTLED_SCALE8_FIXED == 1) && !defined(__AVR__)
+
+void ColorFromPalette(const CRGBPalette16 &pal, const fl::u8 *indices,
+                      CRGB *out, fl::u16 count, fl::u8 brightness,
+                      TBlendType blendType) {
+    const fl::u32 kRB = 0x00FF00FF;
+    fl::u32 entries[16];
+    for (int i = 0; i < 16; ++i) {
+        entries[i] = pal[i].r | (fl::u32(pal[i].g) << 8) |
+                     (fl::u32(pal[i].b) << 16);
+    }
+    const fl::u32 blendMask = blendType == NOBLEND ? 0 : 0xF0;
+    // The ++brightness of the scalar version plus the scale8 FIXED + 1.
+    const fl::u32 bscale =
+        brightness == 255 ? 256 : brightness ? brightness + 2 : 0;
+    for (fl::u16 i = 0; i < count; ++i) {
+        fl::u8 index = indices[i];
+        if (blendType == LINEARBLEND_NOWRAP) {
+            index = map8(index, 0, 239);
+        }
+        const fl::u32 c1 = entries[index >> 4];
+        const fl::u32 c2 = entries[((index >> 4) + 1) & 15];
+        const fl::u32 f2 = (fl::u32(index) << 4) & blendMask;
+        const fl::u32 w1 = 256 - f2;
+        const fl::u32 w2 = f2 + 1;
+        fl::u32 rb = ((((c1 & kRB) * w1) >> 8) & kRB) +
+                     ((((c2 & kRB) * w2) >> 8) & kRB);
+        fl::u32 g = ((((c1 >> 8) & 0xFF) * w1) >> 8) +
+                    ((((c2 >> 8) & 0xFF) * w2) >> 8);
+        rb = ((rb * bscale) >> 8) & kRB;
+        g = (g * bscale) >> 8;
+        out[i] = CRGB(fl::u8(rb), fl::u8(g), fl::u8(rb >> 16));
+    }
+}
+
+#else
+
+void ColorFromPalette(const CRGBPalette16 &pal, const fl::u8 *indices,
+                      CRGB *out, fl::u16 count, fl::u8 brightness,
+                      TBlendType blendType) {
+    for (fl::u16 i = 0; i < count; ++i) {
+        out[i] = ColorFromPalette(pal, indices[i], brightness, blendType);
+    }
+}
+
+#endif
+
+void fill_palette(CRGB *L, fl::u16 N, fl::u8 startIndex, fl::u8 incIndex,
+                  const CRGBPalette16 &pal, fl::u8 brightness,
+                  TBlendType blendType) {
+    fl::u8 indices[64];
+    fl::u8 colorIndex = startIndex;
+    for (fl::u16 done = 0; done < N;) {
+        const fl::u16 n = N - done < 64 ? N - done : 64;
+        for (fl::u16 i = 0; i < n; ++i) {
+            indices[i] = colorIndex;
+            colorIndex += incIndex;
+        }
+        ColorFromPalette(pal, indices, L + done, n, brightness, blendType);
+        done += n;
+    }
+}
+
+void map_data_into_colors_through_palette(fl::u8 *dataArray, fl::u16 dataCount,
+                                          CRGB *targetColorArray,
+                                          const CRGBPalette16 &pal,
+                                          fl::u8 brightness, fl::u8 opacity,
+                                          TBlendType blendType) {
+    if (opacity == 255) {
+        ColorFromPalette(pal, dataArray, targetColorArray, dataCount,
+                         brightness, blendType);
+        return;
+    }
+    CRGB colors[64];
+    for (fl::u16 done = 0; done < dataCount;) {
+        const fl::u16 n = dataCount - done < 64 ? dataCount - done : 64;
+        ColorFromPalette(pal, dataArray + done, colors, n, brightness,
+                         blendType);
+        for (fl::u16 i = 0; i < n; ++i) {
+            CRGB &target = targetColorArray[done + i];
+            target.nscale8(256 - opacity);
+            colors[i].nscale8_video(opacity);
+            target += colors[i];
+        }
+        done += n;
+    }
+}
+
 CRGB ColorFromPaletteExtended(const CRGBPalette16 &pal, fl::u16 index,
                               fl::u8 brightness, TBlendType blendType) {
     // Extract the four most significant bits of the index as a palette index.
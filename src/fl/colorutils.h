@@ -1505,6 +1505,13 @@ CRGB ColorFromPalette(const CRGBPalette16 &pal, fl::u8 index,
                       fl::u8 brightness = 255,
                       TBlendType blendType = LINEARBLEND);
 
+/// Palette lookup for a whole array, out[i] = ColorFromPalette(pal,
+/// indices[i], brightness, blendType) with the same results. Runs without
+/// per pixel branches, so prefer it over a loop for large arrays.
+void ColorFromPalette(const CRGBPalette16 &pal, const fl::u8 *indices,
+                      CRGB *out, fl::u16 count, fl::u8 brightness = 255,
+                      TBlendType blendType = LINEARBLEND);
+
 /// @brief Same as ColorFromPalette, but with fl::u16 `index` to give greater
 /// precision.
 /// @author https://github.com/generalelectrix
@@ -1588,6 +1595,12 @@ void fill_palette(CRGB *L, fl::u16 N, fl::u8 startIndex, fl::u8 incIndex,
     }
 }
 
+/// @copydoc fill_palette()
+/// CRGBPalette16 goes through the array ColorFromPalette().
+void fill_palette(CRGB *L, fl::u16 N, fl::u8 startIndex, fl::u8 incIndex,
+                  const CRGBPalette16 &pal, fl::u8 brightness = 255,
+                  TBlendType blendType = LINEARBLEND);
+
 /// Fill a range of LEDs with a sequence of entries from a palette, so that
 /// the entire palette smoothly covers the range of LEDs.
 /// @tparam PALETTE the type of the palette used (auto-deduced)
@@ -1658,6 +1671,13 @@ void map_data_into_colors_through_palette(
     }
 }
 
+/// @copydoc map_data_into_colors_through_palette()
+/// CRGBPalette16 goes through the array ColorFromPalette().
+void map_data_into_colors_through_palette(
+    fl::u8 *dataArray, fl::u16 dataCount, CRGB *targetColorArray,
+    const CRGBPalette16 &pal, fl::u8 brightness = 255, fl::u8 opacity = 255,
+    TBlendType blendType = LINEARBLEND);
+
 /// Alter one palette by making it slightly more like a "target palette".
 /// Used for palette cross-fades.
 ///
@@ -172,6 +172,7 @@ void Corkscrew::setCachingEnabled(bool enabled) {
         // Caching was enabled, now disabling - clear the cache
         mTileCache.clear();
         mCacheInitialized = false;
+        mResampler = CanvasResampler();
     }
     mCachingEnabled = enabled;
 }
@@ -275,51 +276,38 @@ void Corkscrew::readFromMulti(const fl::Grid<CRGB>& source_grid) const {
     
     // Clear buffer first
     const_cast<Corkscrew*>(this)->clearBuffer();
-    
-    // Iterate through each LED in the corkscrew
-    for (fl::size led_idx = 0; led_idx < mInput.numLeds; ++led_idx) {
-        // Get the wrapped tile for this LED position
-        Tile2x2_u8_wrap tile = at_wrap(static_cast<float>(led_idx));
-        
-        // Accumulate color from the 4 sample points with their weights
-        fl::u32 r_accum = 0, g_accum = 0, b_accum = 0;
-        fl::u32 total_weight = 0;
-        
-        // Sample from each of the 4 corners of the tile
-        for (fl::u8 x = 0; x < 2; x++) {
-            for (fl::u8 y = 0; y < 2; y++) {
-                const auto& entry = tile.at(x, y);
-                vec2i16 pos = entry.first;   // position is the first element of the pair
-                fl::u8 weight = entry.second; // weight is the second element of the pair
-                
-                // Bounds check for the source grid
-                if (pos.x >= 0 && pos.x < static_cast<fl::i16>(source_grid.width()) && 
-                    pos.y >= 0 && pos.y < static_cast<fl::i16>(source_grid.height())) {
-                    
-                    // Sample from the source grid
-                    CRGB sample_color = source_grid.at(pos.x, pos.y);
-                    
-                    // Accumulate weighted color components
-                    r_accum += static_cast<fl::u32>(sample_color.r) * weight;
-                    g_accum += static_cast<fl::u32>(sample_color.g) * weight;
-                    b_accum += static_cast<fl::u32>(sample_color.b) * weight;
-                    total_weight += weight;
-                }
+
+    if (mCachingEnabled) {
+        // The bilinear taps of every LED on the unwrapped surface, wrapped
+        // around the source width, kept until the source size changes.
+        const fl::u16 width = static_cast<fl::u16>(source_grid.width());
+        const fl::u16 height = static_cast<fl::u16>(source_grid.height());
+        if (mResampler.size() != mInput.numLeds ||
+            mResampler.width() != width || mResampler.height() != height) {
+            fl::ScreenMap positions(mInput.numLeds);
+            for (fl::u16 i = 0; i < mInput.numLeds; ++i) {
+                positions.set(i, at_no_wrap(i));
             }
+            mResampler.build(positions, width, height, true);
         }
-        
-        // Calculate final color by dividing by total weight
-        CRGB final_color = CRGB::Black;
-        if (total_weight > 0) {
-            final_color.r = static_cast<fl::u8>(r_accum / total_weight);
-            final_color.g = static_cast<fl::u8>(g_accum / total_weight);
-            final_color.b = static_cast<fl::u8>(b_accum / total_weight);
-        }
-        
-        // Store the result in the LED buffer at the LED index position
-        if (led_idx < mCorkscrewLeds.size()) {
-            mCorkscrewLeds[led_idx] = final_color;
+        if (mCorkscrewLeds.size() >= mInput.numLeds) {
+            mResampler.apply(source_grid, mCorkscrewLeds.data());
+        } else {
+            fl::vector<CRGB> leds(mInput.numLeds);
+            mResampler.apply(source_grid, leds.data());
+            for (fl::size i = 0; i < mCorkscrewLeds.size(); ++i) {
+                mCorkscrewLeds[i] = leds[i];
+            }
         }
+        return;
+    }
+
+    // Without caching, the same taps worked out per LED and dropped, so the
+    // result matches the cached read exactly.
+    const fl::size n = MIN(fl::size(mInput.numLeds), mCorkscrewLeds.size());
+    for (fl::size led_idx = 0; led_idx < n; ++led_idx) {
+        mCorkscrewLeds[led_idx] = CanvasResampler::sample(
+            source_grid, at_no_wrap(static_cast<fl::u16>(led_idx)), true);
     }
 }
 
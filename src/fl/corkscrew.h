@@ -41,6 +41,7 @@
 #include "fl/math.h"
 #include "fl/math_macros.h"
 #include "fl/pair.h"
+#include "fl/resampler.h"
 #include "fl/tile2x2.h"
 #include "fl/vector.h"
 #include "crgb.h"
@@ -258,7 +259,7 @@ class Corkscrew {
     Tile2x2_u8 at_splat_extrapolate(float i) const;
 
     // Read from rectangular buffer using multi-sampling and store in target grid
-    // Uses Tile2x2_u8_wrap for sub-pixel accurate sampling with proper blending
+    // Uses a CanvasResampler with the bilinear taps of every LED position
     void readFromMulti(const fl::Grid<CRGB>& target_grid) const;
     
     // Initialize the rectangular buffer if not already done
@@ -277,10 +278,15 @@ class Corkscrew {
     mutable fl::vector<CRGB> mCorkscrewLeds;
     mutable bool mBufferInitialized = false;
     
-    // Caching for Tile2x2_u8_wrap objects
+    // Caching for Tile2x2_u8_wrap objects, filled by the first at_wrap() call.
+    // readFrom() does not use them.
     mutable fl::vector<Tile2x2_u8_wrap> mTileCache;
     mutable bool mCacheInitialized = false;
     bool mCachingEnabled = true; // Default to enabled
+
+    // Sampling table for readFrom() while caching, built for the last source
+    // grid size
+    mutable CanvasResampler mResampler;
 };
 
 } // namespace fl
@@ -2,12 +2,16 @@
 // BETA - NOT TESTED!!!
 // VIBE CODED WITH AI
 
+#include <string.h>
+
 #include "fl/downscale.h"
 #include "fl/int.h"
 
 #include "crgb.h"
 #include "fl/assert.h"
 #include "fl/math_macros.h"
+#include "fl/simd.h"
+#include "fl/vector.h"
 #include "fl/xymap.h"
 
 #pragma GCC diagnostic push
@@ -15,32 +19,112 @@
 
 namespace fl {
 
+namespace {
+
+// Averages the 2x2 blocks of the source rows row0 and row1 into count
+// pixels of out, rounding to nearest.
+void downscaleHalfRow(const CRGB *row0, const CRGB *row1, CRGB *out,
+                      fl::u16 count) {
+    fl::u16 x = 0;
+#if FASTLED_SIMD_SSE2
+    // Each lane adds the byte three on, the same channel of the next pixel,
+    // so the lanes of the even pixels hold the 2x2 sums. 8 output pixels per
+    // step read 3 bytes past their 48, so the last pixel is left to the
+    // scalar loop.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+    for (; x + 8 < count; x += 8) {
+        const fl::u8 *a = row0[2 * x].raw;
+        const fl::u8 *b = row1[2 * x].raw;
+        fl::u8 half[48];
+        for (int i = 0; i < 48; i += 16) {
+            const __m128i a0 = _mm_loadu_si128((const __m128i *)(a + i));
+            const __m128i a1 = _mm_loadu_si128((const __m128i *)(a + i + 3));
+            const __m128i b0 = _mm_loadu_si128((const __m128i *)(b + i));
+            const __m128i b1 = _mm_loadu_si128((const __m128i *)(b + i + 3));
+            __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero),
+                                       _mm_unpacklo_epi8(a1, zero));
+            lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(b0, zero));
+            lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(b1, zero));
+            __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero),
+                                       _mm_unpackhi_epi8(a1, zero));
+            hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(b0, zero));
+            hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(b1, zero));
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, two), 2);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, two), 2);
+            _mm_storeu_si128((__m128i *)(half + i), _mm_packus_epi16(lo, hi));
+        }
+        for (int k = 0; k < 8; ++k) {
+            out[x + k] = CRGB(half[6 * k], half[6 * k + 1], half[6 * k + 2]);
+        }
+    }
+#elif FASTLED_SIMD_NEON
+    // vld3 splits 16 pixels into channels, the pairwise adds sum each pair
+    // of neighbours and the rounding narrow is (sum + 2) >> 2.
+    for (; x + 8 <= count; x += 8) {
+        const uint8x16x3_t a = vld3q_u8(row0[2 * x].raw);
+        const uint8x16x3_t b = vld3q_u8(row1[2 * x].raw);
+        uint8x8x3_t o;
+        for (int c = 0; c < 3; ++c) {
+            o.val[c] =
+                vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(a.val[c]), b.val[c]), 2);
+        }
+        vst3_u8(out[x].raw, o);
+    }
+#endif
+    for (; x < count; ++x) {
+        const CRGB &p00 = row0[2 * x];
+        const CRGB &p10 = row0[2 * x + 1];
+        const CRGB &p01 = row1[2 * x];
+        const CRGB &p11 = row1[2 * x + 1];
+        // +2 for rounding
+        fl::u16 r = (p00.r + p10.r + p01.r + p11.r + 2) / 4;
+        fl::u16 g = (p00.g + p10.g + p01.g + p11.g + 2) / 4;
+        fl::u16 b = (p00.b + p10.b + p01.b + p11.b + 2) / 4;
+        out[x] = CRGB((fl::u8)r, (fl::u8)g, (fl::u8)b);
+    }
+}
+
+// Serpentine and line by line maps have every row in one run of the led
+// buffer, see XYMap::spanAt(). Other maps go pixel by pixel.
+bool downscaleHasRowSpans(const XYMap &xy) {
+    return xy.isSerpentine() || xy.isLineByLine();
+}
+
+// Row y of such a map in x order. A row that runs backwards is copied to
+// scratch first.
+const CRGB *downscaleReadRow(const CRGB *src, const XYMap &xy, fl::u16 y,
+                             CRGB *scratch) {
+    const XYSpan span = xy.spanAt(0, y);
+    if (span.step > 0) {
+        return src + span.index;
+    }
+    readSpan(src, span, scratch);
+    return scratch;
+}
+
+// Where to render row y of such a map; finish with downscaleWriteRow().
+CRGB *downscaleRowTarget(CRGB *dst, const XYSpan &span, CRGB *scratch) {
+    return span.step > 0 ? dst + span.index : scratch;
+}
+
+void downscaleWriteRow(CRGB *dst, const XYSpan &span, const CRGB *row) {
+    if (span.step < 0) {
+        writeSpan(dst, span, row);
+    }
+}
+
+} // namespace
+
 void downscaleHalf(const CRGB *src, fl::u16 srcWidth, fl::u16 srcHeight,
                    CRGB *dst) {
     fl::u16 dstWidth = srcWidth / 2;
     fl::u16 dstHeight = srcHeight / 2;
 
     for (fl::u16 y = 0; y < dstHeight; ++y) {
-        for (fl::u16 x = 0; x < dstWidth; ++x) {
-            // Map to top-left of the 2x2 block in source
-            fl::u16 srcX = x * 2;
-            fl::u16 srcY = y * 2;
-
-            // Fetch 2x2 block
-            const CRGB &p00 = src[(srcY)*srcWidth + (srcX)];
-            const CRGB &p10 = src[(srcY)*srcWidth + (srcX + 1)];
-            const CRGB &p01 = src[(srcY + 1) * srcWidth + (srcX)];
-            const CRGB &p11 = src[(srcY + 1) * srcWidth + (srcX + 1)];
-
-            // Average each color channel
-            fl::u16 r =
-                (p00.r + p10.r + p01.r + p11.r + 2) / 4; // +2 for rounding
-            fl::u16 g = (p00.g + p10.g + p01.g + p11.g + 2) / 4;
-            fl::u16 b = (p00.b + p10.b + p01.b + p11.b + 2) / 4;
-
-            // Store result
-            dst[y * dstWidth + x] = CRGB((fl::u8)r, (fl::u8)g, (fl::u8)b);
-        }
+        const CRGB *row0 = src + fl::u32(2 * y) * srcWidth;
+        downscaleHalfRow(row0, row0 + srcWidth, dst + fl::u32(y) * dstWidth,
+                         dstWidth);
     }
 }
 
@@ -54,6 +138,22 @@ void downscaleHalf(const CRGB *src, const XYMap &srcXY, CRGB *dst,
     FASTLED_ASSERT(srcXY.getHeight() == dstXY.getHeight() * 2,
                    "Source height must be double the destination height");
 
+    if (downscaleHasRowSpans(srcXY) && downscaleHasRowSpans(dstXY)) {
+        fl::vector_inlined<CRGB, 64> scratch(2 * srcXY.getWidth() + dstWidth);
+        CRGB *scratch0 = scratch.data();
+        CRGB *scratch1 = scratch0 + srcXY.getWidth();
+        CRGB *scratchOut = scratch1 + srcXY.getWidth();
+        for (fl::u16 y = 0; y < dstHeight; ++y) {
+            const XYSpan span = dstXY.spanAt(0, y);
+            CRGB *out = downscaleRowTarget(dst, span, scratchOut);
+            downscaleHalfRow(downscaleReadRow(src, srcXY, 2 * y, scratch0),
+                             downscaleReadRow(src, srcXY, 2 * y + 1, scratch1),
+                             out, dstWidth);
+            downscaleWriteRow(dst, span, out);
+        }
+        return;
+    }
+
     for (fl::u16 y = 0; y < dstHeight; ++y) {
         for (fl::u16 x = 0; x < dstWidth; ++x) {
             // Map to top-left of the 2x2 block in source
@@ -79,6 +179,82 @@ void downscaleHalf(const CRGB *src, const XYMap &srcXY, CRGB *dst,
     }
 }
 
+namespace {
+
+// downscaleArbitrary() for maps with row spans. The source is streamed a
+// row at a time into per column sums, with the column boundaries worked out
+// once instead of per pixel. The weights and rounding are the same, and the
+// sums fit a u32 since a map has at most 65535 pixels of weight <= 256.
+void downscaleArbitraryRows(const CRGB *src, const XYMap &srcXY, CRGB *dst,
+                            const XYMap &dstXY) {
+    const fl::u16 srcWidth = srcXY.getWidth();
+    const fl::u16 srcHeight = srcXY.getHeight();
+    const fl::u16 dstWidth = dstXY.getWidth();
+    const fl::u16 dstHeight = dstXY.getHeight();
+    const fl::u32 FP_ONE = 256; // Q8.8 fixed-point multiplier
+
+    // Q8.8 left edge of every destination column, and the right edge of
+    // the last one.
+    fl::vector_inlined<fl::u32, 65> edges(dstWidth + 1);
+    for (fl::u16 dx = 0; dx <= dstWidth; ++dx) {
+        edges[dx] = (dx * srcWidth * FP_ONE) / dstWidth;
+    }
+    // r, g, b and total weight of every destination column.
+    fl::vector_inlined<fl::u32, 4 * 64> sums(4 * dstWidth);
+    fl::vector_inlined<CRGB, 64> scratch(srcWidth + dstWidth);
+    CRGB *scratchOut = scratch.data() + srcWidth;
+
+    for (fl::u16 dy = 0; dy < dstHeight; ++dy) {
+        const fl::u32 dstY0 = (dy * srcHeight * FP_ONE) / dstHeight;
+        const fl::u32 dstY1 = ((dy + 1) * srcHeight * FP_ONE) / dstHeight;
+        const fl::u16 srcY_start = dstY0 / FP_ONE;
+        const fl::u16 srcY_end = (dstY1 + FP_ONE - 1) / FP_ONE; // ceil
+
+        fl::u32 *sum = sums.data();
+        memset(sum, 0, sizeof(fl::u32) * 4 * dstWidth);
+        for (fl::u16 sy = srcY_start; sy < srcY_end; ++sy) {
+            const fl::u32 y_overlap =
+                MIN(dstY1, (sy + 1) * FP_ONE) - MAX(dstY0, sy * FP_ONE);
+            if (y_overlap == 0)
+                continue;
+            const CRGB *row = downscaleReadRow(src, srcXY, sy, scratch.data());
+            for (fl::u16 dx = 0; dx < dstWidth; ++dx) {
+                const fl::u32 dstX0 = edges[dx];
+                const fl::u32 dstX1 = edges[dx + 1];
+                const fl::u16 srcX_end = (dstX1 + FP_ONE - 1) / FP_ONE;
+                fl::u32 *acc = sum + 4 * dx;
+                for (fl::u16 sx = dstX0 / FP_ONE; sx < srcX_end; ++sx) {
+                    const fl::u32 x_overlap =
+                        MIN(dstX1, (sx + 1) * FP_ONE) - MAX(dstX0, sx * FP_ONE);
+                    const fl::u32 weight =
+                        (x_overlap * y_overlap + (FP_ONE >> 1)) >> 8;
+                    const CRGB &p = row[sx];
+                    acc[0] += p.r * weight;
+                    acc[1] += p.g * weight;
+                    acc[2] += p.b * weight;
+                    acc[3] += weight;
+                }
+            }
+        }
+
+        const XYSpan span = dstXY.spanAt(0, dy);
+        CRGB *out = downscaleRowTarget(dst, span, scratchOut);
+        for (fl::u16 dx = 0; dx < dstWidth; ++dx) {
+            const fl::u32 *acc = sum + 4 * dx;
+            const fl::u32 totalWeight = acc[3];
+            const fl::u32 half = totalWeight >> 1;
+            out[dx] = totalWeight
+                          ? CRGB((acc[0] + half) / totalWeight,
+                                 (acc[1] + half) / totalWeight,
+                                 (acc[2] + half) / totalWeight)
+                          : CRGB(0, 0, 0);
+        }
+        downscaleWriteRow(dst, span, out);
+    }
+}
+
+} // namespace
+
 void downscaleArbitrary(const CRGB *src, const XYMap &srcXY, CRGB *dst,
                         const XYMap &dstXY) {
     const fl::u16 srcWidth = srcXY.getWidth();
@@ -93,6 +269,11 @@ void downscaleArbitrary(const CRGB *src, const XYMap &srcXY, CRGB *dst,
     FASTLED_ASSERT(dstHeight <= srcHeight,
                    "Destination height must be <= source height");
 
+    if (downscaleHasRowSpans(srcXY) && downscaleHasRowSpans(dstXY)) {
+        downscaleArbitraryRows(src, srcXY, dst, dstXY);
+        return;
+    }
+
     for (fl::u16 dy = 0; dy < dstHeight; ++dy) {
         // Fractional boundaries in Q8.8
         fl::u32 dstY0 = (dy * srcHeight * FP_ONE) / dstHeight;
@@ -168,7 +349,9 @@ void downscale(const CRGB *src, const XYMap &srcXY, CRGB *dst,
     // size of the source.
     if (destination_is_half_of_source) {
         const bool both_rectangles = (srcXY.getType() == XYMap::kLineByLine) &&
-                                     (dstXY.getType() == XYMap::kLineByLine);
+                                     (dstXY.getType() == XYMap::kLineByLine) &&
+                                     srcXY.getOffset() == 0 &&
+                                     dstXY.getOffset() == 0;
         if (both_rectangles) {
             // If both source and destination are rectangular, we can use the
             // optimized version
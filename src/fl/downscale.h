@@ -22,7 +22,8 @@ void downscale(const CRGB *src, const XYMap &srcXY, CRGB *dst,
 // mostly. You should prefer to use downscale(...) instead of calling these
 // functions. It's important to note that downscale(...) will invoke
 // downscaleHalf(...) automatically when the source and destination are half the
-// size of each other.
+// size of each other. Serpentine and line by line maps are processed a row at
+// a time with vectorized kernels, other maps go pixel by pixel.
 void downscaleHalf(const CRGB *src, fl::u16 srcWidth, fl::u16 srcHeight,
                    CRGB *dst);
 void downscaleHalf(const CRGB *src, const XYMap &srcXY, CRGB *dst,
@@ -115,6 +115,16 @@ void EngineEvents::_onStripAdded(CLEDController *strip, fl::u32 num_leds) {
     }
 }
 
+void EngineEvents::_onStripRemoved(CLEDController *strip) {
+    // Make the copy of the listener list to avoid issues with listeners being
+    // added or removed during the loop.
+    ListenerList copy = mListeners;
+    for (auto &item : copy) {
+        auto listener = item.listener;
+        listener->onStripRemoved(strip);
+    }
+}
+
 void EngineEvents::_onCanvasUiSet(CLEDController *strip,
                                   const ScreenMap &screenmap) {
     // Make the copy of the listener list to avoid issues with listeners being
@@ -35,6 +35,8 @@ class EngineEvents {
             (void)strip;
             (void)num_leds;
         }
+        // The controller is being destroyed, drop anything keyed by it.
+        virtual void onStripRemoved(CLEDController *strip) { (void)strip; }
         // Called to set the canvas for UI elements for a particular strip.
         virtual void onCanvasUiSet(CLEDController *strip,
                                    const ScreenMap &screenmap) {
@@ -98,6 +100,14 @@ class EngineEvents {
 #endif
     }
 
+    static void onStripRemoved(CLEDController *strip) {
+#if FASTLED_HAS_ENGINE_EVENTS
+        EngineEvents::getInstance()->_onStripRemoved(strip);
+#else
+        (void)strip;
+#endif
+    }
+
     static void onCanvasUiSet(CLEDController *strip, const ScreenMap &xymap) {
 #if FASTLED_HAS_ENGINE_EVENTS
         EngineEvents::getInstance()->_onCanvasUiSet(strip, xymap);
@@ -125,6 +135,7 @@ class EngineEvents {
     void _onEndShowLeds();
     void _onEndFrame();
     void _onStripAdded(CLEDController *strip, fl::u32 num_leds);
+    void _onStripRemoved(CLEDController *strip);
     void _onCanvasUiSet(CLEDController *strip, const ScreenMap &xymap);
     void _onPlatformPreLoop();
     bool _hasListener(Listener *listener);
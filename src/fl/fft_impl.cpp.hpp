@@ -17,6 +17,7 @@
 
 #include "fl/array.h"
 #include "fl/audio.h"
+#include "fl/audio_fixed.h"
 #include "fl/fft.h"
 #include "fl/fft_impl.h"
 #include "fl/str.h"
@@ -55,6 +56,8 @@ class FFTContext {
             return;
         }
         m_kernels = generate_kernels(m_cq_cfg);
+        m_fft.resize(samples);
+        m_cq.resize(bands);
     }
     ~FFTContext() {
         if (m_fftr_cfg) {
@@ -67,17 +70,34 @@ class FFTContext {
 
     fl::size sampleSize() const { return m_cq_cfg.samples; }
 
+    // Q15 kiss_fftr followed by the constant-Q kernels, result in m_cq.
+    void transform(span<const i16> buffer) {
+        // Scratch buffers live as long as the context, apply_kernels()
+        // accumulates so they start out zeroed on every run.
+        kiss_fft_cpx *fft = m_fft.data();
+        fl::memfill(fft, 0, sizeof(kiss_fft_cpx) * m_fft.size());
+        fl::memfill(m_cq.data(), 0, sizeof(kiss_fft_cpx) * m_cq.size());
+        kiss_fftr(m_fftr_cfg, buffer.data(), fft);
+        apply_kernels(fft, m_cq.data(), m_kernels, m_cq_cfg);
+    }
+
+    void magnitudes(span<const i16> buffer, fl::u32 *out) {
+        transform(buffer);
+        for (int i = 0; i < m_cq_cfg.bands; ++i) {
+            const i32 real = m_cq[i].r;
+            const i32 imag = m_cq[i].i;
+            const fl::u64 power = fl::u64(real * real) + fl::u64(imag * imag);
+            out[i] = isqrt64(power << 16);
+        }
+    }
+
     void fft_unit_test(span<const i16> buffer, FFTBins *out) {
 
         // FASTLED_ASSERT(512 == m_cq_cfg.samples, "FFTImpl samples mismatch and
         // are still hardcoded to 512");
         out->clear();
-        // allocate
-        FASTLED_STACK_ARRAY(kiss_fft_cpx, fft, m_cq_cfg.samples);
-        FASTLED_STACK_ARRAY(kiss_fft_cpx, cq, m_cq_cfg.bands);
-        // initialize
-        kiss_fftr(m_fftr_cfg, buffer.data(), fft);
-        apply_kernels(fft, cq, m_kernels, m_cq_cfg);
+        transform(buffer);
+        const kiss_fft_cpx *cq = m_cq.data();
         const float maxf = m_cq_cfg.fmax;
         const float minf = m_cq_cfg.fmin;
         const float delta_f = (maxf - minf) / m_cq_cfg.bands;
@@ -125,6 +145,8 @@ class FFTContext {
     kiss_fftr_cfg m_fftr_cfg;
     cq_kernels_t m_kernels;
     cq_kernel_cfg m_cq_cfg;
+    fl::vector<kiss_fft_cpx> m_fft;
+    fl::vector<kiss_fft_cpx> m_cq;
 };
 
 FFTImpl::FFTImpl(const FFT_Args &args) {
@@ -156,6 +178,19 @@ FFTImpl::Result FFTImpl::run(const AudioSample &sample, FFTBins *out) {
     return run(slice, out);
 }
 
+FFTImpl::Result FFTImpl::runMagnitudes(span<const i16> sample,
+                                       fl::u32 *out) {
+    if (!mContext) {
+        return FFTImpl::Result(false, "FFTImpl context is not initialized");
+    }
+    if (sample.size() != mContext->sampleSize()) {
+        FASTLED_WARN("FFTImpl sample size mismatch");
+        return FFTImpl::Result(false, "FFTImpl sample size mismatch");
+    }
+    mContext->magnitudes(sample, out);
+    return FFTImpl::Result(true, "");
+}
+
 FFTImpl::Result FFTImpl::run(span<const i16> sample, FFTBins *out) {
     if (!mContext) {
         return FFTImpl::Result(false, "FFTImpl context is not initialized");
@@ -35,6 +35,10 @@ class FFTImpl : public fl::Referent {
     // constructor.
     Result run(const AudioSample &sample, FFTBins *out);
     Result run(span<const i16> sample, FFTBins *out);
+    // Integer only variant of run(): out[band] = |cq[band]| in Q24.8, the
+    // same value as bins_raw without any float math. out must hold one entry
+    // per band.
+    Result runMagnitudes(span<const i16> sample, fl::u32 *out);
     // Info on what the frequency the bins represent
     fl::string info() const;
 
@@ -0,0 +1,66 @@
+#include <string.h>
+
+#include "fl/fft_stream.h"
+
+#include "fl/fft_impl.h"
+
+namespace fl {
+
+FFTStream::FFTStream(const FFT_Args &args, fl::u32 hopSize)
+    : mImpl(new FFTImpl(args)), mRing(args.samples), mWindow(args.samples),
+      mBins(args.bands), mHop(hopSize ? hopSize : fl::u32(args.samples) / 2),
+      mUntilNext(args.samples) {
+    if (mHop == 0) {
+        mHop = 1;
+    }
+}
+
+FFTStream::~FFTStream() {}
+
+void FFTStream::reset() {
+    mWritePos = 0;
+    mUntilNext = windowSize();
+    mBins.clear();
+}
+
+fl::u32 FFTStream::push(span<const i16> pcm) {
+    const fl::u32 size = windowSize();
+    fl::u32 windows = 0;
+    fl::size i = 0;
+    while (i < pcm.size()) {
+        // Copy up to the end of the ring or the next window, whichever is
+        // closer.
+        fl::u32 n = size - mWritePos;
+        if (mUntilNext < n) {
+            n = mUntilNext;
+        }
+        if (pcm.size() - i < n) {
+            n = fl::u32(pcm.size() - i);
+        }
+        memcpy(mRing.data() + mWritePos, pcm.data() + i, n * sizeof(i16));
+        i += n;
+        mWritePos = (mWritePos + n) % size;
+        mUntilNext -= n;
+        if (mUntilNext == 0) {
+            runWindow();
+            mUntilNext = mHop;
+            ++windows;
+        }
+    }
+    return windows;
+}
+
+void FFTStream::runWindow() {
+    // mWritePos is the oldest sample once the ring is full.
+    const fl::u32 size = windowSize();
+    const fl::u32 head = size - mWritePos;
+    memcpy(mWindow.data(), mRing.data() + mWritePos, head * sizeof(i16));
+    memcpy(mWindow.data() + head, mRing.data(), mWritePos * sizeof(i16));
+    mImpl->run(span<const i16>(mWindow.data(), size), &mBins);
+    ++mWindows;
+    if (mCallback) {
+        mCallback(mBins);
+    }
+}
+
+} // namespace fl
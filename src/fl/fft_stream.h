@@ -0,0 +1,65 @@
+#pragma once
+
+#include "fl/fft.h"
+#include "fl/function.h"
+#include "fl/int.h"
+#include "fl/scoped_ptr.h"
+#include "fl/span.h"
+#include "fl/vector.h"
+
+namespace fl {
+
+class FFTImpl;
+
+// Sliding window constant-Q analyzer for a continuous PCM stream.
+//
+// PCM arrives in chunks of any length and goes into a ring buffer of
+// args.samples. Once the ring is full, every hopSize new samples the last
+// args.samples are transformed and the bands are handed to the callback.
+// hopSize == args.samples gives back to back windows, samples / 2 is 50%
+// overlap. All buffers are allocated in the constructor, push() itself does
+// not allocate.
+//
+// Example, 60 updates per second at 44.1kHz with a 512 sample window:
+//   FFTStream stream(FFT_Args(), 735);
+//   stream.setCallback([](const FFTBins &bins) { ... });
+//   stream.push(pcmChunk);
+class FFTStream {
+  public:
+    using Callback = fl::function<void(const FFTBins &)>;
+
+    // hopSize == 0 picks args.samples / 2.
+    explicit FFTStream(const FFT_Args &args = FFT_Args(), fl::u32 hopSize = 0);
+    ~FFTStream();
+
+    void setCallback(const Callback &cb) { mCallback = cb; }
+
+    // Returns the number of windows that completed during this call.
+    fl::u32 push(span<const i16> pcm);
+    // Drops the buffered samples, the next window needs a full ring again.
+    void reset();
+
+    // Bands of the most recent window, empty until the first one completes.
+    const FFTBins &bins() const { return mBins; }
+    fl::u32 windowsCompleted() const { return mWindows; }
+    fl::u32 hopSize() const { return mHop; }
+    fl::u32 windowSize() const { return fl::u32(mRing.size()); }
+
+  private:
+    FFTStream(const FFTStream &) = delete;
+    FFTStream &operator=(const FFTStream &) = delete;
+
+    void runWindow();
+
+    fl::scoped_ptr<FFTImpl> mImpl;
+    fl::vector<i16> mRing;
+    fl::vector<i16> mWindow; // mRing unrolled oldest first.
+    FFTBins mBins;
+    Callback mCallback;
+    fl::u32 mHop;
+    fl::u32 mWritePos = 0;
+    fl::u32 mUntilNext; // Samples still missing for the next window.
+    fl::u32 mWindows = 0;
+};
+
+} // namespace fl
@@ -5,6 +5,10 @@
 #ifdef __EMSCRIPTEN__
 #include "platforms/wasm/fs_wasm.h"
 #define FASTLED_HAS_SDCARD 1
+#elif defined(FASTLED_STUB_IMPL) && !defined(ARDUINO)
+// Memory mapped host file system, FASTLED_STUB_MMAP_FS is 0 if unavailable.
+#include "platforms/stub/fs_stub.h"
+#define FASTLED_HAS_SDCARD FASTLED_STUB_MMAP_FS
 #elif __has_include(<SD.h>) && __has_include(<fs.h>)
 // Include Arduino SD card implementation when SD library is available
 #include "platforms/fs_sdcard_arduino.hpp"
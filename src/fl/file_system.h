@@ -7,6 +7,7 @@
 
 #include "fl/namespace.h"
 #include "fl/ptr.h"
+#include "fl/span.h"
 #include "fl/str.h"
 #include "fx/video.h"
 
@@ -74,6 +75,12 @@ class FileHandle : public Referent {
     virtual void close() = 0;
     virtual bool valid() const = 0;
 
+    // Zero copy view of the whole file for handles backed by memory, such as
+    // memory mapped files. Empty for handles that have to be read().
+    virtual fl::span<const fl::u8> mapping() const {
+        return fl::span<const fl::u8>();
+    }
+
     // convenience functions
     fl::size readCRGB(CRGB *dst, fl::size n) {
         return read((fl::u8 *)dst, n * 3) / 3;
@@ -6,7 +6,9 @@
 // FL MODULE IMPLEMENTATIONS
 #include "fl/allocator.cpp.hpp"
 #include "fl/audio.cpp.hpp"
+#include "fl/audio_fixed.cpp.hpp"
 #include "fl/audio_reactive.cpp.hpp"
+#include "fl/beat_detector.cpp.hpp"
 #include "fl/blur.cpp.hpp"
 #include "fl/bytestreammemory.cpp.hpp"
 #include "fl/colorutils.cpp.hpp"
@@ -17,8 +19,10 @@
 #include "fl/engine_events.cpp.hpp"
 #include "fl/fft.cpp.hpp"
 #include "fl/fft_impl.cpp.hpp"
+#include "fl/fft_stream.cpp.hpp"
 #include "fl/file_system.cpp.hpp"
 #include "fl/fill.cpp.hpp"
+#include "fl/frame_profiler.cpp.hpp"
 #include "fl/gamma.cpp.hpp"
 #include "fl/gradient.cpp.hpp"
 #include "fl/hsv16.cpp.hpp"
@@ -26,14 +30,18 @@
 #include "fl/istream.cpp.hpp"
 #include "fl/json.cpp.hpp"
 #include "fl/json_console.cpp.hpp"
+#include "fl/json_stream.cpp.hpp"
 #include "fl/leds.cpp.hpp"
 #include "fl/line_simplification.cpp.hpp"
 #include "fl/noise_woryley.cpp.hpp"
 #include "fl/ostream.cpp.hpp"
+#include "fl/pixel_blend.cpp.hpp"
+#include "fl/pixel_encode.cpp.hpp"
 #include "fl/ptr.cpp.hpp"
 #include "fl/ptr_impl.h"
 #include "fl/random.cpp.hpp"
 #include "fl/referent.cpp.hpp"
+#include "fl/resampler.cpp.hpp"
 #include "fl/raster_sparse.cpp.hpp"
 #include "fl/rectangular_draw_buffer.cpp.hpp"
 #include "fl/screenmap.cpp.hpp"
@@ -43,6 +51,7 @@
 #include "fl/str_ui.cpp.hpp"
 #include "fl/strstream.cpp.hpp"
 #include "fl/stub_main.cpp.hpp"
+#include "fl/thread_pool.cpp.hpp"
 #include "fl/tile2x2.cpp.hpp"
 #include "fl/time_alpha.cpp.hpp"
 #include "fl/transform.cpp.hpp"
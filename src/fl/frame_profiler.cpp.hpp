@@ -0,0 +1,190 @@
+#include <string.h>
+
+#include "fl/frame_profiler.h"
+
+#include "fl/algorithm.h"
+#include "fl/json_stream.h"
+#include "fl/strstream.h"
+#include "fx/fx.h"
+#include "led_sysdefs.h"
+
+namespace fl {
+
+namespace {
+FrameProfiler *gActiveProfiler = nullptr;
+} // namespace
+
+FrameProfiler::FrameProfiler() {
+    mSeries[kRender].name = "render";
+    mSeries[kShow].name = "show";
+    mPrevActive = gActiveProfiler;
+    if (mPrevActive) {
+        mPrevActive->mNextActive = this;
+    }
+    gActiveProfiler = this;
+    EngineEvents::addListener(this);
+}
+
+FrameProfiler::~FrameProfiler() {
+    EngineEvents::removeListener(this);
+    if (mPrevActive) {
+        mPrevActive->mNextActive = mNextActive;
+    }
+    if (mNextActive) {
+        mNextActive->mPrevActive = mPrevActive;
+    } else {
+        gActiveProfiler = mPrevActive;
+    }
+}
+
+FrameProfiler *FrameProfiler::active() { return gActiveProfiler; }
+
+void FrameProfiler::onBeginFrame() {
+    const fl::u32 now = micros();
+    if (mHaveFrameEnd) {
+        recordRender(now - mFrameEnd);
+    }
+    mFrameStart = now;
+    mInFrame = true;
+}
+
+void FrameProfiler::onEndShowLeds() {
+    const fl::u32 now = micros();
+    if (mInFrame) {
+        recordShow(now - mFrameStart);
+    }
+    mInFrame = false;
+    mFrameEnd = now;
+    mHaveFrameEnd = true;
+}
+
+void FrameProfiler::recordStrip(const CLEDController *strip, fl::u32 us) {
+    const fl::u32 index = findOrAdd(fl::bit_cast<fl::uptr>(strip));
+    if (index == FASTLED_FRAME_PROFILER_MAX_SERIES) {
+        return;
+    }
+    if (mSeries[index].name.empty()) {
+        fl::StrStream name;
+        name << "strip" << mNumStrips++;
+        mSeries[index].name = name.str();
+    }
+    record(index, us);
+}
+
+void FrameProfiler::recordFx(const FxPtr &fx, fl::u32 us) {
+    const fl::WeakPtr<Fx> ref(fx);
+    const fl::u32 index = findOrAdd(ref.ptr_value());
+    if (index == FASTLED_FRAME_PROFILER_MAX_SERIES) {
+        return;
+    }
+    if (mSeries[index].name.empty()) {
+        mSeries[index].fx = ref;
+        mSeries[index].name = fx->fxName();
+    }
+    record(index, us);
+}
+
+void FrameProfiler::onStripRemoved(CLEDController *strip) {
+    const fl::uptr key = fl::bit_cast<fl::uptr>(strip);
+    for (fl::u32 i = 2; i < mNumSeries; ++i) {
+        if (mSeries[i].key != key) {
+            continue;
+        }
+        // Keep the order of the others, json output lists them as added.
+        for (fl::u32 j = i + 1; j < mNumSeries; ++j) {
+            mSeries[j - 1] = mSeries[j];
+        }
+        --mNumSeries;
+        mSeries[mNumSeries] = Series();
+        return;
+    }
+}
+
+fl::u32 FrameProfiler::findOrAdd(fl::uptr key) {
+    for (fl::u32 i = 2; i < mNumSeries; ++i) {
+        if (mSeries[i].key == key) {
+            return i;
+        }
+    }
+    if (mNumSeries == FASTLED_FRAME_PROFILER_MAX_SERIES) {
+        return FASTLED_FRAME_PROFILER_MAX_SERIES;
+    }
+    mSeries[mNumSeries].key = key;
+    return mNumSeries++;
+}
+
+void FrameProfiler::record(fl::u32 index, fl::u32 us) {
+    Series &s = mSeries[index];
+    s.samples[s.head] = us;
+    s.head = (s.head + 1) % FASTLED_FRAME_PROFILER_HISTORY;
+    if (s.count < FASTLED_FRAME_PROFILER_HISTORY) {
+        ++s.count;
+    }
+}
+
+const char *FrameProfiler::seriesName(fl::u32 index) const {
+    return index < mNumSeries ? mSeries[index].name.c_str() : "";
+}
+
+FrameProfiler::Stats FrameProfiler::stats(fl::u32 index) const {
+    Stats out;
+    if (index >= mNumSeries || mSeries[index].count == 0) {
+        return out;
+    }
+    const Series &s = mSeries[index];
+    // Order of the samples does not matter, the ring is used as is.
+    fl::u32 sorted[FASTLED_FRAME_PROFILER_HISTORY];
+    fl::u64 sum = 0;
+    for (fl::u32 i = 0; i < s.count; ++i) {
+        sorted[i] = s.samples[i];
+        sum += s.samples[i];
+    }
+    fl::sort(sorted, sorted + s.count);
+    out.count = s.count;
+    out.min = sorted[0];
+    out.max = sorted[s.count - 1];
+    out.avg = fl::u32(sum / s.count);
+    // Nearest rank: the smallest sample with at least 99% at or below it.
+    const fl::u32 rank = (s.count * 99 + 99) / 100;
+    out.p99 = sorted[rank - 1];
+    return out;
+}
+
+FrameProfiler::Stats FrameProfiler::stats(const char *name) const {
+    for (fl::u32 i = 0; i < mNumSeries; ++i) {
+        if (strcmp(mSeries[i].name.c_str(), name) == 0) {
+            return stats(i);
+        }
+    }
+    return Stats();
+}
+
+void FrameProfiler::toJson(fl::string *out) const {
+    out->clear();
+    fl::JsonWriter json(out);
+    json.beginObject();
+    json.member("history", fl::u32(FASTLED_FRAME_PROFILER_HISTORY));
+    json.key("series").beginArray();
+    for (fl::u32 i = 0; i < mNumSeries; ++i) {
+        const Stats st = stats(i);
+        json.beginObject();
+        json.member("name", mSeries[i].name);
+        json.member("count", st.count).member("min", st.min);
+        json.member("avg", st.avg).member("p99", st.p99);
+        json.member("max", st.max);
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+}
+
+void FrameProfiler::reset() {
+    for (fl::u32 i = 0; i < mNumSeries; ++i) {
+        mSeries[i].head = 0;
+        mSeries[i].count = 0;
+    }
+    mInFrame = false;
+    mHaveFrameEnd = false;
+}
+
+} // namespace fl
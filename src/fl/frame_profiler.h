@@ -0,0 +1,138 @@
+#pragma once
+
+#include "fl/engine_events.h"
+#include "fl/int.h"
+#include "fl/ptr.h"
+#include "fl/sketch_macros.h"
+#include "fl/str.h"
+
+// A profiler holds FASTLED_FRAME_PROFILER_MAX_SERIES *
+// FASTLED_FRAME_PROFILER_HISTORY u32 samples plus a name per series: 8 KB of
+// samples at the 16 x 128 default, about 10 KB in all on a 64 bit host.
+// stats() sorts a copy of one series on the stack. Boards without much RAM
+// default to 6 x 32, about 1 KB.
+
+// Frames of history kept per series. Stats are computed over this window.
+#ifndef FASTLED_FRAME_PROFILER_HISTORY
+#if SKETCH_HAS_LOTS_OF_MEMORY
+#define FASTLED_FRAME_PROFILER_HISTORY 128
+#else
+#define FASTLED_FRAME_PROFILER_HISTORY 32
+#endif
+#endif
+
+// Upper bound on render + show + one series per strip and per Fx. Samples
+// for strips or effects beyond this are dropped.
+#ifndef FASTLED_FRAME_PROFILER_MAX_SERIES
+#if SKETCH_HAS_LOTS_OF_MEMORY
+#define FASTLED_FRAME_PROFILER_MAX_SERIES 16
+#else
+#define FASTLED_FRAME_PROFILER_MAX_SERIES 6
+#endif
+#endif
+
+static_assert(FASTLED_FRAME_PROFILER_HISTORY > 0,
+              "FASTLED_FRAME_PROFILER_HISTORY must be at least 1");
+static_assert(FASTLED_FRAME_PROFILER_MAX_SERIES >= 2,
+              "FASTLED_FRAME_PROFILER_MAX_SERIES needs room for render and "
+              "show");
+
+namespace fl {
+
+FASTLED_SMART_PTR(Fx);
+
+// Frame time profiler driven by EngineEvents. While one is alive it records,
+// in microseconds:
+//   render: end of the previous show() to the start of the next one, which is
+//           the time the sketch spent drawing.
+//   show:   the whole of FastLED.show().
+//   strip:  showLedsInternal() of each controller.
+//   fx:     Fx::draw() of each effect run through FxEngine.
+// Every series keeps the last FASTLED_FRAME_PROFILER_HISTORY samples in a
+// ring buffer, so the profiler does not allocate once all series exist.
+//
+//   fl::FrameProfiler profiler;
+//   ...
+//   fl::string json;
+//   profiler.toJson(&json);
+class FrameProfiler : public EngineEvents::Listener {
+  public:
+    struct Stats {
+        fl::u32 count = 0; // Samples in the window.
+        fl::u32 min = 0;
+        fl::u32 avg = 0;
+        fl::u32 p99 = 0;
+        fl::u32 max = 0;
+    };
+
+    // Registers with EngineEvents and becomes the active() profiler.
+    FrameProfiler();
+    ~FrameProfiler() override;
+
+    // The most recently constructed profiler that is still alive, nullptr if
+    // none. Profilers may be destroyed in any order. The strip and Fx hooks
+    // check this before reading the clock.
+    static FrameProfiler *active();
+
+    const char *seriesName(fl::u32 index) const;
+    fl::u32 numSeries() const { return mNumSeries; }
+    Stats stats(fl::u32 index) const;
+    // Stats of the series with this name, all zero if there is none.
+    Stats stats(const char *name) const;
+    Stats renderStats() const { return stats(kRender); }
+    Stats showStats() const { return stats(kShow); }
+
+    // {"history":128,"series":[{"name":"show","count":..,"min":..,"avg":..,
+    //  "p99":..,"max":..},...]}
+    void toJson(fl::string *out) const;
+    void reset();
+
+    // Sample entry points, also usable to feed timings from elsewhere.
+    void recordRender(fl::u32 us) { record(kRender, us); }
+    void recordShow(fl::u32 us) { record(kShow, us); }
+    void recordStrip(const CLEDController *strip, fl::u32 us);
+    // Each Fx object gets its own series, also when a new one is created at
+    // the address of a destroyed one.
+    void recordFx(const FxPtr &fx, fl::u32 us);
+
+    void onBeginFrame() override;
+    void onEndShowLeds() override;
+    // Drops the series of a destroyed strip, so a controller created at the
+    // same address starts a new one.
+    void onStripRemoved(CLEDController *strip) override;
+
+  private:
+    enum { kRender = 0, kShow = 1 };
+
+    struct Series {
+        fl::uptr key = 0;
+        // For an Fx series the key is its weak referent, held here so the
+        // address is not reused while the series exists.
+        fl::WeakPtr<Fx> fx;
+        fl::string name;
+        fl::u32 samples[FASTLED_FRAME_PROFILER_HISTORY];
+        fl::u32 head = 0;  // Next slot to write.
+        fl::u32 count = 0; // Valid samples, saturates at the history size.
+    };
+
+    FrameProfiler(const FrameProfiler &) = delete;
+    FrameProfiler &operator=(const FrameProfiler &) = delete;
+
+    void record(fl::u32 index, fl::u32 us);
+    // Index of the series for key, creating it on first use. Returns
+    // FASTLED_FRAME_PROFILER_MAX_SERIES when full.
+    fl::u32 findOrAdd(fl::uptr key);
+
+    Series mSeries[FASTLED_FRAME_PROFILER_MAX_SERIES];
+    fl::u32 mNumSeries = 2;
+    fl::u32 mNumStrips = 0;
+    fl::u32 mFrameStart = 0;
+    fl::u32 mFrameEnd = 0;
+    bool mInFrame = false;
+    bool mHaveFrameEnd = false;
+    // Live profilers, oldest first, the newest is active().
+    FrameProfiler *mPrevActive = nullptr;
+    FrameProfiler *mNextActive = nullptr;
+};
+
+} // namespace fl
@@ -0,0 +1,919 @@
+#include "fl/json_stream.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "fl/ostream.h"
+#include "fl/str.h"
+
+namespace fl {
+
+namespace {
+
+u32 floatBits(float f) {
+    u32 bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+u64 doubleBits(double d) {
+    u64 bits;
+    memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+
+// What the writer and the reader compute numbers in, see
+// FASTLED_JSON_LONG_DOUBLE.
+#if FASTLED_JSON_LONG_DOUBLE
+typedef long double JsonWide;
+#else
+typedef double JsonWide;
+#endif
+
+template <typename Wide> Wide powerOf10(int n) {
+    Wide result = 1.0;
+    Wide base = 10.0;
+    for (; n > 0; n >>= 1) {
+        if (n & 1) {
+            result *= base;
+        }
+        base *= base;
+    }
+    return result;
+}
+
+// mantissa * 10^exponent, the way JsonReader reads a number with that many
+// significant digits.
+template <typename Wide> Wide digitsValue(u64 mantissa, int exponent,
+                                          int digits) {
+    Wide v = Wide(mantissa);
+    if (exponent > 0) {
+        v = exponent > 308 ? Wide(HUGE_VAL) : v * powerOf10<Wide>(exponent);
+    } else if (exponent < 0) {
+        // Below 1e-330 even a double subnormal is 0. Otherwise divide in
+        // steps, 10^-exponent alone can overflow.
+        if (exponent + digits < -330) {
+            v = 0.0;
+        } else {
+            int n = -exponent;
+            for (; n > 300; n -= 300) {
+                v /= powerOf10<Wide>(300);
+            }
+            v /= powerOf10<Wide>(n);
+        }
+    }
+    return v;
+}
+
+// Writes u as decimal digits ending at end, returns the first digit.
+char *formatU32(u32 u, char *end) {
+    do {
+        *--end = char('0' + u % 10);
+        u /= 10;
+    } while (u);
+    return end;
+}
+
+char *formatU64(u64 u, char *end) {
+    if (u <= 0xffffffffu) {
+        return formatU32(u32(u), end);
+    }
+    do {
+        *--end = char('0' + u % 10);
+        u /= 10;
+    } while (u);
+    return end;
+}
+
+// Positive finite v rounded to p <= 17 significant digits, as the p digit
+// integer m. *e is the decimal exponent of the leading digit.
+template <typename Wide> u64 roundDigits(Wide v, int p, int *e) {
+    *e = int(floor(log10(double(v))));
+    const u64 limit = u64(powerOf10<Wide>(p));
+    int scale = p - 1 - *e;
+    Wide scaled = v;
+    if (scale > 300) {
+        // Subnormals, 10^scale alone would overflow a 64 bit long double.
+        scaled *= powerOf10<Wide>(scale - 300);
+        scale = 300;
+    }
+    scaled = scale >= 0 ? scaled * powerOf10<Wide>(scale)
+                        : scaled / powerOf10<Wide>(-scale);
+    u64 m = u64(scaled + 0.5);
+    if (m >= limit) {
+        m = (m + 5) / 10;
+        ++*e;
+    } else if (m < limit / 10) {
+        // log10() came out one too high.
+        scaled *= 10.0;
+        m = u64(scaled + 0.5);
+        --*e;
+    }
+    return m;
+}
+
+// Drops the trailing zeros of the p digits in *m, returns the digits left.
+int trimZeros(u64 *m, int p) {
+    while (p > 1 && *m % 10 == 0) {
+        *m /= 10;
+        --p;
+    }
+    return p;
+}
+
+// The k digits of m with the leading one at decimal exponent e, into out
+// (at least 32 chars). Plain decimals for moderate exponents, exponent form
+// otherwise.
+void writeDigits(u64 m, int e, int k, char *out) {
+    char digits[20];
+    char *first = formatU64(m, digits + sizeof(digits));
+
+    if (e >= -5 && e < 10) {
+        if (e >= k - 1) {
+            memcpy(out, first, k);
+            out += k;
+            for (int i = k - 1; i < e; ++i) {
+                *out++ = '0';
+            }
+        } else if (e >= 0) {
+            memcpy(out, first, e + 1);
+            out += e + 1;
+            *out++ = '.';
+            memcpy(out, first + e + 1, k - e - 1);
+            out += k - e - 1;
+        } else {
+            *out++ = '0';
+            *out++ = '.';
+            for (int i = -1; i > e; --i) {
+                *out++ = '0';
+            }
+            memcpy(out, first, k);
+            out += k;
+        }
+    } else {
+        *out++ = first[0];
+        if (k > 1) {
+            *out++ = '.';
+            memcpy(out, first + 1, k - 1);
+            out += k - 1;
+        }
+        *out++ = 'e';
+        if (e < 0) {
+            *out++ = '-';
+            e = -e;
+        }
+        char exp[5];
+        char *expFirst = formatU32(u32(e), exp + sizeof(exp));
+        memcpy(out, expFirst, exp + sizeof(exp) - expFirst);
+        out += exp + sizeof(exp) - expFirst;
+    }
+    *out = '\0';
+}
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// Reads the 4 hex digits of a \u escape at p, advancing past them.
+bool decodeHex4(const char *&p, const char *end, u32 *cp) {
+    u32 v = 0;
+    for (int i = 0; i < 4; ++i) {
+        const int d = p < end ? hexDigit(*p) : -1;
+        if (d < 0) {
+            return false;
+        }
+        v = (v << 4) | u32(d);
+        ++p;
+    }
+    *cp = v;
+    return true;
+}
+
+// Decodes one character of a JSON string body at *p into out as UTF-8 and
+// returns the byte count. Bad escapes come out as '?'.
+int decodeChar(const char *&p, const char *end, char out[4]) {
+    if (*p != '\\' || p + 1 >= end) {
+        out[0] = *p++;
+        return 1;
+    }
+    const char c = p[1];
+    p += 2;
+    switch (c) {
+    case 'b':
+        out[0] = '\b';
+        return 1;
+    case 'f':
+        out[0] = '\f';
+        return 1;
+    case 'n':
+        out[0] = '\n';
+        return 1;
+    case 'r':
+        out[0] = '\r';
+        return 1;
+    case 't':
+        out[0] = '\t';
+        return 1;
+    case 'u':
+        break;
+    default:
+        out[0] = c;
+        return 1;
+    }
+    u32 cp = 0;
+    if (!decodeHex4(p, end, &cp)) {
+        out[0] = '?';
+        return 1;
+    }
+    if (cp >= 0xd800 && cp <= 0xdfff) {
+        // A high surrogate followed by \uDC00-\uDFFF is one code point
+        // above the BMP, anything else is malformed.
+        const char *low = p + 2;
+        u32 lo = 0;
+        if (cp > 0xdbff || p + 1 >= end || p[0] != '\\' || p[1] != 'u' ||
+            !decodeHex4(low, end, &lo) || lo < 0xdc00 || lo > 0xdfff) {
+            out[0] = '?';
+            return 1;
+        }
+        p = low;
+        cp = 0x10000 + ((cp - 0xd800) << 10) + (lo - 0xdc00);
+        out[0] = char(0xf0 | (cp >> 18));
+        out[1] = char(0x80 | ((cp >> 12) & 0x3f));
+        out[2] = char(0x80 | ((cp >> 6) & 0x3f));
+        out[3] = char(0x80 | (cp & 0x3f));
+        return 4;
+    }
+    if (cp < 0x80) {
+        out[0] = char(cp);
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = char(0xc0 | (cp >> 6));
+        out[1] = char(0x80 | (cp & 0x3f));
+        return 2;
+    }
+    out[0] = char(0xe0 | (cp >> 12));
+    out[1] = char(0x80 | ((cp >> 6) & 0x3f));
+    out[2] = char(0x80 | (cp & 0x3f));
+    return 3;
+}
+
+} // namespace
+
+namespace json_detail {
+
+template <typename Wide> void formatFloat(float v, char *out) {
+    if (v < 0) {
+        *out++ = '-';
+        v = -v;
+    }
+    const u32 bits = floatBits(v);
+    // Fewest digits that read back to the same float, 9 always do. The
+    // check is the reader's own arithmetic, no text is parsed.
+    for (int p = 6;; ++p) {
+        int e;
+        u64 m = roundDigits<Wide>(Wide(v), p, &e);
+        const int k = trimZeros(&m, p);
+        const double back = double(digitsValue<Wide>(m, e - k + 1, k));
+        if (p == 9 || floatBits(float(back)) == bits) {
+            writeDigits(m, e, k, out);
+            return;
+        }
+    }
+}
+
+template <typename Wide> void formatDouble(double v, char *out) {
+    if (v < 0) {
+        *out++ = '-';
+        v = -v;
+    }
+    const u64 bits = doubleBits(v);
+    int e;
+    if (sizeof(Wide) <= sizeof(double)) {
+        // Without the headroom to find the shortest form, 17 digits in one
+        // pass. Double arithmetic leaves them a few ulp off.
+        u64 m = roundDigits<Wide>(Wide(v), 17, &e);
+        const int k = trimZeros(&m, 17);
+        writeDigits(m, e, k, out);
+        return;
+    }
+    // 15 digits are exact for every normal double that has a shorter form,
+    // 17 always read back. Subnormals have fewer bits, so try from 1.
+    const bool subnormal = (bits & 0x7ff0000000000000ull) == 0;
+    for (int p = subnormal ? 1 : 15;; ++p) {
+        u64 m = roundDigits<Wide>(Wide(v), p, &e);
+        const int k = trimZeros(&m, p);
+        const double back = double(digitsValue<Wide>(m, e - k + 1, k));
+        if (p == 17 || doubleBits(back) == bits) {
+            writeDigits(m, e, k, out);
+            return;
+        }
+    }
+}
+
+template void formatFloat<double>(float v, char *out);
+template void formatFloat<long double>(float v, char *out);
+template void formatDouble<double>(double v, char *out);
+template void formatDouble<long double>(double v, char *out);
+
+} // namespace json_detail
+
+JsonWriter::JsonWriter(char *buf, fl::size capacity)
+    : mSink(kBuffer), mBuf(buf), mCapacity(capacity) {
+    if (mBuf && mCapacity) {
+        mBuf[0] = '\0';
+    }
+}
+
+JsonWriter::JsonWriter(fl::string *out) : mSink(kString), mString(out) {}
+
+JsonWriter::JsonWriter(fl::ostream &out) : mSink(kStream), mStream(&out) {}
+
+JsonWriter::~JsonWriter() { flush(); }
+
+void JsonWriter::flush() {
+    if (mSink == kStream && mStaged) {
+        mStage[mStaged] = '\0';
+        *mStream << static_cast<const char *>(mStage);
+        mStaged = 0;
+    }
+}
+
+void JsonWriter::write(const char *str, fl::size n) {
+    const fl::size pos = mLength;
+    mLength += n;
+    switch (mSink) {
+    case kBuffer: {
+        if (!mBuf || mCapacity == 0) {
+            mError = true;
+            return;
+        }
+        const fl::size room = pos < mCapacity - 1 ? mCapacity - 1 - pos : 0;
+        const fl::size count = n < room ? n : room;
+        if (count < n) {
+            mError = true;
+        }
+        if (count) {
+            memcpy(mBuf + pos, str, count);
+            mBuf[pos + count] = '\0';
+        }
+        return;
+    }
+    case kString:
+        mString->append(str, n);
+        return;
+    case kStream:
+        while (n) {
+            fl::size count = sizeof(mStage) - 1 - mStaged;
+            count = n < count ? n : count;
+            memcpy(mStage + mStaged, str, count);
+            mStaged = u8(mStaged + count);
+            str += count;
+            n -= count;
+            if (mStaged == sizeof(mStage) - 1) {
+                flush();
+            }
+        }
+        return;
+    }
+}
+
+void JsonWriter::write(const char *str) { write(str, strlen(str)); }
+
+void JsonWriter::beforeValue() {
+    if (mDepth > 0 && !mAfterKey) {
+        const u32 bit = 1u << (mDepth - 1);
+        if (mIsObject & bit) {
+            // Object members need a key first.
+            mError = true;
+        }
+        if (mHasItems & bit) {
+            put(',');
+        }
+        mHasItems |= bit;
+    }
+    mAfterKey = false;
+}
+
+bool JsonWriter::push(bool isObject) {
+    if (mDepth >= FASTLED_JSON_MAX_DEPTH) {
+        mError = true;
+        return false;
+    }
+    const u32 bit = 1u << mDepth;
+    mHasItems &= ~bit;
+    mIsObject = isObject ? (mIsObject | bit) : (mIsObject & ~bit);
+    ++mDepth;
+    return true;
+}
+
+bool JsonWriter::pop(bool isObject) {
+    if (mDepth == 0 || mAfterKey ||
+        bool(mIsObject & (1u << (mDepth - 1))) != isObject) {
+        mError = true;
+        return false;
+    }
+    --mDepth;
+    return true;
+}
+
+JsonWriter &JsonWriter::beginObject() {
+    beforeValue();
+    if (push(true)) {
+        put('{');
+    }
+    return *this;
+}
+
+JsonWriter &JsonWriter::endObject() {
+    if (pop(true)) {
+        put('}');
+    }
+    if (mDepth == 0) {
+        flush();
+    }
+    return *this;
+}
+
+JsonWriter &JsonWriter::beginArray() {
+    beforeValue();
+    if (push(false)) {
+        put('[');
+    }
+    return *this;
+}
+
+JsonWriter &JsonWriter::endArray() {
+    if (pop(false)) {
+        put(']');
+    }
+    if (mDepth == 0) {
+        flush();
+    }
+    return *this;
+}
+
+JsonWriter &JsonWriter::key(const char *name) {
+    const u32 bit = mDepth ? 1u << (mDepth - 1) : 0;
+    if (!(mIsObject & bit) || mAfterKey) {
+        mError = true;
+        return *this;
+    }
+    if (mHasItems & bit) {
+        put(',');
+    }
+    mHasItems |= bit;
+    writeString(name);
+    put(':');
+    mAfterKey = true;
+    return *this;
+}
+
+void JsonWriter::writeString(const char *str) {
+    put('"');
+    const char *run = str;
+    for (const char *p = str; *p; ++p) {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        write(run, fl::size(p - run));
+        run = p + 1;
+        char esc[7] = {'\\', char(c), 0, 0, 0, 0, 0};
+        switch (c) {
+        case '\b':
+            esc[1] = 'b';
+            break;
+        case '\f':
+            esc[1] = 'f';
+            break;
+        case '\n':
+            esc[1] = 'n';
+            break;
+        case '\r':
+            esc[1] = 'r';
+            break;
+        case '\t':
+            esc[1] = 't';
+            break;
+        case '"':
+        case '\\':
+            break;
+        default: {
+            static const char kHex[] = "0123456789abcdef";
+            esc[1] = 'u';
+            esc[2] = '0';
+            esc[3] = '0';
+            esc[4] = kHex[c >> 4];
+            esc[5] = kHex[c & 0xf];
+            break;
+        }
+        }
+        write(esc);
+    }
+    write(run);
+    put('"');
+}
+
+JsonWriter &JsonWriter::value(const char *str) {
+    if (!str) {
+        return null();
+    }
+    beforeValue();
+    writeString(str);
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(const fl::string &str) {
+    return value(str.c_str());
+}
+
+JsonWriter &JsonWriter::value(bool b) {
+    beforeValue();
+    write(b ? "true" : "false");
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(i32 n) {
+    beforeValue();
+    char buf[12];
+    char *end = buf + sizeof(buf);
+    const u32 mag = n < 0 ? 0u - u32(n) : u32(n);
+    char *first = formatU32(mag, end);
+    if (n < 0) {
+        *--first = '-';
+    }
+    write(first, fl::size(end - first));
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(u32 n) {
+    beforeValue();
+    char buf[12];
+    char *end = buf + sizeof(buf);
+    char *first = formatU32(n, end);
+    write(first, fl::size(end - first));
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(i64 n) {
+    beforeValue();
+    char buf[21];
+    char *end = buf + sizeof(buf);
+    const u64 mag = n < 0 ? 0u - u64(n) : u64(n);
+    char *first = formatU64(mag, end);
+    if (n < 0) {
+        *--first = '-';
+    }
+    write(first, fl::size(end - first));
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(u64 n) {
+    beforeValue();
+    char buf[21];
+    char *end = buf + sizeof(buf);
+    char *first = formatU64(n, end);
+    write(first, fl::size(end - first));
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(float f) {
+    const u32 bits = floatBits(f);
+    if ((bits & 0x7f800000u) == 0x7f800000u) {
+        return null();
+    }
+    beforeValue();
+    if ((bits & 0x7fffffffu) == 0) {
+        put('0');
+        return *this;
+    }
+    char buf[32];
+    json_detail::formatFloat<JsonWide>(f, buf);
+    write(buf);
+    return *this;
+}
+
+JsonWriter &JsonWriter::value(double d) {
+    if (sizeof(double) == sizeof(float)) {
+        // AVR, double is float.
+        return value(float(d));
+    }
+    const u64 bits = doubleBits(d);
+    const u64 exponent = 0x7ff0000000000000ull;
+    if ((bits & exponent) == exponent) {
+        return null();
+    }
+    beforeValue();
+    if ((bits & ~(u64(1) << 63)) == 0) {
+        put('0');
+        return *this;
+    }
+    char buf[32];
+    json_detail::formatDouble<JsonWide>(d, buf);
+    write(buf);
+    return *this;
+}
+
+JsonWriter &JsonWriter::null() {
+    beforeValue();
+    write("null");
+    return *this;
+}
+
+JsonReader::JsonReader(const char *json)
+    : mBegin(json), mPos(json), mEnd(json ? json + strlen(json) : json) {}
+
+JsonReader::JsonReader(const char *json, fl::size len)
+    : mBegin(json), mPos(json), mEnd(json + len) {}
+
+JsonReader::Token JsonReader::fail() {
+    mToken = kError;
+    return kError;
+}
+
+void JsonReader::skipSpace() {
+    while (mPos < mEnd &&
+           (*mPos == ' ' || *mPos == '\t' || *mPos == '\n' || *mPos == '\r')) {
+        ++mPos;
+    }
+}
+
+bool JsonReader::push(bool isObject) {
+    if (mDepth >= FASTLED_JSON_MAX_DEPTH) {
+        return false;
+    }
+    const u32 bit = 1u << mDepth;
+    mHasItems &= ~bit;
+    mIsObject = isObject ? (mIsObject | bit) : (mIsObject & ~bit);
+    ++mDepth;
+    return true;
+}
+
+JsonReader::Token JsonReader::next() {
+    if (mToken == kEnd || mToken == kError) {
+        return mToken;
+    }
+    skipSpace();
+    if (!mStarted || mAfterKey) {
+        mStarted = true;
+        mAfterKey = false;
+        return value();
+    }
+    if (mDepth == 0) {
+        if (mPos != mEnd) {
+            return fail();
+        }
+        mToken = kEnd;
+        return kEnd;
+    }
+    if (mPos == mEnd) {
+        return fail();
+    }
+    const bool object = inObject();
+    const u32 bit = 1u << (mDepth - 1);
+    if (*mPos == (object ? '}' : ']')) {
+        ++mPos;
+        --mDepth;
+        mToken = object ? kEndObject : kEndArray;
+        return mToken;
+    }
+    if (mHasItems & bit) {
+        if (*mPos != ',') {
+            return fail();
+        }
+        ++mPos;
+        skipSpace();
+    }
+    mHasItems |= bit;
+    if (!object) {
+        return value();
+    }
+    if (mPos == mEnd || *mPos != '"' || !scanString()) {
+        return fail();
+    }
+    skipSpace();
+    if (mPos == mEnd || *mPos != ':') {
+        return fail();
+    }
+    ++mPos;
+    mAfterKey = true;
+    mToken = kKey;
+    return kKey;
+}
+
+JsonReader::Token JsonReader::value() {
+    if (mPos == mEnd) {
+        return fail();
+    }
+    switch (*mPos) {
+    case '{':
+    case '[': {
+        const bool object = *mPos == '{';
+        if (!push(object)) {
+            return fail();
+        }
+        ++mPos;
+        mToken = object ? kBeginObject : kBeginArray;
+        return mToken;
+    }
+    case '"':
+        if (!scanString()) {
+            return fail();
+        }
+        mToken = kString;
+        return kString;
+    case 't':
+    case 'f':
+        mBool = *mPos == 't';
+        if (!literal(mBool ? "true" : "false")) {
+            return fail();
+        }
+        mNumber = mBool ? 1.0 : 0.0;
+        mInt = mBool ? 1 : 0;
+        mToken = kBool;
+        return kBool;
+    case 'n':
+        if (!literal("null")) {
+            return fail();
+        }
+        mBool = false;
+        mNumber = 0.0;
+        mInt = 0;
+        mToken = kNull;
+        return kNull;
+    default:
+        if (!scanNumber()) {
+            return fail();
+        }
+        mToken = kNumber;
+        return kNumber;
+    }
+}
+
+bool JsonReader::literal(const char *word) {
+    const fl::size n = strlen(word);
+    if (fl::size(mEnd - mPos) < n || memcmp(mPos, word, n) != 0) {
+        return false;
+    }
+    mPos += n;
+    return true;
+}
+
+bool JsonReader::scanString() {
+    ++mPos;
+    mStr = mPos;
+    while (mPos < mEnd) {
+        const unsigned char c = static_cast<unsigned char>(*mPos);
+        if (c == '"') {
+            mStrLen = fl::size(mPos - mStr);
+            ++mPos;
+            return true;
+        }
+        if (c < 0x20) {
+            return false;
+        }
+        mPos += c == '\\' ? 2 : 1;
+    }
+    return false;
+}
+
+bool JsonReader::scanNumber() {
+    const char *p = mPos;
+    bool negative = false;
+    if (p < mEnd && *p == '-') {
+        negative = true;
+        ++p;
+    }
+    if (p == mEnd || *p < '0' || *p > '9') {
+        return false;
+    }
+    // Up to 19 significant digits in the mantissa, the rest only move the
+    // decimal exponent.
+    u64 mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool integer = true;
+    if (*p == '0') {
+        ++p;
+    } else {
+        for (; p < mEnd && *p >= '0' && *p <= '9'; ++p) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + u64(*p - '0');
+                ++digits;
+            } else {
+                ++exponent;
+            }
+        }
+    }
+    if (p < mEnd && *p == '.') {
+        integer = false;
+        ++p;
+        if (p == mEnd || *p < '0' || *p > '9') {
+            return false;
+        }
+        for (; p < mEnd && *p >= '0' && *p <= '9'; ++p) {
+            if (digits < 19) {
+                // Leading zeros only move the exponent.
+                mantissa = mantissa * 10 + u64(*p - '0');
+                digits += mantissa ? 1 : 0;
+                --exponent;
+            }
+        }
+    }
+    if (p < mEnd && (*p == 'e' || *p == 'E')) {
+        integer = false;
+        ++p;
+        bool expNegative = false;
+        if (p < mEnd && (*p == '+' || *p == '-')) {
+            expNegative = *p == '-';
+            ++p;
+        }
+        if (p == mEnd || *p < '0' || *p > '9') {
+            return false;
+        }
+        int e = 0;
+        for (; p < mEnd && *p >= '0' && *p <= '9'; ++p) {
+            if (e < 10000) {
+                e = e * 10 + (*p - '0');
+            }
+        }
+        exponent += expNegative ? -e : e;
+    }
+    mPos = p;
+
+    JsonWide v = digitsValue<JsonWide>(mantissa, exponent, digits);
+    if (negative) {
+        v = -v;
+    }
+    mNumber = double(v);
+    if (integer && digits <= 10 && exponent == 0) {
+        const i64 n = negative ? -i64(mantissa) : i64(mantissa);
+        mInt = n > 2147483647 ? 2147483647
+                              : (n < -2147483647 - 1 ? -2147483647 - 1 : i32(n));
+    } else {
+        mInt = v >= 2147483647.0
+                   ? 2147483647
+                   : (v <= -2147483648.0 ? -2147483647 - 1 : i32(v));
+    }
+    return true;
+}
+
+bool JsonReader::skip() {
+    if (mToken == kKey) {
+        next();
+    }
+    if (mToken == kBeginObject || mToken == kBeginArray) {
+        const int target = mDepth - 1;
+        while (mDepth > target) {
+            if (next() == kError) {
+                return false;
+            }
+        }
+    }
+    return mToken != kError;
+}
+
+bool JsonReader::keyIs(const char *str) const {
+    const char *p = mStr;
+    const char *end = mStr + mStrLen;
+    while (p < end) {
+        char buf[4];
+        const int n = decodeChar(p, end, buf);
+        for (int i = 0; i < n; ++i) {
+            if (*str++ != buf[i]) {
+                return false;
+            }
+        }
+    }
+    return *str == '\0';
+}
+
+void JsonReader::decodeString(fl::string *out) const {
+    const char *p = mStr;
+    const char *end = mStr + mStrLen;
+    while (p < end) {
+        // Copy runs without escapes in one go.
+        const char *run = p;
+        while (p < end && *p != '\\') {
+            ++p;
+        }
+        out->append(run, fl::size(p - run));
+        if (p < end) {
+            char buf[4];
+            const int n = decodeChar(p, end, buf);
+            out->append(buf, fl::size(n));
+        }
+    }
+}
+
+} // namespace fl
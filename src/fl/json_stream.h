@@ -0,0 +1,231 @@
+#pragma once
+
+// Streaming JSON without a document tree.
+//
+// JsonWriter emits JSON text as it is produced, straight into a caller
+// buffer, an fl::string or an fl::ostream. JsonReader pulls tokens out of a
+// JSON string in place. Both keep only a bit per nesting level, so memory
+// use does not grow with the size of the document and neither one
+// allocates.
+//
+//   char buf[128];
+//   fl::JsonWriter json(buf, sizeof(buf));
+//   json.beginObject();
+//   json.member("fps", 60).member("name", "strip");
+//   json.key("xy").beginArray().value(1.5f).value(2).endArray();
+//   json.endObject();
+//   // buf: {"fps":60,"name":"strip","xy":[1.5,2]}
+//
+//   fl::JsonReader in(buf);
+//   in.next();                           // kBeginObject
+//   while (in.next() == fl::JsonReader::kKey) {
+//       if (in.keyIs("fps")) {
+//           in.next();                   // kNumber
+//           int fps = in.asInt();
+//       } else {
+//           in.skip();                   // skip the value, any type
+//       }
+//   }
+
+#include "fl/int.h"
+#include "fl/stdint.h"
+#include "fl/type_traits.h"
+
+#ifndef FASTLED_JSON_MAX_DEPTH
+#define FASTLED_JSON_MAX_DEPTH 32
+#endif
+
+// Whether number formatting and parsing use long double. Only worth it where
+// long double is wider than double: there the double writer searches for the
+// shortest form. Elsewhere (32 bit long double on AVR, 64 bit soft float on
+// ESP32) floats go through double and doubles are written with a fixed 17
+// digits.
+#ifndef FASTLED_JSON_LONG_DOUBLE
+#if defined(__LDBL_MANT_DIG__) && defined(__DBL_MANT_DIG__) &&               \
+    __LDBL_MANT_DIG__ > __DBL_MANT_DIG__
+#define FASTLED_JSON_LONG_DOUBLE 1
+#else
+#define FASTLED_JSON_LONG_DOUBLE 0
+#endif
+#endif
+
+// The writer and the reader keep one bit per level in a u32.
+static_assert(FASTLED_JSON_MAX_DEPTH <= 32,
+              "FASTLED_JSON_MAX_DEPTH can be at most 32");
+
+namespace fl {
+
+class ostream;
+class string;
+
+class JsonWriter {
+  public:
+    // Writes into buf and keeps it null terminated. When the text does not
+    // fit it is cut off, ok() is false and length() still counts the full
+    // text, so a first pass into a small buffer can size the real one.
+    JsonWriter(char *buf, fl::size capacity);
+    // Appends to the string.
+    explicit JsonWriter(fl::string *out);
+    // Prints to the stream in small chunks.
+    explicit JsonWriter(fl::ostream &out);
+    ~JsonWriter();
+
+    JsonWriter &beginObject();
+    JsonWriter &endObject();
+    JsonWriter &beginArray();
+    JsonWriter &endArray();
+
+    // Object member name, followed by exactly one value or container.
+    JsonWriter &key(const char *name);
+
+    JsonWriter &value(const char *str);
+    JsonWriter &value(const fl::string &str);
+    JsonWriter &value(bool b);
+    JsonWriter &value(i32 n);
+    JsonWriter &value(u32 n);
+    JsonWriter &value(i64 n);
+    JsonWriter &value(u64 n);
+    // Other integer types go through the 32 or 64 bit overloads.
+    template <typename T>
+    typename fl::enable_if<fl::is_integral<T>::value, JsonWriter &>::type
+    value(T n) {
+        const bool isSigned = T(~T(0)) < T(1);
+        if (sizeof(T) > sizeof(u32)) {
+            return isSigned ? value(i64(n)) : value(u64(n));
+        }
+        return isSigned ? value(i32(n)) : value(u32(n));
+    }
+    // Shortest form that JsonReader reads back as the same float or double,
+    // at most 9 and 17 significant digits. Without FASTLED_JSON_LONG_DOUBLE
+    // doubles always get 17. NaN and infinity are written as null, like
+    // ArduinoJson does.
+    JsonWriter &value(float f);
+    JsonWriter &value(double d);
+    JsonWriter &null();
+
+    template <typename T> JsonWriter &member(const char *name, const T &v) {
+        key(name);
+        return value(v);
+    }
+
+    // Pushes buffered output to the stream sink, a no-op for the others.
+    void flush();
+
+    // False after a cut off write or a nesting error.
+    bool ok() const { return !mError; }
+    // Characters produced so far, including any that did not fit.
+    fl::size length() const { return mLength; }
+
+  private:
+    enum Sink { kBuffer, kString, kStream };
+
+    void beforeValue();
+    bool push(bool isObject);
+    bool pop(bool isObject);
+    void write(const char *str, fl::size n);
+    void write(const char *str);
+    void put(char c) { write(&c, 1); }
+    void writeString(const char *str);
+
+    Sink mSink;
+    char *mBuf = nullptr;
+    fl::size mCapacity = 0;
+    fl::string *mString = nullptr;
+    fl::ostream *mStream = nullptr;
+    char mStage[32];
+    u8 mStaged = 0;
+
+    fl::size mLength = 0;
+    u32 mHasItems = 0; // Bit per level, set once it has an element.
+    u32 mIsObject = 0; // Bit per level, objects set, arrays clear.
+    u8 mDepth = 0;
+    bool mAfterKey = false;
+    bool mError = false;
+};
+
+class JsonReader {
+  public:
+    enum Token {
+        kBeginObject,
+        kEndObject,
+        kBeginArray,
+        kEndArray,
+        kKey,
+        kString,
+        kNumber,
+        kBool,
+        kNull,
+        kEnd,
+        kError
+    };
+
+    // Reads json up to the terminating null, or len characters.
+    explicit JsonReader(const char *json);
+    JsonReader(const char *json, fl::size len);
+
+    // Advances to the next token. Keys come back as kKey, and the token
+    // after a key is its value. Once kEnd or kError is returned it sticks.
+    Token next();
+    Token token() const { return mToken; }
+
+    // Skips the current value. After kKey that is the member's value, after
+    // kBeginObject or kBeginArray the whole container. Returns false on a
+    // parse error.
+    bool skip();
+
+    // For kKey and kString, the raw text between the quotes, escapes not
+    // decoded. Decoded equality with keyIs() and decodeString().
+    const char *stringData() const { return mStr; }
+    fl::size stringLength() const { return mStrLen; }
+    bool keyIs(const char *str) const;
+    void decodeString(fl::string *out) const;
+
+    // For kNumber, kBool and kNull.
+    float asFloat() const { return float(mNumber); }
+    double asDouble() const { return mNumber; }
+    i32 asInt() const { return mInt; }
+    bool asBool() const { return mBool; }
+
+    // Nesting level after the current token, 0 at the top level.
+    int depth() const { return mDepth; }
+    // Offset of the current position, useful in error messages.
+    fl::size offset() const { return fl::size(mPos - mBegin); }
+
+  private:
+    Token fail();
+    Token value();
+    bool push(bool isObject);
+    bool scanString();
+    bool scanNumber();
+    bool literal(const char *word);
+    void skipSpace();
+    bool inObject() const { return mIsObject & (1u << (mDepth - 1)); }
+
+    const char *mBegin;
+    const char *mPos;
+    const char *mEnd;
+    const char *mStr = nullptr;
+    fl::size mStrLen = 0;
+    double mNumber = 0.0;
+    i32 mInt = 0;
+    bool mBool = false;
+    Token mToken = kNull;
+
+    u32 mHasItems = 0;
+    u32 mIsObject = 0;
+    u8 mDepth = 0;
+    bool mStarted = false;
+    bool mAfterKey = false;
+};
+
+namespace json_detail {
+
+// The number text JsonWriter writes for a finite, nonzero v, into out (at
+// least 32 chars). Wide is the type the digits are computed in, double or
+// long double; the writer uses long double when FASTLED_JSON_LONG_DOUBLE.
+template <typename Wide> void formatFloat(float v, char *out);
+template <typename Wide> void formatDouble(double v, char *out);
+
+} // namespace json_detail
+
+} // namespace fl
@@ -0,0 +1,283 @@
+#include <string.h>
+
+#define FASTLED_INTERNAL
+#include "FastLED.h"
+
+#include "fl/pixel_blend.h"
+
+#include "fl/force_inline.h"
+#include "fl/simd.h"
+#include "fl/unused.h"
+#include "lib8tion/math8.h"
+#include "lib8tion/scale8.h"
+
+// The batched paths below are derived from the FIXED variants of scale8 and
+// blend8, for any other configuration everything runs through blendChannel().
+#if (FASTLED_SCALE8_FIXED == 1) && (FASTLED_BLEND_FIXED == 1)
+#define FASTLED_PIXEL_BLEND_BATCHED 1
+#else
+#define FASTLED_PIXEL_BLEND_BATCHED 0
+#endif
+
+namespace fl {
+
+fl::u8 blendChannel(fl::u8 lower, fl::u8 upper, BlendMode mode,
+                    fl::u8 opacity) {
+    fl::u8 mixed = upper;
+    switch (mode) {
+    case BLEND_MODE_ALPHA:
+        mixed = upper;
+        break;
+    case BLEND_MODE_ADD:
+        mixed = qadd8(lower, upper);
+        break;
+    case BLEND_MODE_MULTIPLY:
+        mixed = scale8(lower, upper);
+        break;
+    case BLEND_MODE_SCREEN:
+        mixed = 255 - scale8(255 - lower, 255 - upper);
+        break;
+    case BLEND_MODE_MAX:
+        mixed = lower > upper ? lower : upper;
+        break;
+    }
+    if (opacity == 255) {
+        return mixed;
+    }
+    return blend8(lower, mixed, opacity);
+}
+
+namespace {
+
+void blendBytesScalar(fl::u8 *dst, const fl::u8 *src, fl::u32 n,
+                      BlendMode mode, fl::u8 opacity) {
+    for (fl::u32 i = 0; i < n; ++i) {
+        dst[i] = blendChannel(dst[i], src[i], mode, opacity);
+    }
+}
+
+#if FASTLED_PIXEL_BLEND_BATCHED && FASTLED_SIMD_SSE2
+
+// 16 channels per step. blend8 FIXED expands to
+// (lower * (256 - a) + upper * (a + 1)) >> 8 which never exceeds 16 bits.
+FASTLED_FORCE_INLINE __m128i mulHi8(__m128i a, __m128i b, __m128i bias) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(a, zero),
+                                 _mm_add_epi16(_mm_unpacklo_epi8(b, zero), bias));
+    __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(a, zero),
+                                 _mm_add_epi16(_mm_unpackhi_epi8(b, zero), bias));
+    return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+}
+
+FASTLED_FORCE_INLINE __m128i lerpSSE2(__m128i lower, __m128i upper,
+                                      __m128i wLower, __m128i wUpper) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_add_epi16(
+        _mm_mullo_epi16(_mm_unpacklo_epi8(lower, zero), wLower),
+        _mm_mullo_epi16(_mm_unpacklo_epi8(upper, zero), wUpper));
+    __m128i hi = _mm_add_epi16(
+        _mm_mullo_epi16(_mm_unpackhi_epi8(lower, zero), wLower),
+        _mm_mullo_epi16(_mm_unpackhi_epi8(upper, zero), wUpper));
+    return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+}
+
+fl::u32 blendBytesSIMD(fl::u8 *dst, const fl::u8 *src, fl::u32 n,
+                       BlendMode mode, fl::u8 opacity) {
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i ones = _mm_set1_epi8(-1);
+    const __m128i wLower = _mm_set1_epi16(256 - opacity);
+    const __m128i wUpper = _mm_set1_epi16(opacity + 1);
+    fl::u32 i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i m = s;
+        switch (mode) {
+        case BLEND_MODE_ALPHA:
+            break;
+        case BLEND_MODE_ADD:
+            m = _mm_adds_epu8(d, s);
+            break;
+        case BLEND_MODE_MULTIPLY:
+            m = mulHi8(d, s, one);
+            break;
+        case BLEND_MODE_SCREEN:
+            m = _mm_xor_si128(
+                mulHi8(_mm_xor_si128(d, ones), _mm_xor_si128(s, ones), one),
+                ones);
+            break;
+        case BLEND_MODE_MAX:
+            m = _mm_max_epu8(d, s);
+            break;
+        }
+        if (opacity != 255) {
+            m = lerpSSE2(d, m, wLower, wUpper);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), m);
+    }
+    return i;
+}
+
+#elif FASTLED_PIXEL_BLEND_BATCHED && FASTLED_SIMD_NEON
+
+FASTLED_FORCE_INLINE uint8x8_t mulHi8(uint8x8_t a, uint8x8_t b) {
+    // scale8 FIXED: (a * (b + 1)) >> 8 == (a * b + a) >> 8
+    return vshrn_n_u16(vaddw_u8(vmull_u8(a, b), a), 8);
+}
+
+FASTLED_FORCE_INLINE uint8x8_t lerpNEON(uint8x8_t lower, uint8x8_t upper,
+                                        uint8x8_t amount) {
+    // blend8 FIXED: ((lower << 8) | upper) + upper * a - lower * a
+    uint16x8_t acc = vaddw_u8(vshll_n_u8(lower, 8), upper);
+    acc = vmlal_u8(acc, upper, amount);
+    acc = vmlsl_u8(acc, lower, amount);
+    return vshrn_n_u16(acc, 8);
+}
+
+fl::u32 blendBytesSIMD(fl::u8 *dst, const fl::u8 *src, fl::u32 n,
+                       BlendMode mode, fl::u8 opacity) {
+    const uint8x8_t amount = vdup_n_u8(opacity);
+    fl::u32 i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint8x8_t d = vld1_u8(dst + i);
+        uint8x8_t s = vld1_u8(src + i);
+        uint8x8_t m = s;
+        switch (mode) {
+        case BLEND_MODE_ALPHA:
+            break;
+        case BLEND_MODE_ADD:
+            m = vqadd_u8(d, s);
+            break;
+        case BLEND_MODE_MULTIPLY:
+            m = mulHi8(d, s);
+            break;
+        case BLEND_MODE_SCREEN:
+            m = vmvn_u8(mulHi8(vmvn_u8(d), vmvn_u8(s)));
+            break;
+        case BLEND_MODE_MAX:
+            m = vmax_u8(d, s);
+            break;
+        }
+        if (opacity != 255) {
+            m = lerpNEON(d, m, amount);
+        }
+        vst1_u8(dst + i, m);
+    }
+    return i;
+}
+
+#elif FASTLED_PIXEL_BLEND_BATCHED && !defined(__AVR__)
+
+// Word packed fallback for 32 bit MCUs. Four channels are loaded into a u32,
+// add/alpha are done as SWAR and the cross fade uses two 16 bit lanes per
+// multiply since lower * (256 - a) + upper * (a + 1) fits in 16 bits.
+FASTLED_FORCE_INLINE fl::u32 qadd8x4(fl::u32 x, fl::u32 y) {
+    const fl::u32 kHigh = 0x80808080u;
+    fl::u32 low = (x & ~kHigh) + (y & ~kHigh);
+    fl::u32 sum = low ^ ((x ^ y) & kHigh);
+    fl::u32 carry = ((x & y) | ((x | y) & ~sum)) & kHigh;
+    return sum | ((carry >> 7) * 0xFFu);
+}
+
+FASTLED_FORCE_INLINE fl::u32 lerp8x4(fl::u32 lower, fl::u32 upper,
+                                     fl::u32 wLower, fl::u32 wUpper) {
+    const fl::u32 kEven = 0x00FF00FFu;
+    fl::u32 even = ((lower & kEven) * wLower + (upper & kEven) * wUpper) >> 8;
+    fl::u32 odd = ((lower >> 8) & kEven) * wLower +
+                  ((upper >> 8) & kEven) * wUpper;
+    return (even & kEven) | (odd & ~kEven);
+}
+
+fl::u32 blendBytesSIMD(fl::u8 *dst, const fl::u8 *src, fl::u32 n,
+                       BlendMode mode, fl::u8 opacity) {
+    const fl::u32 wLower = 256u - opacity;
+    const fl::u32 wUpper = opacity + 1u;
+    fl::u32 i = 0;
+    for (; i + 4 <= n; i += 4) {
+        fl::u32 d, s;
+        memcpy(&d, dst + i, 4);
+        memcpy(&s, src + i, 4);
+        fl::u32 m = s;
+        switch (mode) {
+        case BLEND_MODE_ALPHA:
+            break;
+        case BLEND_MODE_ADD:
+            m = qadd8x4(d, s);
+            break;
+        case BLEND_MODE_MULTIPLY:
+        case BLEND_MODE_SCREEN:
+        case BLEND_MODE_MAX: {
+            fl::u8 lanes[4];
+            for (int k = 0; k < 4; ++k) {
+                lanes[k] = blendChannel(dst[i + k], src[i + k], mode, 255);
+            }
+            memcpy(&m, lanes, 4);
+            break;
+        }
+        }
+        if (opacity != 255) {
+            m = lerp8x4(d, m, wLower, wUpper);
+        }
+        memcpy(dst + i, &m, 4);
+    }
+    return i;
+}
+
+#else
+
+fl::u32 blendBytesSIMD(fl::u8 *dst, const fl::u8 *src, fl::u32 n,
+                       BlendMode mode, fl::u8 opacity) {
+    FASTLED_UNUSED(dst);
+    FASTLED_UNUSED(src);
+    FASTLED_UNUSED(n);
+    FASTLED_UNUSED(mode);
+    FASTLED_UNUSED(opacity);
+    return 0;
+}
+
+#endif
+
+} // namespace
+
+void blendPixels(CRGB *dst, const CRGB *src, fl::u32 count, BlendMode mode,
+                 fl::u8 opacity) {
+    if (opacity == 0 || count == 0) {
+        return;
+    }
+    if (mode == BLEND_MODE_ALPHA && opacity == 255) {
+        memcpy(dst, src, sizeof(CRGB) * count);
+        return;
+    }
+    // All modes are channel independent so the pixels are treated as a flat
+    // byte array, which keeps the vector lanes full regardless of the 3 byte
+    // pixel stride.
+    fl::u8 *d = reinterpret_cast<fl::u8 *>(dst);
+    const fl::u8 *s = reinterpret_cast<const fl::u8 *>(src);
+    const fl::u32 n = count * 3;
+    fl::u32 done = blendBytesSIMD(d, s, n, mode, opacity);
+    blendBytesScalar(d + done, s + done, n - done, mode, opacity);
+}
+
+void compositeLayers(CRGB *out, const BlendLayer *layers, fl::size numLayers,
+                     fl::u32 numLeds) {
+    CRGB tile[FASTLED_BLEND_TILE_PIXELS];
+    for (fl::u32 start = 0; start < numLeds;
+         start += FASTLED_BLEND_TILE_PIXELS) {
+        fl::u32 n = numLeds - start;
+        if (n > FASTLED_BLEND_TILE_PIXELS) {
+            n = FASTLED_BLEND_TILE_PIXELS;
+        }
+        memset(static_cast<void *>(tile), 0, sizeof(CRGB) * n);
+        for (fl::size i = 0; i < numLayers; ++i) {
+            const BlendLayer &layer = layers[i];
+            if (!layer.pixels) {
+                continue;
+            }
+            blendPixels(tile, layer.pixels + start, n, layer.mode,
+                        layer.opacity);
+        }
+        memcpy(static_cast<void *>(out + start), tile, sizeof(CRGB) * n);
+    }
+}
+
+} // namespace fl
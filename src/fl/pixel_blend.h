@@ -0,0 +1,49 @@
+#pragma once
+
+#include "crgb.h"
+#include "fl/int.h"
+#include "fl/stdint.h"
+
+namespace fl {
+
+// How a layer is combined with the pixels underneath it. Every mode works
+// per channel and the result is then cross faded against the lower pixel by
+// the layer opacity, so opacity 255 applies the mode fully and 0 is a no-op.
+enum BlendMode {
+    BLEND_MODE_ALPHA,    // upper replaces lower (classic CRGB::blend).
+    BLEND_MODE_ADD,      // saturating add, qadd8(lower, upper).
+    BLEND_MODE_MULTIPLY, // scale8(lower, upper), darkens.
+    BLEND_MODE_SCREEN,   // inverse multiply of the inverses, lightens.
+    BLEND_MODE_MAX       // per channel max.
+};
+
+// A source buffer plus how it should be blended onto what is below it.
+struct BlendLayer {
+    const CRGB *pixels = nullptr;
+    BlendMode mode = BLEND_MODE_ALPHA;
+    fl::u8 opacity = 255;
+};
+
+// Number of pixels processed per tile by compositeLayers(). The tile is small
+// enough to live on the stack and stay in L1 while every layer is applied.
+#ifndef FASTLED_BLEND_TILE_PIXELS
+#define FASTLED_BLEND_TILE_PIXELS 16
+#endif
+
+// Blends one channel value, this is the reference the batched kernels must
+// match bit for bit.
+fl::u8 blendChannel(fl::u8 lower, fl::u8 upper, BlendMode mode,
+                    fl::u8 opacity);
+
+// dst[i] = blend(dst[i], src[i]) for count pixels. Uses SSE2/NEON when
+// available and a word packed path on MCUs.
+void blendPixels(CRGB *dst, const CRGB *src, fl::u32 count, BlendMode mode,
+                 fl::u8 opacity);
+
+// Composites numLayers layers bottom to top into out, which starts out black.
+// The work is done tile by tile so that the output is only written once per
+// frame no matter how many layers are stacked.
+void compositeLayers(CRGB *out, const BlendLayer *layers, fl::size numLayers,
+                     fl::u32 numLeds);
+
+} // namespace fl
@@ -0,0 +1,162 @@
+#include "fl/pixel_encode.h"
+
+#include "fl/force_inline.h"
+#include "fl/simd.h"
+#include "lib8tion/math8.h"
+#include "lib8tion/scale8.h"
+
+// The vector kernels reproduce the C versions of qadd8 and scale8. The bias
+// turns x * s >> 8 into the FIXED variant x * (s + 1) >> 8.
+#if (FASTLED_SCALE8_FIXED == 1)
+#define FASTLED_PIXEL_ENCODE_SCALE_BIAS 1
+#else
+#define FASTLED_PIXEL_ENCODE_SCALE_BIAS 0
+#endif
+
+namespace fl {
+
+namespace {
+
+FASTLED_FORCE_INLINE fl::u8 ditherScale(fl::u8 b, fl::u8 d, fl::u8 s) {
+    return scale8(b ? qadd8(b, d) : 0, s);
+}
+
+#if FASTLED_SIMD_SSE2
+
+// 48 bytes per step, the smallest multiple of 16 the 6 byte pattern fits.
+FASTLED_FORCE_INLINE __m128i ditherScaleSSE2(__m128i b, __m128i d, __m128i s) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(FASTLED_PIXEL_ENCODE_SCALE_BIAS);
+    __m128i x = _mm_andnot_si128(_mm_cmpeq_epi8(b, zero), _mm_adds_epu8(b, d));
+    __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(x, zero),
+                                 _mm_add_epi16(_mm_unpacklo_epi8(s, zero), bias));
+    __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(x, zero),
+                                 _mm_add_epi16(_mm_unpackhi_epi8(s, zero), bias));
+    return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+}
+
+fl::u32 ditherScaleSIMD(fl::u8 *buf, fl::u32 n, const fl::u8 *dither,
+                        const fl::u8 *scale) {
+    fl::u8 dPattern[48];
+    fl::u8 sPattern[48];
+    for (int i = 0; i < 48; ++i) {
+        dPattern[i] = dither[i % kPixelEncodePatternBytes];
+        sPattern[i] = scale[i % kPixelEncodePatternBytes];
+    }
+    const __m128i d0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dPattern));
+    const __m128i d1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dPattern + 16));
+    const __m128i d2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dPattern + 32));
+    const __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sPattern));
+    const __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sPattern + 16));
+    const __m128i s2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sPattern + 32));
+    fl::u32 i = 0;
+    for (; i + 48 <= n; i += 48) {
+        __m128i *p = reinterpret_cast<__m128i *>(buf + i);
+        __m128i b0 = _mm_loadu_si128(p);
+        __m128i b1 = _mm_loadu_si128(p + 1);
+        __m128i b2 = _mm_loadu_si128(p + 2);
+        _mm_storeu_si128(p, ditherScaleSSE2(b0, d0, s0));
+        _mm_storeu_si128(p + 1, ditherScaleSSE2(b1, d1, s1));
+        _mm_storeu_si128(p + 2, ditherScaleSSE2(b2, d2, s2));
+    }
+    return i;
+}
+
+#elif FASTLED_SIMD_NEON
+
+// 24 bytes per step, three 8 lane vectors cover the 6 byte pattern.
+FASTLED_FORCE_INLINE uint8x8_t ditherScaleNEON(uint8x8_t b, uint8x8_t d,
+                                               uint8x8_t s) {
+    uint8x8_t x = vbic_u8(vqadd_u8(b, d), vceq_u8(b, vdup_n_u8(0)));
+    uint16x8_t prod = vmull_u8(x, s);
+#if FASTLED_PIXEL_ENCODE_SCALE_BIAS
+    prod = vaddw_u8(prod, x);
+#endif
+    return vshrn_n_u16(prod, 8);
+}
+
+fl::u32 ditherScaleSIMD(fl::u8 *buf, fl::u32 n, const fl::u8 *dither,
+                        const fl::u8 *scale) {
+    fl::u8 dPattern[24];
+    fl::u8 sPattern[24];
+    for (int i = 0; i < 24; ++i) {
+        dPattern[i] = dither[i % kPixelEncodePatternBytes];
+        sPattern[i] = scale[i % kPixelEncodePatternBytes];
+    }
+    const uint8x8_t d0 = vld1_u8(dPattern);
+    const uint8x8_t d1 = vld1_u8(dPattern + 8);
+    const uint8x8_t d2 = vld1_u8(dPattern + 16);
+    const uint8x8_t s0 = vld1_u8(sPattern);
+    const uint8x8_t s1 = vld1_u8(sPattern + 8);
+    const uint8x8_t s2 = vld1_u8(sPattern + 16);
+    fl::u32 i = 0;
+    for (; i + 24 <= n; i += 24) {
+        fl::u8 *p = buf + i;
+        uint8x8_t b0 = vld1_u8(p);
+        uint8x8_t b1 = vld1_u8(p + 8);
+        uint8x8_t b2 = vld1_u8(p + 16);
+        vst1_u8(p, ditherScaleNEON(b0, d0, s0));
+        vst1_u8(p + 8, ditherScaleNEON(b1, d1, s1));
+        vst1_u8(p + 16, ditherScaleNEON(b2, d2, s2));
+    }
+    return i;
+}
+
+#endif
+
+} // namespace
+
+void encodePixelBytes(fl::u8 *out, const fl::u8 *in, fl::u32 numPixels,
+                      int stride, const fl::u8 order[3],
+                      const fl::u8 dither[kPixelEncodePatternBytes],
+                      const fl::u8 scale[kPixelEncodePatternBytes]) {
+    const fl::u32 n = numPixels * 3;
+    // Byte stores may alias any byte array, so keep the tables in locals or
+    // the compiler reloads them after every write.
+    const fl::u8 o0 = order[0], o1 = order[1], o2 = order[2];
+#if FASTLED_HAS_SIMD
+    // Reorder into the output first, then dither and scale the flat bytes.
+    // The SIMD step is a multiple of the pattern length, so the scalar tail
+    // starts at pattern offset 0 again.
+    fl::u8 *dst = out;
+    for (fl::u32 p = 0; p < numPixels; ++p) {
+        dst[0] = in[o0];
+        dst[1] = in[o1];
+        dst[2] = in[o2];
+        dst += 3;
+        in += stride;
+    }
+    fl::u32 i = ditherScaleSIMD(out, n, dither, scale);
+    for (int k = 0; i < n; ++i) {
+        out[i] = ditherScale(out[i], dither[k], scale[k]);
+        if (++k == kPixelEncodePatternBytes) {
+            k = 0;
+        }
+    }
+#else
+    // Without vector units a second pass over the output costs more than it
+    // saves, so everything is done in a single pass, two pixels at a time.
+    const fl::u8 d0 = dither[0], d1 = dither[1], d2 = dither[2];
+    const fl::u8 d3 = dither[3], d4 = dither[4], d5 = dither[5];
+    const fl::u8 s0 = scale[0], s1 = scale[1], s2 = scale[2];
+    const fl::u8 s3 = scale[3], s4 = scale[4], s5 = scale[5];
+    fl::u32 i = 0;
+    for (; i + 6 <= n; i += 6) {
+        const fl::u8 *next = in + stride;
+        out[i] = ditherScale(in[o0], d0, s0);
+        out[i + 1] = ditherScale(in[o1], d1, s1);
+        out[i + 2] = ditherScale(in[o2], d2, s2);
+        out[i + 3] = ditherScale(next[o0], d3, s3);
+        out[i + 4] = ditherScale(next[o1], d4, s4);
+        out[i + 5] = ditherScale(next[o2], d5, s5);
+        in = next + stride;
+    }
+    if (i < n) {
+        out[i] = ditherScale(in[o0], d0, s0);
+        out[i + 1] = ditherScale(in[o1], d1, s1);
+        out[i + 2] = ditherScale(in[o2], d2, s2);
+    }
+#endif
+}
+
+} // namespace fl
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "fl/int.h"
+#include "fl/stdint.h"
+
+namespace fl {
+
+// Number of output bytes after which the per byte dither and scale pattern
+// used by PixelController repeats: two pixels, since the dither flips between
+// d and e - d on every pixel.
+enum { kPixelEncodePatternBytes = 6 };
+
+// Batch form of the PixelController loadAndScale<SLOT>() loop: numPixels
+// pixels are read stride bytes apart, reordered so that output byte k of a
+// pixel is input byte order[k], then dithered and scaled per byte:
+//   out[i] = scale8(b ? qadd8(b, dither[i % 6]) : 0, scale[i % 6])
+// Uses SSE2/NEON when available and is bit exact with the per byte path.
+void encodePixelBytes(fl::u8 *out, const fl::u8 *in, fl::u32 numPixels,
+                      int stride, const fl::u8 order[3],
+                      const fl::u8 dither[kPixelEncodePatternBytes],
+                      const fl::u8 scale[kPixelEncodePatternBytes]);
+
+} // namespace fl
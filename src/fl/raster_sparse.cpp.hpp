@@ -1,5 +1,7 @@
 #include "fl/stdint.h"
 
+#include <string.h>
+
 #include "fl/draw_visitor.h"
 #include "fl/leds.h"
 #include "fl/raster_sparse.h"
@@ -7,6 +9,185 @@
 
 namespace fl {
 
+namespace {
+// A footprint goes dense once at least 1 in this many of its pixels is set.
+const fl::size kDenseCoverage = 8;
+} // namespace
+
+XYRasterU8Sparse &XYRasterU8Sparse::reset() {
+    mSparseGrid.clear();
+    mCache.clear();
+    if (mAbsoluteBoundsSet && mDenseBounds == mAbsoluteBounds) {
+        if (mDenseCount) {
+            memset(mDense.data(), 0, mDense.size());
+            memset(mDenseSet.data(), 0, mDenseSet.size() * sizeof(u32));
+        }
+    } else {
+        // The footprint of the next frame may be elsewhere, start over but
+        // keep the capacity.
+        mDense.clear();
+        mDenseSet.clear();
+        mDenseBounds = rect<i16>(0, 0, 0, 0);
+    }
+    mDenseCount = 0;
+    mNextDensityCheck = FASTLED_RASTER_SPARSE_DENSE_MIN_PIXELS;
+    return *this;
+}
+
+void XYRasterU8Sparse::setBounds(const rect<i16> &bounds) {
+    mAbsoluteBounds = bounds;
+    mAbsoluteBoundsSet = true;
+    if (bounds == mDenseBounds && !mDense.empty()) {
+        return;
+    }
+    const fl::size area = fl::size(bounds.width()) * bounds.height();
+    if (area > 0 && area <= FASTLED_RASTER_SPARSE_DENSE_MAX_CELLS) {
+        makeDense(bounds);
+    }
+}
+
+rect<i16> XYRasterU8Sparse::bounds_pixels() const {
+    int min_x = 0;
+    bool min_x_set = false;
+    int min_y = 0;
+    bool min_y_set = false;
+    int max_x = 0;
+    bool max_x_set = false;
+    int max_y = 0;
+    bool max_y_set = false;
+    for (const auto &it : *this) {
+        const vec2<i16> &pt = it.first;
+        if (!min_x_set || pt.x < min_x) {
+            min_x = pt.x;
+            min_x_set = true;
+        }
+        if (!min_y_set || pt.y < min_y) {
+            min_y = pt.y;
+            min_y_set = true;
+        }
+        if (!max_x_set || pt.x > max_x) {
+            max_x = pt.x;
+            max_x_set = true;
+        }
+        if (!max_y_set || pt.y > max_y) {
+            max_y = pt.y;
+            max_y_set = true;
+        }
+    }
+    return rect<i16>(min_x, min_y, max_x + 1, max_y + 1);
+}
+
+void XYRasterU8Sparse::goDenseIfCovered() {
+    mNextDensityCheck = size() * 2;
+    if (mAbsoluteBoundsSet && mDenseBounds == mAbsoluteBounds &&
+        !mDense.empty()) {
+        return;
+    }
+    const rect<i16> footprint = bounds_pixels();
+    const fl::size area = fl::size(footprint.width()) * footprint.height();
+    if (area <= FASTLED_RASTER_SPARSE_DENSE_MAX_CELLS &&
+        area <= size() * kDenseCoverage) {
+        makeDense(footprint);
+    }
+}
+
+void XYRasterU8Sparse::makeDense(const rect<i16> &bounds) {
+    // Cells of the old dense grid that fall outside of the new one go to the
+    // hash map with the rest.
+    fl::vector<pair<vec2<i16>, u8>> moved;
+    const i16 oldWidth = mDenseBounds.width();
+    for (fl::size i = 0; i < mDense.size(); ++i) {
+        if (denseSet(i)) {
+            const vec2<i16> pt(mDenseBounds.mMin.x + i16(i % oldWidth),
+                               mDenseBounds.mMin.y + i16(i / oldWidth));
+            moved.push_back(pair<vec2<i16>, u8>(pt, mDense[i]));
+        }
+    }
+    for (const auto &it : mSparseGrid) {
+        moved.push_back(pair<vec2<i16>, u8>(it.first, it.second));
+    }
+    mSparseGrid.clear();
+    mCache.clear();
+
+    mDenseBounds = bounds;
+    const fl::size cells = fl::size(bounds.width()) * bounds.height();
+    mDense.clear();
+    mDense.resize(cells, 0);
+    mDenseSet.clear();
+    mDenseSet.resize((cells + 31) / 32, 0);
+    mDenseCount = 0;
+    for (const auto &it : moved) {
+        if (bounds.contains(it.first)) {
+            const fl::size cell = denseIndex(it.first);
+            mDense[cell] = it.second;
+            mDenseSet[cell >> 5] |= u32(1) << (cell & 31);
+            ++mDenseCount;
+        } else {
+            mSparseGrid.insert(it.first, it.second);
+        }
+    }
+}
+
+fl::size XYRasterU8Sparse::nextDenseCell(fl::size cell) const {
+    const fl::size end = mDense.size();
+    while (cell < end) {
+        const u32 bits = mDenseSet[cell >> 5] >> (cell & 31);
+        if (bits) {
+            return cell + __builtin_ctz(bits);
+        }
+        cell = (cell | 31) + 1;
+    }
+    return end;
+}
+
+XYRasterU8Sparse::const_iterator::value_type
+XYRasterU8Sparse::const_iterator::operator*() const {
+    if (mCell < mRaster->mDense.size()) {
+        const rect<i16> &b = mRaster->mDenseBounds;
+        const i16 w = b.width();
+        return value_type(vec2<i16>(b.mMin.x + i16(mCell % w),
+                                    b.mMin.y + i16(mCell / w)),
+                          mRaster->mDense[mCell]);
+    }
+    const auto entry = *mSparse;
+    return value_type(entry.first, entry.second);
+}
+
+XYRasterU8Sparse::const_iterator &
+XYRasterU8Sparse::const_iterator::operator++() {
+    if (mCell < mRaster->mDense.size()) {
+        mCell = mRaster->nextDenseCell(mCell + 1);
+    } else {
+        ++mSparse;
+    }
+    return *this;
+}
+
+XYRasterU8Sparse::iterator::Entry &
+XYRasterU8Sparse::iterator::operator*() const {
+    Entry *entry;
+    if (mCell < mRaster->mDense.size()) {
+        const rect<i16> &b = mRaster->mDenseBounds;
+        const i16 w = b.width();
+        const vec2<i16> pt(b.mMin.x + i16(mCell % w),
+                           b.mMin.y + i16(mCell / w));
+        entry = new (mEntry) Entry{pt, mRaster->mDense[mCell]};
+    } else {
+        const vec2<i16> pt = (*mSparse).first;
+        entry = new (mEntry) Entry{pt, *mRaster->mSparseGrid.find_value(pt)};
+    }
+    return *entry;
+}
+
+XYRasterU8Sparse::iterator &XYRasterU8Sparse::iterator::operator++() {
+    if (mCell < mRaster->mDense.size()) {
+        mCell = mRaster->nextDenseCell(mCell + 1);
+    } else {
+        ++mSparse;
+    }
+    return *this;
+}
+
 void XYRasterU8Sparse::draw(const CRGB &color, const XYMap &xymap, CRGB *out) {
     XYDrawComposited visitor(color, xymap, out);
     draw(xymap, visitor);
@@ -13,10 +13,12 @@ only a small number of pixels are set.
 #include "fl/geometry.h"
 #include "fl/grid.h"
 #include "fl/hash_map.h"
+#include "fl/inplacenew.h"
 #include "fl/map.h"
 #include "fl/namespace.h"
 #include "fl/span.h"
 #include "fl/tile2x2.h"
+#include "fl/vector.h"
 #include "fl/xymap.h"
 
 FASTLED_NAMESPACE_BEGIN
@@ -27,6 +29,17 @@ FASTLED_NAMESPACE_END
 #define FASTLED_RASTER_SPARSE_INLINED_COUNT 128
 #endif
 
+// Largest area, in pixels, that XYRasterU8Sparse keeps as a dense u8 grid.
+#ifndef FASTLED_RASTER_SPARSE_DENSE_MAX_CELLS
+#define FASTLED_RASTER_SPARSE_DENSE_MAX_CELLS 16384
+#endif
+
+// Without bounds, the footprint is first checked for density once this many
+// pixels have been written, and again every time the count doubles.
+#ifndef FASTLED_RASTER_SPARSE_DENSE_MIN_PIXELS
+#define FASTLED_RASTER_SPARSE_DENSE_MIN_PIXELS 64
+#endif
+
 namespace fl {
 
 class XYMap;
@@ -36,7 +49,24 @@ class Leds;
 
 // A raster of u8 values. This is a sparse raster, meaning that it will
 // only store the values that are set.
+//
+// Pixels inside a dense region are kept in a plain row major u8 grid instead
+// of the hash map, which is much cheaper for the thousands of overlapping
+// Tile2x2_u8 splats a path produces. The dense region is the bounds given to
+// setBounds() / setSize(), or, without bounds, the footprint of the pixels
+// written so far once they cover it densely enough. Pixels outside of it
+// still go to the hash map. Dense occupancy is tracked in a bitmask, so a
+// pixel written with 0 counts as written in both.
 class XYRasterU8Sparse {
+  private:
+    using Key = vec2<i16>;
+    using Value = u8;
+    using HashKey = Hash<Key>;
+    using EqualToKey = EqualTo<Key>;
+    using FastHashKey = FastHash<Key>;
+    using HashMapLarge = fl::HashMap<Key, Value, HashKey, EqualToKey,
+                                     FASTLED_HASHMAP_INLINED_COUNT>;
+
   public:
     XYRasterU8Sparse() = default;
     XYRasterU8Sparse(int width, int height) {
@@ -47,11 +77,8 @@ class XYRasterU8Sparse {
     XYRasterU8Sparse(XYRasterU8Sparse &&) = default;
     XYRasterU8Sparse &operator=(XYRasterU8Sparse &) = default;
 
-    XYRasterU8Sparse &reset() {
-        mSparseGrid.clear();
-        mCache.clear();
-        return *this;
-    }
+    // Keeps the dense grid allocated, only its contents are cleared.
+    XYRasterU8Sparse &reset();
 
     XYRasterU8Sparse &clear() { return reset(); }
 
@@ -69,20 +96,81 @@ class XYRasterU8Sparse {
         setBounds(rect<i16>(0, 0, width, height));
     }
 
-    void setBounds(const rect<i16> &bounds) {
-        mAbsoluteBounds = bounds;
-        mAbsoluteBoundsSet = true;
-    }
+    // Bounds of at most FASTLED_RASTER_SPARSE_DENSE_MAX_CELLS pixels become
+    // the dense region, pixels already written inside move over to it.
+    void setBounds(const rect<i16> &bounds);
+
+    // Back to the pixel footprint for bounds(). The dense grid is kept until
+    // the next reset().
+    void clearBounds() { mAbsoluteBoundsSet = false; }
+
+    // Visits the dense region in memory order, then the sparse pixels.
+    class const_iterator {
+      public:
+        using value_type = pair<vec2<i16>, u8>;
+        const_iterator(const XYRasterU8Sparse *raster, fl::size cell,
+                       HashMapLarge::const_iterator sparse)
+            : mRaster(raster), mCell(raster->nextDenseCell(cell)),
+              mSparse(sparse) {}
+        value_type operator*() const;
+        const_iterator &operator++();
+        bool operator==(const const_iterator &other) const {
+            return mCell == other.mCell && mSparse == other.mSparse;
+        }
+        bool operator!=(const const_iterator &other) const {
+            return !(*this == other);
+        }
 
-    using iterator = fl::HashMap<vec2<i16>, u8>::iterator;
-    using const_iterator = fl::HashMap<vec2<i16>, u8>::const_iterator;
+      private:
+        const XYRasterU8Sparse *mRaster;
+        fl::size mCell; // Index into the dense grid, its size once done.
+        HashMapLarge::const_iterator mSparse;
+    };
+
+    // Same order as const_iterator, second refers to the stored value:
+    //   for (auto &it : raster) { it.second = scale8(it.second, 128); }
+    class iterator {
+      public:
+        struct Entry {
+            vec2<i16> first;
+            u8 &second;
+        };
+        using value_type = Entry;
+        iterator(XYRasterU8Sparse *raster, fl::size cell,
+                 HashMapLarge::iterator sparse)
+            : mRaster(raster), mCell(raster->nextDenseCell(cell)),
+              mSparse(sparse) {}
+        Entry &operator*() const;
+        Entry *operator->() const { return &operator*(); }
+        iterator &operator++();
+        bool operator==(const iterator &other) const {
+            return mCell == other.mCell && mSparse == other.mSparse;
+        }
+        bool operator!=(const iterator &other) const {
+            return !(*this == other);
+        }
 
-    iterator begin() { return mSparseGrid.begin(); }
-    const_iterator begin() const { return mSparseGrid.begin(); }
-    iterator end() { return mSparseGrid.end(); }
-    const_iterator end() const { return mSparseGrid.end(); }
-    fl::size size() const { return mSparseGrid.size(); }
-    bool empty() const { return mSparseGrid.empty(); }
+      private:
+        XYRasterU8Sparse *mRaster;
+        fl::size mCell;
+        HashMapLarge::iterator mSparse;
+        // Entry holds a reference, so it is rebuilt in place on every
+        // dereference.
+        alignas(Entry) mutable char mEntry[sizeof(Entry)];
+    };
+
+    iterator begin() { return iterator(this, 0, mSparseGrid.begin()); }
+    iterator end() {
+        return iterator(this, mDense.size(), mSparseGrid.end());
+    }
+    const_iterator begin() const {
+        return const_iterator(this, 0, mSparseGrid.begin());
+    }
+    const_iterator end() const {
+        return const_iterator(this, mDense.size(), mSparseGrid.end());
+    }
+    fl::size size() const { return mDenseCount + mSparseGrid.size(); }
+    bool empty() const { return size() == 0; }
 
     void rasterize(const span<const Tile2x2_u8> &tiles);
     void rasterize(const Tile2x2_u8 &tile) { rasterize_internal(tile); }
@@ -98,7 +186,12 @@ class XYRasterU8Sparse {
     // y); }
 
     pair<bool, u8> at(u16 x, u16 y) const {
-        const u8 *val = mSparseGrid.find_value(vec2<i16>(x, y));
+        const vec2<i16> pt(x, y);
+        if (!mDense.empty() && mDenseBounds.contains(pt)) {
+            const fl::size cell = denseIndex(pt);
+            return {denseSet(cell), mDense[cell]};
+        }
+        const u8 *val = mSparseGrid.find_value(pt);
         if (val != nullptr) {
             return {true, *val};
         }
@@ -112,41 +205,16 @@ class XYRasterU8Sparse {
         return bounds_pixels();
     }
 
-    rect<i16> bounds_pixels() const {
-        int min_x = 0;
-        bool min_x_set = false;
-        int min_y = 0;
-        bool min_y_set = false;
-        int max_x = 0;
-        bool max_x_set = false;
-        int max_y = 0;
-        bool max_y_set = false;
-        for (const auto &it : mSparseGrid) {
-            const vec2<i16> &pt = it.first;
-            if (!min_x_set || pt.x < min_x) {
-                min_x = pt.x;
-                min_x_set = true;
-            }
-            if (!min_y_set || pt.y < min_y) {
-                min_y = pt.y;
-                min_y_set = true;
-            }
-            if (!max_x_set || pt.x > max_x) {
-                max_x = pt.x;
-                max_x_set = true;
-            }
-            if (!max_y_set || pt.y > max_y) {
-                max_y = pt.y;
-                max_y_set = true;
-            }
-        }
-        return rect<i16>(min_x, min_y, max_x + 1, max_y + 1);
-    }
+    rect<i16> bounds_pixels() const;
 
     // Warning! - SLOW.
     u16 width() const { return bounds().width(); }
     u16 height() const { return bounds().height(); }
 
+    // True while pixels inside denseBounds() bypass the hash map.
+    bool isDense() const { return !mDense.empty(); }
+    const rect<i16> &denseBounds() const { return mDenseBounds; }
+
     void draw(const CRGB &color, const XYMap &xymap, CRGB *out);
     void draw(const CRGB &color, Leds *leds);
 
@@ -157,6 +225,25 @@ class XYRasterU8Sparse {
     // pixels that are within the bounds of the XYMap.
     template <typename XYVisitor>
     void draw(const XYMap &xymap, XYVisitor &visitor) {
+        if (mDenseCount) {
+            const i16 w = mDenseBounds.width();
+            const i16 h = mDenseBounds.height();
+            const u8 *cell = mDense.data();
+            for (i16 y = 0; y < h; ++y) {
+                const i16 yy = mDenseBounds.mMin.y + y;
+                for (i16 x = 0; x < w; ++x, ++cell) {
+                    const u8 value = *cell;
+                    if (!value) { // Unwritten, or written with 0.
+                        continue;
+                    }
+                    const i16 xx = mDenseBounds.mMin.x + x;
+                    if (!xymap.has(xx, yy)) {
+                        continue;
+                    }
+                    visitor.draw(vec2<i16>(xx, yy), xymap(xx, yy), value);
+                }
+            }
+        }
         for (const auto &it : mSparseGrid) {
             auto pt = it.first;
             if (!xymap.has(pt.x, pt.y)) {
@@ -176,6 +263,19 @@ class XYRasterU8Sparse {
         // FASTLED_WARN("write: " << pt.x << "," << pt.y << " value: " <<
         // value); mSparseGrid.insert(pt, value);
 
+        if (!mDense.empty() && mDenseBounds.contains(pt)) {
+            const fl::size index = denseIndex(pt);
+            u8 &cell = mDense[index];
+            if (!denseSet(index)) {
+                mDenseSet[index >> 5] |= u32(1) << (index & 31);
+                ++mDenseCount;
+                cell = value;
+            } else if (cell < value) {
+                cell = value;
+            }
+            return;
+        }
+
         u8 **cached = mCache.find_value(pt);
         if (cached) {
             u8 *val = *cached;
@@ -197,6 +297,7 @@ class XYRasterU8Sparse {
                 }
 
                 mSparseGrid.insert(pt, value);
+                checkDensity();
                 return;
             }
             mCache.insert(pt, v);
@@ -207,23 +308,51 @@ class XYRasterU8Sparse {
         } else {
             // overflow, clear cache and write directly.
             mCache.clear();
+            u8 *v = mSparseGrid.find_value(pt);
+            if (v != nullptr) {
+                if (*v < value) {
+                    *v = value;
+                }
+                return;
+            }
             mSparseGrid.insert(pt, value);
+            checkDensity();
             return;
         }
     }
 
   private:
-    using Key = vec2<i16>;
-    using Value = u8;
-    using HashKey = Hash<Key>;
-    using EqualToKey = EqualTo<Key>;
-    using FastHashKey = FastHash<Key>;
-    using HashMapLarge = fl::HashMap<Key, Value, HashKey, EqualToKey,
-                                     FASTLED_HASHMAP_INLINED_COUNT>;
+    bool denseSet(fl::size cell) const {
+        return (mDenseSet[cell >> 5] >> (cell & 31)) & 1;
+    }
+    // First written cell at or after cell, mDense.size() if there is none.
+    fl::size nextDenseCell(fl::size cell) const;
+
+    fl::size denseIndex(const vec2<i16> &pt) const {
+        return fl::size(pt.y - mDenseBounds.mMin.y) * mDenseBounds.width() +
+               fl::size(pt.x - mDenseBounds.mMin.x);
+    }
+
+    // Without fixed bounds, switches to a dense grid over the pixel
+    // footprint once it is small and filled well enough.
+    void checkDensity() {
+        if (size() >= mNextDensityCheck) {
+            goDenseIfCovered();
+        }
+    }
+    void goDenseIfCovered();
+    // Moves the sparse pixels inside bounds into a fresh dense grid.
+    void makeDense(const rect<i16> &bounds);
+
     HashMapLarge mSparseGrid;
     // Small cache for the last N writes to help performance.
     HashMap<vec2<i16>, u8 *, FastHashKey, EqualToKey, kMaxCacheSize>
         mCache;
+    fl::vector<u8> mDense; // Row major over mDenseBounds, empty if unused.
+    fl::vector<u32> mDenseSet; // One bit per written cell of mDense.
+    rect<i16> mDenseBounds = rect<i16>(0, 0, 0, 0);
+    fl::size mDenseCount = 0; // Written cells in mDense.
+    fl::size mNextDensityCheck = FASTLED_RASTER_SPARSE_DENSE_MIN_PIXELS;
     fl::rect<i16> mAbsoluteBounds;
     bool mAbsoluteBoundsSet = false;
 };
@@ -0,0 +1,191 @@
+#include "fl/resampler.h"
+
+#include "fl/assert.h"
+#include "fl/force_inline.h"
+#include "fl/grid.h"
+#include "fl/math.h"
+#include "fl/screenmap.h"
+
+namespace fl {
+
+namespace {
+
+// Canvas index and weight share a u32, 23 bits are plenty for a canvas.
+const u32 kWeightBits = 9;
+const u32 kWeightMask = (1u << kWeightBits) - 1;
+const u32 kMaxCanvasPixels = 1u << (32 - kWeightBits);
+
+// The taps of one LED at canvas position (x, y) into taps, returns how many
+// there are.
+u8 computeTaps(float x, float y, u16 width, u16 height, bool wrapX,
+               u32 taps[4]) {
+    // Also rejects NaN.
+    if (!(fabsf(x) < 1e6f) || !(fabsf(y) < 1e6f)) {
+        return 0;
+    }
+    const float x0 = floorf(x);
+    const float y0 = floorf(y);
+    const float fx = x - x0;
+    const float fy = y - y0;
+    const float corner[4] = {(1 - fx) * (1 - fy), fx * (1 - fy),
+                             (1 - fx) * fy, fx * fy};
+
+    u32 index[4];
+    float weight[4];
+    int n = 0;
+    float total = 0;
+    for (int k = 0; k < 4; ++k) {
+        i32 cx = i32(x0) + (k & 1);
+        const i32 cy = i32(y0) + (k >> 1);
+        if (wrapX && width) {
+            cx %= i32(width);
+            cx += cx < 0 ? i32(width) : 0;
+        }
+        if (corner[k] <= 0 || cx < 0 || cx >= i32(width) || cy < 0 ||
+            cy >= i32(height)) {
+            continue;
+        }
+        index[n] = u32(cy) * width + u32(cx);
+        weight[n] = corner[k];
+        total += corner[k];
+        ++n;
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    // Round to 8 bit fractions of the taps that are left and give the
+    // rounding error to the heaviest, so that they sum to exactly 256.
+    u32 q[4];
+    u32 sum = 0;
+    int heaviest = 0;
+    for (int k = 0; k < n; ++k) {
+        q[k] = u32(weight[k] / total * 256 + 0.5f);
+        sum += q[k];
+        if (weight[k] > weight[heaviest]) {
+            heaviest = k;
+        }
+    }
+    q[heaviest] += 256 - sum;
+    u8 count = 0;
+    for (int k = 0; k < n; ++k) {
+        if (q[k]) {
+            taps[count++] = index[k] << kWeightBits | q[k];
+        }
+    }
+    return count;
+}
+
+// Weighted sum of the canvas pixels of count taps. Red and blue are summed
+// as two 16 bit fields of one u32: every channel times weights that sum to
+// 256, plus the rounding, stays below 65536.
+FASTLED_FORCE_INLINE CRGB gather(const CRGB *canvas, const u32 *tap,
+                                 u8 count) {
+    u32 rb = 0x00800080;
+    u32 g = 0x80;
+    for (; count; --count, ++tap) {
+        const CRGB &c = canvas[*tap >> kWeightBits];
+        const u32 w = *tap & kWeightMask;
+        rb += (c.r | (u32(c.b) << 16)) * w;
+        g += c.g * w;
+    }
+    return CRGB(u8(rb >> 8), u8(g >> 8), u8(rb >> 24));
+}
+
+} // namespace
+
+CanvasResampler::CanvasResampler(const ScreenMap &map, u16 width, u16 height,
+                                 bool wrapX) {
+    build(map, width, height, wrapX);
+}
+
+void CanvasResampler::build(const ScreenMap &map, u16 width, u16 height,
+                            bool wrapX) {
+    build(map, width, height, wrapX, 1.0f, vec2f(0, 0), vec2f(0, 0));
+}
+
+void CanvasResampler::build(const ScreenMap &map, u16 width, u16 height,
+                            bool wrapX, float scale, vec2f origin,
+                            vec2f offset) {
+    FASTLED_ASSERT(u32(width) * height < kMaxCanvasPixels,
+                   "CanvasResampler canvas too large: " << width << "x"
+                                                        << height);
+    mWidth = width;
+    mHeight = height;
+    const u32 n = map.getLength();
+    mTaps.clear();
+    mTapCount.clear();
+    mTaps.reserve(n * 4);
+    mTapCount.reserve(n);
+    for (u32 i = 0; i < n; ++i) {
+        const float x = (map[i].x - origin.x) * scale + offset.x;
+        const float y = (map[i].y - origin.y) * scale + offset.y;
+        u32 taps[4];
+        const u8 count = computeTaps(x, y, width, height, wrapX, taps);
+        for (u8 k = 0; k < count; ++k) {
+            mTaps.push_back(taps[k]);
+        }
+        mTapCount.push_back(count);
+    }
+}
+
+CanvasResampler CanvasResampler::fit(const ScreenMap &map, u16 width,
+                                     u16 height) {
+    const u32 n = map.getLength();
+    vec2f lo(0, 0);
+    vec2f hi(0, 0);
+    for (u32 i = 0; i < n; ++i) {
+        const vec2f &p = map[i];
+        lo.x = i ? MIN(lo.x, p.x) : p.x;
+        lo.y = i ? MIN(lo.y, p.y) : p.y;
+        hi.x = i ? MAX(hi.x, p.x) : p.x;
+        hi.y = i ? MAX(hi.y, p.y) : p.y;
+    }
+    const float spanX = hi.x - lo.x;
+    const float spanY = hi.y - lo.y;
+    const float maxX = width ? float(width - 1) : 0.0f;
+    const float maxY = height ? float(height - 1) : 0.0f;
+    float scale = 0;
+    if (spanX > 0 && spanY > 0) {
+        scale = MIN(maxX / spanX, maxY / spanY);
+    } else if (spanX > 0) {
+        scale = maxX / spanX;
+    } else if (spanY > 0) {
+        scale = maxY / spanY;
+    }
+    const vec2f offset((maxX - spanX * scale) / 2, (maxY - spanY * scale) / 2);
+
+    CanvasResampler out;
+    out.build(map, width, height, false, scale, lo, offset);
+    return out;
+}
+
+void CanvasResampler::apply(const CRGB *canvas, CRGB *leds) const {
+    const u32 *tap = mTaps.data();
+    const u8 *count = mTapCount.data();
+    const u32 n = mTapCount.size();
+    for (u32 i = 0; i < n; ++i) {
+        leds[i] = gather(canvas, tap, count[i]);
+        tap += count[i];
+    }
+}
+
+void CanvasResampler::apply(const Grid<CRGB> &canvas, CRGB *leds) const {
+    FASTLED_ASSERT(canvas.width() == mWidth && canvas.height() == mHeight,
+                   "CanvasResampler built for " << mWidth << "x" << mHeight
+                                                << ", canvas is "
+                                                << canvas.width() << "x"
+                                                << canvas.height());
+    apply(canvas.data(), leds);
+}
+
+CRGB CanvasResampler::sample(const Grid<CRGB> &canvas, vec2f pos,
+                             bool wrapX) {
+    const u16 width = u16(canvas.width());
+    const u16 height = u16(canvas.height());
+    u32 taps[4];
+    const u8 count = computeTaps(pos.x, pos.y, width, height, wrapX, taps);
+    return gather(canvas.data(), taps, count);
+}
+
+} // namespace fl
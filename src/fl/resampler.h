@@ -0,0 +1,76 @@
+#pragma once
+
+// Samples a rectangular canvas at the LED positions of a ScreenMap.
+//
+// Effects that draw into a width x height canvas can drive LEDs at any
+// physical layout: rings, helices, or a JSON screen map of an installation.
+// The bilinear weights for every LED are worked out once, when the
+// resampler is built, and stored as a sparse table of at most four
+// (canvas pixel, 8 bit weight) taps per LED. Each frame is then a single
+// gather over that table, without floats or divisions.
+//
+//   fl::CanvasResampler ring =
+//       fl::CanvasResampler::fit(fl::ScreenMap::Circle(60), 32, 32);
+//   ...
+//   ring.apply(canvas, leds); // canvas is 32 * 32 CRGB, leds is 60 CRGB.
+
+#include "crgb.h"
+#include "fl/geometry.h"
+#include "fl/int.h"
+#include "fl/vector.h"
+
+namespace fl {
+
+class ScreenMap;
+template <typename T> class Grid;
+
+class CanvasResampler {
+  public:
+    CanvasResampler() = default;
+
+    // LED positions are taken in canvas pixels, with pixel (x, y) centered
+    // on the integer coordinate, the same convention as splat(). Taps that
+    // fall outside the canvas are dropped and the rest reweighted, an LED
+    // entirely outside stays black. With wrapX the canvas is a cylinder and
+    // x wraps around at width, as on a corkscrew.
+    CanvasResampler(const ScreenMap &map, u16 width, u16 height,
+                    bool wrapX = false);
+
+    // For layouts in physical units, like ScreenMap::Circle() or a JSON
+    // screen map. The bounding box of the map is scaled onto the canvas,
+    // keeping its aspect ratio, and centered.
+    static CanvasResampler fit(const ScreenMap &map, u16 width, u16 height);
+
+    void build(const ScreenMap &map, u16 width, u16 height,
+               bool wrapX = false);
+
+    // leds[i] is the weighted sum of the canvas pixels around LED i. The
+    // canvas is row major, width * height pixels.
+    void apply(const CRGB *canvas, CRGB *leds) const;
+    void apply(const Grid<CRGB> &canvas, CRGB *leds) const;
+
+    // One LED at pos, with the same weights and rounding as a built
+    // resampler, for callers that do not keep a table.
+    static CRGB sample(const Grid<CRGB> &canvas, vec2f pos,
+                       bool wrapX = false);
+
+    u32 size() const { return mTapCount.size(); }
+    u16 width() const { return mWidth; }
+    u16 height() const { return mHeight; }
+    // Total number of taps, at most 4 * size().
+    u32 taps() const { return mTaps.size(); }
+
+  private:
+    // Positions are mapped to (p - origin) * scale + offset first.
+    void build(const ScreenMap &map, u16 width, u16 height, bool wrapX,
+               float scale, vec2f origin, vec2f offset);
+
+    // Each tap is the canvas index << 9 | weight, the weights of an LED sum
+    // to 256.
+    fl::vector<u32> mTaps;
+    fl::vector<u8> mTapCount;
+    u16 mWidth = 0;
+    u16 mHeight = 0;
+};
+
+} // namespace fl
@@ -7,6 +7,7 @@
 #include "fl/screenmap.h"
 
 #include "fl/json.h"
+#include "fl/json_stream.h"
 #include "fl/map.h"
 #include "fl/math.h"
 #include "fl/math_macros.h"
@@ -48,58 +49,102 @@ ScreenMap ScreenMap::Circle(int numLeds, float cm_between_leds,
     return screenMap;
 }
 
+// Reads the numbers of a "x" or "y" array into the x or y of out, when out
+// is set, and returns how many there were.
+static bool readAxis(JsonReader *in, ScreenMap *out, bool isX, u32 *count) {
+    if (in->next() != JsonReader::kBeginArray) {
+        return false;
+    }
+    u32 n = 0;
+    for (JsonReader::Token t = in->next(); t != JsonReader::kEndArray;
+         t = in->next()) {
+        if (t != JsonReader::kNumber) {
+            return false;
+        }
+        if (out && n < out->getLength()) {
+            vec2f &p = (*out)[n];
+            (isX ? p.x : p.y) = in->asFloat();
+        }
+        ++n;
+    }
+    *count = n;
+    return true;
+}
+
+// One segment object, {"x": [...], "y": [...], "diameter": d}. Called once
+// on a copy of the reader for the length and diameter, then again to fill
+// the map, so the points are never held anywhere else.
+static bool readSegment(JsonReader *in, ScreenMap *out, u32 *length,
+                        float *diameter) {
+    if (in->next() != JsonReader::kBeginObject) {
+        return false;
+    }
+    while (in->next() == JsonReader::kKey) {
+        u32 n = 0;
+        if (in->keyIs("x")) {
+            if (!readAxis(in, out, true, &n)) {
+                return false;
+            }
+            *length = n;
+        } else if (in->keyIs("y")) {
+            if (!readAxis(in, out, false, &n)) {
+                return false;
+            }
+        } else if (in->keyIs("diameter")) {
+            if (in->next() == JsonReader::kNumber && in->asFloat() > 0.0f) {
+                *diameter = in->asFloat();
+            }
+        } else if (!in->skip()) {
+            return false;
+        }
+    }
+    return in->token() == JsonReader::kEndObject;
+}
+
 bool ScreenMap::ParseJson(const char *jsonStrScreenMap,
                           FixedMap<string, ScreenMap, 16> *segmentMaps, string *err) {
-#if !FASTLED_ENABLE_JSON
-    if (err) {
-        *err = "JSON not enabled";
-    }
-    return false;
-#else
-    JsonDocument doc;
     string _err;
     if (!err) {
         err = &_err;
     }
-
-    bool ok = parseJson(jsonStrScreenMap, &doc, err);
+    JsonReader in(jsonStrScreenMap);
+    bool ok = in.next() == JsonReader::kBeginObject;
+    while (ok && in.next() == JsonReader::kKey) {
+        if (!in.keyIs("map")) {
+            ok = in.skip();
+            continue;
+        }
+        ok = in.next() == JsonReader::kBeginObject;
+        while (ok && in.next() == JsonReader::kKey) {
+            string name;
+            in.decodeString(&name);
+            JsonReader sizing = in;
+            u32 length = 0;
+            float diameter = -1.0f;
+            ok = readSegment(&sizing, nullptr, &length, &diameter);
+            if (!ok) {
+                break;
+            }
+            ScreenMap segment_map(length, diameter);
+            ok = readSegment(&in, &segment_map, &length, &diameter);
+            segmentMaps->insert(name, segment_map);
+        }
+        ok = ok && in.token() == JsonReader::kEndObject;
+    }
+    ok = ok && in.token() == JsonReader::kEndObject &&
+         in.next() == JsonReader::kEnd;
     if (!ok) {
+        *err = "Invalid json at offset ";
+        err->append(u32(in.offset()));
         FASTLED_WARN("Failed to parse json: " << err->c_str());
         return false;
     }
-    auto map = doc["map"];
-    for (auto kv : map.as<FLArduinoJson::JsonObject>()) {
-        auto segment = kv.value();
-        auto x = segment["x"];
-        auto y = segment["y"];
-        auto obj = segment["diameter"];
-        float diameter = -1.0f;
-        if (obj.is<float>()) {
-            float d = obj.as<float>();
-            if (d > 0.0f) {
-                diameter = d;
-            }
-        }
-        auto n = x.size();
-        ScreenMap segment_map(n, diameter);
-        for (u16 j = 0; j < n; j++) {
-            segment_map.set(j, vec2f{x[j], y[j]});
-        }
-        segmentMaps->insert(kv.key().c_str(), segment_map);
-    }
     return true;
-#endif
 }
 
 bool ScreenMap::ParseJson(const char *jsonStrScreenMap,
                           const char *screenMapName, ScreenMap *screenmap,
                           string *err) {
-#if !FASTLED_ENABLE_JSON
-    if (err) {
-        *err = "JSON not enabled";
-    }
-    return false;
-#else
     FixedMap<string, ScreenMap, 16> segmentMaps;
     bool ok = ParseJson(jsonStrScreenMap, &segmentMaps, err);
     if (!ok) {
@@ -119,7 +164,6 @@ bool ScreenMap::ParseJson(const char *jsonStrScreenMap,
     }
     FASTLED_WARN(_err.c_str());
     return false;
-#endif
 }
 
 void ScreenMap::toJson(const FixedMap<string, ScreenMap, 16> &segmentMaps,
@@ -157,15 +201,40 @@ void ScreenMap::toJson(const FixedMap<string, ScreenMap, 16> &segmentMaps,
 #endif
 }
 
+void ScreenMap::toJson(const FixedMap<string, ScreenMap, 16> &segmentMaps,
+                       JsonWriter *out) {
+    out->beginObject();
+    out->key("map").beginObject();
+    for (auto kv : segmentMaps) {
+        const ScreenMap &segment = kv.second;
+        out->key(kv.first.c_str()).beginObject();
+        out->key("x").beginArray();
+        for (u32 i = 0; i < segment.getLength(); i++) {
+            out->value(segment[i].x);
+        }
+        out->endArray();
+        out->key("y").beginArray();
+        for (u32 i = 0; i < segment.getLength(); i++) {
+            out->value(segment[i].y);
+        }
+        out->endArray();
+        float diameter = segment.getDiameter();
+        if (diameter < 0.0f) {
+            diameter = .5f; // 5mm.
+        }
+        if (diameter > 0.0f) {
+            out->member("diameter", diameter);
+        }
+        out->endObject();
+    }
+    out->endObject();
+    out->endObject();
+}
+
 void ScreenMap::toJsonStr(const FixedMap<string, ScreenMap, 16> &segmentMaps,
                           string *jsonBuffer) {
-#if !FASTLED_ENABLE_JSON
-    return;
-#else
-    JsonDocument doc;
-    toJson(segmentMaps, &doc);
-    fl::toJson(doc, jsonBuffer);
-#endif
+    JsonWriter out(jsonBuffer);
+    toJson(segmentMaps, &out);
 }
 
 ScreenMap::ScreenMap(u32 length, float mDiameter)
@@ -20,6 +20,7 @@ namespace fl {
 
 class string;
 class JsonDocument;
+class JsonWriter;
 
 // ScreenMap screen map maps strip indexes to x,y coordinates for a ui
 // canvas in float format.
@@ -83,9 +84,12 @@ class ScreenMap {
                           const char *screenMapName, ScreenMap *screenmap,
                           string *err = nullptr);
 
+    // ParseJson() and toJsonStr() stream the text with JsonReader and
+    // JsonWriter and do not build a JsonDocument.
     static void toJsonStr(const FixedMap<string, ScreenMap, 16> &,
                           string *jsonBuffer);
     static void toJson(const FixedMap<string, ScreenMap, 16> &, JsonDocument *doc);
+    static void toJson(const FixedMap<string, ScreenMap, 16> &, JsonWriter *out);
 
   private:
     static const vec2f &empty();
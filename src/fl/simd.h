@@ -0,0 +1,38 @@
+#pragma once
+
+// Compile time detection of the vector units available to the pixel kernels.
+// Only the baseline instruction sets that are guaranteed by the target ABI are
+// used (SSE2 on x86-64, NEON on aarch64 / armv7 with neon), so no runtime
+// dispatch is needed. Define FASTLED_NO_SIMD to force the portable scalar/SWAR
+// code paths, which is useful for verifying that both paths agree.
+
+#ifndef FASTLED_NO_SIMD
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FASTLED_SIMD_SSE2 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FASTLED_SIMD_NEON 1
+#endif
+
+#endif // FASTLED_NO_SIMD
+
+#ifndef FASTLED_SIMD_SSE2
+#define FASTLED_SIMD_SSE2 0
+#endif
+
+#ifndef FASTLED_SIMD_NEON
+#define FASTLED_SIMD_NEON 0
+#endif
+
+#define FASTLED_HAS_SIMD (FASTLED_SIMD_SSE2 || FASTLED_SIMD_NEON)
+
+#if FASTLED_SIMD_SSE2
+#include <emmintrin.h> // ok include
+#endif
+
+#if FASTLED_SIMD_NEON
+#include <arm_neon.h> // ok include
+#endif
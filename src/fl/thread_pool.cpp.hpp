@@ -0,0 +1,137 @@
+#include "fl/thread_pool.h"
+
+#include "fl/namespace.h"
+#include "fl/vector.h"
+
+#if FASTLED_MULTITHREADED
+#include <atomic>             // ok include
+#include <condition_variable> // ok include
+#include <mutex>              // ok include
+#include <thread>             // ok include
+#endif
+
+namespace fl {
+
+#if FASTLED_MULTITHREADED
+
+struct ThreadPool::Impl {
+    explicit Impl(fl::u32 numWorkers) {
+        if (numWorkers == 0) {
+            const unsigned hw = std::thread::hardware_concurrency();
+            numWorkers = hw > 1 ? hw - 1 : 0;
+        }
+        for (fl::u32 i = 0; i < numWorkers; ++i) {
+            workers.push_back(new std::thread([this]() { workerLoop(); }));
+        }
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wake.notify_all();
+        for (fl::size i = 0; i < workers.size(); ++i) {
+            workers[i]->join();
+            delete workers[i];
+        }
+    }
+
+    void workerLoop() {
+        fl::u32 seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&]() { return stop || generation != seen; });
+                if (stop) {
+                    return;
+                }
+                seen = generation;
+            }
+            runJob();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--active == 0) {
+                done.notify_one();
+            }
+        }
+    }
+
+    // Shared by the workers and the caller, each index is claimed once.
+    void runJob() {
+        fl::u32 i;
+        while ((i = next.fetch_add(1)) < count) {
+            (*job)(i);
+        }
+    }
+
+    void parallelFor(fl::u32 n, const fl::function<void(fl::u32)> &fn) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &fn;
+            count = n;
+            next.store(0);
+            active = fl::u32(workers.size());
+            ++generation;
+        }
+        wake.notify_all();
+        runJob();
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&]() { return active == 0; });
+        job = nullptr;
+    }
+
+    fl::vector<std::thread *> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const fl::function<void(fl::u32)> *job = nullptr;
+    fl::u32 count = 0;
+    std::atomic<fl::u32> next{0};
+    fl::u32 active = 0;
+    fl::u32 generation = 0;
+    bool stop = false;
+    std::atomic<bool> busy{false};
+};
+
+#else
+
+struct ThreadPool::Impl {
+    explicit Impl(fl::u32) {}
+};
+
+#endif // FASTLED_MULTITHREADED
+
+ThreadPool::ThreadPool(fl::u32 numWorkers) : mImpl(new Impl(numWorkers)) {}
+
+ThreadPool::~ThreadPool() { delete mImpl; }
+
+void ThreadPool::parallelFor(fl::u32 count,
+                             const fl::function<void(fl::u32)> &fn) {
+#if FASTLED_MULTITHREADED
+    // Only one loop runs on the workers at a time. Anything that shows up
+    // while they are busy, including a nested call from fn, runs inline.
+    if (count > 1 && !mImpl->workers.empty() && !mImpl->busy.exchange(true)) {
+        mImpl->parallelFor(count, fn);
+        mImpl->busy.store(false);
+        return;
+    }
+#endif
+    for (fl::u32 i = 0; i < count; ++i) {
+        fn(i);
+    }
+}
+
+fl::u32 ThreadPool::numWorkers() const {
+#if FASTLED_MULTITHREADED
+    return fl::u32(mImpl->workers.size());
+#else
+    return 0;
+#endif
+}
+
+ThreadPool &ThreadPool::global() {
+    static ThreadPool sPool;
+    return sPool;
+}
+
+} // namespace fl
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "fl/function.h"
+#include "fl/int.h"
+#include "fl/thread.h"
+
+namespace fl {
+
+// A fixed set of worker threads for data parallel loops. parallelFor() hands
+// out the indices to the workers and the calling thread, and only returns
+// once every call has finished, so it doubles as the barrier between two
+// phases of work.
+//
+// Without FASTLED_MULTITHREADED there are no workers and parallelFor() is a
+// plain loop on the calling thread. The same happens for nested or
+// concurrent calls while the pool is busy.
+class ThreadPool {
+  public:
+    // numWorkers == 0 picks one worker per hardware thread, not counting the
+    // calling thread which also takes part in every loop.
+    explicit ThreadPool(fl::u32 numWorkers = 0);
+    ~ThreadPool();
+
+    // Calls fn(i) for every i in [0, count), in no particular order.
+    void parallelFor(fl::u32 count, const fl::function<void(fl::u32)> &fn);
+
+    fl::u32 numWorkers() const;
+
+    // Process wide pool, started on first use.
+    static ThreadPool &global();
+
+  private:
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    struct Impl;
+    Impl *mImpl;
+};
+
+} // namespace fl
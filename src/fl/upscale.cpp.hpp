@@ -6,7 +6,9 @@
 
 #include "crgb.h"
 #include "fl/namespace.h"
+#include "fl/simd.h"
 #include "fl/upscale.h"
+#include "fl/vector.h"
 #include "fl/xymap.h"
 
 namespace fl {
@@ -17,49 +19,124 @@ u8 bilinearInterpolate(u8 v00, u8 v10, u8 v01, u8 v11,
 u8 bilinearInterpolatePowerOf2(u8 v00, u8 v10, u8 v01,
                                     u8 v11, u8 dx, u8 dy);
 
-void upscaleRectangular(const CRGB *input, CRGB *output, u16 inputWidth,
-                        u16 inputHeight, u16 outputWidth, u16 outputHeight) {
-    const u16 scale_factor = 256; // Using 8 bits for the fractional part
-
-    for (u16 y = 0; y < outputHeight; y++) {
-        for (u16 x = 0; x < outputWidth; x++) {
-            // Calculate the corresponding position in the input grid
-            u32 fx = ((u32)x * (inputWidth - 1) * scale_factor) /
-                          (outputWidth - 1);
-            u32 fy = ((u32)y * (inputHeight - 1) * scale_factor) /
-                          (outputHeight - 1);
-
-            u16 ix = fx / scale_factor; // Integer part of x
-            u16 iy = fy / scale_factor; // Integer part of y
-            u16 dx = fx % scale_factor; // Fractional part of x
-            u16 dy = fy % scale_factor; // Fractional part of y
-
-            u16 ix1 = (ix + 1 < inputWidth) ? ix + 1 : ix;
-            u16 iy1 = (iy + 1 < inputHeight) ? iy + 1 : iy;
-
-            // Direct array access - no XY mapping overhead
-            u16 i00 = iy * inputWidth + ix;
-            u16 i10 = iy * inputWidth + ix1;
-            u16 i01 = iy1 * inputWidth + ix;
-            u16 i11 = iy1 * inputWidth + ix1;
-
-            CRGB c00 = input[i00];
-            CRGB c10 = input[i10];
-            CRGB c01 = input[i01];
-            CRGB c11 = input[i11];
+namespace {
+
+// Vertical pass of bilinearInterpolate() over whole rows of bytes:
+// column[i] = a[i] * (256 - dy) + b[i] * dy, which fits a u16 exactly.
+void upscaleBlendRows(const u8 *a, const u8 *b, u16 dy, u16 *column,
+                      u32 count) {
+    u32 i = 0;
+#if FASTLED_SIMD_SSE2
+    // The 16 bit products wrap, but their sum is in range.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wa = _mm_set1_epi16(short(256 - dy));
+    const __m128i wb = _mm_set1_epi16(short(dy));
+    for (; i + 16 <= count; i += 16) {
+        const __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        const __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+        const __m128i lo =
+            _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(va, zero), wa),
+                          _mm_mullo_epi16(_mm_unpacklo_epi8(vb, zero), wb));
+        const __m128i hi =
+            _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(va, zero), wa),
+                          _mm_mullo_epi16(_mm_unpackhi_epi8(vb, zero), wb));
+        _mm_storeu_si128((__m128i *)(column + i), lo);
+        _mm_storeu_si128((__m128i *)(column + i + 8), hi);
+    }
+#elif FASTLED_SIMD_NEON
+    // 256 - dy does not fit a u8 lane, so a * (256 - dy) is a * 256 - a * dy.
+    const uint8x8_t wb = vdup_n_u8(u8(dy));
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16_t va = vld1q_u8(a + i);
+        const uint8x16_t vb = vld1q_u8(b + i);
+        const uint16x8_t lo = vaddq_u16(
+            vsubq_u16(vshll_n_u8(vget_low_u8(va), 8),
+                      vmull_u8(vget_low_u8(va), wb)),
+            vmull_u8(vget_low_u8(vb), wb));
+        const uint16x8_t hi = vaddq_u16(
+            vsubq_u16(vshll_n_u8(vget_high_u8(va), 8),
+                      vmull_u8(vget_high_u8(va), wb)),
+            vmull_u8(vget_high_u8(vb), wb));
+        vst1q_u16(column + i, lo);
+        vst1q_u16(column + i + 8, hi);
+    }
+#endif
+    for (; i < count; ++i) {
+        column[i] = u16(a[i] * (256 - dy) + b[i] * dy);
+    }
+}
 
-            CRGB result;
-            result.r = bilinearInterpolate(c00.r, c10.r, c01.r, c11.r, dx, dy);
-            result.g = bilinearInterpolate(c00.g, c10.g, c01.g, c11.g, dx, dy);
-            result.b = bilinearInterpolate(c00.b, c10.b, c01.b, c11.b, dx, dy);
+// Horizontal pass, output pixel x at fx = x * (inputWidth - 1) * 256 /
+// (outputWidth - 1). fx is stepped by the quotient and the remainder of
+// that division, so there is no division per pixel.
+void upscaleBlendColumns(const u16 *column, u16 inputWidth, u16 outputWidth,
+                         CRGB *out) {
+    const u32 span = u32(inputWidth - 1) * 256;
+    const u32 divisor = outputWidth > 1 ? outputWidth - 1 : 1;
+    const u32 step = span / divisor;
+    const u32 stepRem = span % divisor;
+    u32 fx = 0;
+    u32 rem = 0;
+    for (u16 x = 0; x < outputWidth; ++x) {
+        const u16 ix = fx >> 8;
+        const u32 dx = fx & 0xFF;
+        const u16 ix1 = (ix + 1 < inputWidth) ? ix + 1 : ix;
+        const u16 *c0 = column + 3 * ix;
+        const u16 *c1 = column + 3 * ix1;
+        // Rounded like bilinearInterpolate().
+        for (int c = 0; c < 3; ++c) {
+            out[x].raw[c] = u8((c0[c] * (256 - dx) + c1[c] * dx + 32768) >> 16);
+        }
+        fx += step;
+        rem += stepRem;
+        if (rem >= divisor) {
+            rem -= divisor;
+            ++fx;
+        }
+    }
+}
 
-            // Direct array access - no XY mapping overhead
-            u16 idx = y * outputWidth + x;
-            output[idx] = result;
+// Bilinear upscale a row at a time, bit for bit the same as the per pixel
+// loop in upscaleArbitrary(). Rows go to output row major, or to the row
+// spans of xyMap when there is one.
+void upscaleRows(const CRGB *input, CRGB *output, u16 inputWidth,
+                 u16 inputHeight, u16 outputWidth, u16 outputHeight,
+                 const XYMap *xyMap) {
+    if (inputWidth == 0 || inputHeight == 0) {
+        return;
+    }
+    fl::vector_inlined<u16, 3 * 64> column(3 * inputWidth);
+    fl::vector_inlined<CRGB, 64> reversed(xyMap ? outputWidth : 0);
+    const u32 divisor = outputHeight > 1 ? outputHeight - 1 : 1;
+    for (u16 y = 0; y < outputHeight; y++) {
+        const u32 fy = ((u32)y * (inputHeight - 1) * 256) / divisor;
+        const u16 iy = fy >> 8;
+        const u16 iy1 = (iy + 1 < inputHeight) ? iy + 1 : iy;
+        upscaleBlendRows(input[u32(iy) * inputWidth].raw,
+                         input[u32(iy1) * inputWidth].raw, fy & 0xFF,
+                         column.data(), 3 * u32(inputWidth));
+
+        CRGB *out = output + u32(y) * outputWidth;
+        XYSpan span = {};
+        if (xyMap) {
+            span = xyMap->spanAt(0, y);
+            out = span.step > 0 ? output + span.index : reversed.data();
+        }
+        upscaleBlendColumns(column.data(), inputWidth, outputWidth, out);
+        if (xyMap && span.step < 0) {
+            writeSpan(output, span, out);
         }
     }
 }
 
+} // namespace
+
+void upscaleRectangular(const CRGB *input, CRGB *output, u16 inputWidth,
+                        u16 inputHeight, u16 outputWidth, u16 outputHeight) {
+    upscaleRows(input, output, inputWidth, inputHeight, outputWidth,
+                outputHeight, nullptr);
+}
+
 void upscaleRectangularPowerOf2(const CRGB *input, CRGB *output, u8 inputWidth,
                                 u8 inputHeight, u8 outputWidth, u8 outputHeight) {
     for (u8 y = 0; y < outputHeight; y++) {
@@ -110,6 +187,16 @@ void upscaleArbitrary(const CRGB *input, CRGB *output, u16 inputWidth,
     u16 outputHeight = xyMap.getHeight();
     const u16 scale_factor = 256; // Using 8 bits for the fractional part
 
+    // Serpentine and line by line rows are runs of the output, so they are
+    // written a row at a time. With an offset some pixels would be clipped
+    // below, which stays with the per pixel loop.
+    if ((xyMap.isSerpentine() || xyMap.isLineByLine()) &&
+        xyMap.getOffset() == 0) {
+        upscaleRows(input, output, inputWidth, inputHeight, outputWidth,
+                    outputHeight, &xyMap);
+        return;
+    }
+
     for (u16 y = 0; y < outputHeight; y++) {
         for (u16 x = 0; x < outputWidth; x++) {
             // Calculate the corresponding position in the input grid
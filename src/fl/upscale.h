@@ -18,7 +18,8 @@ namespace fl {
 /// @param inputWidth The width of the input grid.
 /// @param inputHeight The height of the input grid.
 /// @param xyMap The XYMap to use to determine where to write the pixel. If the
-/// pixel is mapped outside of the range then it is clipped.
+/// pixel is mapped outside of the range then it is clipped. Serpentine and
+/// line by line maps are written a row at a time, as upscaleRectangular().
 void upscaleArbitrary(const CRGB *input, CRGB *output, u16 inputWidth,
                       u16 inputHeight, const fl::XYMap& xyMap);
 
@@ -39,7 +40,9 @@ void upscalePowerOf2(const CRGB *input, CRGB *output, u8 inputWidth,
 /// @param inputHeight The height of the input grid.
 /// @param outputWidth The width of the output grid.
 /// @param outputHeight The height of the output grid.
-/// This version bypasses XY mapping overhead for rectangular layouts.
+/// This version bypasses XY mapping overhead for rectangular layouts, and
+/// works a row at a time: a vectorized vertical pass then a horizontal pass
+/// without divisions.
 void upscaleRectangular(const CRGB *input, CRGB *output, u16 inputWidth,
                         u16 inputHeight, u16 outputWidth, u16 outputHeight);
 
@@ -54,21 +57,31 @@ void upscaleRectangular(const CRGB *input, CRGB *output, u16 inputWidth,
 void upscaleRectangularPowerOf2(const CRGB *input, CRGB *output, u8 inputWidth,
                                 u8 inputHeight, u8 outputWidth, u8 outputHeight);
 
-//
+// Picks the fastest upscale for the map. The row kernels behind
+// upscaleRectangular() and upscaleArbitrary() (for serpentine and line by
+// line maps) beat the power of 2 versions except on AVR, where those keep
+// the math in 16 bits.
 inline void upscale(const CRGB *input, CRGB *output, u16 inputWidth,
                     u16 inputHeight, const fl::XYMap& xyMap) {
     u16 outputWidth = xyMap.getWidth();
     u16 outputHeight = xyMap.getHeight();
     const bool wontFit =
         (outputWidth != xyMap.getWidth() || outputHeight != xyMap.getHeight());
-    
+#if defined(__AVR__)
+    const bool powerOf2 = !wontFit && !(inputWidth & (inputWidth - 1)) &&
+                          !(inputHeight & (inputHeight - 1));
+#else
+    const bool powerOf2 = !wontFit && !(inputWidth & (inputWidth - 1)) &&
+                          !(inputHeight & (inputHeight - 1)) &&
+                          !xyMap.isSerpentine() && !xyMap.isLineByLine();
+#endif
+
     // Check if we can use the optimized rectangular version
     const bool isRectangular = (xyMap.getType() == XYMap::kLineByLine);
     
     if (isRectangular) {
         // Use optimized rectangular version that bypasses XY mapping
-        if (wontFit || (inputWidth & (inputWidth - 1)) ||
-            (inputHeight & (inputHeight - 1))) {
+        if (!powerOf2) {
             upscaleRectangular(input, output, inputWidth, inputHeight, 
                               outputWidth, outputHeight);
         } else {
@@ -77,11 +90,10 @@ inline void upscale(const CRGB *input, CRGB *output, u16 inputWidth,
         }
     } else {
         // Use the original XY-mapped versions
-    if (wontFit || (inputWidth & (inputWidth - 1)) ||
-        (inputHeight & (inputHeight - 1))) {
-        upscaleArbitrary(input, output, inputWidth, inputHeight, xyMap);
-    } else {
-        upscalePowerOf2(input, output, inputWidth, inputHeight, xyMap);
+        if (!powerOf2) {
+            upscaleArbitrary(input, output, inputWidth, inputHeight, xyMap);
+        } else {
+            upscalePowerOf2(input, output, inputWidth, inputHeight, xyMap);
         }
     }
 }
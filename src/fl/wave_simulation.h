@@ -160,6 +160,10 @@ class WaveSimulation2D {
 
     void setXCylindrical(bool on) { mSim->setXCylindrical(on); }
 
+    // Step the supersampled grid on worker threads, see
+    // WaveSimulation2D_Real::setParallel().
+    void setParallel(bool on) { mSim->setParallel(on); }
+
     // Downsampled getter for the floating point value at (x,y) in the outer
     // grid. It averages over the corresponding multiplier×multiplier block in
     // the high-res simulation.
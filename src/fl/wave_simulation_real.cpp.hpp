@@ -3,9 +3,22 @@
 #include "fl/stdint.h"
 
 #include "fl/clamp.h"
+#include "fl/force_inline.h"
 #include "fl/namespace.h"
+#include "fl/simd.h"
+#include "fl/thread_pool.h"
 #include "fl/wave_simulation_real.h"
 
+// Rows per band handed to a worker by the parallel 2D update.
+#ifndef FASTLED_WAVE_TILE_ROWS
+#define FASTLED_WAVE_TILE_ROWS 16
+#endif
+
+// Smallest grid, in cells, that is worth waking the thread pool for.
+#ifndef FASTLED_WAVE_PARALLEL_MIN_CELLS
+#define FASTLED_WAVE_PARALLEL_MIN_CELLS 16384
+#endif
+
 namespace fl {
 
 // Define Q15 conversion constants.
@@ -40,6 +53,161 @@ float fixed_to_float(i16 f) {
 // i16 fixed_mul(i16 a, i16 b) {
 //     return (i16)(((i32)a * b) >> 15);
 // }
+
+// One cell of the 2D update. The courant product wraps at 32 bits like the
+// vector multiplies do, so every path gives the same result even for
+// speeds where it overflows.
+FASTLED_FORCE_INLINE i16 stepCell(i32 center, i32 neighbors, i32 prev,
+                                  i32 courant, int damp, bool halfDuplex) {
+    // Laplacian: sum of four neighbors minus 4 times the center.
+    const i32 laplacian = neighbors - (center << 2);
+    // f = - prev + 2 * center + mCourantSq * laplacian, the multiplication
+    // is in Q15 so shift right by 15.
+    const u32 product = static_cast<u32>(courant) * static_cast<u32>(laplacian);
+    const i32 term = static_cast<i32>(product) >> 15;
+    i32 f = -prev + (center << 1) + term;
+    // Apply damping: f - f / 2^damp, rounding towards zero.
+    f = f - (f / (i32(1) << damp));
+    // Clamp f to the Q15 range.
+    if (f > 32767) {
+        f = 32767;
+    } else if (f < -32768) {
+        f = -32768;
+    }
+    if (halfDuplex && f < 0) {
+        f = 0;
+    }
+    return static_cast<i16>(f);
+}
+
+#if FASTLED_SIMD_SSE2
+
+FASTLED_FORCE_INLINE __m128i widenLo(__m128i v) {
+    return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+}
+
+FASTLED_FORCE_INLINE __m128i widenHi(__m128i v) {
+    return _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+}
+
+// Low 32 bits of a * b per lane, SSE2 has no 32 bit mullo.
+FASTLED_FORCE_INLINE __m128i mullo32(__m128i a, __m128i b) {
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd =
+        _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// stepCell() on four lanes, before the clamp.
+FASTLED_FORCE_INLINE __m128i stepLanes(__m128i center, __m128i neighbors,
+                                       __m128i prev, __m128i courant,
+                                       __m128i bias, __m128i damp) {
+    const __m128i laplacian =
+        _mm_sub_epi32(neighbors, _mm_slli_epi32(center, 2));
+    const __m128i term = _mm_srai_epi32(mullo32(courant, laplacian), 15);
+    __m128i f = _mm_add_epi32(_mm_sub_epi32(_mm_add_epi32(center, center), prev),
+                              term);
+    const __m128i q = _mm_sra_epi32(
+        _mm_add_epi32(f, _mm_and_si128(_mm_srai_epi32(f, 31), bias)), damp);
+    return _mm_sub_epi32(f, q);
+}
+
+#elif FASTLED_SIMD_NEON
+
+FASTLED_FORCE_INLINE int32x4_t stepLanes(int16x4_t center, int16x4_t left,
+                                         int16x4_t right, int16x4_t up,
+                                         int16x4_t down, int16x4_t prev,
+                                         int32x4_t courant, int32x4_t bias,
+                                         int32x4_t damp) {
+    const int32x4_t c = vmovl_s16(center);
+    const int32x4_t neighbors =
+        vaddq_s32(vaddl_s16(left, right), vaddl_s16(up, down));
+    const int32x4_t laplacian = vsubq_s32(neighbors, vshlq_n_s32(c, 2));
+    const int32x4_t term = vshrq_n_s32(vmulq_s32(courant, laplacian), 15);
+    int32x4_t f = vaddq_s32(vsubq_s32(vaddq_s32(c, c), vmovl_s16(prev)), term);
+    // damp holds the negated exponent, vshlq_s32 shifts right for it.
+    const int32x4_t q = vshlq_s32(
+        vaddq_s32(f, vandq_s32(vshrq_n_s32(f, 31), bias)), damp);
+    return vsubq_s32(f, q);
+}
+
+#endif
+
+// Updates the inner cells of one row. mid, up and down point at the first
+// inner cell of the row in the current grid and the rows above and below,
+// next at the same cell of the grid being written, which also holds the
+// previous step.
+static void stepRow(const i16 *up, const i16 *mid, const i16 *down,
+                    i16 *next, u32 width, i32 courant, int damp,
+                    bool halfDuplex) {
+    u32 i = 0;
+#if FASTLED_SIMD_SSE2
+    const __m128i vCourant = _mm_set1_epi32(courant);
+    const __m128i vBias = _mm_set1_epi32((i32(1) << damp) - 1);
+    const __m128i vDamp = _mm_cvtsi32_si128(damp);
+    const __m128i vFloor = halfDuplex ? _mm_setzero_si128()
+                                      : _mm_set1_epi16(-32768);
+    for (; i + 8 <= width; i += 8) {
+        const __m128i c =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(mid + i));
+        const __m128i l =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(mid - 1 + i));
+        const __m128i r =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(mid + i + 1));
+        const __m128i u =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(up + i));
+        const __m128i d =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(down + i));
+        const __m128i p =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(next + i));
+        const __m128i nLo = _mm_add_epi32(
+            _mm_add_epi32(widenLo(l), widenLo(r)),
+            _mm_add_epi32(widenLo(u), widenLo(d)));
+        const __m128i nHi = _mm_add_epi32(
+            _mm_add_epi32(widenHi(l), widenHi(r)),
+            _mm_add_epi32(widenHi(u), widenHi(d)));
+        const __m128i fLo = stepLanes(widenLo(c), nLo, widenLo(p), vCourant,
+                                      vBias, vDamp);
+        const __m128i fHi = stepLanes(widenHi(c), nHi, widenHi(p), vCourant,
+                                      vBias, vDamp);
+        // packs saturates to the Q15 range.
+        const __m128i out = _mm_max_epi16(_mm_packs_epi32(fLo, fHi), vFloor);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(next + i), out);
+    }
+#elif FASTLED_SIMD_NEON
+    const int32x4_t vCourant = vdupq_n_s32(courant);
+    const int32x4_t vBias = vdupq_n_s32((i32(1) << damp) - 1);
+    const int32x4_t vDamp = vdupq_n_s32(-damp);
+    const int16x8_t vFloor = vdupq_n_s16(halfDuplex ? 0 : -32768);
+    for (; i + 8 <= width; i += 8) {
+        const int16x8_t c = vld1q_s16(mid + i);
+        const int16x8_t l = vld1q_s16(mid - 1 + i);
+        const int16x8_t r = vld1q_s16(mid + i + 1);
+        const int16x8_t u = vld1q_s16(up + i);
+        const int16x8_t d = vld1q_s16(down + i);
+        const int16x8_t p = vld1q_s16(next + i);
+        const int32x4_t fLo = stepLanes(
+            vget_low_s16(c), vget_low_s16(l), vget_low_s16(r), vget_low_s16(u),
+            vget_low_s16(d), vget_low_s16(p), vCourant, vBias, vDamp);
+        const int32x4_t fHi = stepLanes(
+            vget_high_s16(c), vget_high_s16(l), vget_high_s16(r),
+            vget_high_s16(u), vget_high_s16(d), vget_high_s16(p), vCourant,
+            vBias, vDamp);
+        // vqmovn saturates to the Q15 range.
+        const int16x8_t out =
+            vmaxq_s16(vcombine_s16(vqmovn_s32(fLo), vqmovn_s32(fHi)), vFloor);
+        vst1q_s16(next + i, out);
+    }
+#endif
+    const i16 *left = mid - 1;
+    const i16 *right = mid + 1;
+    for (; i < width; ++i) {
+        const i32 neighbors = i32(left[i]) + right[i] + up[i] + down[i];
+        next[i] = stepCell(mid[i], neighbors, next[i], courant, damp,
+                           halfDuplex);
+    }
+}
 } // namespace wave_detail
 
 using namespace wave_detail;
@@ -244,48 +412,35 @@ void WaveSimulation2D_Real::update() {
         curr[(height + 1) * stride + i] = curr[height * stride + i];
     }
 
-    // Compute the dampening factor as an integer: 2^(dampening).
-    i32 dampening_factor = 1 << mDampening; // e.g., 6 -> 64
-    i32 mCourantSq32 = static_cast<i32>(mCourantSq);
-
-    // Update each inner cell.
-    for (fl::size j = 1; j <= height; ++j) {
-        for (fl::size i = 1; i <= width; ++i) {
-            int index = j * stride + i;
-            // Laplacian: sum of four neighbors minus 4 times the center.
-            i32 laplacian = (i32)curr[index + 1] + curr[index - 1] +
-                                curr[index + stride] + curr[index - stride] -
-                                ((i32)curr[index] << 2);
-            // Compute the new value:
-            // f = - next[index] + 2 * curr[index] + mCourantSq * laplacian
-            // The multiplication is in Q15, so we shift right by 15.
-            i32 term = (mCourantSq32 * laplacian) >> 15;
-            i32 f =
-                -(i32)next[index] + ((i32)curr[index] << 1) + term;
-
-            // Apply damping:
-            f = f - (f / dampening_factor);
-
-            // Clamp f to the Q15 range.
-            if (f > 32767)
-                f = 32767;
-            else if (f < -32768)
-                f = -32768;
-
-            next[index] = (i16)f;
-        }
-    }
-
-    if (mHalfDuplex) {
-        // Set negative values to zero.
-        for (fl::size j = 1; j <= height; ++j) {
-            for (fl::size i = 1; i <= width; ++i) {
-                int index = j * stride + i;
-                if (next[index] < 0) {
-                    next[index] = 0;
-                }
-            }
+    // Rows only read the current grid and their own cells of the next one,
+    // so bands of rows can be stepped in any order.
+    const i32 courant = static_cast<i32>(mCourantSq);
+    const int damp = mDampening;
+    const bool halfDuplex = mHalfDuplex;
+    const u32 w = width;
+    const u32 s = stride;
+    auto stepRows = [=](u32 jBegin, u32 jEnd) {
+        for (u32 j = jBegin; j < jEnd; ++j) {
+            const i16 *mid = curr + j * s + 1;
+            stepRow(mid - s, mid, mid + s, next + j * s + 1, w, courant, damp,
+                    halfDuplex);
         }
+    };
+
+#if FASTLED_MULTITHREADED
+    if (mParallel && width * height >= FASTLED_WAVE_PARALLEL_MIN_CELLS) {
+        const u32 rows = FASTLED_WAVE_TILE_ROWS;
+        const u32 numBands = (height + rows - 1) / rows;
+        const u32 h = height;
+        ThreadPool::global().parallelFor(numBands, [&](u32 band) {
+            const u32 jBegin = 1 + band * rows;
+            const u32 jEnd = jBegin + rows < h + 1 ? jBegin + rows : h + 1;
+            stepRows(jBegin, jEnd);
+        });
+    } else
+#endif
+    {
+        stepRows(1, height + 1);
     }
 
     // Swap the roles of the grids.
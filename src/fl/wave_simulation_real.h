@@ -168,6 +168,13 @@ class WaveSimulation2D_Real {
 
     void setXCylindrical(bool on) { mXCylindrical = on; }
 
+    // Split update() into bands of rows on fl::ThreadPool::global(). Only
+    // takes effect with FASTLED_MULTITHREADED and for grids of at least
+    // FASTLED_WAVE_PARALLEL_MIN_CELLS cells, the result is the same either
+    // way.
+    void setParallel(bool on) { mParallel = on; }
+    bool getParallel() const { return mParallel; }
+
     // Check if (x,y) is within the inner grid.
     bool has(fl::size x, fl::size y) const;
 
@@ -204,6 +211,7 @@ class WaveSimulation2D_Real {
     bool mHalfDuplex =
         true; // Flag to restrict values to positive range during update.
     bool mXCylindrical = false; // Default to non-cylindrical mode
+    bool mParallel = false;
 };
 
 } // namespace fl
@@ -62,13 +62,76 @@ XYMap::XYMap(u16 width, u16 height, bool is_serpentine,
       height(height), mOffset(offset) {}
 
 void XYMap::mapPixels(const CRGB *input, CRGB *output) const {
-    u16 pos = 0;
-    for (u16 y = 0; y < height; y++) {
-        for (u16 x = 0; x < width; x++) {
-            u16 i = pos++;
-            output[i] = input[mapToIndex(x, y)];
+    for (const XYSpan &span : spans()) {
+        readSpan(input, span, output + span.y * width + span.x);
+    }
+}
+
+XYSpan XYMap::spanAt(u16 x, u16 y) const {
+    XYSpan span;
+    span.x = x;
+    span.y = y;
+    span.index = mapToIndex(x, y);
+    span.step = 1;
+    if (type == kSerpentine || type == kLineByLine) {
+        if (type == kSerpentine && ((y % height) & 1)) {
+            span.step = -1;
         }
+        span.length = width - x;
+        return span;
     }
+    span.length = 1;
+    if (x + 1 >= width) {
+        return span;
+    }
+    const int delta = int(mapToIndex(x + 1, y)) - int(span.index);
+    if (delta != 1 && delta != -1) {
+        return span;
+    }
+    span.step = static_cast<i8>(delta);
+    // In int, so a run can not wrap around into an "unmapped" 0xffff, and
+    // only through indices the map can produce.
+    const int first = mOffset;
+    const int last = int(mOffset) + int(getTotal());
+    int expected = int(span.index) + delta;
+    while (x + span.length < width && expected >= first && expected < last &&
+           int(mapToIndex(x + span.length, y)) == expected) {
+        ++span.length;
+        expected += delta;
+    }
+    return span;
+}
+
+XYSpanRange::iterator::iterator(const XYMap *map, u16 y) : mMap(map) {
+    mSpan.x = 0;
+    mSpan.y = y;
+    mSpan.length = 0;
+    mSpan.index = 0;
+    mSpan.step = 1;
+    if (y < map->getHeight() && map->getWidth() > 0) {
+        mSpan = map->spanAt(0, y);
+    }
+}
+
+XYSpanRange::iterator &XYSpanRange::iterator::operator++() {
+    u16 x = mSpan.x + mSpan.length;
+    u16 y = mSpan.y;
+    if (x >= mMap->getWidth()) {
+        x = 0;
+        ++y;
+    }
+    if (y >= mMap->getHeight()) {
+        mSpan.x = 0;
+        mSpan.y = mMap->getHeight();
+        mSpan.length = 0;
+        return *this;
+    }
+    mSpan = mMap->spanAt(x, y);
+    return *this;
+}
+
+XYSpanRange::iterator XYSpanRange::end() const {
+    return iterator(mMap, mMap->getHeight());
 }
 
 void XYMap::convertToLookUpTable() {
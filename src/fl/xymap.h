@@ -35,6 +35,73 @@ FASTLED_FORCE_INLINE u16 xy_line_by_line(u16 x, u16 y,
 typedef u16 (*XYFunction)(u16 x, u16 y, u16 width,
                                u16 height);
 
+// A run of pixels in one row that are also next to each other in the led
+// buffer. Pixel (x + i, y) is at led index + step * i for i < length.
+struct XYSpan {
+    u16 x;
+    u16 y;
+    u16 length;
+    u16 index;
+    i8 step; // 1, or -1 for rows running backwards (odd serpentine rows).
+};
+
+// Copies span.length pixels from row, in x order, to the span in leds.
+FASTLED_FORCE_INLINE void writeSpan(CRGB *leds, const XYSpan &span,
+                                    const CRGB *row) {
+    CRGB *dst = leds + span.index;
+    if (span.step > 0) {
+        memcpy(static_cast<void *>(dst), row, sizeof(CRGB) * span.length);
+    } else {
+        for (u16 i = 0; i < span.length; ++i) {
+            *(dst - i) = row[i];
+        }
+    }
+}
+
+// Copies the span in leds to row, in x order.
+FASTLED_FORCE_INLINE void readSpan(const CRGB *leds, const XYSpan &span,
+                                   CRGB *row) {
+    const CRGB *src = leds + span.index;
+    if (span.step > 0) {
+        memcpy(static_cast<void *>(row), src, sizeof(CRGB) * span.length);
+    } else {
+        for (u16 i = 0; i < span.length; ++i) {
+            row[i] = *(src - i);
+        }
+    }
+}
+
+class XYMap;
+
+// Iterates the XYSpans of a map row by row, see XYMap::spans().
+class XYSpanRange {
+  public:
+    class iterator {
+      public:
+        iterator(const XYMap *map, u16 y);
+        const XYSpan &operator*() const { return mSpan; }
+        const XYSpan *operator->() const { return &mSpan; }
+        iterator &operator++();
+        bool operator==(const iterator &other) const {
+            return mSpan.y == other.mSpan.y && mSpan.x == other.mSpan.x;
+        }
+        bool operator!=(const iterator &other) const {
+            return !(*this == other);
+        }
+
+      private:
+        const XYMap *mMap;
+        XYSpan mSpan;
+    };
+
+    explicit XYSpanRange(const XYMap *map) : mMap(map) {}
+    iterator begin() const { return iterator(mMap, 0); }
+    iterator end() const;
+
+  private:
+    const XYMap *mMap;
+};
+
 // Maps x,y -> led index
 //
 // The common output led matrix you can buy on amazon is in a serpentine layout.
@@ -114,6 +181,18 @@ class XYMap {
     u16 getHeight() const;
     u16 getTotal() const;
     XyMapType getType() const;
+    u16 getOffset() const { return mOffset; }
+
+    // Longest run of pixels starting at (x, y) that is contiguous in the led
+    // buffer. Serpentine and line by line maps give the rest of the row,
+    // function and look up table maps are scanned for runs.
+    XYSpan spanAt(u16 x, u16 y) const;
+
+    // Every pixel exactly once as contiguous runs, row by row:
+    //   for (const XYSpan &span : xymap.spans()) {
+    //       writeSpan(leds, span, row + span.x);
+    //   }
+    XYSpanRange spans() const { return XYSpanRange(this); }
 
   private:
     XYMap(u16 width, u16 height, XyMapType type);
@@ -126,4 +205,90 @@ class XYMap {
     u16 mOffset = 0;      // offset to be added to the output
 };
 
+// Led layouts for XYMapT. Each one is a type, so the index math inlines into
+// the caller's loop instead of going through XYMap's switch per pixel.
+namespace xy_layout {
+
+struct LineByLine {
+    static XYMap::XyMapType type() { return XYMap::kLineByLine; }
+    static constexpr u16 index(u16 x, u16 y, u16 width) {
+        return y * width + x;
+    }
+    static constexpr i8 step(u16 y) { return (void)y, 1; }
+};
+
+struct Serpentine {
+    static XYMap::XyMapType type() { return XYMap::kSerpentine; }
+    static constexpr u16 index(u16 x, u16 y, u16 width) {
+        return (y & 1) ? (y + 1) * width - 1 - x : y * width + x;
+    }
+    static constexpr i8 step(u16 y) { return (y & 1) ? -1 : 1; }
+};
+
+} // namespace xy_layout
+
+// XYMap with the layout and the dimensions fixed at compile time.
+//
+//   using Panel = fl::XYMapT<fl::xy_layout::Serpentine, 32, 8>;
+//   Panel panel;
+//   panel.forEachRow([&](const fl::XYSpan &row) {
+//       fl::writeSpan(leds, row, image + row.y * Panel::width());
+//   });
+//
+// Its rows are the same spans as XYMap::spans() of the equivalent runtime
+// map. fromXYMap() checks whether a runtime XYMap has this layout and size,
+// so code can take a fast path for the panels it knows about and fall back to
+// XYMap otherwise.
+template <typename Layout, u16 W, u16 H> class XYMapT {
+  public:
+    using layout = Layout;
+
+    constexpr explicit XYMapT(u16 offset = 0) : mOffset(offset) {}
+
+    static constexpr u16 width() { return W; }
+    static constexpr u16 height() { return H; }
+    static constexpr u16 total() { return W * H; }
+
+    constexpr u16 operator()(u16 x, u16 y) const { return mapToIndex(x, y); }
+
+    // No wrapping of out of range coordinates, check has() first.
+    constexpr u16 mapToIndex(u16 x, u16 y) const {
+        return Layout::index(x, y, W) + mOffset;
+    }
+
+    static constexpr bool has(u16 x, u16 y) { return x < W && y < H; }
+
+    // Row y as a single contiguous run.
+    constexpr XYSpan row(u16 y) const {
+        return XYSpan{0, y, W, mapToIndex(0, y), Layout::step(y)};
+    }
+
+    template <typename Fn> FASTLED_FORCE_INLINE void forEachRow(Fn fn) const {
+        for (u16 y = 0; y < H; ++y) {
+            fn(row(y));
+        }
+    }
+
+    constexpr u16 getOffset() const { return mOffset; }
+
+    XYMap toXYMap() const {
+        return Layout::type() == XYMap::kSerpentine
+                   ? XYMap::constructSerpentine(W, H, mOffset)
+                   : XYMap::constructRectangularGrid(W, H, mOffset);
+    }
+
+    // True and *out set if xymap has this layout and size.
+    static bool fromXYMap(const XYMap &xymap, XYMapT *out) {
+        if (xymap.getType() != Layout::type() || xymap.getWidth() != W ||
+            xymap.getHeight() != H) {
+            return false;
+        }
+        *out = XYMapT(xymap.getOffset());
+        return true;
+    }
+
+  private:
+    u16 mOffset;
+};
+
 } // namespace fl
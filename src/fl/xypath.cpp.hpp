@@ -15,6 +15,7 @@
 #include "fl/map_range.h"
 #include "fl/math_macros.h"
 #include "fl/raster.h"
+#include "fl/splat.h"
 #include "fl/xypath.h"
 #include "fl/xypath_renderer.h"
 
@@ -52,6 +53,10 @@ void XYPath::setDrawBounds(u16 width, u16 height) {
 
 void XYPath::setScale(float scale) { mPathRenderer->setScale(scale); }
 
+void XYPath::setLutSize(u32 size) { mPathRenderer->setLutSize(size); }
+
+void XYPath::invalidateLut() { mPathRenderer->invalidateLut(); }
+
 string XYPath::name() const { return mPath->name(); }
 Tile2x2_u8 XYPath::at_subpixel(float alpha) {
     return mPathRenderer->at_subpixel(alpha);
@@ -77,15 +82,33 @@ XYPath::~XYPath() {}
 void XYPathRenderer::rasterize(
     float from, float to, int steps, XYRaster &raster,
     fl::function<u8(float)> *optional_alpha_gen) {
-    for (int i = 0; i < steps; ++i) {
-        float alpha = fl::map_range<int, float>(i, 0, steps - 1, from, to);
-        Tile2x2_u8 tile = at_subpixel(alpha);
-        if (optional_alpha_gen) {
-            // Scale the tile based on the alpha value.
-            u8 a8 = (*optional_alpha_gen)(alpha);
-            tile.scale(a8);
+    if (!mDrawBoundsSet) {
+        FASTLED_WARN("XYPathRenderer::rasterize: draw bounds not set");
+        return;
+    }
+    // Points are evaluated a batch at a time, so the path LUT (or the
+    // generator) runs in one tight loop before the splats go out.
+    enum { kBatch = 64 };
+    float alphas[kBatch];
+    vec2f points[kBatch];
+    for (int base = 0; base < steps; base += kBatch) {
+        const int count = steps - base < kBatch ? steps - base : kBatch;
+        for (int i = 0; i < count; ++i) {
+            alphas[i] =
+                fl::map_range<int, float>(base + i, 0, steps - 1, from, to);
+        }
+        at(span<const float>(alphas, count), points);
+        for (int i = 0; i < count; ++i) {
+            // Shift back so whole pixels go 0..W-1, same as at_subpixel().
+            Tile2x2_u8 tile =
+                splat(vec2f(points[i].x - 0.5f, points[i].y - 0.5f));
+            if (optional_alpha_gen) {
+                // Scale the tile based on the alpha value.
+                u8 a8 = (*optional_alpha_gen)(alphas[i]);
+                tile.scale(a8);
+            }
+            raster.rasterize(tile);
         }
-        raster.rasterize(tile);
     }
 }
 
@@ -272,18 +295,28 @@ void XYPath::drawColor(const CRGB &color, float from, float to, Leds *leds,
                        int steps) {
     XYRasterU8Sparse &raster = get_tls_raster();
     raster.clear();
+    // The panel is the footprint, so the splats land in the dense grid.
+    const XYMap &xymap = leds->xymap();
+    raster.setSize(xymap.getWidth(), xymap.getHeight());
     steps = steps > 0 ? steps : calculateSteps(from, to);
     rasterize(from, to, steps, raster);
     raster.draw(color, leds);
+    // The raster is shared, the next user must not inherit the panel.
+    raster.clearBounds();
 }
 
 void XYPath::drawGradient(const Gradient &gradient, float from, float to,
                           Leds *leds, int steps) {
     XYRasterU8Sparse &raster = get_tls_raster();
     raster.clear();
+    // The panel is the footprint, so the splats land in the dense grid.
+    const XYMap &xymap = leds->xymap();
+    raster.setSize(xymap.getWidth(), xymap.getHeight());
     steps = steps > 0 ? steps : calculateSteps(from, to);
     rasterize(from, to, steps, raster);
     raster.drawGradient(gradient, leds);
+    // The raster is shared, the next user must not inherit the panel.
+    raster.clearBounds();
 }
 
 int XYPath::calculateSteps(float from, float to) {
@@ -108,6 +108,10 @@ class XYPath : public Referent {
                    AlphaFunction *optional_alpha_gen = nullptr);
 
     void setScale(float scale);
+    // Path LUT used by rasterize() and the draw functions, see
+    // XYPathRenderer::setLutSize(). Off by default.
+    void setLutSize(u32 size);
+    void invalidateLut();
     string name() const;
     // Overloaded to allow transform to be passed in.
     vec2f at(float alpha, const TransformFloat &tx);
@@ -1,6 +1,7 @@
 
 
 #include <math.h>
+#include <string.h>
 
 #include "fl/assert.h"
 #include "fl/warn.h"
@@ -21,6 +22,74 @@ vec2f XYPathRenderer::compute_float(float alpha, const TransformFloat &tx) {
     return out;
 }
 
+void XYPathRenderer::at(span<const float> alphas, vec2f *out) {
+    const LUTXYFLOAT *lut = mLutSize >= 2 ? updateLut() : nullptr;
+    if (!lut) {
+        for (fl::size i = 0; i < alphas.size(); ++i) {
+            out[i] = compute_float(alphas[i], mTransform);
+        }
+        return;
+    }
+    const vec2f *points = lut->getData();
+    const u32 last = lut->size() - 1;
+    const float scale = float(last);
+    for (fl::size i = 0; i < alphas.size(); ++i) {
+        const float alpha = alphas[i];
+        if (!(alpha >= 0.0f && alpha <= 1.0f)) {
+            // Outside of the table, e.g. closed paths driven past 1.
+            out[i] = compute_float(alpha, mTransform);
+            continue;
+        }
+        const float pos = alpha * scale;
+        u32 index = static_cast<u32>(pos);
+        if (index >= last) {
+            index = last - 1;
+        }
+        const float t = pos - float(index);
+        const vec2f &a = points[index];
+        const vec2f &b = points[index + 1];
+        out[i] = vec2f(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+    }
+}
+
+void XYPathRenderer::setLutSize(u32 size) {
+    if (size != mLutSize) {
+        mLutSize = size;
+        mLut.reset();
+    }
+}
+
+XYPathRenderer::LutKey XYPathRenderer::lutKey() const {
+    LutKey key;
+    const TransformFloat *txs[2] = {&mTransform, &mGridTransform};
+    for (int i = 0; i < 2; ++i) {
+        const TransformFloat &tx = *txs[i];
+        key.values[i * 5 + 0] = tx.scale_x();
+        key.values[i * 5 + 1] = tx.scale_y();
+        key.values[i * 5 + 2] = tx.offset_x();
+        key.values[i * 5 + 3] = tx.offset_y();
+        key.values[i * 5 + 4] = tx.rotation();
+    }
+    return key;
+}
+
+const LUTXYFLOAT *XYPathRenderer::updateLut() {
+    // transform() hands out a reference, so changes are found by comparing
+    // the parameters rather than through onTransformFloatChanged().
+    const LutKey key = lutKey();
+    if (mLut && memcmp(&key, &mLutKey, sizeof(key)) == 0) {
+        return mLut.get();
+    }
+    mLutKey = key;
+    mLut = LUTXYFLOATPtr::New(mLutSize);
+    vec2f *points = mLut->getDataMutable();
+    const float scale = 1.0f / float(mLutSize - 1);
+    for (u32 i = 0; i < mLutSize; ++i) {
+        points[i] = compute_float(float(i) * scale, mTransform);
+    }
+    return mLut.get();
+}
+
 Tile2x2_u8 XYPathRenderer::at_subpixel(float alpha) {
     // 1) continuous point, in “pixel‐centers” coordinates [0.5 … W–0.5]
     if (!mDrawBoundsSet) {
@@ -9,7 +9,9 @@
 // #include "fl/raster.h"
 // #include "fl/xypath.h"
 #include "fl/function.h"
+#include "fl/lut.h"
 #include "fl/ptr.h"
+#include "fl/span.h"
 #include "fl/tile2x2.h"
 #include "fl/transform.h"
 
@@ -31,6 +33,19 @@ class XYPathRenderer : public Referent {
     // Overloaded to allow transform to be passed in.
     vec2f at(float alpha, const TransformFloat &tx);
 
+    // Batched at(): out[i] = at(alphas[i]). out must hold alphas.size()
+    // points. Uses the LUT when one is enabled.
+    void at(span<const float> alphas, vec2f *out);
+
+    // Caches the path in drawing coordinates at size evenly spaced alphas
+    // over [0, 1], batched lookups then interpolate between the entries
+    // instead of calling the generator. 0 turns the LUT off. The LUT is
+    // rebuilt on first use after a transform or draw bounds change, call
+    // invalidateLut() after changing the parameters of the generator.
+    void setLutSize(u32 size);
+    u32 getLutSize() const { return mLutSize; }
+    void invalidateLut() { mLut.reset(); }
+
     // Needed for drawing to the screen. When this called the rendering will
     // be centered on the width and height such that 0,0 -> maps to .5,.5,
     // which is convenient for drawing since each float pixel can be truncated
@@ -52,11 +67,22 @@ class XYPathRenderer : public Referent {
     vec2f compute(float alpha);
 
   private:
+    // Transform parameters the LUT was built with, both transforms.
+    struct LutKey {
+        float values[10];
+    };
+
     XYPathGeneratorPtr mPath;
     TransformFloat mTransform;
     TransformFloat mGridTransform;
     bool mDrawBoundsSet = false;
     vec2f compute_float(float alpha, const TransformFloat &tx);
+    LutKey lutKey() const;
+    const LUTXYFLOAT *updateLut();
+
+    u32 mLutSize = 0;
+    LUTXYFLOATPtr mLut;
+    LutKey mLutKey;
 };
 
 } // namespace fl
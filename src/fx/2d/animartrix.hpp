@@ -12,6 +12,7 @@
 #include "fl/namespace.h"
 #include "fl/ptr.h"
 #include "fl/scoped_ptr.h"
+#include "fl/vector.h"
 #include "fl/xymap.h"
 #include "fx/fx2d.h"
 #include "eorder.h"
@@ -100,6 +101,13 @@ class Animartrix : public Fx2d {
     void setColorOrder(EOrder order) { color_order = order; }
     EOrder getColorOrder() const { return color_order; }
 
+    // Renders the animations that have a fixed point port with integer math
+    // per pixel, for chips without an FPU. The others keep rendering in
+    // float. Defaults to FL_ANIMARTRIX_FIXED_POINT.
+    void setFixedPoint(bool on) { fixed_point = on; }
+    bool getFixedPoint() const { return fixed_point; }
+    static bool hasFixedPoint(AnimartrixAnim animation);
+
   private:
     friend void AnimartrixLoop(Animartrix &self, fl::u32 now);
     friend class FastLEDANIMartRIX;
@@ -109,6 +117,7 @@ class Animartrix : public Fx2d {
     CRGB *leds = nullptr; // Only set during draw, then unset back to nullptr.
     AnimartrixAnim current_animation = RGB_BLOBS5;
     EOrder color_order = RGB;
+    bool fixed_point = FL_ANIMARTRIX_FIXED_POINT;
 };
 
 void AnimartrixLoop(Animartrix &self, fl::u32 now);
@@ -128,22 +137,48 @@ class FastLEDANIMartRIX : public animartrix_detail::ANIMartRIX {
   public:
     FastLEDANIMartRIX(Animartrix *_data) {
         this->data = _data;
+        this->reset();
+    }
+
+    // Re-initializes the animation state. When every row of the map is a
+    // single run of leds, pixels are written through that row's span instead
+    // of a per pixel xyMap() lookup.
+    void reset() {
         this->init(data->getWidth(), data->getHeight());
+        mRows.clear();
+        for (const XYSpan &span : data->mXyMap.spans()) {
+            if (span.length != num_x) {
+                mRows.clear();
+                break;
+            }
+            mRows.push_back(span);
+        }
     }
 
     void setPixelColor(int x, int y, CRGB pixel) {
-        data->leds[xyMap(x, y)] = pixel;
+        if (mRows.empty()) {
+            data->leds[xyMap(x, y)] = pixel;
+            return;
+        }
+        const XYSpan &row = mRows[y];
+        data->leds[row.index + row.step * x] = pixel;
     }
     void setPixelColorInternal(int x, int y,
                                animartrix_detail::rgb pixel) override {
         setPixelColor(x, y, CRGB(pixel.red, pixel.green, pixel.blue));
     }
+    void setPixelColorInternal(int x, int y, CRGB pixel) override {
+        setPixelColor(x, y, pixel);
+    }
 
     uint16_t xyMap(uint16_t x, uint16_t y) override {
         return data->xyMap(x, y);
     }
 
     void loop();
+
+  private:
+    fl::vector<XYSpan> mRows; // One span per row, or empty.
 };
 
 void Animartrix::fxSet(int fx) {
@@ -163,7 +198,7 @@ void AnimartrixLoop(Animartrix &self, fl::u32 now) {
     if (self.prev_animation != self.current_animation) {
         if (self.impl) {
             // Re-initialize object.
-            self.impl->init(self.getWidth(), self.getHeight());
+            self.impl->reset();
         }
         self.prev_animation = self.current_animation;
     }
@@ -246,6 +281,32 @@ static const AnimartrixEntry ANIMATION_TABLE[] = {
      &FastLEDANIMartRIX::SM10},
 };
 
+// The animations with a fixed point version, see Animartrix::setFixedPoint().
+struct AnimartrixFixedEntry {
+    AnimartrixAnim anim;
+    void (FastLEDANIMartRIX::*func)();
+};
+
+static const AnimartrixFixedEntry FIXED_ANIMATION_TABLE[] = {
+    {RGB_BLOBS5, &FastLEDANIMartRIX::RGB_Blobs5_q16},
+    {RGB_BLOBS4, &FastLEDANIMartRIX::RGB_Blobs4_q16},
+    {RGB_BLOBS3, &FastLEDANIMartRIX::RGB_Blobs3_q16},
+    {RGB_BLOBS2, &FastLEDANIMartRIX::RGB_Blobs2_q16},
+    {RGB_BLOBS, &FastLEDANIMartRIX::RGB_Blobs_q16},
+    {POLAR_WAVES, &FastLEDANIMartRIX::Polar_Waves_q16},
+    {SLOW_FADE, &FastLEDANIMartRIX::Slow_Fade_q16},
+    {ZOOM, &FastLEDANIMartRIX::Zoom_q16},
+};
+
+bool Animartrix::hasFixedPoint(AnimartrixAnim animation) {
+    for (const auto &entry : FIXED_ANIMATION_TABLE) {
+        if (entry.anim == animation) {
+            return true;
+        }
+    }
+    return false;
+}
+
 fl::string getAnimartrixName(int animation) {
     if (animation < 0 || animation >= NUM_ANIMATIONS) {
         return "UNKNOWN";
@@ -254,6 +315,14 @@ fl::string getAnimartrixName(int animation) {
 }
 
 void FastLEDANIMartRIX::loop() {
+    if (data->fixed_point) {
+        for (const auto &entry : FIXED_ANIMATION_TABLE) {
+            if (entry.anim == data->current_animation) {
+                (this->*entry.func)();
+                return;
+            }
+        }
+    }
     for (const auto &entry : ANIMATION_TABLE) {
         if (entry.anim == data->current_animation) {
             (this->*entry.func)();
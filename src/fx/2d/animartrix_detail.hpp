@@ -59,6 +59,7 @@ License CC BY-NC 3.0
 #include "fl/namespace.h"
 #include "fl/math.h"
 #include "fl/compiler_control.h"
+#include "fl/sin32.h"
 
 #ifndef FL_ANIMARTRIX_USES_FAST_MATH
 #define FL_ANIMARTRIX_USES_FAST_MATH 1
@@ -69,6 +70,17 @@ License CC BY-NC 3.0
 //     * FL_ANIMARTRIX_USES_FAST_MATH 0: 143ms
 //     * FL_ANIMARTRIX_USES_FAST_MATH 1: 90ms
 
+// Default for Animartrix::setFixedPoint(): render the animations that have a
+// fixed point port without float math per pixel. On by default for chips
+// without an FPU.
+#ifndef FL_ANIMARTRIX_FIXED_POINT
+#if defined(__ARM_ARCH_6M__) || defined(__AVR__)
+#define FL_ANIMARTRIX_FIXED_POINT 1
+#else
+#define FL_ANIMARTRIX_FIXED_POINT 0
+#endif
+#endif
+
 
 #define FL_SIN_F(x) sinf(x)
 #define FL_COS_F(x) cosf(x)
@@ -141,6 +153,21 @@ struct rgb {
     float red, green, blue;
 };
 
+// render_parameters for render_value_q16(), in 16.16 fixed point. Angles are
+// in turns, 65536 per full circle. The noise space offsets already include
+// the scale, and the centre or z: offset_x is (offset_x + center_x) * scale_x
+// of the float version. Only their low 24 bits, one period of the noise,
+// are used, so they wrap freely.
+struct render_parameters_q16 {
+    fl::i32 dist = 0;
+    fl::u32 angle = 0;
+    fl::i32 scale_x = 6554; // 0.1
+    fl::i32 scale_y = 6554;
+    fl::u32 offset_x = 0, offset_y = 0, offset_z = 0;
+    fl::i32 low_limit = 0;
+    fl::i32 gain = 255 << 16; // 255 / (high_limit - low_limit)
+};
+
 static const uint8_t PERLIN_NOISE[] = {
     151, 160, 137, 91,  90,  15,  131, 13,  201, 95,  96,  53,  194, 233, 7,
     225, 140, 36,  103, 30,  69,  142, 8,   99,  37,  240, 21,  10,  23,  190,
@@ -161,12 +188,38 @@ static const uint8_t PERLIN_NOISE[] = {
     222, 114, 67,  29,  24,  72,  243, 141, 128, 195, 78,  66,  215, 61,  156,
     180};
 
+// sqrt(i << 26) for i = 16 to 64, for sqrt_q16().
+static const fl::u32 SQRT_TABLE[] = {
+    32768, 33776, 34756, 35708, 36636, 37540, 38424, 39287, 40132, 40960,
+    41771, 42567, 43348, 44115, 44869, 45611, 46341, 47059, 47767, 48465,
+    49152, 49830, 50499, 51159, 51811, 52454, 53090, 53719, 54340, 54954,
+    55561, 56162, 56756, 57344, 57926, 58503, 59073, 59639, 60199, 60753,
+    61303, 61848, 62388, 62924, 63455, 63982, 64504, 65022, 65536};
+
 FASTLED_FORCE_INLINE uint8_t P(uint8_t x) {
     const uint8_t idx = x & 255;
     const uint8_t *ptr = PERLIN_NOISE + idx;
     return *ptr;
 }
 
+// Per pixel look-up table in one contiguous block, indexed [x][y].
+template <typename T> class PolarTable {
+  public:
+    void resize(int w, int h) {
+        height = h;
+        data.clear();
+        data.resize(w * h, T());
+    }
+    void clear() { data.clear(); }
+    bool empty() const { return data.empty(); }
+    T *operator[](int x) { return data.data() + x * height; }
+    const T *operator[](int x) const { return data.data() + x * height; }
+
+  private:
+    fl::HeapVector<T> data;
+    int height = 0;
+};
+
 class ANIMartRIX {
 
   public:
@@ -184,10 +237,14 @@ class ANIMartRIX {
     modulators move; // all oscillator based movers and shifters at one place
     rgb pixel;
 
-    fl::HeapVector<fl::HeapVector<float>>
-        polar_theta; // look-up table for polar angles
-    fl::HeapVector<fl::HeapVector<float>>
-        distance; // look-up table for polar distances
+    PolarTable<float> polar_theta; // look-up table for polar angles
+    PolarTable<float> distance;    // look-up table for polar distances
+
+    // The same tables in 16.16 for the fixed point animations, built on
+    // their first frame: angles in turns, distances and 1 / distance.
+    PolarTable<fl::u32> polar_theta_q16;
+    PolarTable<fl::i32> distance_q16;
+    PolarTable<fl::i32> inv_distance_q16;
 
     unsigned long a, b, c; // for time measurements
 
@@ -404,8 +461,11 @@ class ANIMartRIX {
     // the polar coordinates
 
     void render_polar_lookup_table(float cx, float cy) {
-        polar_theta.resize(num_x, fl::HeapVector<float>(num_y, 0.0f));
-        distance.resize(num_x, fl::HeapVector<float>(num_y, 0.0f));
+        polar_theta.resize(num_x, num_y);
+        distance.resize(num_x, num_y);
+        polar_theta_q16.clear();
+        distance_q16.clear();
+        inv_distance_q16.clear();
 
         for (int xx = 0; xx < num_x; xx++) {
             for (int yy = 0; yy < num_y; yy++) {
@@ -419,6 +479,152 @@ class ANIMartRIX {
         }
     }
 
+    // Fixed point engine. The *_q16 animations draw the same picture as
+    // their float versions with integer math per pixel: the polar tables in
+    // 16.16, sin32/cos32 for the trig and pnoise_q16() for the noise. Their
+    // per frame setup, the oscillators and a few constants derived from
+    // them, stays float since it is a handful of values per frame. The
+    // output is close to the float engine, not bit identical.
+
+    void render_polar_lookup_table_q16() {
+        if (!distance_q16.empty()) {
+            return;
+        }
+        polar_theta_q16.resize(num_x, num_y);
+        distance_q16.resize(num_x, num_y);
+        inv_distance_q16.resize(num_x, num_y);
+        for (int xx = 0; xx < num_x; xx++) {
+            for (int yy = 0; yy < num_y; yy++) {
+                const float d = distance[xx][yy];
+                polar_theta_q16[xx][yy] = to_turns_q16(polar_theta[xx][yy]);
+                distance_q16[xx][yy] = to_q16(d);
+                inv_distance_q16[xx][yy] = d > 0 ? to_q16(1 / d) : 0;
+            }
+        }
+    }
+
+    static fl::i32 to_q16(float f) { return fl::i32(f * 65536.0f); }
+
+    // Radians to turns.
+    static fl::u32 to_turns_q16(float radians) {
+        return fl::u32(fl::i32(fmodf(radians, float(2 * PI)) *
+                               float(65536 / (2 * PI))));
+    }
+
+    // An offset in noise space, offset * scale, wrapped to one period.
+    static fl::u32 to_noise_q16(float offset, float scale) {
+        return fl::u32(fl::i32(fmodf(offset * scale, 256.0f) * 65536.0f));
+    }
+
+    static void set_limits_q16(render_parameters_q16 &p, float low,
+                               float high) {
+        p.low_limit = to_q16(low);
+        p.gain = to_q16(255.0f / (high - low));
+    }
+
+    static FASTLED_FORCE_INLINE fl::i32 mul_q16(fl::i32 a, fl::i32 b) {
+        return fl::i32((fl::i64(a) * b) >> 16);
+    }
+
+    // Square root in 16.16, within about 0.05%: the argument is shifted up
+    // to [2^30, 2^32) and the root interpolated in SQRT_TABLE.
+    static fl::i32 sqrt_q16(fl::i32 v) {
+        if (v <= 0) {
+            return 0;
+        }
+        fl::u32 n = fl::u32(v);
+        int half = 0; // half the shift, the root is scaled by 2^half
+        if (n < (fl::u32(1) << 16)) {
+            n <<= 16;
+            half += 8;
+        }
+        if (n < (fl::u32(1) << 24)) {
+            n <<= 8;
+            half += 4;
+        }
+        if (n < (fl::u32(1) << 28)) {
+            n <<= 4;
+            half += 2;
+        }
+        if (n < (fl::u32(1) << 30)) {
+            n <<= 2;
+            half += 1;
+        }
+        const fl::u32 *t = SQRT_TABLE + ((n >> 26) - 16);
+        const fl::u32 frac = (n >> 10) & 0xFFFF;
+        const fl::u32 root = t[0] + (((t[1] - t[0]) * frac) >> 16);
+        return fl::i32((root << 8) >> half);
+    }
+
+    // (radius - distance) / distance of the float radial filters.
+    fl::i32 radial_q16(int x, int y, fl::i32 radius) const {
+        return mul_q16(radius, inv_distance_q16[x][y]) - 65536;
+    }
+
+    // A 16.16 color value to a channel, clamped like rgb_sanity_check().
+    static fl::u8 to_channel_q16(fl::i64 v) {
+        return v <= 0 ? 0 : (v >= (255 << 16) ? 255 : fl::u8(v >> 16));
+    }
+
+    // pnoise() in 16.16, for coordinates in [0, 256).
+    static fl::i32 fade_q16(fl::i32 t) {
+        const fl::i32 t3 = fl::i32((fl::i64(t) * t >> 16) * t >> 16);
+        const fl::i32 inner = mul_q16(t, 6 * t - 15 * 65536) + 10 * 65536;
+        return mul_q16(t3, inner);
+    }
+    static FASTLED_FORCE_INLINE fl::i32 lerp_q16(fl::i32 t, fl::i32 a,
+                                                 fl::i32 b) {
+        return a + mul_q16(t, b - a);
+    }
+    static FASTLED_FORCE_INLINE fl::i32 grad_q16(int hash, fl::i32 x,
+                                                 fl::i32 y, fl::i32 z) {
+        const int h = hash & 15;
+        const fl::i32 u = h < 8 ? x : y,
+                      v = h < 4                ? y
+                          : h == 12 || h == 14 ? x
+                                               : z;
+        return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+    }
+
+    fl::i32 pnoise_q16(fl::u32 x, fl::u32 y, fl::u32 z) {
+        const fl::i32 one = 65536;
+        const int X = (x >> 16) & 255, Y = (y >> 16) & 255,
+                  Z = (z >> 16) & 255;
+        const fl::i32 fx = x & 0xFFFF, fy = y & 0xFFFF, fz = z & 0xFFFF;
+        const fl::i32 u = fade_q16(fx), v = fade_q16(fy), w = fade_q16(fz);
+        const int A = P(X) + Y, AA = P(A) + Z, AB = P(A + 1) + Z,
+                  B = P(X + 1) + Y, BA = P(B) + Z, BB = P(B + 1) + Z;
+
+        return lerp_q16(
+            w,
+            lerp_q16(v,
+                     lerp_q16(u, grad_q16(P(AA), fx, fy, fz),
+                              grad_q16(P(BA), fx - one, fy, fz)),
+                     lerp_q16(u, grad_q16(P(AB), fx, fy - one, fz),
+                              grad_q16(P(BB), fx - one, fy - one, fz))),
+            lerp_q16(v,
+                     lerp_q16(u, grad_q16(P(AA + 1), fx, fy, fz - one),
+                              grad_q16(P(BA + 1), fx - one, fy, fz - one)),
+                     lerp_q16(u, grad_q16(P(AB + 1), fx, fy - one, fz - one),
+                              grad_q16(P(BB + 1), fx - one, fy - one,
+                                       fz - one))));
+    }
+
+    // render_value() in fixed point, returns 0 to 255 in 16.16.
+    fl::i32 render_value_q16(const render_parameters_q16 &p) {
+        const fl::u32 turn = p.angle << 8; // sin32 has 2^24 per turn
+        const fl::i32 c = fl::cos32(turn) >> 15;
+        const fl::i32 s = fl::sin32(turn) >> 15;
+        const fl::u32 x =
+            p.offset_x - fl::u32(mul_q16(c, mul_q16(p.dist, p.scale_x)));
+        const fl::u32 y =
+            p.offset_y - fl::u32(mul_q16(s, mul_q16(p.dist, p.scale_y)));
+        const fl::i32 n =
+            pnoise_q16(x & 0xFFFFFF, y & 0xFFFFFF, p.offset_z & 0xFFFFFF);
+        const fl::i32 v = mul_q16(n - p.low_limit, p.gain);
+        return v < 0 ? 0 : (v > (255 << 16) ? (255 << 16) : v);
+    }
+
     // float mapping maintaining 32 bit precision
     // we keep values with high resolution for potential later usage
 
@@ -489,6 +695,12 @@ class ANIMartRIX {
 
     virtual void setPixelColorInternal(int x, int y, rgb pixel) = 0;
 
+    // For the fixed point animations, which have their color in bytes.
+    virtual void setPixelColorInternal(int x, int y, CRGB pixel) {
+        rgb p = {float(pixel.r), float(pixel.g), float(pixel.b)};
+        setPixelColorInternal(x, y, p);
+    }
+
     // virtual void setPixelColorInternal(int index, rgb pixel) = 0;
 
     void logOutput() { b = micros(); }
@@ -4086,6 +4298,402 @@ class ANIMartRIX {
             }
         }
     }
+
+    // Fixed point versions of the animations above, see
+    // render_polar_lookup_table_q16(). Each sets up its frame like the float
+    // one, then renders every pixel without float math.
+
+    void RGB_Blobs_q16() {
+
+        get_ready();
+
+        timings.master_speed = 0.2; // master speed
+
+        timings.ratio[0] = 0.0025; // speed ratios for the oscillators, higher
+                                   // values = faster transitions
+        timings.ratio[1] = 0.0027;
+        timings.ratio[2] = 0.0031;
+        timings.ratio[3] = 0.0033;
+        timings.ratio[4] = 0.0036;
+        timings.ratio[5] = 0.0039;
+
+        calculate_oscillators(timings);
+        render_polar_lookup_table_q16();
+
+        const float scale = 0.1;
+        const fl::u32 turn1 = to_turns_q16(
+            move.radial[0] + move.noise_angle[0] + move.noise_angle[3]);
+        const fl::u32 turn2 = to_turns_q16(
+            move.radial[1] + move.noise_angle[1] + move.noise_angle[4]);
+        const fl::u32 turn3 = to_turns_q16(
+            move.radial[2] + move.noise_angle[2] + move.noise_angle[5]);
+        const fl::u32 x1 =
+            to_noise_q16(10 * move.linear[0] + animation.center_x, scale);
+        const fl::u32 x2 =
+            to_noise_q16(11 * move.linear[1] + animation.center_x, scale);
+        const fl::u32 x3 =
+            to_noise_q16(12 * move.linear[2] + animation.center_x, scale);
+        const fl::u32 z1 = to_noise_q16(10, animation.scale_z);
+        const fl::u32 z2 = to_noise_q16(100, animation.scale_z);
+        const fl::u32 z3 = to_noise_q16(300, animation.scale_z);
+        const fl::i32 scale_z = to_q16(animation.scale_z);
+        const fl::i32 radius = to_q16(radial_filter_radius);
+
+        render_parameters_q16 p;
+        p.scale_x = p.scale_y = to_q16(scale);
+        p.offset_y = to_noise_q16(animation.center_y, scale);
+
+        for (int x = 0; x < num_x; x++) {
+            for (int y = 0; y < num_y; y++) {
+
+                p.dist = distance_q16[x][y];
+                const fl::u32 theta = polar_theta_q16[x][y];
+                const fl::u32 z = fl::u32(mul_q16(sqrt_q16(p.dist), scale_z));
+
+                p.angle = theta + turn1;
+                p.offset_x = x1;
+                p.offset_z = z1 + z;
+                const fl::i32 show1 = render_value_q16(p);
+
+                p.angle = theta + turn2;
+                p.offset_x = x2;
+                p.offset_z = z2 + z;
+                const fl::i32 show2 = render_value_q16(p);
+
+                p.angle = theta + turn3;
+                p.offset_x = x3;
+                p.offset_z = z3 + z;
+                const fl::i32 show3 = render_value_q16(p);
+
+                const fl::i64 radial = radial_q16(x, y, radius);
+
+                setPixelColorInternal(
+                    x, y,
+                    CRGB(to_channel_q16((radial * show1) >> 16),
+                         to_channel_q16((radial * show2) >> 16),
+                         to_channel_q16((radial * show3) >> 16)));
+            }
+        }
+    }
+
+    void RGB_Blobs2_q16() {
+
+        get_ready();
+
+        timings.master_speed = 0.12; // master speed
+
+        timings.ratio[0] = 0.0025; // speed ratios for the oscillators, higher
+                                   // values = faster transitions
+        timings.ratio[1] = 0.0027;
+        timings.ratio[2] = 0.0031;
+        timings.ratio[3] = 0.0033;
+        timings.ratio[4] = 0.0036;
+        timings.ratio[5] = 0.0039;
+
+        calculate_oscillators(timings);
+        render_polar_lookup_table_q16();
+
+        const float scale = 0.1;
+        const fl::u32 turn1 =
+            to_turns_q16(move.radial[0] + move.noise_angle[0] +
+                         move.noise_angle[3] + move.noise_angle[1]);
+        const fl::u32 turn2 =
+            to_turns_q16(move.radial[1] + move.noise_angle[1] +
+                         move.noise_angle[4] + move.noise_angle[2]);
+        const fl::u32 turn3 =
+            to_turns_q16(move.radial[2] + move.noise_angle[2] +
+                         move.noise_angle[5] + move.noise_angle[3]);
+        const fl::u32 x1 =
+            to_noise_q16(10 * move.linear[0] + animation.center_x, scale);
+        const fl::u32 x2 =
+            to_noise_q16(11 * move.linear[1] + animation.center_x, scale);
+        const fl::u32 x3 =
+            to_noise_q16(12 * move.linear[2] + animation.center_x, scale);
+        const fl::u32 z1 = to_noise_q16(10, animation.scale_z);
+        const fl::u32 z2 = to_noise_q16(100, animation.scale_z);
+        const fl::u32 z3 = to_noise_q16(300, animation.scale_z);
+        const fl::i32 scale_z = to_q16(animation.scale_z);
+        const fl::i32 radius = to_q16(radial_filter_radius);
+
+        render_parameters_q16 p;
+        p.scale_x = p.scale_y = to_q16(scale);
+        p.offset_y = to_noise_q16(animation.center_y, scale);
+
+        for (int x = 0; x < num_x; x++) {
+            for (int y = 0; y < num_y; y++) {
+
+                p.dist = distance_q16[x][y];
+                const fl::u32 theta = polar_theta_q16[x][y];
+                const fl::u32 z = fl::u32(mul_q16(sqrt_q16(p.dist), scale_z));
+
+                p.angle = theta + turn1;
+                p.offset_x = x1;
+                p.offset_z = z1 + z;
+                const fl::i32 show1 = render_value_q16(p);
+
+                p.angle = theta + turn2;
+                p.offset_x = x2;
+                p.offset_z = z2 + z;
+                const fl::i32 show2 = render_value_q16(p);
+
+                p.angle = theta + turn3;
+                p.offset_x = x3;
+                p.offset_z = z3 + z;
+                const fl::i32 show3 = render_value_q16(p);
+
+                const fl::i64 radial = radial_q16(x, y, radius);
+
+                setPixelColorInternal(
+                    x, y,
+                    CRGB(to_channel_q16((radial * (show1 - show3)) >> 16),
+                         to_channel_q16((radial * (show2 - show1)) >> 16),
+                         to_channel_q16((radial * (show3 - show2)) >> 16)));
+            }
+        }
+    }
+
+    // RGB_Blobs3 to 5 differ only in their speed, offsets and zoom.
+    void RGB_Blobs345_q16(float master_speed, const float (&offset)[3],
+                          float scale, float z_base, float radius_f) {
+
+        get_ready();
+
+        timings.master_speed = master_speed; // master speed
+
+        timings.ratio[0] = 0.0025; // speed ratios for the oscillators, higher
+                                   // values = faster transitions
+        timings.ratio[1] = 0.0027;
+        timings.ratio[2] = 0.0031;
+        timings.ratio[3] = 0.0033;
+        timings.ratio[4] = 0.0036;
+        timings.ratio[5] = 0.0039;
+
+        calculate_oscillators(timings);
+        render_polar_lookup_table_q16();
+
+        const fl::i32 grow = to_q16(move.noise_angle[4]);
+        const fl::u32 turn1 =
+            to_turns_q16(move.radial[0] + move.noise_angle[0] +
+                         move.noise_angle[3] + move.noise_angle[1]);
+        const fl::u32 turn2 =
+            to_turns_q16(move.radial[1] + move.noise_angle[1] +
+                         move.noise_angle[4] + move.noise_angle[2]);
+        const fl::u32 turn3 =
+            to_turns_q16(move.radial[2] + move.noise_angle[2] +
+                         move.noise_angle[5] + move.noise_angle[3]);
+        const fl::u32 x1 = to_noise_q16(
+            offset[0] * move.linear[0] + animation.center_x, scale);
+        const fl::u32 x2 = to_noise_q16(
+            offset[1] * move.linear[1] + animation.center_x, scale);
+        const fl::u32 x3 = to_noise_q16(
+            offset[2] * move.linear[2] + animation.center_x, scale);
+        const fl::u32 z1 = to_noise_q16(10 + z_base, animation.scale_z);
+        const fl::u32 z2 = to_noise_q16(100 + z_base, animation.scale_z);
+        const fl::u32 z3 = to_noise_q16(300 + z_base, animation.scale_z);
+        const fl::i32 scale_z = to_q16(animation.scale_z);
+        const fl::i32 radius = to_q16(radius_f);
+        const fl::i32 tenth = to_q16(0.1);
+        const fl::i32 thirtieth = to_q16(1 / 30.f);
+
+        render_parameters_q16 p;
+        p.scale_x = p.scale_y = to_q16(scale);
+        p.offset_y = to_noise_q16(animation.center_y, scale);
+
+        for (int x = 0; x < num_x; x++) {
+            for (int y = 0; y < num_y; y++) {
+
+                p.dist = distance_q16[x][y] + grow;
+                const fl::u32 theta = polar_theta_q16[x][y];
+                const fl::u32 z = fl::u32(mul_q16(sqrt_q16(p.dist), scale_z));
+
+                p.angle = theta + turn1;
+                p.offset_x = x1;
+                p.offset_z = z1 + z;
+                const fl::i32 show1 = render_value_q16(p);
+
+                p.angle = theta + turn2;
+                p.offset_x = x2;
+                p.offset_z = z2 + z;
+                const fl::i32 show2 = render_value_q16(p);
+
+                p.angle = theta + turn3;
+                p.offset_x = x3;
+                p.offset_z = z3 + z;
+                const fl::i32 show3 = render_value_q16(p);
+
+                const fl::i64 radial = radial_q16(x, y, radius);
+
+                // radial * (a + b) * 0.5 * dist / 5, * y / 15 and * x / 15
+                const fl::i64 red = (radial * (show1 + show3)) >> 16;
+                const fl::i64 green = (radial * (show2 + show1)) >> 16;
+                const fl::i64 blue = (radial * (show3 + show2)) >> 16;
+                setPixelColorInternal(
+                    x, y,
+                    CRGB(to_channel_q16((((red * p.dist) >> 16) * tenth) >> 16),
+                         to_channel_q16((green * y * thirtieth) >> 16),
+                         to_channel_q16((blue * x * thirtieth) >> 16)));
+            }
+        }
+    }
+
+    void RGB_Blobs3_q16() {
+        const float offset[3] = {10, 11, 12};
+        RGB_Blobs345_q16(0.12, offset, 0.1, 0, radial_filter_radius);
+    }
+
+    void RGB_Blobs4_q16() {
+        const float offset[3] = {50, 50, 50};
+        RGB_Blobs345_q16(0.02, offset, 0.1, 3, 23);
+    }
+
+    void RGB_Blobs5_q16() {
+        const float offset[3] = {50, 50, 50};
+        RGB_Blobs345_q16(0.02, offset, 0.05, 3, 23);
+    }
+
+    void Polar_Waves_q16() {
+
+        get_ready();
+
+        timings.master_speed = 0.5; // master speed
+
+        timings.ratio[0] = 0.0025; // speed ratios for the oscillators, higher
+                                   // values = faster transitions
+        timings.ratio[1] = 0.0027;
+        timings.ratio[2] = 0.0031;
+
+        calculate_oscillators(timings);
+        render_polar_lookup_table_q16();
+
+        const float scale = 0.15;
+        fl::u32 turn[3], offset_x[3], offset_z[3];
+        for (int i = 0; i < 3; i++) {
+            turn[i] = to_turns_q16(move.radial[i]);
+            offset_x[i] =
+                to_noise_q16(move.linear[i] + animation.center_x, scale);
+            offset_z[i] = to_noise_q16(-10 * move.linear[i], animation.scale_z);
+        }
+        const fl::i32 twist = to_q16(0.1 / (2 * PI)); // 0.1 radians in turns
+        const fl::i32 depth = to_q16(1.5 * animation.scale_z);
+        const fl::i32 radius = to_q16(radial_filter_radius);
+
+        render_parameters_q16 p;
+        p.scale_x = p.scale_y = to_q16(scale);
+        p.offset_y = to_noise_q16(animation.center_y, scale);
+
+        for (int x = 0; x < num_x; x++) {
+            for (int y = 0; y < num_y; y++) {
+
+                p.dist = distance_q16[x][y];
+                const fl::u32 theta =
+                    polar_theta_q16[x][y] - fl::u32(mul_q16(p.dist, twist));
+                const fl::u32 z = fl::u32(mul_q16(p.dist, depth));
+                fl::i32 show[3];
+                for (int i = 0; i < 3; i++) {
+                    p.angle = theta + turn[i];
+                    p.offset_x = offset_x[i];
+                    p.offset_z = offset_z[i] + z;
+                    show[i] = render_value_q16(p);
+                }
+
+                const fl::i64 radial = radial_q16(x, y, radius);
+
+                setPixelColorInternal(
+                    x, y,
+                    CRGB(to_channel_q16((radial * show[0]) >> 16),
+                         to_channel_q16((radial * show[1]) >> 16),
+                         to_channel_q16((radial * show[2]) >> 16)));
+            }
+        }
+    }
+
+    void Zoom_q16() {
+
+        get_ready();
+
+        run_default_oscillators();
+        timings.master_speed = 0.003;
+        calculate_oscillators(timings);
+        render_polar_lookup_table_q16();
+
+        const float scale = 0.005;
+        render_parameters_q16 p;
+        p.scale_x = p.scale_y = to_q16(scale);
+        p.offset_x = to_noise_q16(animation.center_x, scale);
+        p.offset_y =
+            to_noise_q16(-10 * move.linear[0] + animation.center_y, scale);
+        p.offset_z = 0;
+
+        for (int x = 0; x < num_x; x++) {
+            for (int y = 0; y < num_y; y++) {
+
+                const fl::i32 d = distance_q16[x][y];
+                p.dist = mul_q16(d, d) / 2;
+                p.angle = polar_theta_q16[x][y];
+                const fl::i32 show1 = render_value_q16(p);
+
+                setPixelColorInternal(x, y, CRGB(to_channel_q16(show1), 0, 0));
+            }
+        }
+    }
+
+    void Slow_Fade_q16() {
+
+        get_ready();
+
+        run_default_oscillators();
+        timings.master_speed = 0.00005;
+        calculate_oscillators(timings);
+        render_polar_lookup_table_q16();
+
+        const float scale = 0.11;
+        const fl::i32 stretch = to_q16(0.7 * (move.directional[0] + 1.5));
+        const fl::i32 twist = to_q16(0.2 / (2 * PI)); // distance / 5 in turns
+        const fl::u32 turn = fl::u32(0) - to_turns_q16(move.radial[0]);
+        const fl::u32 turn2 = to_turns_q16(move.noise_angle[0] / 10);
+        const fl::u32 turn3 = to_turns_q16(move.noise_angle[1] / 10);
+        const fl::i32 widen = to_q16(1.1);
+        const fl::i32 radius = to_q16(radial_filter_radius);
+        const fl::i32 sixth = to_q16(1 / 6.f);
+        const fl::i32 fifth = to_q16(1 / 5.f);
+
+        render_parameters_q16 p;
+        p.scale_x = p.scale_y = to_q16(scale);
+        p.offset_x = to_noise_q16(animation.center_x, scale);
+        p.offset_y =
+            to_noise_q16(-50 * move.linear[0] + animation.center_y, scale);
+        p.offset_z = to_noise_q16(move.linear[0], animation.scale_z);
+        set_limits_q16(p, -0.1, 1);
+
+        for (int x = 0; x < num_x; x++) {
+            for (int y = 0; y < num_y; y++) {
+
+                const fl::i32 d = distance_q16[x][y];
+                p.dist = mul_q16(sqrt_q16(d), stretch);
+                p.angle = polar_theta_q16[x][y] + turn +
+                          fl::u32(mul_q16(d, twist));
+                const fl::i32 show1 = render_value_q16(p);
+
+                p.dist = mul_q16(p.dist, widen);
+                p.angle += turn2;
+                const fl::i32 show2 = render_value_q16(p);
+
+                p.dist = mul_q16(p.dist, widen);
+                p.angle += turn3;
+                const fl::i32 show3 = render_value_q16(p);
+
+                const fl::i64 radial = radial_q16(x, y, radius);
+
+                const fl::i64 green = (radial * (show1 - show2)) >> 16;
+                const fl::i64 blue = (radial * (show1 - show3)) >> 16;
+                setPixelColorInternal(
+                    x, y,
+                    CRGB(to_channel_q16((radial * show1) >> 16),
+                         to_channel_q16((green * sixth) >> 16),
+                         to_channel_q16((blue * fifth) >> 16)));
+            }
+        }
+    }
 };
 
 } // namespace animartrix_detail
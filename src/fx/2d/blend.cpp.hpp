@@ -72,7 +72,12 @@ void Blend2d::draw(DrawContext context) {
         mFrame->draw(mFrameTransform->rgb(), mode);
     }
 
-    if (mGlobalBlurAmount > 0) {
+    if (mGlobalBoxBlur.radius() > 0) {
+        XYMap rect = XYMap::constructRectangularGrid(mXyMap.getWidth(),
+                                                     mXyMap.getHeight());
+        mGlobalBoxBlur.setPasses(MAX(1, mGlobalBlurPasses));
+        mGlobalBoxBlur.apply(mFrameTransform->rgb(), rect);
+    } else if (mGlobalBlurAmount > 0) {
         // Apply the blur effect
         uint16_t width = mXyMap.getWidth();
         uint16_t height = mXyMap.getHeight();
@@ -8,6 +8,7 @@ are blended by the the max luminance of the components.
 
 #include "fl/stdint.h"
 
+#include "fl/blur.h"
 #include "fl/namespace.h"
 #include "fl/ptr.h"
 #include "fl/vector.h"
@@ -43,6 +44,12 @@ class Blend2d : public Fx2d {
     void setGlobalBlurPasses(uint8_t blur_passes) {
         mGlobalBlurPasses = blur_passes;
     }
+    // Non zero replaces the global blur2d() passes with a BoxBlur2d of this
+    // radius, run setGlobalBlurPasses() times. A wide glow then costs one
+    // pass and the blur amount is ignored.
+    void setGlobalBlurRadius(uint16_t radius) {
+        mGlobalBoxBlur.setRadius(radius);
+    }
     bool setParams(Fx2dPtr fx, const Params &p);
     bool setParams(Fx2d &fx, const Params &p);
 
@@ -60,6 +67,7 @@ class Blend2d : public Fx2d {
     FramePtr mFrameTransform;
     uint8_t mGlobalBlurAmount = 0;
     uint8_t mGlobalBlurPasses = 1;
+    BoxBlur2d mGlobalBoxBlur = BoxBlur2d(0);
 };
 
 } // namespace fl
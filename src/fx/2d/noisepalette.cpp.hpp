@@ -5,6 +5,7 @@
 #endif
 
 #include "FastLED.h"
+#include "fl/array.h"
 #include "fl/ptr.h"
 #include "fl/xymap.h"
 #include "fx/fx2d.h"
@@ -108,8 +109,13 @@ void NoisePalette::setPalettePreset(int paletteIndex) {
 void NoisePalette::mapNoiseToLEDsUsingPalette(CRGB *leds) {
     static uint8_t ihue = 0;
 
-    for (uint16_t i = 0; i < width; i++) {
-        for (uint16_t j = 0; j < height; j++) {
+    // Row by row over contiguous runs of leds, so the xy map is consulted
+    // once per run instead of once per pixel.
+    for (const XYSpan &span : mXyMap.spans()) {
+        const uint16_t j = span.y;
+        CRGB *out = leds + span.index;
+        for (uint16_t k = 0; k < span.length; ++k, out += span.step) {
+            const uint16_t i = span.x + k;
             // We use the value at the (i,j) coordinate in the noise
             // array for our brightness, and the flipped value from (j,i)
             // for our pixel's index into the color palette.
@@ -130,8 +136,7 @@ void NoisePalette::mapNoiseToLEDsUsingPalette(CRGB *leds) {
                 bri = dim8_raw(bri * 2);
             }
 
-            CRGB color = ColorFromPalette(currentPalette, index, bri);
-            leds[XY(i, j)] = color;
+            *out = ColorFromPalette(currentPalette, index, bri);
         }
     }
 
@@ -148,12 +153,13 @@ void NoisePalette::fillnoise8() {
         dataSmoothing = 200 - (speed * 4);
     }
 
-    for (uint16_t i = 0; i < width; i++) {
-        int ioffset = scale * i;
-        for (uint16_t j = 0; j < height; j++) {
-            int joffset = scale * j;
-
-            uint8_t data = inoise8(mX + ioffset, mY + joffset, mZ);
+    // One row of x at a time, so the noise is evaluated as a batch.
+    FASTLED_STACK_ARRAY(uint8_t, row, width);
+    for (uint16_t j = 0; j < height; j++) {
+        int joffset = scale * j;
+        inoise8_row(row, width, mX, scale, mY + joffset, mZ);
+        for (uint16_t i = 0; i < width; i++) {
+            uint8_t data = row[i];
 
             // The range of the inoise8 function is roughly 16-238.
             // These two operations expand those values out to roughly
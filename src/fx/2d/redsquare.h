@@ -40,6 +40,13 @@ class RedSquare : public Fx2d {
         }
     }
 
+    // The square never moves, so there is nothing to redraw.
+    bool hasChangedSince(fl::u32 lastDrawTime, fl::u32 now) const override {
+        FASTLED_UNUSED(lastDrawTime);
+        FASTLED_UNUSED(now);
+        return false;
+    }
+
     fl::string fxName() const override { return "red_square"; }
 };
 
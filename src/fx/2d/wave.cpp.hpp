@@ -49,13 +49,10 @@ struct BatchDraw {
 void WaveCrgbGradientMap::mapWaveToLEDs(const XYMap &xymap,
                                         WaveSimulation2D &waveSim, CRGB *leds) {
     BatchDraw batch(leds, &mGradient);
-    const fl::u32 width = waveSim.getWidth();
-    const fl::u32 height = waveSim.getHeight();
-    for (fl::u32 y = 0; y < height; y++) {
-        for (fl::u32 x = 0; x < width; x++) {
-            fl::u32 idx = xymap(x, y);
-            uint8_t value8 = waveSim.getu8(x, y);
-            batch.push(idx, value8);
+    for (const XYSpan &span : xymap.spans()) {
+        for (fl::u16 i = 0; i < span.length; i++) {
+            uint8_t value8 = waveSim.getu8(span.x + i, span.y);
+            batch.push(span.index + span.step * i, value8);
         }
     }
     batch.flush();
@@ -33,13 +33,11 @@ class WaveCrgbMapDefault : public WaveCrgbMap {
   public:
     void mapWaveToLEDs(const XYMap &xymap, WaveSimulation2D &waveSim,
                        CRGB *leds) override {
-        const fl::u32 width = waveSim.getWidth();
-        const fl::u32 height = waveSim.getHeight();
-        for (fl::u32 y = 0; y < height; y++) {
-            for (fl::u32 x = 0; x < width; x++) {
-                fl::u32 idx = xymap(x, y);
-                uint8_t value8 = waveSim.getu8(x, y);
-                leds[idx] = CRGB(value8, value8, value8);
+        for (const XYSpan &span : xymap.spans()) {
+            CRGB *out = leds + span.index;
+            for (fl::u16 i = 0; i < span.length; i++) {
+                uint8_t value8 = waveSim.getu8(span.x + i, span.y);
+                out[span.step * i] = CRGB(value8, value8, value8);
             }
         }
     }
@@ -5,8 +5,10 @@
 
 #include "crgb.h"
 #include "fl/namespace.h"
+#include "fl/pixel_blend.h"
 #include "fl/ptr.h"
 #include "fl/vector.h"
+#include "fl/warn.h"
 #include "fx/detail/fx_layer.h"
 #include "fx/fx.h"
 
@@ -16,7 +18,14 @@
 
 namespace fl {
 
-// Takes two fx layers and composites them together to a final output buffer.
+// Composites the current fx (and the next one while a transition is running)
+// plus any number of overlay layers into a final output buffer. Each overlay
+// has its own blend mode and opacity, and all layers are applied in a single
+// tiled pass over the output, see compositeLayers().
+//
+// With change tracking enabled the compositor asks each fx whether it changed
+// since its last draw, and when nothing changed the output buffer is left
+// untouched, so the caller must not modify it between frames.
 class FxCompositor {
   public:
     FxCompositor(fl::u32 numLeds) : mNumLeds(numLeds) {
@@ -26,6 +35,7 @@ class FxCompositor {
 
     void startTransition(fl::u32 now, fl::u32 duration, fl::Ptr<Fx> nextFx) {
         completeTransition();
+        mDirty = true;
         if (duration == 0) {
             mLayers[0]->setFx(nextFx);
             return;
@@ -38,11 +48,68 @@ class FxCompositor {
         if (mLayers[1]->getFx()) {
             swapLayers();
             mLayers[1]->release();
+            mDirty = true;
         }
         mTransition.end();
     }
 
-    void draw(fl::u32 now, fl::u32 warpedTime, CRGB *finalBuffer);
+    // Stacks an overlay on top of the base fx, overlays are drawn in the order
+    // they were added. Returns the overlay index or -1 if the fx is too small
+    // to cover the output.
+    int addLayer(fl::Ptr<Fx> fx, BlendMode mode = BLEND_MODE_ALPHA,
+                 fl::u8 opacity = 255) {
+        if (!fx || fx->getNumLeds() < mNumLeds) {
+            FASTLED_WARN("FxCompositor: overlay fx must cover all leds");
+            return -1;
+        }
+        FxLayerPtr layer = FxLayerPtr::New();
+        layer->setFx(fx);
+        layer->setBlendMode(mode);
+        layer->setOpacity(opacity);
+        mOverlays.push_back(layer);
+        mDirty = true;
+        return static_cast<int>(mOverlays.size()) - 1;
+    }
+
+    bool setLayerBlend(int index, BlendMode mode, fl::u8 opacity) {
+        FxLayerPtr layer = getLayer(index);
+        if (!layer) {
+            return false;
+        }
+        layer->setBlendMode(mode);
+        layer->setOpacity(opacity);
+        mDirty = true;
+        return true;
+    }
+
+    bool removeLayer(int index) {
+        FxLayerPtr layer = getLayer(index);
+        if (!layer) {
+            return false;
+        }
+        layer->release();
+        mOverlays.erase(mOverlays.begin() + index);
+        mDirty = true;
+        return true;
+    }
+
+    FxLayerPtr getLayer(int index) {
+        if (index < 0 || index >= static_cast<int>(mOverlays.size())) {
+            return FxLayerPtr();
+        }
+        return mOverlays[index];
+    }
+
+    fl::size numLayers() const { return mOverlays.size(); }
+
+    void setChangeTracking(bool enabled) {
+        mChangeTracking = enabled;
+        mDirty = true;
+    }
+    bool changeTracking() const { return mChangeTracking; }
+
+    // Returns true if finalBuffer was written.
+    bool draw(fl::u32 now, fl::u32 warpedTime, CRGB *finalBuffer);
 
   private:
     void swapLayers() {
@@ -51,35 +118,71 @@ class FxCompositor {
         mLayers[1] = tmp;
     }
 
+    static BlendLayer toBlendLayer(FxLayer &layer, BlendMode mode,
+                                   fl::u8 opacity) {
+        BlendLayer out;
+        out.pixels = layer.getSurface();
+        out.mode = mode;
+        out.opacity = opacity;
+        return out;
+    }
+
     FxLayerPtr mLayers[2];
+    fl::vector<FxLayerPtr> mOverlays;
+    fl::vector<BlendLayer> mStack; // Reused every frame, no allocations.
     const fl::u32 mNumLeds;
     Transition mTransition;
+    bool mChangeTracking = false;
+    bool mDirty = true; // Layer stack changed since the last output.
 };
 
-inline void FxCompositor::draw(fl::u32 now, fl::u32 warpedTime,
+inline bool FxCompositor::draw(fl::u32 now, fl::u32 warpedTime,
                                CRGB *finalBuffer) {
     if (!mLayers[0]->getFx()) {
-        return;
+        return false;
     }
-    mLayers[0]->draw(warpedTime);
+    bool changed = mLayers[0]->draw(warpedTime, mChangeTracking);
     uint8_t progress = mTransition.getProgress(now);
-    if (!progress) {
+    if (progress) {
+        changed = true;
+    }
+    for (fl::size i = 0; i < mOverlays.size(); ++i) {
+        FxLayer &overlay = *mOverlays[i];
+        if (overlay.getOpacity() &&
+            overlay.draw(warpedTime, mChangeTracking)) {
+            changed = true;
+        }
+    }
+    if (mChangeTracking && !changed && !mDirty) {
+        return false;
+    }
+    mDirty = false;
+    if (!progress && mOverlays.empty()) {
         memcpy(finalBuffer, mLayers[0]->getSurface(), sizeof(CRGB) * mNumLeds);
-        return;
+        return true;
     }
-    mLayers[1]->draw(warpedTime);
-    const CRGB *surface0 = mLayers[0]->getSurface();
-    const CRGB *surface1 = mLayers[1]->getSurface();
-
-    for (fl::u32 i = 0; i < mNumLeds; i++) {
-        const CRGB &p0 = surface0[i];
-        const CRGB &p1 = surface1[i];
-        CRGB out = CRGB::blend(p0, p1, progress);
-        finalBuffer[i] = out;
+    mStack.clear();
+    mStack.push_back(toBlendLayer(*mLayers[0], BLEND_MODE_ALPHA, 255));
+    if (progress) {
+        // The incoming fx is cross faded in with the transition progress,
+        // which is bit exact with CRGB::blend(surface0, surface1, progress).
+        mLayers[1]->draw(warpedTime, mChangeTracking);
+        mStack.push_back(
+            toBlendLayer(*mLayers[1], BLEND_MODE_ALPHA, progress));
+    }
+    for (fl::size i = 0; i < mOverlays.size(); ++i) {
+        FxLayer &overlay = *mOverlays[i];
+        if (!overlay.getOpacity()) {
+            continue;
+        }
+        mStack.push_back(toBlendLayer(overlay, overlay.getBlendMode(),
+                                      overlay.getOpacity()));
     }
+    compositeLayers(finalBuffer, mStack.data(), mStack.size(), mNumLeds);
     if (progress == 255) {
         completeTransition();
     }
+    return true;
 }
 
 } // namespace fl
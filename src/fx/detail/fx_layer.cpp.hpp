@@ -5,6 +5,7 @@
 #include "fx_layer.h"
 
 
+#include "fl/frame_profiler.h"
 #include "fl/memfill.h"
 
 namespace fl {
@@ -16,7 +17,7 @@ void FxLayer::setFx(fl::Ptr<Fx> newFx) {
     }
 }
 
-void FxLayer::draw(fl::u32 now) {
+bool FxLayer::draw(fl::u32 now, bool trackChanges) {
     // assert(fx);
     if (!frame) {
         frame = FramePtr::New(fx->getNumLeds());
@@ -27,9 +28,23 @@ void FxLayer::draw(fl::u32 now) {
         fl::memfill((uint8_t*)frame->rgb(), 0, frame->size() * sizeof(CRGB));
         fx->resume(now);
         running = true;
+        drawn = false;
+    }
+    if (trackChanges && drawn && !fx->hasChangedSince(lastDrawTime, now)) {
+        return false;
     }
     Fx::DrawContext context = {now, frame->rgb()};
-    fx->draw(context);
+    fl::FrameProfiler *profiler = fl::FrameProfiler::active();
+    if (profiler) {
+        const fl::u32 start = micros();
+        fx->draw(context);
+        profiler->recordFx(fx, micros() - start);
+    } else {
+        fx->draw(context);
+    }
+    lastDrawTime = now;
+    drawn = true;
+    return true;
 }
 
 void FxLayer::pause(fl::u32 now) {
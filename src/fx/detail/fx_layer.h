@@ -4,6 +4,7 @@
 #include "fl/stdint.h"
 #include "crgb.h"
 #include "fl/namespace.h"
+#include "fl/pixel_blend.h"
 #include "fl/ptr.h"
 #include "fl/vector.h"
 #include "fl/warn.h"
@@ -18,7 +19,9 @@ class FxLayer : public fl::Referent {
   public:
     void setFx(fl::Ptr<Fx> newFx);
 
-    void draw(fl::u32 now);
+    // Returns true if the surface was redrawn. With trackChanges set the fx
+    // is skipped when it reports no change since the last draw.
+    bool draw(fl::u32 now, bool trackChanges = false);
 
     void pause(fl::u32 now);
 
@@ -28,10 +31,20 @@ class FxLayer : public fl::Referent {
 
     CRGB *getSurface();
 
+    // How this layer is combined with the layers below it by the compositor.
+    void setBlendMode(BlendMode mode) { blendMode = mode; }
+    BlendMode getBlendMode() const { return blendMode; }
+    void setOpacity(fl::u8 value) { opacity = value; }
+    fl::u8 getOpacity() const { return opacity; }
+
   private:
     fl::Ptr<Frame> frame;
     fl::Ptr<Fx> fx;
     bool running = false;
+    bool drawn = false;
+    fl::u32 lastDrawTime = 0;
+    BlendMode blendMode = BLEND_MODE_ALPHA;
+    fl::u8 opacity = 255;
 };
 
 } // namespace fl
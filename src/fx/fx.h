@@ -36,6 +36,16 @@ class Fx : public fl::Referent {
         return false;
     }
 
+    // Change tracking, only consulted when the FxEngine has change tracking
+    // enabled. Return false if a draw() at `now` would produce exactly the
+    // same pixels as the last draw() at `lastDrawTime`, the previous frame is
+    // then reused and draw() is not called. The default is to always redraw.
+    virtual bool hasChangedSince(fl::u32 lastDrawTime, fl::u32 now) const {
+        FASTLED_UNUSED(lastDrawTime);
+        FASTLED_UNUSED(now);
+        return true;
+    }
+
     // Get the name of the current fx.
     virtual fl::string fxName() const = 0;
 
@@ -12,7 +12,9 @@
 #include "fx/frame.cpp.hpp"
 #include "fx/fx_engine.cpp.hpp"
 #include "fx/time.cpp.hpp"
+#include "fx/video/compressed_video.cpp.hpp"
 #include "fx/video/frame_interpolator.cpp.hpp"
+#include "fx/video/frame_prefetcher.cpp.hpp"
 #include "fx/video/frame_tracker.cpp.hpp"
 #include "fx/video/pixel_stream.cpp.hpp"
 #include "fx/video/video_impl.cpp.hpp"
@@ -83,6 +83,7 @@ bool FxEngine::draw(fl::u32 now, CRGB *finalBuffer) {
     mTimeFunction.update(now);
     fl::u32 warpedTime = mTimeFunction.time();
 
+    mLastFrameChanged = false;
     if (mEffects.empty()) {
         return false;
     }
@@ -97,7 +98,7 @@ bool FxEngine::draw(fl::u32 now, CRGB *finalBuffer) {
         mDurationSet = false;
     }
     if (!mEffects.empty()) {
-        mCompositor.draw(now, warpedTime, finalBuffer);
+        mLastFrameChanged = mCompositor.draw(now, warpedTime, finalBuffer);
     }
     return true;
 }
@@ -103,6 +103,52 @@ class FxEngine {
      */
     bool setNextFx(int index, uint16_t duration);
 
+    /**
+     * @brief Stacks an overlay effect on top of the current effect. Overlays
+     * keep running across transitions and are composited in a single pass.
+     * @param effect The overlay effect, must cover all leds.
+     * @param mode How the overlay is combined with the layers below it.
+     * @param opacity Strength of the overlay, 0 disables it.
+     * @return The overlay index, or -1 if the overlay couldn't be added.
+     */
+    int addLayer(FxPtr effect, BlendMode mode = BLEND_MODE_ALPHA,
+                 fl::u8 opacity = 255) {
+        return mCompositor.addLayer(effect, mode, opacity);
+    }
+
+    /**
+     * @brief Changes the blend mode and opacity of an overlay.
+     * @return False if the index was invalid.
+     */
+    bool setLayerBlend(int index, BlendMode mode, fl::u8 opacity) {
+        return mCompositor.setLayerBlend(index, mode, opacity);
+    }
+
+    /**
+     * @brief Removes an overlay, the indices of the overlays above it shift
+     * down by one.
+     * @return False if the index was invalid.
+     */
+    bool removeLayer(int index) { return mCompositor.removeLayer(index); }
+
+    /**
+     * @brief Opt-in change tracking. Effects that report no change via
+     * Fx::hasChangedSince() are not redrawn, and when no layer changed the
+     * output buffer is not written at all. The output buffer must therefore
+     * not be modified by the caller between frames.
+     * @param enabled True to enable change tracking.
+     */
+    void setChangeTracking(bool enabled) {
+        mCompositor.setChangeTracking(enabled);
+    }
+
+    /**
+     * @brief Whether the last call to draw() wrote new pixels to the output
+     * buffer. False when no effect is installed, otherwise always true
+     * unless change tracking is enabled.
+     */
+    bool lastFrameChanged() const { return mLastFrameChanged; }
+
     IntFxMap &_getEffects() { return mEffects; }
 
     /**
@@ -123,6 +169,7 @@ class FxEngine {
     bool mDurationSet =
         false; ///< Flag indicating if a new transition has been set
     bool mInterpolate = true;
+    bool mLastFrameChanged = false;
 };
 
 } // namespace fl
@@ -35,6 +35,13 @@ void Video::setFade(fl::u32 fadeInTime, fl::u32 fadeOutTime) {
     mImpl->setFade(fadeInTime, fadeOutTime);
 }
 
+void Video::setPrefetch(fl::u32 lookaheadFrames) {
+    if (!mImpl) {
+        return;
+    }
+    mImpl->setPrefetch(lookaheadFrames);
+}
+
 void Video::pause(fl::u32 now) { mImpl->pause(now); }
 
 void Video::resume(fl::u32 now) { mImpl->resume(now); }
@@ -69,6 +69,9 @@ class Video : public Fx1d { // Fx1d because video can be irregular.
     void pause(fl::u32 now) override;
     void resume(fl::u32 now) override;
     void setFade(fl::u32 fadeInTime, fl::u32 fadeOutTime);
+    // Number of frames to decode ahead of playback on a background worker,
+    // 0 (the default) reads frames on demand from draw(). File videos only.
+    void setPrefetch(fl::u32 lookaheadFrames);
     int32_t durationMicros() const; // -1 if this is a stream.
 
     // make compatible with if statements
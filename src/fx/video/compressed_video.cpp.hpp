@@ -0,0 +1,302 @@
+#include <string.h>
+
+#include "fx/video/compressed_video.h"
+
+#include "fl/dbg.h"
+#include "fl/namespace.h"
+#include "fl/warn.h"
+
+#define DBG FASTLED_DBG
+
+namespace fl {
+
+namespace {
+
+const fl::u8 kMagic[4] = {'F', 'L', 'C', 'V'};
+const fl::u32 kMaxOpCount = 64;
+
+fl::u32 readU32(const fl::u8 *p) {
+    return fl::u32(p[0]) | (fl::u32(p[1]) << 8) | (fl::u32(p[2]) << 16) |
+           (fl::u32(p[3]) << 24);
+}
+
+void writeU32(fl::u32 v, fl::u8 *p) {
+    p[0] = fl::u8(v);
+    p[1] = fl::u8(v >> 8);
+    p[2] = fl::u8(v >> 16);
+    p[3] = fl::u8(v >> 24);
+}
+
+void appendU32(fl::u32 v, fl::vector<fl::u8> *out) {
+    fl::u8 bytes[4];
+    writeU32(v, bytes);
+    for (int i = 0; i < 4; ++i) {
+        out->push_back(bytes[i]);
+    }
+}
+
+void appendOp(fl::u8 op, fl::u32 count, fl::vector<fl::u8> *out) {
+    out->push_back(fl::u8((op << 6) | (count - 1)));
+}
+
+void appendPixel(const CRGB &c, fl::vector<fl::u8> *out) {
+    out->push_back(c.r);
+    out->push_back(c.g);
+    out->push_back(c.b);
+}
+
+bool readExact(fl::FileHandle *h, fl::u8 *dst, fl::size n) {
+    return h->read(dst, n) == n;
+}
+
+} // namespace
+
+bool CompressedVideoDecoder::isCompressed(fl::FileHandlePtr h) {
+    if (!h || h->size() < kHeaderSize) {
+        return false;
+    }
+    fl::u8 magic[4] = {};
+    h->seek(0);
+    bool ok = readExact(h.get(), magic, 4) && memcmp(magic, kMagic, 4) == 0;
+    h->seek(0);
+    return ok;
+}
+
+bool CompressedVideoDecoder::begin(fl::FileHandlePtr h) {
+    close();
+    fl::u8 header[kHeaderSize];
+    h->seek(0);
+    if (!readExact(h.get(), header, kHeaderSize) ||
+        memcmp(header, kMagic, 4) != 0) {
+        FASTLED_WARN("CompressedVideoDecoder: not a compressed video");
+        return false;
+    }
+    if (header[4] != kVersion) {
+        FASTLED_WARN("CompressedVideoDecoder: unsupported version "
+                     << int(header[4]));
+        return false;
+    }
+    mPixelsPerFrame = readU32(header + 8);
+    mFrameCount = readU32(header + 12);
+    mKeyframeInterval = readU32(header + 16);
+    const fl::u32 indexOffset = readU32(header + 20);
+    if (mKeyframeInterval == 0 || mPixelsPerFrame == 0) {
+        FASTLED_WARN("CompressedVideoDecoder: bad header");
+        return false;
+    }
+    const fl::u32 numKeyframes =
+        (mFrameCount + mKeyframeInterval - 1) / mKeyframeInterval;
+    const fl::u64 fileSize = h->size();
+    if (fl::u64(indexOffset) + 4ull * numKeyframes > fileSize) {
+        FASTLED_WARN("CompressedVideoDecoder: truncated keyframe index");
+        return false;
+    }
+    mKeyframes.resize(numKeyframes);
+    h->seek(indexOffset);
+    for (fl::u32 i = 0; i < numKeyframes; ++i) {
+        fl::u8 offset[4];
+        if (!readExact(h.get(), offset, 4)) {
+            FASTLED_WARN("CompressedVideoDecoder: truncated keyframe index");
+            mKeyframes.clear();
+            return false;
+        }
+        mKeyframes[i] = readU32(offset);
+        if (fl::u64(mKeyframes[i]) + kRecordHeaderSize > fileSize) {
+            FASTLED_WARN("CompressedVideoDecoder: keyframe " << i
+                                                            << " past the end");
+            mKeyframes.clear();
+            return false;
+        }
+    }
+    mRef.resize(mPixelsPerFrame);
+    mHandle = h;
+    return true;
+}
+
+void CompressedVideoDecoder::close() {
+    mHandle.reset();
+    mKeyframes.clear();
+    mRefFrame = -1;
+    mNextOffset = 0;
+}
+
+bool CompressedVideoDecoder::applyOps(const fl::u8 *ops, fl::size size,
+                                      CRGB *frame, fl::u32 numPixels) {
+    fl::u32 pixel = 0;
+    fl::size i = 0;
+    while (i < size) {
+        const fl::u8 control = ops[i++];
+        const fl::u32 count = (control & 0x3f) + 1u;
+        if (pixel + count > numPixels) {
+            return false;
+        }
+        switch (control >> 6) {
+        case kOpSkip:
+            break;
+        case kOpRun: {
+            if (i + 3 > size) {
+                return false;
+            }
+            const CRGB c(ops[i], ops[i + 1], ops[i + 2]);
+            i += 3;
+            for (fl::u32 k = 0; k < count; ++k) {
+                frame[pixel + k] = c;
+            }
+            break;
+        }
+        case kOpLiteral:
+            if (i + 3 * count > size) {
+                return false;
+            }
+            memcpy(static_cast<void *>(frame + pixel), ops + i, 3 * count);
+            i += 3 * count;
+            break;
+        default:
+            return false;
+        }
+        pixel += count;
+    }
+    return true;
+}
+
+bool CompressedVideoDecoder::decodeNext() {
+    fl::u8 recordHeader[kRecordHeaderSize];
+    mHandle->seek(mNextOffset);
+    if (!readExact(mHandle.get(), recordHeader, kRecordHeaderSize)) {
+        return false;
+    }
+    const fl::u32 size = readU32(recordHeader + 1);
+    // The largest payload is one literal op per pixel.
+    const fl::u64 maxSize = 1 + 4ull * mPixelsPerFrame;
+    const fl::u64 end = fl::u64(mNextOffset) + kRecordHeaderSize + size;
+    if (size > maxSize || end > mHandle->size()) {
+        FASTLED_WARN("CompressedVideoDecoder: bad record size " << size);
+        return false;
+    }
+    mPayload.resize(size);
+    if (!readExact(mHandle.get(), mPayload.data(), size)) {
+        return false;
+    }
+    if (recordHeader[0] == kKeyFrame) {
+        memset(static_cast<void *>(mRef.data()), 0,
+               sizeof(CRGB) * mPixelsPerFrame);
+    }
+    if (!applyOps(mPayload.data(), size, mRef.data(), mPixelsPerFrame)) {
+        FASTLED_WARN("CompressedVideoDecoder: corrupt frame "
+                     << (mRefFrame + 1));
+        mRefFrame = -1;
+        return false;
+    }
+    mNextOffset = fl::u32(end);
+    return true;
+}
+
+bool CompressedVideoDecoder::readFrameAt(fl::u32 frameNumber, CRGB *dst) {
+    if (!mHandle || frameNumber >= mFrameCount) {
+        return false;
+    }
+    const fl::u32 keyframe = frameNumber / mKeyframeInterval;
+    const fl::i32 keyframeNumber = fl::i32(keyframe * mKeyframeInterval);
+    // Continue from the last decoded frame when it lies between the keyframe
+    // and the target, otherwise restart at the keyframe.
+    if (mRefFrame < keyframeNumber || mRefFrame > fl::i32(frameNumber)) {
+        mRefFrame = keyframeNumber - 1;
+        mNextOffset = mKeyframes[keyframe];
+    }
+    while (mRefFrame < fl::i32(frameNumber)) {
+        if (!decodeNext()) {
+            DBG("decode failed at frame " << (mRefFrame + 1));
+            mRefFrame = -1;
+            return false;
+        }
+        ++mRefFrame;
+    }
+    memcpy(static_cast<void *>(dst), mRef.data(),
+           sizeof(CRGB) * mPixelsPerFrame);
+    return true;
+}
+
+CompressedVideoEncoder::CompressedVideoEncoder(fl::u32 pixelsPerFrame,
+                                               fl::u32 keyframeInterval)
+    : mPixelsPerFrame(pixelsPerFrame),
+      mKeyframeInterval(keyframeInterval ? keyframeInterval : 1),
+      mPrev(pixelsPerFrame) {}
+
+void CompressedVideoEncoder::encodeOps(const CRGB *prev, const CRGB *curr,
+                                       fl::u32 numPixels,
+                                       fl::vector<fl::u8> *out) {
+    const CRGB black(0, 0, 0);
+    auto unchanged = [&](fl::u32 i) {
+        return curr[i] == (prev ? prev[i] : black);
+    };
+    fl::u32 i = 0;
+    while (i < numPixels) {
+        fl::u32 n = 1;
+        if (unchanged(i)) {
+            while (i + n < numPixels && n < kMaxOpCount && unchanged(i + n)) {
+                ++n;
+            }
+            appendOp(CompressedVideoDecoder::kOpSkip, n, out);
+        } else if (i + 1 < numPixels && curr[i + 1] == curr[i]) {
+            while (i + n < numPixels && n < kMaxOpCount &&
+                   curr[i + n] == curr[i]) {
+                ++n;
+            }
+            appendOp(CompressedVideoDecoder::kOpRun, n, out);
+            appendPixel(curr[i], out);
+        } else {
+            // Literal until the next skip or run would be cheaper.
+            while (i + n < numPixels && n < kMaxOpCount && !unchanged(i + n) &&
+                   !(i + n + 1 < numPixels && curr[i + n + 1] == curr[i + n])) {
+                ++n;
+            }
+            appendOp(CompressedVideoDecoder::kOpLiteral, n, out);
+            for (fl::u32 k = 0; k < n; ++k) {
+                appendPixel(curr[i + k], out);
+            }
+        }
+        i += n;
+    }
+}
+
+void CompressedVideoEncoder::addFrame(const CRGB *pixels) {
+    const bool key = mFrameCount % mKeyframeInterval == 0;
+    if (key) {
+        mKeyframes.push_back(fl::u32(mRecords.size()));
+    }
+    mRecords.push_back(key ? CompressedVideoDecoder::kKeyFrame
+                           : CompressedVideoDecoder::kDeltaFrame);
+    const fl::size sizeAt = mRecords.size();
+    appendU32(0, &mRecords); // Patched below.
+    encodeOps(key ? nullptr : mPrev.data(), pixels, mPixelsPerFrame,
+              &mRecords);
+    writeU32(fl::u32(mRecords.size() - sizeAt - 4), mRecords.data() + sizeAt);
+    memcpy(static_cast<void *>(mPrev.data()), pixels,
+           sizeof(CRGB) * mPixelsPerFrame);
+    ++mFrameCount;
+}
+
+void CompressedVideoEncoder::finish(fl::vector<fl::u8> *out) const {
+    out->clear();
+    for (int i = 0; i < 4; ++i) {
+        out->push_back(kMagic[i]);
+    }
+    out->push_back(CompressedVideoDecoder::kVersion);
+    out->push_back(0); // flags
+    out->push_back(0); // reserved
+    out->push_back(0);
+    appendU32(mPixelsPerFrame, out);
+    appendU32(mFrameCount, out);
+    appendU32(mKeyframeInterval, out);
+    const fl::u32 indexOffset =
+        CompressedVideoDecoder::kHeaderSize + fl::u32(mRecords.size());
+    appendU32(indexOffset, out);
+    for (fl::size i = 0; i < mRecords.size(); ++i) {
+        out->push_back(mRecords[i]);
+    }
+    for (fl::size i = 0; i < mKeyframes.size(); ++i) {
+        appendU32(CompressedVideoDecoder::kHeaderSize + mKeyframes[i], out);
+    }
+}
+
+} // namespace fl
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "crgb.h"
+#include "fl/file_system.h"
+#include "fl/int.h"
+#include "fl/namespace.h"
+#include "fl/ptr.h"
+#include "fl/vector.h"
+
+// Compressed video container read by PixelStream next to raw RGB8 files.
+//
+// Layout, all integers little endian:
+//   header   "FLCV", u8 version, u8 flags, u16 reserved, u32 pixelsPerFrame,
+//            u32 frameCount, u32 keyframeInterval, u32 keyframeIndexOffset
+//   frames   one record per frame: u8 type, u32 payloadSize, payload
+//   index    u32 file offset of every keyframe record
+//
+// Every keyframeInterval'th frame, starting with frame 0, is a keyframe which
+// is encoded against a black frame, all other frames are encoded against the
+// frame before them. A payload is a list of ops, each a control byte with the
+// op in the top two bits and (count - 1) in the low six bits:
+//   SKIP    count pixels are unchanged
+//   RUN     count pixels are set to the RGB triple that follows
+//   LITERAL count RGB triples follow
+// Seeking decodes from the closest keyframe, so random access costs at most
+// keyframeInterval records while sequential playback costs one.
+
+namespace fl {
+
+FASTLED_SMART_PTR(FileHandle);
+FASTLED_SMART_PTR(CompressedVideoDecoder);
+
+class CompressedVideoDecoder : public fl::Referent {
+  public:
+    enum {
+        kHeaderSize = 24,
+        kRecordHeaderSize = 5,
+        kVersion = 1,
+    };
+    enum FrameType { kKeyFrame = 0, kDeltaFrame = 1 };
+    enum Op { kOpSkip = 0, kOpRun = 1, kOpLiteral = 2 };
+
+    // True if the handle holds a compressed video. Leaves the handle at the
+    // start of the file.
+    static bool isCompressed(fl::FileHandlePtr h);
+
+    CompressedVideoDecoder() = default;
+    ~CompressedVideoDecoder() override = default;
+
+    // Reads the header and keyframe index. False if the file is malformed.
+    bool begin(fl::FileHandlePtr h);
+    void close();
+
+    fl::u32 pixelsPerFrame() const { return mPixelsPerFrame; }
+    fl::u32 frameCount() const { return mFrameCount; }
+    fl::u32 keyframeInterval() const { return mKeyframeInterval; }
+
+    // Decodes frame frameNumber into dst, which holds pixelsPerFrame()
+    // pixels. Reading frames in order only touches one record per frame.
+    bool readFrameAt(fl::u32 frameNumber, CRGB *dst);
+
+    // Decodes one payload onto frame, exposed for tests and the encoder.
+    static bool applyOps(const fl::u8 *ops, fl::size size, CRGB *frame,
+                         fl::u32 numPixels);
+
+  private:
+    bool decodeNext();
+    fl::FileHandlePtr mHandle;
+    fl::u32 mPixelsPerFrame = 0;
+    fl::u32 mFrameCount = 0;
+    fl::u32 mKeyframeInterval = 1;
+    fl::vector<fl::u32> mKeyframes; // File offset of each keyframe record.
+    fl::vector<CRGB> mRef;          // Last decoded frame.
+    fl::vector<fl::u8> mPayload;    // Reused record buffer.
+    fl::i32 mRefFrame = -1;         // Frame held by mRef, -1 if none.
+    fl::u32 mNextOffset = 0;        // Record following mRefFrame.
+};
+
+// Builds a compressed video from raw frames, used by tools and tests. The
+// whole container is kept in memory.
+class CompressedVideoEncoder {
+  public:
+    CompressedVideoEncoder(fl::u32 pixelsPerFrame,
+                           fl::u32 keyframeInterval = 30);
+    void addFrame(const CRGB *pixels);
+    fl::u32 frameCount() const { return mFrameCount; }
+    // Writes the finished container to out.
+    void finish(fl::vector<fl::u8> *out) const;
+
+    // Appends the ops that turn prev into curr, prev == nullptr is black.
+    static void encodeOps(const CRGB *prev, const CRGB *curr,
+                          fl::u32 numPixels, fl::vector<fl::u8> *out);
+
+  private:
+    fl::u32 mPixelsPerFrame;
+    fl::u32 mKeyframeInterval;
+    fl::u32 mFrameCount = 0;
+    fl::vector<CRGB> mPrev;
+    fl::vector<fl::u8> mRecords;
+    fl::vector<fl::u32> mKeyframes; // Offsets relative to mRecords.
+};
+
+} // namespace fl
@@ -0,0 +1,5 @@
+#include "fl/compiler_control.h"
+
+#if !FASTLED_ALL_SRC
+#include "fx/video/frame_prefetcher.cpp.hpp"
+#endif
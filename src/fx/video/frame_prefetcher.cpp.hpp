@@ -0,0 +1,273 @@
+#include "fx/video/frame_prefetcher.h"
+
+#include "fl/atomic.h"
+#include "fl/namespace.h"
+#include "fl/vector.h"
+#include "fl/warn.h"
+
+#if FASTLED_VIDEO_PREFETCH_THREAD
+#include <atomic> // ok include
+#ifdef ESP32
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#else
+#include <chrono> // ok include
+#include <thread> // ok include
+#endif
+#endif
+
+namespace fl {
+
+namespace {
+#if FASTLED_VIDEO_PREFETCH_THREAD
+// fl::atomic is only real when FASTLED_MULTITHREADED, the ESP32 task needs
+// the genuine article too.
+template <typename T> using PrefetchAtomic = std::atomic<T>;
+#else
+template <typename T> using PrefetchAtomic = fl::atomic<T>;
+#endif
+} // namespace
+
+struct FramePrefetcher::Impl {
+    struct Slot {
+        FramePtr frame;
+        fl::u32 seq = 0;
+        fl::u32 gen = 0;
+    };
+
+    Impl(PixelStreamPtr s, fl::u32 pixels, fl::u32 n)
+        : stream(s), pixelsPerFrame(pixels) {
+        fl::i32 frames = stream->frameCount();
+        totalFrames = frames > 0 ? static_cast<fl::u32>(frames) : 0;
+        slots.resize(n);
+        for (fl::size i = 0; i < slots.size(); ++i) {
+            slots[i].frame = FramePtr::New(pixelsPerFrame);
+        }
+        // Start reading from the first frame right away.
+        requestSeek(0, true);
+    }
+
+    // Consumer side, redirects the reader. The generation is published last
+    // so the reader either sees the complete request or retries.
+    void requestSeek(fl::u32 seq, bool fwd) {
+        ++gen;
+        expect = seq;
+        expectForward = fwd;
+        reqSeq.store(seq);
+        reqForward.store(fwd);
+        reqGen.store(gen);
+    }
+
+    bool onTheWay(fl::u32 seq, bool fwd) const {
+        const fl::u32 window = static_cast<fl::u32>(slots.size());
+        if (fwd != expectForward) {
+            return false;
+        }
+        return fwd ? (seq >= expect && seq - expect < window)
+                   : (seq <= expect && expect - seq < window);
+    }
+
+    void pop(fl::u32 t, const Slot &slot) {
+        expect = expectForward ? slot.seq + 1 : slot.seq - 1;
+        tail.store(t + 1);
+    }
+
+    bool take(fl::u32 seq, bool fwd, FramePtr *frame) {
+        const fl::u32 n = static_cast<fl::u32>(slots.size());
+        for (;;) {
+            fl::u32 t = tail.load();
+            if (t == head.load()) {
+                break;
+            }
+            Slot &slot = slots[t % n];
+            if (slot.gen != gen) {
+                tail.store(t + 1); // Decoded before the last seek.
+                continue;
+            }
+            if (slot.seq == seq) {
+                if (!*frame) {
+                    *frame = FramePtr::New(pixelsPerFrame);
+                }
+                slot.frame.swap(*frame);
+                pop(t, slot);
+                return true;
+            }
+            const bool behind = fwd ? slot.seq < seq : slot.seq > seq;
+            if (!behind || fwd != expectForward) {
+                break;
+            }
+            pop(t, slot);
+        }
+        if (!onTheWay(seq, fwd)) {
+            requestSeek(seq, fwd);
+        }
+        return false;
+    }
+
+    // Producer side.
+    bool pump() {
+        if (totalFrames == 0) {
+            return false;
+        }
+        const fl::u32 g = reqGen.load();
+        if (g != readGen) {
+            fl::u32 seq = reqSeq.load();
+            bool fwd = reqForward.load();
+            if (reqGen.load() != g) {
+                return false; // Request is being rewritten, try again.
+            }
+            readGen = g;
+            readSeq = seq;
+            readForward = fwd;
+            exhausted = false;
+        }
+        if (exhausted) {
+            return false;
+        }
+        const fl::u32 h = head.load();
+        const fl::u32 n = static_cast<fl::u32>(slots.size());
+        if (h - tail.load() >= n) {
+            return false; // Ring is full.
+        }
+        Slot &slot = slots[h % n];
+        const fl::u32 index = readSeq % totalFrames;
+        if (!stream->readFrameAt(index, slot.frame.get())) {
+            FASTLED_WARN("FramePrefetcher: readFrameAt failed: " << index);
+            exhausted = true;
+            return false;
+        }
+        slot.seq = readSeq;
+        slot.gen = readGen;
+        head.store(h + 1);
+        if (readForward) {
+            ++readSeq;
+        } else if (index == 0) {
+            exhausted = true; // Can't play backward past the first frame.
+        } else {
+            --readSeq;
+        }
+        return true;
+    }
+
+#if FASTLED_VIDEO_PREFETCH_THREAD
+    void run() {
+        while (!stop.load()) {
+            if (!pump()) {
+#ifdef ESP32
+                vTaskDelay(1);
+#else
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+            }
+        }
+    }
+#endif
+
+    void start() {
+#if FASTLED_VIDEO_PREFETCH_THREAD
+#ifdef ESP32
+        TaskHandle_t handle = nullptr;
+        BaseType_t ok = xTaskCreate(&Impl::taskEntry, "fl_prefetch",
+                                    FASTLED_VIDEO_PREFETCH_STACK_SIZE, this,
+                                    tskIDLE_PRIORITY + 1, &handle);
+        threaded = ok == pdPASS;
+#else
+        worker = std::thread([this]() { run(); });
+        threaded = true;
+#endif
+        if (!threaded) {
+            FASTLED_WARN("FramePrefetcher: could not start worker");
+        }
+#endif
+    }
+
+    void join() {
+        if (!threaded) {
+            return;
+        }
+        stop.store(true);
+#if FASTLED_VIDEO_PREFETCH_THREAD
+#ifdef ESP32
+        while (!stopped.load()) {
+            vTaskDelay(1);
+        }
+#else
+        worker.join();
+#endif
+#endif
+        threaded = false;
+    }
+
+#if FASTLED_VIDEO_PREFETCH_THREAD && defined(ESP32)
+    static void taskEntry(void *arg) {
+        Impl *self = static_cast<Impl *>(arg);
+        self->run();
+        self->stopped.store(true);
+        vTaskDelete(nullptr);
+    }
+    PrefetchAtomic<bool> stopped{false};
+#elif FASTLED_VIDEO_PREFETCH_THREAD
+    std::thread worker;
+#endif
+
+    PixelStreamPtr stream;
+    fl::u32 pixelsPerFrame = 0;
+    fl::u32 totalFrames = 0;
+    fl::vector<Slot> slots;
+    bool threaded = false;
+
+    // Ring indices, head is owned by the reader and tail by the consumer.
+    PrefetchAtomic<fl::u32> head{0};
+    PrefetchAtomic<fl::u32> tail{0};
+    // Seek request from the consumer.
+    PrefetchAtomic<fl::u32> reqGen{0};
+    PrefetchAtomic<fl::u32> reqSeq{0};
+    PrefetchAtomic<bool> reqForward{true};
+    PrefetchAtomic<bool> stop{false};
+
+    // Consumer state.
+    fl::u32 gen = 0;
+    fl::u32 expect = 0; // Next seq the reader will hand over.
+    bool expectForward = true;
+
+    // Reader state.
+    fl::u32 readGen = 0;
+    fl::u32 readSeq = 0;
+    bool readForward = true;
+    bool exhausted = false;
+};
+
+FramePrefetcher::FramePrefetcher(PixelStreamPtr stream,
+                                 fl::u32 pixelsPerFrame, fl::u32 lookahead,
+                                 bool startWorker)
+    : mImpl(new Impl(stream, pixelsPerFrame, lookahead ? lookahead : 1)) {
+    if (startWorker && mImpl->totalFrames) {
+        mImpl->start();
+    }
+}
+
+FramePrefetcher::~FramePrefetcher() {
+    mImpl->join();
+    delete mImpl;
+}
+
+bool FramePrefetcher::take(fl::u32 seq, bool forward, FramePtr *frame) {
+    return mImpl->take(seq, forward, frame);
+}
+
+bool FramePrefetcher::pump() {
+    if (mImpl->threaded) {
+        return false; // The worker owns the reader.
+    }
+    return mImpl->pump();
+}
+
+fl::u32 FramePrefetcher::totalFrames() const { return mImpl->totalFrames; }
+
+fl::u32 FramePrefetcher::lookahead() const {
+    return static_cast<fl::u32>(mImpl->slots.size());
+}
+
+bool FramePrefetcher::threaded() const { return mImpl->threaded; }
+
+} // namespace fl
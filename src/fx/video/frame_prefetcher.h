@@ -0,0 +1,70 @@
+#pragma once
+
+#include "fl/int.h"
+#include "fl/namespace.h"
+#include "fl/ptr.h"
+#include "fl/thread.h"
+#include "fx/frame.h"
+#include "fx/video/pixel_stream.h"
+
+// Whether FramePrefetcher decodes on its own worker: a std::thread on
+// multithreaded hosts and a FreeRTOS task on ESP32. Everywhere else the reader
+// is pumped synchronously by the caller.
+#ifndef FASTLED_VIDEO_PREFETCH_THREAD
+#if FASTLED_MULTITHREADED || defined(ESP32)
+#define FASTLED_VIDEO_PREFETCH_THREAD 1
+#else
+#define FASTLED_VIDEO_PREFETCH_THREAD 0
+#endif
+#endif
+
+#ifndef FASTLED_VIDEO_PREFETCH_STACK_SIZE
+#define FASTLED_VIDEO_PREFETCH_STACK_SIZE 4096 // ESP32 task stack, in bytes.
+#endif
+
+namespace fl {
+
+FASTLED_SMART_PTR(FramePrefetcher);
+
+// Decodes the frames of a file backed PixelStream ahead of playback into a
+// fixed ring of `lookahead` frames. The reader walks the file sequentially,
+// forward or backward, wrapping from the last frame back to the first so that
+// looping videos stay buffered. Frames are addressed by a sequence number
+// that keeps counting across loops, frame index = seq % totalFrames().
+//
+// The ring is single producer / single consumer: the reader only writes the
+// slot at the head, the consumer only touches slots between tail and head and
+// ownership is handed over by publishing the indices, so take() never blocks
+// on a lock or on I/O.
+class FramePrefetcher : public fl::Referent {
+  public:
+    // The stream must not be read by anyone else while the prefetcher is
+    // alive. With startWorker false no thread is started and pump() drives
+    // the reader instead.
+    FramePrefetcher(PixelStreamPtr stream, fl::u32 pixelsPerFrame,
+                    fl::u32 lookahead,
+                    bool startWorker = FASTLED_VIDEO_PREFETCH_THREAD);
+
+    // Moves frame `seq` into *frame and gives the frame previously held by
+    // *frame to the ring for reuse. Frames older than seq in the direction of
+    // playback are dropped. Returns false if seq isn't decoded yet, in which
+    // case the reader is redirected to seq unless it is already on its way.
+    bool take(fl::u32 seq, bool forward, FramePtr *frame);
+
+    // Decodes at most one frame on the calling thread, returns true if it
+    // did. Only needed when there is no worker.
+    bool pump();
+
+    fl::u32 totalFrames() const;
+    fl::u32 lookahead() const;
+    bool threaded() const;
+
+  protected:
+    ~FramePrefetcher() override;
+
+  private:
+    struct Impl;
+    Impl *mImpl;
+};
+
+} // namespace fl
@@ -2,6 +2,7 @@
 #include "fx/video/pixel_stream.h"
 #include "fl/dbg.h"
 #include "fl/namespace.h"
+#include "fl/warn.h"
 
 #ifndef INT32_MAX
 #define INT32_MAX 0x7fffffff
@@ -23,6 +24,18 @@ bool PixelStream::begin(FileHandlePtr h) {
     close();
     mFileHandle = h;
     mUsingByteStream = false;
+    if (CompressedVideoDecoder::isCompressed(h)) {
+        mDecoder = CompressedVideoDecoderPtr::New();
+        if (!mDecoder->begin(h) ||
+            mDecoder->pixelsPerFrame() * 3 != fl::u32(mbytesPerFrame)) {
+            FASTLED_WARN("PixelStream: compressed video does not match "
+                         << mbytesPerFrame / 3 << " pixels per frame");
+            mDecoder.reset();
+            return false;
+        }
+        mNextFrame = 0;
+        return mDecoder->frameCount() > 0;
+    }
     return mFileHandle->available();
 }
 
@@ -39,11 +52,16 @@ void PixelStream::close() {
     }
     mByteStream.reset();
     mFileHandle.reset();
+    mDecoder.reset();
+    mNextFrame = 0;
 }
 
 int32_t PixelStream::bytesPerFrame() { return mbytesPerFrame; }
 
 bool PixelStream::readPixel(CRGB *dst) {
+    if (mDecoder) {
+        return false;
+    }
     if (mUsingByteStream) {
         return mByteStream->read(&dst->r, 1) && mByteStream->read(&dst->g, 1) &&
                mByteStream->read(&dst->b, 1);
@@ -56,6 +74,8 @@ bool PixelStream::readPixel(CRGB *dst) {
 bool PixelStream::available() const {
     if (mUsingByteStream) {
         return mByteStream->available(mbytesPerFrame);
+    } else if (mDecoder) {
+        return !atEnd();
     } else {
         return mFileHandle->available();
     }
@@ -64,6 +84,8 @@ bool PixelStream::available() const {
 bool PixelStream::atEnd() const {
     if (mUsingByteStream) {
         return false;
+    } else if (mDecoder) {
+        return mNextFrame >= mDecoder->frameCount();
     } else {
         return !mFileHandle->available();
     }
@@ -73,6 +95,9 @@ bool PixelStream::readFrame(Frame *frame) {
     if (!frame) {
         return false;
     }
+    if (mDecoder) {
+        return readFrameAt(mNextFrame, frame);
+    }
     if (!mUsingByteStream) {
         if (!framesRemaining()) {
             return false;
@@ -90,6 +115,8 @@ bool PixelStream::hasFrame(fl::u32 frameNumber) {
         // ByteStream doesn't support seeking
         DBG("Not implemented and therefore always returns true");
         return true;
+    } else if (mDecoder) {
+        return frameNumber < mDecoder->frameCount();
     } else {
         size_t total_bytes = mFileHandle->size();
         return frameNumber * mbytesPerFrame < total_bytes;
@@ -102,6 +129,18 @@ bool PixelStream::readFrameAt(fl::u32 frameNumber, Frame *frame) {
         // ByteStream doesn't support seeking
         FASTLED_DBG("ByteStream doesn't support seeking");
         return false;
+    } else if (mDecoder) {
+        if (!mDecoder->readFrameAt(frameNumber, frame->rgb())) {
+            return false;
+        }
+        mNextFrame = frameNumber + 1;
+        return true;
+    } else if (const CRGB *src = frameAt(frameNumber)) {
+        // Memory mapped, a single copy out of the mapping. The position is
+        // still advanced so framesRemaining() behaves like a regular read.
+        memcpy(static_cast<void *>(frame->rgb()), src, mbytesPerFrame);
+        mFileHandle->seek((frameNumber + 1) * mbytesPerFrame);
+        return true;
     } else {
         // DBG("mbytesPerFrame: " << mbytesPerFrame);
         mFileHandle->seek(frameNumber * mbytesPerFrame);
@@ -123,9 +162,32 @@ bool PixelStream::readFrameAt(fl::u32 frameNumber, Frame *frame) {
     }
 }
 
+fl::span<const fl::u8> PixelStream::mapping() const {
+    if (mUsingByteStream || mDecoder || !mFileHandle) {
+        return fl::span<const fl::u8>();
+    }
+    return mFileHandle->mapping();
+}
+
+const CRGB *PixelStream::frameAt(fl::u32 frameNumber) const {
+    fl::span<const fl::u8> data = mapping();
+    const fl::size offset = fl::size(frameNumber) * mbytesPerFrame;
+    if (data.size() == 0 || mbytesPerFrame <= 0 ||
+        offset + mbytesPerFrame > data.size()) {
+        return nullptr;
+    }
+    // CRGB is three packed bytes, so the mapping is usable as is.
+    return reinterpret_cast<const CRGB *>(data.data() + offset);
+}
+
 int32_t PixelStream::framesRemaining() const {
     if (mbytesPerFrame == 0)
         return 0;
+    if (mDecoder) {
+        return mNextFrame < mDecoder->frameCount()
+                   ? int32_t(mDecoder->frameCount() - mNextFrame)
+                   : 0;
+    }
     int32_t bytes_left = bytesRemaining();
     if (bytes_left <= 0) {
         return 0;
@@ -133,11 +195,26 @@ int32_t PixelStream::framesRemaining() const {
     return bytes_left / mbytesPerFrame;
 }
 
+int32_t PixelStream::frameCount() const {
+    if (mUsingByteStream) {
+        return -1;
+    }
+    if (mDecoder) {
+        return int32_t(mDecoder->frameCount());
+    }
+    if (mbytesPerFrame <= 0 || !mFileHandle) {
+        return 0;
+    }
+    return int32_t(mFileHandle->size() / mbytesPerFrame);
+}
+
 int32_t PixelStream::framesDisplayed() const {
     if (mUsingByteStream) {
         // ByteStream doesn't have a concept of total size, so we can't
         // calculate this
         return -1;
+    } else if (mDecoder) {
+        return int32_t(mNextFrame);
     } else {
         int32_t bytes_played = mFileHandle->pos();
         return bytes_played / mbytesPerFrame;
@@ -147,6 +224,9 @@ int32_t PixelStream::framesDisplayed() const {
 int32_t PixelStream::bytesRemaining() const {
     if (mUsingByteStream) {
         return INT32_MAX;
+    } else if (mDecoder) {
+        // Decoded size, which is what callers count frames with.
+        return framesRemaining() * mbytesPerFrame;
     } else {
         return mFileHandle->bytesLeft();
     }
@@ -160,6 +240,9 @@ bool PixelStream::rewind() {
     if (mUsingByteStream) {
         // ByteStream doesn't support rewinding
         return false;
+    } else if (mDecoder) {
+        mNextFrame = 0;
+        return true;
     } else {
         mFileHandle->seek(0);
         return true;
@@ -172,6 +255,9 @@ PixelStream::Type PixelStream::getType() const {
 
 size_t PixelStream::readBytes(uint8_t *dst, size_t len) {
     uint16_t bytesRead = 0;
+    if (mDecoder) {
+        return 0;
+    }
     if (mUsingByteStream) {
         while (bytesRead < len && mByteStream->available(len)) {
             // use pop_front()
@@ -6,6 +6,7 @@
 #include "fl/namespace.h"
 #include "fl/ptr.h"
 #include "fx/frame.h"
+#include "fx/video/compressed_video.h"
 #include "fl/int.h"
 namespace fl {
 FASTLED_SMART_PTR(FileHandle);
@@ -18,7 +19,8 @@ FASTLED_SMART_PTR(PixelStream);
 
 // PixelStream takes either a file handle or a byte stream
 // and reads frames from it in order to serve data to the
-// video system.
+// video system. Files are either raw RGB8 frames or a compressed video, see
+// compressed_video.h, which is detected from the file header.
 class PixelStream : public fl::Referent {
   public:
     enum Type {
@@ -32,13 +34,20 @@ class PixelStream : public fl::Referent {
     bool beginStream(fl::ByteStreamPtr s);
     void close();
     int32_t bytesPerFrame();
+    // Raw byte access, not available for compressed files.
     bool readPixel(CRGB *dst); // Convenience function to read a pixel
     size_t readBytes(uint8_t *dst, size_t len);
 
     bool readFrame(Frame *frame);
     bool readFrameAt(fl::u32 frameNumber, Frame *frame);
+    // Zero copy view of a raw frame when the file is memory mapped, see
+    // FileHandle::mapping(). nullptr for streams, compressed files or frames
+    // past the end.
+    const CRGB *frameAt(fl::u32 frameNumber) const;
+    bool mapped() const { return mapping().size() != 0; }
     bool hasFrame(fl::u32 frameNumber);
     int32_t framesRemaining() const; // -1 if this is a stream.
+    int32_t frameCount() const;      // -1 if this is a stream.
     int32_t framesDisplayed() const;
     bool available() const;
     bool atEnd() const;
@@ -49,12 +58,16 @@ class PixelStream : public fl::Referent {
     rewind(); // Returns false on failure, which can happen for streaming mode.
     Type getType()
         const; // Returns the type of the video stream (kStreaming or kFile)
+    bool compressed() const { return bool(mDecoder); }
 
   private:
+    fl::span<const fl::u8> mapping() const;
     fl::i32 mbytesPerFrame;
     fl::FileHandlePtr mFileHandle;
     fl::ByteStreamPtr mByteStream;
     bool mUsingByteStream;
+    CompressedVideoDecoderPtr mDecoder; // Set for compressed files.
+    fl::u32 mNextFrame = 0;             // Read position of mDecoder.
 
   protected:
     virtual ~PixelStream();
@@ -5,6 +5,7 @@
 #include "fl/assert.h"
 #include "fl/math_macros.h"
 #include "fl/namespace.h"
+#include "fl/pixel_blend.h"
 #include "fl/warn.h"
 
 namespace fl {
@@ -40,6 +41,26 @@ void VideoImpl::setFade(fl::u32 fadeInTime, fl::u32 fadeOutTime) {
     mFadeOutTime = fadeOutTime;
 }
 
+void VideoImpl::setPrefetch(fl::u32 lookaheadFrames) {
+    mPrefetchFrames = lookaheadFrames;
+    startPrefetch();
+}
+
+void VideoImpl::startPrefetch() {
+    mPrefetcher.reset(); // Joins the old worker before anything else.
+    mSpareFrame.reset();
+    mLoopOffset = 0;
+    if (!mPrefetchFrames || !mStream ||
+        mStream->getType() != PixelStream::kFile || mStream->mapped()) {
+        return; // Mapped files are drawn in place, there is no I/O to hide.
+    }
+    mPrefetcher =
+        FramePrefetcherPtr::New(mStream, mPixelsPerFrame, mPrefetchFrames);
+    if (mPrefetcher->totalFrames() == 0) {
+        mPrefetcher.reset();
+    }
+}
+
 bool VideoImpl::needsFrame(fl::u32 now) const {
     fl::u32 f1, f2;
     bool out = mFrameInterpolator->needsFrame(now, &f1, &f2);
@@ -54,6 +75,7 @@ void VideoImpl::begin(FileHandlePtr h) {
     mStream = PixelStreamPtr::New(mPixelsPerFrame * kSizeRGB8);
     mStream->begin(h);
     mPrevNow = 0;
+    startPrefetch();
 }
 
 void VideoImpl::beginStream(ByteStreamPtr bs) {
@@ -67,6 +89,8 @@ void VideoImpl::beginStream(ByteStreamPtr bs) {
 void VideoImpl::end() {
     mFrameInterpolator->clear();
     // Removed resetFrameCounter and setStartTime calls
+    mPrefetcher.reset();
+    mSpareFrame.reset();
     mStream.reset();
 }
 
@@ -80,7 +104,11 @@ int32_t VideoImpl::durationMicros() const {
     if (!mStream) {
         return -1;
     }
-    int32_t frames = mStream->framesRemaining();
+    // The worker owns the file position while prefetching and mapped files
+    // never move it.
+    int32_t frames = (mPrefetcher || mStream->mapped())
+                         ? mStream->frameCount()
+                         : mStream->framesRemaining();
     if (frames < 0) {
         return -1; // Stream case, duration unknown
     }
@@ -101,13 +129,47 @@ bool VideoImpl::draw(fl::u32 now, CRGB *leds) {
         return false;
     }
     bool ok = updateBufferIfNecessary(mPrevNow, now);
-    mPrevNow = now;
+    // The prefetched and mapped paths loop by resetting the time warp, keep
+    // their direction check on the warped time that is zero again.
+    mPrevNow = (mPrefetcher || mStream->mapped()) ? mTime->time() : now;
     if (!ok) {
         FASTLED_WARN("updateBufferIfNecessary failed");
         return false;
     }
-    mFrameInterpolator->draw(now, leds);
+    const bool drawn = mStream->mapped() ? drawMapped(now, leds)
+                                         : mFrameInterpolator->draw(now, leds);
+    const fl::u32 brightness = fadeBrightness(now);
+    if (!drawn) {
+        // Frame not decoded yet, keep showing the last one. While fading,
+        // repaint it so the fade doesn't stack on the previous output.
+        if (brightness == 255 || !drawNewestFrame(leds)) {
+            return true;
+        }
+    }
+    if (brightness < 255) {
+        if (brightness == 0) {
+            for (size_t i = 0; i < mPixelsPerFrame; ++i) {
+                leds[i] = CRGB::Black;
+            }
+        } else {
+            for (size_t i = 0; i < mPixelsPerFrame; ++i) {
+                leds[i].nscale8(brightness);
+            }
+        }
+    }
+    return true;
+}
 
+bool VideoImpl::drawNewestFrame(CRGB *leds) {
+    fl::u32 frameNumber = 0;
+    if (!mFrameInterpolator->get_newest_frame_number(&frameNumber)) {
+        return false;
+    }
+    mFrameInterpolator->get(frameNumber)->draw(leds);
+    return true;
+}
+
+fl::u32 VideoImpl::fadeBrightness(fl::u32 now) const {
     fl::u32 time = mTime->time();
     fl::u32 brightness = 255;
     // Compute fade in/out brightness.
@@ -120,7 +182,7 @@ bool VideoImpl::draw(fl::u32 now, CRGB *leds) {
                 brightness = time * 255 / mFadeInTime;
             }
         } else if (mFadeOutTime) {
-            int32_t frames_remaining = mStream->framesRemaining();
+            int32_t frames_remaining = framesRemaining(now);
             if (frames_remaining < 0) {
                 // -1 means this is a stream.
                 brightness = 255;
@@ -137,18 +199,7 @@ bool VideoImpl::draw(fl::u32 now, CRGB *leds) {
             }
         }
     }
-    if (brightness < 255) {
-        if (brightness == 0) {
-            for (size_t i = 0; i < mPixelsPerFrame; ++i) {
-                leds[i] = CRGB::Black;
-            }
-        } else {
-            for (size_t i = 0; i < mPixelsPerFrame; ++i) {
-                leds[i].nscale8(brightness);
-            }
-        }
-    }
-    return true;
+    return brightness;
 }
 
 bool VideoImpl::updateBufferFromStream(fl::u32 now) {
@@ -329,12 +380,131 @@ bool VideoImpl::updateBufferFromFile(fl::u32 now, bool forward) {
     return true;
 }
 
+bool VideoImpl::updateBufferFromPrefetcher(fl::u32 now, bool forward) {
+    fl::u32 currFrameNumber = 0;
+    fl::u32 nextFrameNumber = 0;
+    bool needs_frame =
+        mFrameInterpolator->needsFrame(now, &currFrameNumber, &nextFrameNumber);
+    if (!needs_frame) {
+        return true;
+    }
+    const fl::u32 total = mPrefetcher->totalFrames();
+    if (currFrameNumber >= total) {
+        // Time ran past the end between two draws, start over.
+        mLoopOffset += total;
+        mTime->reset(now);
+        return true;
+    }
+    // A frame that isn't decoded yet is simply skipped, draw() never waits.
+    if (!mFrameInterpolator->has(currFrameNumber)) {
+        takePrefetched(currFrameNumber, forward, nextFrameNumber);
+    }
+    if (nextFrameNumber >= total) {
+        // Showing the last frame, loop the same way the unbuffered path does
+        // when the file runs out. The worker has already wrapped around.
+        if (forward && mFrameInterpolator->has(currFrameNumber)) {
+            mLoopOffset += total;
+            mTime->reset(now);
+        }
+        return true;
+    }
+    // Asking for the next frame before the current one arrived would move
+    // the reader past it when the ring only holds one frame.
+    if (mFrameInterpolator->capacity() > 1 &&
+        mFrameInterpolator->has(currFrameNumber) &&
+        !mFrameInterpolator->has(nextFrameNumber)) {
+        takePrefetched(nextFrameNumber, forward, currFrameNumber);
+    }
+    return true;
+}
+
+bool VideoImpl::takePrefetched(fl::u32 frameNumber, bool forward,
+                               fl::u32 keep) {
+    const fl::u32 seq = mLoopOffset + frameNumber;
+    bool ok = mPrefetcher->take(seq, forward, &mSpareFrame);
+    // Without a worker on this platform the reader is pumped on demand, one
+    // extra round lets take() drop frames that were read before a seek.
+    const bool pumped = !mPrefetcher->threaded();
+    for (fl::u32 i = 0; pumped && !ok && i <= mPrefetcher->lookahead(); ++i) {
+        mPrefetcher->pump();
+        ok = mPrefetcher->take(seq, forward, &mSpareFrame);
+    }
+    if (!ok) {
+        return false;
+    }
+    FramePtr frame = mSpareFrame;
+    mSpareFrame.reset();
+    if (mFrameInterpolator->full()) {
+        // Recycle the frame furthest from the playhead, which the ring gets
+        // back on the next take().
+        fl::u32 oldest = 0;
+        fl::u32 newest = 0;
+        mFrameInterpolator->get_oldest_frame_number(&oldest);
+        mFrameInterpolator->get_newest_frame_number(&newest);
+        fl::u32 victim = forward ? oldest : newest;
+        if (victim == keep) {
+            victim = forward ? newest : oldest;
+        }
+        mSpareFrame = mFrameInterpolator->erase(victim);
+    }
+    return mFrameInterpolator->insert(frameNumber, frame);
+}
+
+bool VideoImpl::updateBufferFromMapping(fl::u32 now, bool forward) {
+    fl::u32 currFrameNumber = 0;
+    fl::u32 nextFrameNumber = 0;
+    mFrameInterpolator->needsFrame(now, &currFrameNumber, &nextFrameNumber);
+    if (forward && nextFrameNumber >= fl::u32(mStream->frameCount())) {
+        // Last frame, loop like the other paths do.
+        mTime->reset(now);
+    }
+    return true;
+}
+
+bool VideoImpl::drawMapped(fl::u32 now, CRGB *leds) {
+    fl::u32 currFrameNumber = 0;
+    fl::u32 nextFrameNumber = 0;
+    fl::u8 amountOfNextFrame = 0;
+    mFrameInterpolator->getFrameTracker().get_interval_frames(
+        now, &currFrameNumber, &nextFrameNumber, &amountOfNextFrame);
+    const CRGB *curr = mStream->frameAt(currFrameNumber);
+    if (!curr) {
+        return false;
+    }
+    // Same result as FrameInterpolator::draw() but straight from the mapping,
+    // seeking is free and no frame is ever copied into a buffer.
+    memcpy(static_cast<void *>(leds), curr, sizeof(CRGB) * mPixelsPerFrame);
+    const CRGB *next = mStream->frameAt(nextFrameNumber);
+    if (next && amountOfNextFrame) {
+        blendPixels(leds, next, mPixelsPerFrame, BLEND_MODE_ALPHA,
+                    amountOfNextFrame);
+    }
+    return true;
+}
+
+int32_t VideoImpl::framesRemaining(fl::u32 now) const {
+    if (!mPrefetcher && !mStream->mapped()) {
+        return mStream->framesRemaining();
+    }
+    fl::u32 curr = 0;
+    fl::u32 next = 0;
+    mFrameInterpolator->needsFrame(now, &curr, &next);
+    fl::u32 total = fl::u32(mStream->frameCount());
+    return curr + 1 < total ? int32_t(total - curr - 1) : 0;
+}
+
 bool VideoImpl::updateBufferIfNecessary(fl::u32 prev, fl::u32 now) {
     const bool forward = now >= prev;
 
     PixelStream::Type type = mStream->getType();
     switch (type) {
     case PixelStream::kFile:
+        if (mStream->mapped()) {
+            return updateBufferFromMapping(now, forward);
+        }
+        if (mPrefetcher) {
+            return updateBufferFromPrefetcher(now, forward);
+        }
         return updateBufferFromFile(now, forward);
     case PixelStream::kStreaming:
         return updateBufferFromStream(now);
@@ -345,6 +515,11 @@ bool VideoImpl::updateBufferIfNecessary(fl::u32 prev, fl::u32 now) {
 }
 
 bool VideoImpl::rewind() {
+    if (mPrefetcher) {
+        // The worker seeks on its own, the stream must not be touched here.
+        mFrameInterpolator->clear();
+        return true;
+    }
     if (!mStream || !mStream->rewind()) {
         return false;
     }
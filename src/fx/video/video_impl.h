@@ -3,11 +3,16 @@
 #include "fl/bytestream.h"
 #include "fl/file_system.h"
 #include "fx/video/frame_interpolator.h"
+#include "fx/video/frame_prefetcher.h"
 #include "fx/video/pixel_stream.h"
 #include "fl/stdint.h"
 
 #include "fl/namespace.h"
 
+#ifndef FASTLED_VIDEO_PREFETCH_FRAMES
+#define FASTLED_VIDEO_PREFETCH_FRAMES 0 // Default lookahead, 0 = disabled.
+#endif
+
 namespace fl {
 FASTLED_SMART_PTR(FileHandle);
 FASTLED_SMART_PTR(ByteStream);
@@ -18,6 +23,7 @@ namespace fl {
 FASTLED_SMART_PTR(VideoImpl);
 FASTLED_SMART_PTR(FrameInterpolator);
 FASTLED_SMART_PTR(PixelStream)
+FASTLED_SMART_PTR(FramePrefetcher);
 
 class VideoImpl : public fl::Referent {
   public:
@@ -34,6 +40,11 @@ class VideoImpl : public fl::Referent {
     void begin(fl::FileHandlePtr h);
     void beginStream(fl::ByteStreamPtr s);
     void setFade(fl::u32 fadeInTime, fl::u32 fadeOutTime);
+    // Decode up to lookaheadFrames frames of a file ahead of playback on a
+    // background worker so draw() never waits on the file system. 0 disables
+    // prefetching, streams are never prefetched.
+    void setPrefetch(fl::u32 lookaheadFrames);
+    fl::u32 prefetch() const { return mPrefetchFrames; }
     bool draw(fl::u32 now, CRGB *leds);
     void end();
     bool rewind();
@@ -52,6 +63,14 @@ class VideoImpl : public fl::Referent {
     bool updateBufferIfNecessary(fl::u32 prev, fl::u32 now);
     bool updateBufferFromFile(fl::u32 now, bool forward);
     bool updateBufferFromStream(fl::u32 now);
+    bool updateBufferFromPrefetcher(fl::u32 now, bool forward);
+    bool updateBufferFromMapping(fl::u32 now, bool forward);
+    bool drawMapped(fl::u32 now, CRGB *leds);
+    bool drawNewestFrame(CRGB *leds);
+    fl::u32 fadeBrightness(fl::u32 now) const; // 255 when not fading.
+    bool takePrefetched(fl::u32 frameNumber, bool forward, fl::u32 keep);
+    void startPrefetch();
+    int32_t framesRemaining(fl::u32 now) const;
     fl::u32 mPixelsPerFrame = 0;
     PixelStreamPtr mStream;
     fl::u32 mPrevNow = 0;
@@ -60,6 +79,10 @@ class VideoImpl : public fl::Referent {
     fl::u32 mFadeInTime = 1000;
     fl::u32 mFadeOutTime = 1000;
     float mTimeScale = 1.0f;
+    fl::u32 mPrefetchFrames = FASTLED_VIDEO_PREFETCH_FRAMES;
+    FramePrefetcherPtr mPrefetcher;
+    FramePtr mSpareFrame; // Traded with the prefetcher for a decoded frame.
+    fl::u32 mLoopOffset = 0; // Prefetch sequence number of frame 0.
 };
 
 } // namespace fl
@@ -516,12 +516,70 @@ void hsv2rgb_raw(const struct CHSV * phsv, struct CRGB * prgb, int numLeds) {
     }
 }
 
+// The array version skips the branches of hsv2rgb_rainbow(). The hue only
+// picks the fully saturated, full brightness color, which is looked up in a
+// table built from the scalar code. Saturation and value then reduce to two
+// multiplies per channel that need no special cases: sat 255 and val 255
+// are the identity, sat 0 gives white and val 0 gives black. Red and blue
+// share one 32 bit multiply as two 16 bit fields. This matches the scalar
+// version bit for bit, only for FASTLED_SCALE8_FIXED and not on AVR where
+// the table would not fit in RAM.
+#if (FASTLED_SCALE8_FIXED == 1) && !defined(__AVR__)
+
+namespace {
+// Entries are r | g << 8 | b << 16.
+struct RainbowHueTable {
+    uint32_t entries[256];
+    RainbowHueTable() {
+        for (int h = 0; h < 256; ++h) {
+            CRGB rgb;
+            hsv2rgb_rainbow(CHSV(h, 255, 255), rgb);
+            entries[h] = rgb.r | (uint32_t(rgb.g) << 8) | (uint32_t(rgb.b) << 16);
+        }
+    }
+};
+} // namespace
+
+static const uint32_t* rainbowHueTable() {
+    // Filled once by the static initializer, which also guards the first
+    // concurrent calls.
+    static const RainbowHueTable table;
+    return table.entries;
+}
+
+void hsv2rgb_rainbow( const struct CHSV* phsv, struct CRGB * prgb, int numLeds) {
+    const uint32_t* hues = rainbowHueTable();
+    for (int i = 0; i < numLeds; ++i) {
+        const uint32_t color = hues[phsv[i].hue];
+        // scale8_video(255 - sat, 255 - sat), is 0 at full saturation.
+        const uint32_t invsat = 255 - phsv[i].sat;
+        const uint32_t desat = ((invsat * invsat) >> 8) + (invsat != 0);
+        // scale8_video(val, val) + 1, the scale8 FIXED multiplier.
+        const uint32_t val = phsv[i].val;
+        const uint32_t vscale = ((val * val) >> 8) + (val != 0) + 1;
+
+        uint32_t rb = color & 0x00FF00FF;
+        uint32_t g = (color >> 8) & 0xFF;
+        rb = (((rb * (256 - desat)) >> 8) & 0x00FF00FF) + desat * 0x00010001;
+        g = ((g * (256 - desat)) >> 8) + desat;
+        rb = ((rb * vscale) >> 8) & 0x00FF00FF;
+        g = (g * vscale) >> 8;
+        prgb[i].r = uint8_t(rb);
+        prgb[i].g = uint8_t(g);
+        prgb[i].b = uint8_t(rb >> 16);
+    }
+}
+
+#else
+
 void hsv2rgb_rainbow( const struct CHSV* phsv, struct CRGB * prgb, int numLeds) {
     for(int i = 0; i < numLeds; ++i) {
         hsv2rgb_rainbow(phsv[i], prgb[i]);
     }
 }
 
+#endif
+
 void hsv2rgb_spectrum( const struct CHSV* phsv, struct CRGB * prgb, int numLeds) {
     for(int i = 0; i < numLeds; ++i) {
         hsv2rgb_spectrum(phsv[i], prgb[i]);
@@ -11,6 +11,7 @@
 
 
 #include "fl/memfill.h"
+#include "fl/simd.h"
 // Compiler throws a warning about stack usage possibly being unbounded even
 // though bounds are checked, silence that so users don't see it
 #pragma GCC diagnostic push
@@ -295,20 +296,81 @@ static int8_t inline __attribute__((always_inline)) lerp7by8( int8_t a, int8_t b
     return result;
 }
 
-int16_t inoise16_raw(uint32_t x, uint32_t y, uint32_t z)
-{
-    // Find the unit cube containing the point
-    uint8_t X = (x>>16)&0xFF;
-    uint8_t Y = (y>>16)&0xFF;
-    uint8_t Z = (z>>16)&0xFF;
+namespace noise_detail {
 
-    // Hash cube corner coordinates
+// Hashes of the 8 corners of lattice cube (X,Y,Z), in the order the 3D
+// noise functions interpolate them. Samples in the same cube share these.
+static void inline __attribute__((always_inline)) hashCorners(uint8_t X, uint8_t Y, uint8_t Z, uint8_t h[8]) {
     uint8_t A = NOISE_P(X)+Y;
     uint8_t AA = NOISE_P(A)+Z;
     uint8_t AB = NOISE_P(A+1)+Z;
     uint8_t B = NOISE_P(X+1)+Y;
     uint8_t BA = NOISE_P(B) + Z;
     uint8_t BB = NOISE_P(B+1)+Z;
+    h[0] = NOISE_P(AA);
+    h[1] = NOISE_P(BA);
+    h[2] = NOISE_P(AB);
+    h[3] = NOISE_P(BB);
+    h[4] = NOISE_P(AA+1);
+    h[5] = NOISE_P(BA+1);
+    h[6] = NOISE_P(AB+1);
+    h[7] = NOISE_P(BB+1);
+}
+
+// 3D noise inside one cube. xx, yy, zz are the halved fractional
+// coordinates, u, v, w the eased ones.
+static int16_t inline __attribute__((always_inline)) noise16Cube(const uint8_t h[8], int16_t xx, int16_t yy, int16_t zz, uint16_t u, uint16_t v, uint16_t w) {
+    uint16_t N = 0x8000L;
+    int16_t X1 = LERP(grad16(h[0], xx, yy, zz), grad16(h[1], xx - N, yy, zz), u);
+    int16_t X2 = LERP(grad16(h[2], xx, yy-N, zz), grad16(h[3], xx - N, yy - N, zz), u);
+    int16_t X3 = LERP(grad16(h[4], xx, yy, zz-N), grad16(h[5], xx - N, yy, zz-N), u);
+    int16_t X4 = LERP(grad16(h[6], xx, yy-N, zz-N), grad16(h[7], xx - N, yy - N, zz - N), u);
+
+    int16_t Y1 = LERP(X1,X2,v);
+    int16_t Y2 = LERP(X3,X4,v);
+
+    return LERP(Y1,Y2,w);
+}
+
+static int8_t inline __attribute__((always_inline)) noise8Cube(const uint8_t h[8], int8_t xx, int8_t yy, int8_t zz, uint8_t u, uint8_t v, uint8_t w) {
+    uint8_t N = 0x80;
+    int8_t X1 = lerp7by8(grad8(h[0], xx, yy, zz), grad8(h[1], xx - N, yy, zz), u);
+    int8_t X2 = lerp7by8(grad8(h[2], xx, yy-N, zz), grad8(h[3], xx - N, yy - N, zz), u);
+    int8_t X3 = lerp7by8(grad8(h[4], xx, yy, zz-N), grad8(h[5], xx - N, yy, zz-N), u);
+    int8_t X4 = lerp7by8(grad8(h[6], xx, yy-N, zz-N), grad8(h[7], xx - N, yy - N, zz - N), u);
+
+    int8_t Y1 = lerp7by8(X1,X2,v);
+    int8_t Y2 = lerp7by8(X3,X4,v);
+
+    return lerp7by8(Y1,Y2,w);
+}
+
+// inoise16() and inoise8() scaling of the raw noise.
+static uint16_t inline __attribute__((always_inline)) scaleNoise16(int16_t raw) {
+    int32_t ans = raw;
+    ans = ans + 19052L;
+    uint32_t pan = ans;
+    // pan = (ans * 220L) >> 7.  That's the same as:
+    // pan = (ans * 440L) >> 8.  And this way avoids a 7X four-byte shift-loop on AVR.
+    // Identical math, except for the highest bit, which we don't care about anyway,
+    // since we're returning the 'middle' 16 out of a 32-bit value anyway.
+    pan *= 440L;
+    return (pan>>8);
+}
+
+static uint8_t inline __attribute__((always_inline)) scaleNoise8(int8_t raw) {
+    int8_t n = raw;                    // -64..+64
+    n+= 64;                            //   0..128
+    return qadd8( n, n);               //   0..255
+}
+
+} // namespace noise_detail
+
+int16_t inoise16_raw(uint32_t x, uint32_t y, uint32_t z)
+{
+    // Hash the corners of the unit cube containing the point
+    uint8_t h[8];
+    noise_detail::hashCorners(x>>16, y>>16, z>>16, h);
 
     // Get the relative position of the point in the cube
     uint16_t u = x & 0xFFFF;
@@ -319,23 +381,12 @@ int16_t inoise16_raw(uint32_t x, uint32_t y, uint32_t z)
     int16_t xx = (u >> 1) & 0x7FFF;
     int16_t yy = (v >> 1) & 0x7FFF;
     int16_t zz = (w >> 1) & 0x7FFF;
-    uint16_t N = 0x8000L;
 
     u = EASE16(u); v = EASE16(v); w = EASE16(w);
 
     // skip the log fade adjustment for the moment, otherwise here we would
     // adjust fade values for u,v,w
-    int16_t X1 = LERP(grad16(NOISE_P(AA), xx, yy, zz), grad16(NOISE_P(BA), xx - N, yy, zz), u);
-    int16_t X2 = LERP(grad16(NOISE_P(AB), xx, yy-N, zz), grad16(NOISE_P(BB), xx - N, yy - N, zz), u);
-    int16_t X3 = LERP(grad16(NOISE_P(AA+1), xx, yy, zz-N), grad16(NOISE_P(BA+1), xx - N, yy, zz-N), u);
-    int16_t X4 = LERP(grad16(NOISE_P(AB+1), xx, yy-N, zz-N), grad16(NOISE_P(BB+1), xx - N, yy - N, zz - N), u);
-
-    int16_t Y1 = LERP(X1,X2,v);
-    int16_t Y2 = LERP(X3,X4,v);
-
-    int16_t ans = LERP(Y1,Y2,w);
-
-    return ans;
+    return noise_detail::noise16Cube(h, xx, yy, zz, u, v, w);
 }
 
 int16_t inoise16_raw(uint32_t x, uint32_t y, uint32_t z, uint32_t t) {
@@ -434,19 +485,7 @@ uint16_t inoise16(uint32_t x, uint32_t y, uint32_t z, uint32_t t) {
 }
 
 uint16_t inoise16(uint32_t x, uint32_t y, uint32_t z) {
-    int32_t ans = inoise16_raw(x,y,z);
-    ans = ans + 19052L;
-    uint32_t pan = ans;
-    // pan = (ans * 220L) >> 7.  That's the same as:
-    // pan = (ans * 440L) >> 8.  And this way avoids a 7X four-byte shift-loop on AVR.
-    // Identical math, except for the highest bit, which we don't care about anyway,
-    // since we're returning the 'middle' 16 out of a 32-bit value anyway.
-    pan *= 440L;
-    return (pan>>8);
-
-    // // return scale16by8(pan,220)<<1;
-    // return ((inoise16_raw(x,y,z)+19052)*220)>>7;
-    // return scale16by8(inoise16_raw(x,y,z)+19052,220)<<1;
+    return noise_detail::scaleNoise16(inoise16_raw(x,y,z));
 }
 
 int16_t inoise16_raw(uint32_t x, uint32_t y)
@@ -528,18 +567,9 @@ uint16_t inoise16(uint32_t x) {
 
 int8_t inoise8_raw(uint16_t x, uint16_t y, uint16_t z)
 {
-    // Find the unit cube containing the point
-    uint8_t X = x>>8;
-    uint8_t Y = y>>8;
-    uint8_t Z = z>>8;
-
-    // Hash cube corner coordinates
-    uint8_t A = NOISE_P(X)+Y;
-    uint8_t AA = NOISE_P(A)+Z;
-    uint8_t AB = NOISE_P(A+1)+Z;
-    uint8_t B = NOISE_P(X+1)+Y;
-    uint8_t BA = NOISE_P(B) + Z;
-    uint8_t BB = NOISE_P(B+1)+Z;
+    // Hash the corners of the unit cube containing the point
+    uint8_t h[8];
+    noise_detail::hashCorners(x>>8, y>>8, z>>8, h);
 
     // Get the relative position of the point in the cube
     uint8_t u = x;
@@ -550,29 +580,384 @@ int8_t inoise8_raw(uint16_t x, uint16_t y, uint16_t z)
     int8_t xx = ((uint8_t)(x)>>1) & 0x7F;
     int8_t yy = ((uint8_t)(y)>>1) & 0x7F;
     int8_t zz = ((uint8_t)(z)>>1) & 0x7F;
-    uint8_t N = 0x80;
 
     u = EASE8(u); v = EASE8(v); w = EASE8(w);
 
-    int8_t X1 = lerp7by8(grad8(NOISE_P(AA), xx, yy, zz), grad8(NOISE_P(BA), xx - N, yy, zz), u);
-    int8_t X2 = lerp7by8(grad8(NOISE_P(AB), xx, yy-N, zz), grad8(NOISE_P(BB), xx - N, yy - N, zz), u);
-    int8_t X3 = lerp7by8(grad8(NOISE_P(AA+1), xx, yy, zz-N), grad8(NOISE_P(BA+1), xx - N, yy, zz-N), u);
-    int8_t X4 = lerp7by8(grad8(NOISE_P(AB+1), xx, yy-N, zz-N), grad8(NOISE_P(BB+1), xx - N, yy - N, zz - N), u);
+    return noise_detail::noise8Cube(h, xx, yy, zz, u, v, w);
+}
 
-    int8_t Y1 = lerp7by8(X1,X2,v);
-    int8_t Y2 = lerp7by8(X3,X4,v);
+uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z) {
+    //return scale8(76+(inoise8_raw(x,y,z)),215)<<1;
+    return noise_detail::scaleNoise8(inoise8_raw( x, y, z));
+}
+
+// Row batches
+//
+// Along a row only x changes, so the y and z work (easing, the signed
+// offsets, their part of the hash) is done once per row and the corner
+// hashes once per lattice cell instead of once per sample. With SSE2 or
+// NEON eight samples go through the gradients and lerps together. The lane
+// code follows the scalar code operation for operation, so a row is bit
+// identical to calling inoise16()/inoise8() per sample.
+
+#if FASTLED_HAS_SIMD && FASTLED_NOISE_FIXED == 1 && FASTLED_SCALE8_FIXED == 1 && FASTLED_NOISE_ALLOW_AVERAGE_TO_OVERFLOW == 0 && defined(FADE_16)
+#define FASTLED_NOISE_LANES 1
+#else
+#define FASTLED_NOISE_LANES 0
+#endif
 
-    int8_t ans = lerp7by8(Y1,Y2,w);
+namespace noise_detail {
 
-    return ans;
+// Points h at the corner hashes of cell X of the row, starting from the
+// cell it holds now. The x+1 side of a cell is the x side of the next one,
+// so stepping one cell along x only hashes the new side.
+static void inline __attribute__((always_inline)) moveToCell(uint8_t X, uint8_t Y, uint8_t Z, int &cell, uint8_t h[8]) {
+    if (X == cell) {
+        return;
+    }
+    if (cell >= 0 && X == uint8_t(cell + 1)) {
+        uint8_t B = NOISE_P(X+1)+Y;
+        uint8_t BA = NOISE_P(B) + Z;
+        uint8_t BB = NOISE_P(B+1)+Z;
+        h[0] = h[1];
+        h[2] = h[3];
+        h[4] = h[5];
+        h[6] = h[7];
+        h[1] = NOISE_P(BA);
+        h[3] = NOISE_P(BB);
+        h[5] = NOISE_P(BA+1);
+        h[7] = NOISE_P(BB+1);
+    } else {
+        hashCorners(X, Y, Z, h);
+    }
+    cell = X;
 }
 
-uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z) {
-    //return scale8(76+(inoise8_raw(x,y,z)),215)<<1;
-    int8_t n = inoise8_raw( x, y, z);  // -64..+64
-    n+= 64;                            //   0..128
-    uint8_t ans = qadd8( n, n);        //   0..255
-    return ans;
+#if FASTLED_NOISE_LANES
+
+// Eight int16 lanes. Comparisons return all ones per true lane.
+#if FASTLED_SIMD_SSE2
+typedef __m128i lanes16;
+static inline lanes16 lanesLoad(const void *p) { return _mm_loadu_si128(static_cast<const __m128i *>(p)); }
+static inline void lanesStore(void *p, lanes16 v) { _mm_storeu_si128(static_cast<__m128i *>(p), v); }
+static inline lanes16 lanesSet(int16_t v) { return _mm_set1_epi16(v); }
+static inline lanes16 lanesAdd(lanes16 a, lanes16 b) { return _mm_add_epi16(a, b); }
+static inline lanes16 lanesSub(lanes16 a, lanes16 b) { return _mm_sub_epi16(a, b); }
+static inline lanes16 lanesAnd(lanes16 a, lanes16 b) { return _mm_and_si128(a, b); }
+static inline lanes16 lanesOr(lanes16 a, lanes16 b) { return _mm_or_si128(a, b); }
+static inline lanes16 lanesXor(lanes16 a, lanes16 b) { return _mm_xor_si128(a, b); }
+static inline lanes16 lanesLt(lanes16 a, lanes16 b) { return _mm_cmplt_epi16(a, b); }
+static inline lanes16 lanesGt(lanes16 a, lanes16 b) { return _mm_cmpgt_epi16(a, b); }
+static inline lanes16 lanesEq(lanes16 a, lanes16 b) { return _mm_cmpeq_epi16(a, b); }
+static inline lanes16 lanesSel(lanes16 m, lanes16 a, lanes16 b) { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+static inline lanes16 lanesHalf(lanes16 v) { return _mm_srai_epi16(v, 1); }
+static inline lanes16 lanesHalfU(lanes16 v) { return _mm_srli_epi16(v, 1); }
+static inline lanes16 lanesHigh8(lanes16 v) { return _mm_srli_epi16(v, 8); }
+static inline lanes16 lanesSext8(lanes16 v) { return _mm_srai_epi16(_mm_slli_epi16(v, 8), 8); }
+static inline lanes16 lanesMul(lanes16 a, lanes16 b) { return _mm_mullo_epi16(a, b); }
+// scale16(i, s) == (i * (s + 1)) >> 16, as the high half of i * s plus
+// the carry out of adding i to the low half.
+static inline lanes16 lanesScale16(lanes16 i, lanes16 s) {
+    const lanes16 bias = _mm_set1_epi16(-0x8000);
+    lanes16 lo = _mm_mullo_epi16(i, s);
+    lanes16 carry = _mm_cmplt_epi16(_mm_xor_si128(_mm_add_epi16(lo, i), bias), _mm_xor_si128(lo, bias));
+    return _mm_sub_epi16(_mm_mulhi_epu16(i, s), carry);
+}
+// Turns eight lanes of eight corner hashes into eight corners of eight lanes.
+static inline void lanesTranspose(const uint8_t in[8][8], lanes16 out[8]) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i r[8];
+    for (int l = 0; l < 8; ++l) {
+        r[l] = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in[l]));
+    }
+    __m128i t0 = _mm_unpacklo_epi8(r[0], r[1]);
+    __m128i t1 = _mm_unpacklo_epi8(r[2], r[3]);
+    __m128i t2 = _mm_unpacklo_epi8(r[4], r[5]);
+    __m128i t3 = _mm_unpacklo_epi8(r[6], r[7]);
+    __m128i u0 = _mm_unpacklo_epi16(t0, t1);
+    __m128i u1 = _mm_unpackhi_epi16(t0, t1);
+    __m128i u2 = _mm_unpacklo_epi16(t2, t3);
+    __m128i u3 = _mm_unpackhi_epi16(t2, t3);
+    __m128i c[4] = {_mm_unpacklo_epi32(u0, u2), _mm_unpackhi_epi32(u0, u2),
+                    _mm_unpacklo_epi32(u1, u3), _mm_unpackhi_epi32(u1, u3)};
+    for (int i = 0; i < 4; ++i) {
+        out[2 * i] = _mm_unpacklo_epi8(c[i], zero);
+        out[2 * i + 1] = _mm_unpackhi_epi8(c[i], zero);
+    }
+}
+#else
+typedef int16x8_t lanes16;
+static inline lanes16 lanesLoad(const void *p) { return vld1q_s16(static_cast<const int16_t *>(p)); }
+static inline void lanesStore(void *p, lanes16 v) { vst1q_s16(static_cast<int16_t *>(p), v); }
+static inline lanes16 lanesSet(int16_t v) { return vdupq_n_s16(v); }
+static inline lanes16 lanesAdd(lanes16 a, lanes16 b) { return vaddq_s16(a, b); }
+static inline lanes16 lanesSub(lanes16 a, lanes16 b) { return vsubq_s16(a, b); }
+static inline lanes16 lanesAnd(lanes16 a, lanes16 b) { return vandq_s16(a, b); }
+static inline lanes16 lanesOr(lanes16 a, lanes16 b) { return vorrq_s16(a, b); }
+static inline lanes16 lanesXor(lanes16 a, lanes16 b) { return veorq_s16(a, b); }
+static inline lanes16 lanesLt(lanes16 a, lanes16 b) { return vreinterpretq_s16_u16(vcltq_s16(a, b)); }
+static inline lanes16 lanesGt(lanes16 a, lanes16 b) { return vreinterpretq_s16_u16(vcgtq_s16(a, b)); }
+static inline lanes16 lanesEq(lanes16 a, lanes16 b) { return vreinterpretq_s16_u16(vceqq_s16(a, b)); }
+static inline lanes16 lanesSel(lanes16 m, lanes16 a, lanes16 b) { return vbslq_s16(vreinterpretq_u16_s16(m), a, b); }
+static inline lanes16 lanesHalf(lanes16 v) { return vshrq_n_s16(v, 1); }
+static inline lanes16 lanesHalfU(lanes16 v) { return vreinterpretq_s16_u16(vshrq_n_u16(vreinterpretq_u16_s16(v), 1)); }
+static inline lanes16 lanesHigh8(lanes16 v) { return vreinterpretq_s16_u16(vshrq_n_u16(vreinterpretq_u16_s16(v), 8)); }
+static inline lanes16 lanesSext8(lanes16 v) { return vshrq_n_s16(vshlq_n_s16(v, 8), 8); }
+static inline lanes16 lanesMul(lanes16 a, lanes16 b) { return vmulq_s16(a, b); }
+static inline lanes16 lanesScale16(lanes16 i, lanes16 s) {
+    uint16x8_t a = vreinterpretq_u16_s16(i);
+    uint16x8_t b = vreinterpretq_u16_s16(s);
+    uint32x4_t lo = vaddw_u16(vmull_u16(vget_low_u16(a), vget_low_u16(b)), vget_low_u16(a));
+    uint32x4_t hi = vaddw_u16(vmull_u16(vget_high_u16(a), vget_high_u16(b)), vget_high_u16(a));
+    return vreinterpretq_s16_u16(vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16)));
+}
+static inline void lanesTranspose(const uint8_t in[8][8], lanes16 out[8]) {
+    int16_t corner[8];
+    for (int c = 0; c < 8; ++c) {
+        for (int l = 0; l < 8; ++l) {
+            corner[l] = in[l][c];
+        }
+        out[c] = vld1q_s16(corner);
+    }
+}
+#endif
+
+// -v in the lanes where m is set.
+static inline lanes16 lanesNegIf(lanes16 m, lanes16 v) { return lanesSub(lanesXor(v, m), m); }
+
+static inline lanes16 lanesBit(lanes16 v, int16_t bit) {
+    return lanesEq(lanesAnd(v, lanesSet(bit)), lanesSet(bit));
+}
+
+// Per lane versions of ease16InOutQuad, grad16 and lerp15by16.
+static inline lanes16 lanesEase16(lanes16 i) {
+    lanes16 hi = lanesLt(i, lanesSet(0));
+    lanes16 j = lanesXor(i, hi);
+    lanes16 jj = lanesScale16(j, j);
+    return lanesXor(lanesAdd(jj, jj), hi);
+}
+
+static inline lanes16 lanesGrad16(lanes16 hash, lanes16 x, lanes16 y, lanes16 z) {
+    lanes16 u = lanesSel(lanesLt(hash, lanesSet(8)), x, y);
+    lanes16 xz = lanesSel(lanesOr(lanesEq(hash, lanesSet(12)), lanesEq(hash, lanesSet(14))), x, z);
+    lanes16 v = lanesSel(lanesLt(hash, lanesSet(4)), y, xz);
+    u = lanesNegIf(lanesBit(hash, 1), u);
+    v = lanesNegIf(lanesBit(hash, 2), v);
+    return lanesAdd(lanesAdd(lanesHalf(u), lanesHalf(v)), lanesAnd(u, lanesSet(1)));
+}
+
+// grad16 for a block inside one cell, where the hash is the same in every
+// lane and the selection is resolved once for all of them.
+static inline lanes16 lanesGrad16(uint8_t hash, lanes16 x, lanes16 y, lanes16 z) {
+    hash = hash & 15;
+    lanes16 u = hash < 8 ? x : y;
+    lanes16 v = hash < 4 ? y : hash == 12 || hash == 14 ? x : z;
+    if (hash & 1) { u = lanesSub(lanesSet(0), u); }
+    if (hash & 2) { v = lanesSub(lanesSet(0), v); }
+    return lanesAdd(lanesAdd(lanesHalf(u), lanesHalf(v)), lanesAnd(u, lanesSet(1)));
+}
+
+static inline lanes16 lanesLerp16(lanes16 a, lanes16 b, lanes16 frac) {
+    lanes16 gt = lanesGt(b, a);
+    lanes16 scaled = lanesScale16(lanesSel(gt, lanesSub(b, a), lanesSub(a, b)), frac);
+    return lanesSel(gt, lanesAdd(a, scaled), lanesSub(a, scaled));
+}
+
+// Per lane versions of ease8InOutQuad, grad8 and lerp7by8, on int8 values
+// kept sign extended in the 16 bit lanes.
+static inline lanes16 lanesEase8(lanes16 i) {
+    lanes16 hi = lanesAnd(lanesBit(i, 0x80), lanesSet(0xFF));
+    lanes16 j = lanesXor(i, hi);
+    lanes16 jj = lanesHigh8(lanesMul(j, lanesAdd(j, lanesSet(1))));
+    return lanesXor(lanesAnd(lanesAdd(jj, jj), lanesSet(0xFF)), hi);
+}
+
+static inline lanes16 lanesGrad8(lanes16 hash, lanes16 x, lanes16 y, lanes16 z) {
+    lanes16 group = lanesAnd(hash, lanesSet(12));
+    lanes16 isYZ = lanesEq(group, lanesSet(8));
+    lanes16 u = lanesSel(isYZ, y, x);
+    lanes16 v = lanesSel(lanesOr(isYZ, lanesEq(group, lanesSet(4))), z, y);
+    u = lanesSext8(lanesNegIf(lanesBit(hash, 1), u));
+    v = lanesSext8(lanesNegIf(lanesBit(hash, 2), v));
+    return lanesAdd(lanesAdd(lanesHalf(u), lanesHalf(v)), lanesAnd(u, lanesSet(1)));
+}
+
+static inline lanes16 lanesGrad8(uint8_t hash, lanes16 x, lanes16 y, lanes16 z) {
+    uint8_t group = hash & 12;
+    lanes16 u = group == 8 ? y : x;
+    lanes16 v = group == 4 || group == 8 ? z : y;
+    if (hash & 1) { u = lanesSext8(lanesSub(lanesSet(0), u)); }
+    if (hash & 2) { v = lanesSext8(lanesSub(lanesSet(0), v)); }
+    return lanesAdd(lanesAdd(lanesHalf(u), lanesHalf(v)), lanesAnd(u, lanesSet(1)));
+}
+
+static inline lanes16 lanesLerp8(lanes16 a, lanes16 b, lanes16 frac) {
+    lanes16 gt = lanesGt(b, a);
+    lanes16 delta = lanesSel(gt, lanesSub(b, a), lanesSub(a, b));
+    lanes16 scaled = lanesHigh8(lanesMul(delta, lanesAdd(frac, lanesSet(1))));
+    return lanesSext8(lanesSel(gt, lanesAdd(a, scaled), lanesSub(a, scaled)));
+}
+
+// The y and z inputs of a row, the same in every lane.
+struct RowLanes {
+    lanes16 yy, yyN, zz, zzN, v, w;
+};
+
+// Corner hashes for eight samples in cells X. Neighbouring samples usually
+// share a cell: then this returns true and the hashes are in h. Otherwise
+// hash gets the hashes of each lane.
+static inline bool lanesHashes(const uint8_t X[8], uint8_t Y, uint8_t Z, int &cell, uint8_t h[8], lanes16 hash[8]) {
+    bool oneCell = true;
+    for (int l = 1; l < 8; ++l) {
+        oneCell = oneCell && X[l] == X[0];
+    }
+    if (oneCell) {
+        moveToCell(X[0], Y, Z, cell, h);
+        return true;
+    }
+    uint8_t lanes[8][8];
+    for (int l = 0; l < 8; ++l) {
+        moveToCell(X[l], Y, Z, cell, h);
+        memcpy(lanes[l], h, 8);
+    }
+    lanesTranspose(lanes, hash);
+    for (int c = 0; c < 8; ++c) {
+        hash[c] = lanesAnd(hash[c], lanesSet(15));
+    }
+    return false;
+}
+
+// Hash is lanes16 for per lane hashes, uint8_t for a block in one cell.
+template <typename Hash>
+static inline lanes16 noise16Lanes(const Hash hash[8], lanes16 frac, const RowLanes &row) {
+    lanes16 xx = lanesHalfU(frac);
+    lanes16 xxN = lanesXor(xx, lanesSet(-0x8000));
+    lanes16 u = lanesEase16(frac);
+    lanes16 X1 = lanesLerp16(lanesGrad16(hash[0], xx, row.yy, row.zz), lanesGrad16(hash[1], xxN, row.yy, row.zz), u);
+    lanes16 X2 = lanesLerp16(lanesGrad16(hash[2], xx, row.yyN, row.zz), lanesGrad16(hash[3], xxN, row.yyN, row.zz), u);
+    lanes16 X3 = lanesLerp16(lanesGrad16(hash[4], xx, row.yy, row.zzN), lanesGrad16(hash[5], xxN, row.yy, row.zzN), u);
+    lanes16 X4 = lanesLerp16(lanesGrad16(hash[6], xx, row.yyN, row.zzN), lanesGrad16(hash[7], xxN, row.yyN, row.zzN), u);
+    lanes16 Y1 = lanesLerp16(X1, X2, row.v);
+    lanes16 Y2 = lanesLerp16(X3, X4, row.v);
+    return lanesLerp16(Y1, Y2, row.w);
+}
+
+template <typename Hash>
+static inline lanes16 noise8Lanes(const Hash hash[8], lanes16 frac, const RowLanes &row) {
+    lanes16 xx = lanesHalfU(frac);
+    lanes16 xxN = lanesSub(xx, lanesSet(0x80));
+    lanes16 u = lanesEase8(frac);
+    lanes16 X1 = lanesLerp8(lanesGrad8(hash[0], xx, row.yy, row.zz), lanesGrad8(hash[1], xxN, row.yy, row.zz), u);
+    lanes16 X2 = lanesLerp8(lanesGrad8(hash[2], xx, row.yyN, row.zz), lanesGrad8(hash[3], xxN, row.yyN, row.zz), u);
+    lanes16 X3 = lanesLerp8(lanesGrad8(hash[4], xx, row.yy, row.zzN), lanesGrad8(hash[5], xxN, row.yy, row.zzN), u);
+    lanes16 X4 = lanesLerp8(lanesGrad8(hash[6], xx, row.yyN, row.zzN), lanesGrad8(hash[7], xxN, row.yyN, row.zzN), u);
+    lanes16 Y1 = lanesLerp8(X1, X2, row.v);
+    lanes16 Y2 = lanesLerp8(X3, X4, row.v);
+    return lanesLerp8(Y1, Y2, row.w);
+}
+
+#endif // FASTLED_NOISE_LANES
+
+} // namespace noise_detail
+
+void inoise16_row(uint16_t *out, int count, uint32_t x, int32_t dx, uint32_t y, uint32_t z) {
+    uint8_t Y = y >> 16;
+    uint8_t Z = z >> 16;
+    uint16_t v = y & 0xFFFF;
+    uint16_t w = z & 0xFFFF;
+    int16_t yy = (v >> 1) & 0x7FFF;
+    int16_t zz = (w >> 1) & 0x7FFF;
+    v = EASE16(v); w = EASE16(w);
+
+    uint8_t h[8];
+    int cell = -1;
+    int i = 0;
+#if FASTLED_NOISE_LANES
+    using namespace noise_detail;
+    RowLanes row;
+    row.yy = lanesSet(yy);
+    row.yyN = lanesSet(yy - 0x8000);
+    row.zz = lanesSet(zz);
+    row.zzN = lanesSet(zz - 0x8000);
+    row.v = lanesSet(v);
+    row.w = lanesSet(w);
+    for (; i + 8 <= count; i += 8) {
+        uint16_t frac[8];
+        uint8_t X[8];
+        for (int l = 0; l < 8; ++l, x += dx) {
+            frac[l] = x & 0xFFFF;
+            X[l] = x >> 16;
+        }
+        lanes16 hash[8];
+        int16_t raw[8];
+        if (lanesHashes(X, Y, Z, cell, h, hash)) {
+            lanesStore(raw, noise16Lanes(h, lanesLoad(frac), row));
+        } else {
+            lanesStore(raw, noise16Lanes(hash, lanesLoad(frac), row));
+        }
+        for (int l = 0; l < 8; ++l) {
+            out[i + l] = scaleNoise16(raw[l]);
+        }
+    }
+#endif
+    for (; i < count; ++i, x += dx) {
+        uint8_t X = x >> 16;
+        noise_detail::moveToCell(X, Y, Z, cell, h);
+        uint16_t u = x & 0xFFFF;
+        int16_t xx = (u >> 1) & 0x7FFF;
+        u = EASE16(u);
+        out[i] = noise_detail::scaleNoise16(noise_detail::noise16Cube(h, xx, yy, zz, u, v, w));
+    }
+}
+
+void inoise8_row(uint8_t *out, int count, uint16_t x, int16_t dx, uint16_t y, uint16_t z) {
+    uint8_t Y = y >> 8;
+    uint8_t Z = z >> 8;
+    uint8_t v = y;
+    uint8_t w = z;
+    int8_t yy = (v >> 1) & 0x7F;
+    int8_t zz = (w >> 1) & 0x7F;
+    v = EASE8(v); w = EASE8(w);
+
+    uint8_t h[8];
+    int cell = -1;
+    int i = 0;
+#if FASTLED_NOISE_LANES
+    using namespace noise_detail;
+    RowLanes row;
+    row.yy = lanesSet(yy);
+    row.yyN = lanesSet(yy - 0x80);
+    row.zz = lanesSet(zz);
+    row.zzN = lanesSet(zz - 0x80);
+    row.v = lanesSet(v);
+    row.w = lanesSet(w);
+    for (; i + 8 <= count; i += 8) {
+        uint16_t frac[8];
+        uint8_t X[8];
+        for (int l = 0; l < 8; ++l, x += dx) {
+            frac[l] = x & 0xFF;
+            X[l] = x >> 8;
+        }
+        lanes16 hash[8];
+        int16_t raw[8];
+        if (lanesHashes(X, Y, Z, cell, h, hash)) {
+            lanesStore(raw, noise8Lanes(h, lanesLoad(frac), row));
+        } else {
+            lanesStore(raw, noise8Lanes(hash, lanesLoad(frac), row));
+        }
+        for (int l = 0; l < 8; ++l) {
+            out[i + l] = scaleNoise8(raw[l]);
+        }
+    }
+#endif
+    for (; i < count; ++i, x += dx) {
+        uint8_t X = x >> 8;
+        noise_detail::moveToCell(X, Y, Z, cell, h);
+        uint8_t u = x;
+        int8_t xx = (u >> 1) & 0x7F;
+        u = EASE8(u);
+        out[i] = noise_detail::scaleNoise8(noise_detail::noise8Cube(h, xx, yy, zz, u, v, w));
+    }
 }
 
 int8_t inoise8_raw(uint16_t x, uint16_t y)
@@ -758,15 +1143,17 @@ void fill_raw_2dnoise8(uint8_t *pData, int width, int height, uint8_t octaves, q
   scaley *= skip;
 
   fract8 invamp = 255-amplitude;
-  uint16_t xx = x;
+  FASTLED_STACK_ARRAY(uint8_t, noise, width);
   for(int i = 0; i < height; ++i, y+=scaley) {
     uint8_t *pRow = pData + (i*width);
-    xx = x;
-    for(int j = 0; j < width; ++j, xx+=scalex) {
-      uint8_t noise_base = inoise8(xx,y,time);
+    inoise8_row(noise, width, x, scalex, y, time);
+    for(int j = 0; j < width; ++j) {
+      uint8_t noise_base = noise[j];
       noise_base = (0x80 & noise_base) ? (noise_base - 127) : (127 - noise_base);
       noise_base = scale8(noise_base<<1,amplitude);
-      if(skip == 1) {
+      // With invamp 0 each block below overwrites the last one, leaving
+      // every pixel with its own sample, so skip the blocks.
+      if(skip == 1 || invamp == 0) {
         pRow[j] = scale8(pRow[j],invamp) + noise_base;
       } else {
         for(int ii = i; ii<(i+skip) && ii<height; ++ii) {
@@ -795,10 +1182,12 @@ void fill_raw_2dnoise16(uint16_t *pData, int width, int height, uint8_t octaves,
   scalex *= skip;
   scaley *= skip;
   fract16 invamp = 65535-amplitude;
+  FASTLED_STACK_ARRAY(uint16_t, noise, width);
   for(int i = 0; i < height; i+=skip, y+=scaley) {
     uint16_t *pRow = pData + (i*width);
-    for(int j = 0,xx=x; j < width; j+=skip, xx+=scalex) {
-      uint16_t noise_base = inoise16(xx,y,time);
+    inoise16_row(noise, (width + skip - 1) / skip, x, scalex, y, time);
+    for(int j = 0; j < width; j+=skip) {
+      uint16_t noise_base = noise[j / skip];
       noise_base = (0x8000 & noise_base) ? noise_base - (32767) : 32767 - noise_base;
       noise_base = scale16(noise_base<<1, amplitude);
       if(skip==1) {
@@ -832,13 +1221,13 @@ void fill_raw_2dnoise16into8(uint8_t *pData, int width, int height, uint8_t octa
 
   scalex *= skip;
   scaley *= skip;
-  uint32_t xx;
   fract8 invamp = 255-amplitude;
+  FASTLED_STACK_ARRAY(uint16_t, noise, width);
   for(int i = 0; i < height; i+=skip, y+=scaley) {
     uint8_t *pRow = pData + (i*width);
-    xx = x;
-    for(int j = 0; j < width; j+=skip, xx+=scalex) {
-      uint16_t noise_base = inoise16(xx,y,time);
+    inoise16_row(noise, (width + skip - 1) / skip, x, scalex, y, time);
+    for(int j = 0; j < width; j+=skip) {
+      uint16_t noise_base = noise[j / skip];
       noise_base = (0x8000 & noise_base) ? noise_base - (32767) : 32767 - noise_base;
       noise_base = scale8(noise_base>>7,amplitude);
       if(skip==1) {
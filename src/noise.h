@@ -135,6 +135,22 @@ extern int8_t inoise8_raw(uint16_t x);
 /// @} 8-Bit Raw Noise Functions
 
 
+/// @name Row Noise Functions
+/// Evaluate a whole row of samples at once. Along a row only x changes, so
+/// the lattice hashes are computed once per cell instead of once per sample,
+/// and on hosts with SSE2 or NEON eight samples are evaluated together. The
+/// results are identical to calling the per sample functions.
+/// @{
+
+/// Fills out[i] with inoise16(x + i * dx, y, z), for i in [0, count).
+extern void inoise16_row(uint16_t *out, int count, uint32_t x, int32_t dx, uint32_t y, uint32_t z);
+
+/// Fills out[i] with inoise8(x + i * dx, y, z), for i in [0, count).
+extern void inoise8_row(uint8_t *out, int count, uint16_t x, int16_t dx, uint16_t y, uint16_t z);
+
+/// @} Row Noise Functions
+
+
 /// @name 32-Bit Simplex Noise Functions
 /// @{
 
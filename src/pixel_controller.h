@@ -15,6 +15,7 @@
 #include "rgbw.h"
 #include "fl/five_bit_hd_gamma.h"
 #include "fl/force_inline.h"
+#include "fl/pixel_encode.h"
 #include "lib8tion/scale8.h"
 #include "fl/namespace.h"
 #include "eorder.h"
@@ -167,6 +168,21 @@ struct PixelController {
         initOffsets(len);
     }
 
+    /// Constructor
+    /// @param d pointer to LED data
+    /// @param len length of the LED data
+    /// @param color_adjustment LED scale values
+    /// @param dither dither setting for the LEDs
+    /// @param ditherPhase dither counter for this frame, see CLEDController::nextDitherPhase()
+    PixelController(
+            const CRGB *d, int len, ColorAdjustment color_adjustment,
+            EDitherMode dither, uint8_t ditherPhase)
+                : mData((const uint8_t*)d), mLen(len), mLenRemaining(len), mColorAdjustment(color_adjustment) {
+        enable_dithering(dither, ditherPhase);
+        mAdvance = 3;
+        initOffsets(len);
+    }
+
     /// Constructor
     /// @param d pointer to LED data
     /// @param len length of the LED data
@@ -180,6 +196,21 @@ struct PixelController {
         initOffsets(len);
     }
 
+    /// Constructor
+    /// @param d pointer to LED data
+    /// @param len length of the LED data
+    /// @param color_adjustment LED scale values
+    /// @param dither dither setting for the LEDs
+    /// @param ditherPhase dither counter for this frame, see CLEDController::nextDitherPhase()
+    PixelController(
+            const CRGB &d, int len, ColorAdjustment color_adjustment, EDitherMode dither,
+            uint8_t ditherPhase)
+                : mData((const uint8_t*)&d), mLen(len), mLenRemaining(len), mColorAdjustment(color_adjustment) {
+        enable_dithering(dither, ditherPhase);
+        mAdvance = 0;
+        initOffsets(len);
+    }
+
     #if FASTLED_HD_COLOR_MIXING
     uint8_t global_brightness() const {
         return mColorAdjustment.brightness;
@@ -226,13 +257,18 @@ struct PixelController {
 #endif
 
 
-    /// Set up the values for binary dithering
+    /// Set up the values for binary dithering, advancing a counter shared by
+    /// all pixel controllers that don't pass their own dither phase.
     void init_binary_dithering() {
-#if !defined(NO_DITHERING) || (NO_DITHERING != 1)
         // R is the digther signal 'counter'.
         static uint8_t R = 0;
-        ++R;
+        init_binary_dithering(++R);
+    }
 
+    /// Set up the values for binary dithering
+    /// @param R the dither signal counter for this frame
+    void init_binary_dithering(uint8_t R) {
+#if !defined(NO_DITHERING) || (NO_DITHERING != 1)
         // R is wrapped around at 2^ditherBits,
         // so if ditherBits is 2, R will cycle through (0,1,2,3)
         uint8_t ditherBits = VIRTUAL_BITS;
@@ -277,6 +313,8 @@ struct PixelController {
 #endif
                 if(e[i]) --e[i];
         }
+#else
+        (void)R;
 #endif
     }
 
@@ -299,6 +337,16 @@ struct PixelController {
         }
     }
 
+    /// Toggle dithering enable, using the given dither counter
+    /// @param dither the dither setting
+    /// @param ditherPhase the dither signal counter for this frame
+    void enable_dithering(EDitherMode dither, uint8_t ditherPhase) {
+        switch(dither) {
+            case BINARY_DITHER: init_binary_dithering(ditherPhase); break;
+            default: d[0]=d[1]=d[2]=e[0]=e[1]=e[2]=0; break;
+        }
+    }
+
     /// Get the length of the LED strip
     /// @returns PixelController::mLen
     FASTLED_FORCE_INLINE int size() { return mLen; }
@@ -600,6 +648,65 @@ struct PixelController {
             b0_out, b1_out, b2_out, b3_out);  // RGBW data now in total native led order.
 #endif
     }
+
+    /// @name Batch output
+    /// Convert all remaining pixels into a contiguous byte buffer in led native order,
+    /// ready to be handed to a DMA engine. The output is identical to calling
+    /// loadAndScaleRGB() / loadAndScaleRGBW(), advanceData() and stepDithering()
+    /// for every pixel, and the controller is left in the same state as that loop.
+    /// Only lane 0 is converted, so this is meant for single lane controllers.
+    /// @{
+
+    /// Batch version of loadAndScaleRGB().
+    /// @param out receives 3 bytes per remaining pixel
+    /// @returns the number of bytes written
+    int loadAndScaleRGBBatch(uint8_t *out) {
+        const int n = mLenRemaining;
+        // The dither value flips between d and e - d from one pixel to the next,
+        // so two pixels make up the whole per byte pattern.
+        uint8_t order[3];
+        uint8_t dith[fl::kPixelEncodePatternBytes];
+        uint8_t scl[fl::kPixelEncodePatternBytes];
+        for (int slot = 0; slot < 3; ++slot) {
+            const int ch = RGB_BYTE(RGB_ORDER, slot);
+            order[slot] = uint8_t(ch);
+            dith[slot] = d[ch];
+            dith[slot + 3] = uint8_t(e[ch] - d[ch]);
+            scl[slot] = scl[slot + 3] = mColorAdjustment.premixed.raw[ch];
+        }
+        fl::encodePixelBytes(out, mData, fl::u32(n), mAdvance, order, dith, scl);
+        mData += n * mAdvance;
+        mLenRemaining = 0;
+        if (n & 1) {
+            stepDithering();
+        }
+        return n * 3;
+    }
+
+    /// Batch version of loadAndScaleRGBW().
+    /// @param rgbw the white channel conversion settings
+    /// @param out receives 4 bytes per remaining pixel
+    /// @returns the number of bytes written
+    int loadAndScaleRGBWBatch(Rgbw rgbw, uint8_t *out) {
+        const int n = mLenRemaining;
+        for (int i = 0; i < n; ++i) {
+            loadAndScaleRGBW(rgbw, out, out + 1, out + 2, out + 3);
+            out += 4;
+            advanceData();
+            stepDithering();
+        }
+        return n * 4;
+    }
+
+    /// Picks loadAndScaleRGBWBatch() or loadAndScaleRGBBatch() depending on rgbw.active().
+    /// @param rgbw the white channel conversion settings
+    /// @param out receives 3 or 4 bytes per remaining pixel
+    /// @returns the number of bytes written
+    int loadAndScaleBatch(Rgbw rgbw, uint8_t *out) {
+        return rgbw.active() ? loadAndScaleRGBWBatch(rgbw, out) : loadAndScaleRGBBatch(out);
+    }
+
+    /// @} Batch output
 };
 
 
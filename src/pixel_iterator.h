@@ -44,6 +44,11 @@ struct PixelControllerVtable {
     pc->loadAndScale_WS2816_HD(s0_out, s1_out, s2_out);
   }
 
+  static int loadAndScaleBatch(void* pixel_controller, Rgbw rgbw, uint8_t* out) {
+    PixelControllerT* pc = static_cast<PixelControllerT*>(pixel_controller);
+    return pc->loadAndScaleBatch(rgbw, out);
+  }
+
   static void stepDithering(void* pixel_controller) {
     PixelControllerT* pc = static_cast<PixelControllerT*>(pixel_controller);
     pc->stepDithering();
@@ -78,6 +83,7 @@ typedef void (*loadAndScaleRGBFunction)(void* pixel_controller, uint8_t* r_out,
 typedef void (*loadAndScale_APA102_HDFunction)(void* pixel_controller, uint8_t* b0_out, uint8_t* b1_out, uint8_t* b2_out, uint8_t* brightness_out);
 #endif
 typedef void (*loadAndScale_WS2816_HDFunction)(void* pixel_controller, uint16_t* b0_out, uint16_t* b1_out, uint16_t* b2_out);
+typedef int (*loadAndScaleBatchFunction)(void* pixel_controller, Rgbw rgbw, uint8_t* out);
 typedef void (*stepDitheringFunction)(void* pixel_controller);
 typedef void (*advanceDataFunction)(void* pixel_controller);
 typedef int (*sizeFunction)(void* pixel_controller);
@@ -128,6 +134,7 @@ class PixelIterator {
       mLoadAndScale_APA102_HD = &Vtable::loadAndScale_APA102_HD;
       #endif
       mLoadAndScale_WS2816_HD = &Vtable::loadAndScale_WS2816_HD;
+      mLoadAndScaleBatch = &Vtable::loadAndScaleBatch;
       mStepDithering = &Vtable::stepDithering;
       mAdvanceData = &Vtable::advanceData;
       mSize = &Vtable::size;
@@ -152,6 +159,11 @@ class PixelIterator {
     void loadAndScale_WS2816_HD(uint16_t *s0_out, uint16_t *s1_out, uint16_t *s2_out) {
       mLoadAndScale_WS2816_HD(mPixelController, s0_out, s1_out, s2_out);
     }
+    // Writes every remaining pixel (3 or 4 bytes each, depending on rgbw) into out
+    // and returns the number of bytes written. Same output as the per pixel loop.
+    int loadAndScaleBatch(uint8_t *out) {
+      return mLoadAndScaleBatch(mPixelController, mRgbw, out);
+    }
     void stepDithering() { mStepDithering(mPixelController); }
     void advanceData() { mAdvanceData(mPixelController); }
     int size() { return mSize(mPixelController); }
@@ -175,6 +187,7 @@ class PixelIterator {
     loadAndScale_APA102_HDFunction mLoadAndScale_APA102_HD = nullptr;
     #endif
     loadAndScale_WS2816_HDFunction mLoadAndScale_WS2816_HD = nullptr;
+    loadAndScaleBatchFunction mLoadAndScaleBatch = nullptr;
     stepDitheringFunction mStepDithering = nullptr;
     advanceDataFunction mAdvanceData = nullptr;
     sizeFunction mSize = nullptr;
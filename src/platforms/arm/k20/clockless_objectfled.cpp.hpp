@@ -119,38 +119,9 @@ void ObjectFled::showPixels(uint8_t data_pin, PixelIterator& pixel_iterator) {
     const Rgbw rgbw = pixel_iterator.get_rgbw();
 
             fl::span<uint8_t> strip_pixels = group.mRectDrawBuffer.getLedsBufferBytesForPin(data_pin, true);
-    if (rgbw.active()) {
-        uint8_t r, g, b, w;
-        while (pixel_iterator.has(1)) {
-            FASTLED_ASSERT(strip_pixels.size() >= 4, "ObjectFled::showPixels: buffer overflow");
-            pixel_iterator.loadAndScaleRGBW(&r, &g, &b, &w);
-            strip_pixels[0] = r;
-            strip_pixels[1] = g;
-            strip_pixels[2] = b;
-            strip_pixels[3] = w;
-            strip_pixels.pop_front();
-            strip_pixels.pop_front();
-            strip_pixels.pop_front();
-            strip_pixels.pop_front();
-            pixel_iterator.advanceData();
-            pixel_iterator.stepDithering();
-        }
-    } else {
-        uint8_t r, g, b;
-        while (pixel_iterator.has(1)) {
-            FASTLED_ASSERT(strip_pixels.size() >= 3, "ObjectFled::showPixels: buffer overflow");
-            pixel_iterator.loadAndScaleRGB(&r, &g, &b);
-            strip_pixels[0] = r;
-            strip_pixels[1] = g;
-            strip_pixels[2] = b;
-            strip_pixels.pop_front();
-            strip_pixels.pop_front();
-            strip_pixels.pop_front();
-            pixel_iterator.advanceData();
-            pixel_iterator.stepDithering();
-        }
-    }
-
+    FASTLED_ASSERT(strip_pixels.size() >= fl::size(pixel_iterator.size() * (rgbw.active() ? 4 : 3)),
+                   "ObjectFled::showPixels: buffer overflow");
+    pixel_iterator.loadAndScaleBatch(strip_pixels.data());
 }
 
 void ObjectFled::endShowLeds() {
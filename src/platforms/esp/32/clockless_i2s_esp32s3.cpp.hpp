@@ -123,35 +123,9 @@ void I2S_Esp32::showPixels(uint8_t data_pin, PixelIterator& pixel_iterator) {
     const Rgbw rgbw = pixel_iterator.get_rgbw();
     int numLeds = pixel_iterator.size();
             span<uint8_t> strip_bytes = group.mRectDrawBuffer.getLedsBufferBytesForPin(data_pin, true);
-    if (rgbw.active()) {
-        uint8_t r, g, b, w;
-        while (pixel_iterator.has(1)) {
-            pixel_iterator.loadAndScaleRGBW(&r, &g, &b, &w);
-            strip_bytes[0] = r;
-            strip_bytes[1] = g;
-            strip_bytes[2] = b;
-            strip_bytes[3] = w;
-            strip_bytes.pop_front();
-            strip_bytes.pop_front();
-            strip_bytes.pop_front();
-            strip_bytes.pop_front();
-            pixel_iterator.advanceData();
-            pixel_iterator.stepDithering();
-        }
-    } else {
-        uint8_t r, g, b;
-        while (pixel_iterator.has(1)) {
-            pixel_iterator.loadAndScaleRGB(&r, &g, &b);
-            strip_bytes[0] = r;
-            strip_bytes[1] = g;
-            strip_bytes[2] = b;
-            strip_bytes.pop_front();
-            strip_bytes.pop_front();
-            strip_bytes.pop_front();
-            pixel_iterator.advanceData();
-            pixel_iterator.stepDithering();
-        }
-    }
+    FASTLED_ASSERT(strip_bytes.size() >= fl::size(pixel_iterator.size() * (rgbw.active() ? 4 : 3)),
+                   "I2S_Esp32::showPixels: buffer overflow");
+    pixel_iterator.loadAndScaleBatch(strip_bytes.data());
 }
 
 void I2S_Esp32::endShowLeds() {
@@ -17,6 +17,7 @@
 #include "platforms/shared/ui/json/ui.cpp.hpp"
 #include "platforms/shared/ui/json/ui_internal.cpp.hpp"
 #include "platforms/shared/ui/json/ui_manager.cpp.hpp"
+#include "platforms/stub/fs_stub.cpp.hpp"
 #include "platforms/stub/led_sysdefs_stub.cpp.hpp"
 
 #endif // FASTLED_ALL_SRC
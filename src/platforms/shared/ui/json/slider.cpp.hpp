@@ -68,6 +68,22 @@ float JsonSliderImpl::getMax() const { return mMax; }
 float JsonSliderImpl::getMin() const { return mMin; }
 
 void JsonSliderImpl::setValue(float value) {
+    if (value < mMin) {
+        value = mMin;
+    } else if (value > mMax) {
+        value = mMax;
+    }
+    float oldValue = mValue;
+    mValue = value;
+
+    // If value actually changed, mark this component as changed for polling
+    if (!ALMOST_EQUAL_FLOAT(mValue, oldValue)) {
+        mInternal->markChanged();
+    }
+}
+
+void JsonSliderImpl::setValueInternal(float value) {
+    // Internal method for updates from JSON UI system - no change notification
     if (value < mMin) {
         value = mMin;
     } else if (value > mMax) {
@@ -101,10 +117,10 @@ void JsonSliderImpl::updateInternal(
     const FLArduinoJson::JsonVariantConst &value) {
     if (value.is<float>()) {
         float newValue = value.as<float>();
-        setValue(newValue);
+        setValueInternal(newValue);
     } else if (value.is<int>()) {
         int newValue = value.as<int>();
-        setValue(static_cast<float>(newValue));
+        setValueInternal(static_cast<float>(newValue));
     } else {
         FL_ASSERT(false, "*** SLIDER UPDATE ERROR: "
                     << name() << " " << fl::getJsonTypeStr(value)
@@ -1,3 +1,5 @@
+#include <string.h>
+
 #include "fl/json.h"
 #include "fl/map.h"
 #include "fl/mutex.h"
@@ -7,6 +9,7 @@
 #include "fl/warn.h"
 #include "fl/assert.h"
 #include "fl/string.h"
+#include "fl/hash.h"
 
 
 FL_DISABLE_WARNING(deprecated-declarations)
@@ -42,9 +45,11 @@ void JsonUiManager::addComponent(fl::WeakPtr<JsonUiInternal> component) {
     fl::lock_guard<fl::mutex> lock(mMutex);
     mComponents.insert(component);
     mItemsAdded = true;
+    mIndexDirty = true;
     
     // Mark the component as changed so it gets sent to the frontend initially
     if (auto ptr = component.lock()) {
+        mComponentIds[component.ptr_value()] = ptr->id();
         ptr->markChanged();
         //FL_WARN("*** COMPONENT REGISTERED: ID " << ptr->id() << " name=" << ptr->name() << " (Total: " << mComponents.size() << ")");
     }
@@ -53,6 +58,17 @@ void JsonUiManager::addComponent(fl::WeakPtr<JsonUiInternal> component) {
 void JsonUiManager::removeComponent(fl::WeakPtr<JsonUiInternal> component) {
     fl::lock_guard<fl::mutex> lock(mMutex);
     mComponents.erase(component);
+    mIndexDirty = true;
+    // Called from the component's destructor, when lock() may already fail.
+    if (const int *id = mComponentIds.find_value(component.ptr_value())) {
+        mSentState.erase(*id);
+        mComponentIds.erase(component.ptr_value());
+    }
+}
+
+fl::size JsonUiManager::sentStateSize() {
+    fl::lock_guard<fl::mutex> lock(mMutex);
+    return mSentState.size();
 }
 
 void JsonUiManager::processPendingUpdates() {
@@ -65,37 +81,25 @@ void JsonUiManager::processPendingUpdates() {
     }
 
 
-    bool shouldUpdate = false;
+    // A new component means the frontend rebuilds its layout from the full
+    // list, otherwise only the components that changed are sent.
+    bool sendAll = false;
+    fl::vector<JsonUiInternalPtr> changed;
     {
         fl::lock_guard<fl::mutex> lock(mMutex);
-        // Check if new components were added
-        shouldUpdate = mItemsAdded;
+        sendAll = mItemsAdded;
         mItemsAdded = false;
-        
-        // Poll all components for changes (eliminates need for manual notifications)
-        if (!shouldUpdate) {
-            for (auto &componentRef : mComponents) {
-                if (auto component = componentRef.lock()) {
-                    if (component->hasChanged()) {
-                        shouldUpdate = true;
-                        break; // Found at least one change, no need to check more
-                    }
-                }
-            }
-        }
-    }
-    
-    if (shouldUpdate) {
-        // Clear the changed flags for all components
-        {
-            fl::lock_guard<fl::mutex> lock(mMutex);
-            for (auto &componentRef : mComponents) {
-                if (auto component = componentRef.lock()) {
+        for (auto &componentRef : mComponents) {
+            if (auto component = componentRef.lock()) {
+                if (component->hasChanged()) {
                     component->clearChanged();
+                    changed.push_back(component);
                 }
             }
         }
-        
+    }
+
+    if (sendAll) {
         FLArduinoJson::JsonDocument doc;
         auto json = doc.to<FLArduinoJson::JsonArray>();
         toJson(json);
@@ -103,12 +107,110 @@ void JsonUiManager::processPendingUpdates() {
         serializeJson(doc, jsonStr);
         //FL_WARN("*** SENDING UI TO FRONTEND: " << jsonStr.substr(0, 100).c_str() << "...");
         mUpdateJs(jsonStr.c_str());
+    } else if (!changed.empty()) {
+        sendChanges(changed);
     }
+}
 
+namespace {
 
+// Cheap for the scalars that components send every frame, arrays and
+// objects are rare and hashed as text.
+fl::u32 hashJsonValue(FLArduinoJson::JsonVariantConst value) {
+    if (value.is<bool>()) {
+        return value.as<bool>() ? 1 : 2;
+    }
+    if (value.is<long long>()) {
+        const long long v = value.as<long long>();
+        return fl::MurmurHash3_x86_32(&v, sizeof(v), 3);
+    }
+    if (value.is<double>()) {
+        const double v = value.as<double>();
+        return fl::MurmurHash3_x86_32(&v, sizeof(v), 4);
+    }
+    if (value.is<const char *>()) {
+        const char *v = value.as<const char *>();
+        return fl::MurmurHash3_x86_32(v, strlen(v), 5);
+    }
+    string text;
+    serializeJson(value, text);
+    return fl::MurmurHash3_x86_32(text.c_str(), text.size(), 6);
+}
 
+} // namespace
 
+void JsonUiManager::hashFields(FLArduinoJson::JsonObjectConst json,
+                               SentFields *out) {
+    out->clear();
+    for (auto kv : json) {
+        const char *key = kv.key().c_str();
+        SentField field;
+        field.key = fl::MurmurHash3_x86_32(key, strlen(key));
+        field.value = hashJsonValue(kv.value());
+        out->push_back(field);
+    }
+}
 
+void JsonUiManager::sendChanges(const fl::vector<JsonUiInternalPtr> &changed) {
+    FLArduinoJson::JsonDocument doc;
+    auto delta = doc.to<FLArduinoJson::JsonObject>();
+    FLArduinoJson::JsonDocument scratch;
+    SentFields current;
+    for (auto &component : changed) {
+        scratch.clear();
+        auto json = scratch.to<FLArduinoJson::JsonObject>();
+        component->toJson(json);
+        hashFields(json, &current);
+        const int id = component->id();
+        FLArduinoJson::JsonObject fields;
+        fl::lock_guard<fl::mutex> lock(mMutex);
+        SentFields *sent = mSentState.find_value(id);
+        fl::size i = 0;
+        for (auto kv : json) {
+            const SentField &field = current[i++];
+            bool same = false;
+            for (fl::size k = 0; sent && k < sent->size() && !same; ++k) {
+                same = (*sent)[k].key == field.key &&
+                       (*sent)[k].value == field.value;
+            }
+            if (same) {
+                continue;
+            }
+            if (fields.isNull()) {
+                string key;
+                key.append(id);
+                fields = delta[FLArduinoJson::JsonString(
+                                   key.c_str(), FLArduinoJson::JsonString::Copied)]
+                             .to<FLArduinoJson::JsonObject>();
+            }
+            fields[kv.key()] = kv.value();
+        }
+        if (fields.isNull()) {
+            continue;
+        }
+        if (sent) {
+            sent->swap(current);
+        } else {
+            mSentState.insert(id, current);
+        }
+    }
+    if (delta.size() == 0) {
+        return;
+    }
+    string jsonStr;
+    serializeJson(doc, jsonStr);
+    mUpdateJs(jsonStr.c_str());
+}
+
+void JsonUiManager::rememberSent(int id, FLArduinoJson::JsonObjectConst json) {
+    SentFields fields;
+    hashFields(json, &fields);
+    fl::lock_guard<fl::mutex> lock(mMutex);
+    if (SentFields *sent = mSentState.find_value(id)) {
+        sent->swap(fields);
+        return;
+    }
+    mSentState.insert(id, fields);
 }
 
 fl::vector<JsonUiInternalPtr> JsonUiManager::getComponents() {
@@ -128,27 +230,48 @@ fl::vector<JsonUiInternalPtr> JsonUiManager::getComponents() {
     return out;
 }
 
-JsonUiInternalPtr JsonUiManager::findUiComponent(const char* id_or_name) {
-    auto components = getComponents();
-    
-    for (auto &component : components) {
-        int id = component->id();
-        string componentIdStr;
-        componentIdStr.append(id);
-        
-        if (fl::string::strcmp(componentIdStr.c_str(), id_or_name) == 0) {
-            //FL_WARN("*** Found component with ID " << id);
-            return component;
+void JsonUiManager::rebuildIndex() {
+    mIdIndex.clear();
+    mNameIndex.clear();
+    for (auto &componentRef : mComponents) {
+        if (auto component = componentRef.lock()) {
+            mIdIndex.insert(component->id(), componentRef);
+            // The first component with a given name wins, as before.
+            if (!mNameIndex.find_value(component->name())) {
+                mNameIndex.insert(component->name(), componentRef);
+            }
         }
     }
+    mIndexDirty = false;
+}
 
-    // If we didn't find it by id, try to find it by name
-    for (auto &component : components) {
-        if (fl::string::strcmp(component->name().c_str(), id_or_name) == 0) {
-            return component;
+JsonUiInternalPtr JsonUiManager::findUiComponent(const char* id_or_name) {
+    if (!id_or_name) {
+        return JsonUiInternalPtr();
+    }
+    fl::lock_guard<fl::mutex> lock(mMutex);
+    if (mIndexDirty) {
+        rebuildIndex();
+    }
+
+    // Ids are sent as decimal strings, anything else is taken as a name.
+    int id = 0;
+    int digits = 0;
+    for (const char *c = id_or_name; *c >= '0' && *c <= '9' && digits < 9;
+         ++c, ++digits) {
+        id = id * 10 + (*c - '0');
+    }
+    if (digits > 0 && id_or_name[digits] == '\0') {
+        if (const auto *ref = mIdIndex.find_value(id)) {
+            if (auto component = ref->lock()) {
+                return component;
+            }
         }
     }
-    
+
+    if (const auto *ref = mNameIndex.find_value(fl::string(id_or_name))) {
+        return ref->lock();
+    }
     return JsonUiInternalPtr(); // Return null pointer if not found
 }
 
@@ -193,6 +316,12 @@ void JsonUiManager::executeUiUpdates(const FLArduinoJson::JsonDocument &doc) {
             if (component) {
                 const FLArduinoJson::JsonVariantConst v = kv.value();
                 component->update(v);
+                // The frontend already shows this value, so it is the new
+                // base for deltas.
+                FLArduinoJson::JsonDocument current;
+                auto json = current.to<FLArduinoJson::JsonObject>();
+                component->toJson(json);
+                rememberSent(component->id(), json);
                 //FL_WARN("*** Updated component with ID " << idStr);
             } else {
                 FL_WARN("*** ERROR: could not find component with ID or name: " << id_or_name);
@@ -212,6 +341,7 @@ void JsonUiManager::toJson(FLArduinoJson::JsonArray &json) {
     for (auto &component : components) {
         auto obj = json.add<FLArduinoJson::JsonObject>();
         component->toJson(obj);
+        rememberSent(component->id(), obj);
     }
 }
 
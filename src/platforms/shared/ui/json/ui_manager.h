@@ -2,9 +2,11 @@
 
 #include "fl/singleton.h"
 
+#include "fl/hash_map.h"
 #include "fl/map.h"
 #include "fl/ptr.h"
 #include "fl/set.h"
+#include "fl/vector.h"
 #include "fl/engine_events.h"
 
 #include "fl/json.h"
@@ -35,10 +37,15 @@ class JsonUiManager : fl::EngineEvents::Listener {
 
     JsonUiInternalPtr findUiComponent(const char* id_or_name);
 
+    // Number of components with remembered sent state, for tests.
+    fl::size sentStateSize();
+
 
   private:
     
     typedef fl::VectorSet<fl::WeakPtr<JsonUiInternal>> JsonUIRefSet;
+    typedef fl::HashMap<int, fl::WeakPtr<JsonUiInternal>> JsonUIIdIndex;
+    typedef fl::HashMap<fl::string, fl::WeakPtr<JsonUiInternal>> JsonUINameIndex;
 
     void onEndFrame() override;
 
@@ -46,10 +53,37 @@ class JsonUiManager : fl::EngineEvents::Listener {
     void toJson(FLArduinoJson::JsonArray &json);
     JsonUiInternalPtr findUiComponent(const fl::string& idStr);
 
+    // Sends only the fields that differ from what the frontend last saw,
+    // as {"<id>": {"<field>": value}}, for the components in changed.
+    void sendChanges(const fl::vector<JsonUiInternalPtr> &changed);
+    // Hash of one field as last sent, compared instead of the json itself.
+    struct SentField {
+        fl::u32 key;
+        fl::u32 value;
+    };
+    typedef fl::vector<SentField> SentFields;
+    static void hashFields(FLArduinoJson::JsonObjectConst json,
+                           SentFields *out);
+    // Takes mMutex, like every access to mSentState.
+    void rememberSent(int id, FLArduinoJson::JsonObjectConst json);
+    // Needs mMutex held.
+    void rebuildIndex();
+
     Callback mUpdateJs;
     JsonUIRefSet mComponents;
     fl::mutex mMutex;
 
+    // Lookup for inbound updates, rebuilt after components come and go.
+    JsonUIIdIndex mIdIndex;
+    JsonUINameIndex mNameIndex;
+    bool mIndexDirty = true;
+
+    // Last state sent to the frontend for each component id.
+    fl::HashMap<int, SentFields> mSentState;
+    // Id of each registered component, so it can be dropped from mSentState
+    // even after the component is gone.
+    fl::HashMap<fl::uptr, int> mComponentIds;
+
     bool mItemsAdded = false;
     FLArduinoJson::JsonDocument mPendingJsonUpdate;
     bool mHasPendingUpdate = false;
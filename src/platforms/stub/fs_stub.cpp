@@ -0,0 +1,7 @@
+#include "fl/compiler_control.h"
+
+#ifdef FASTLED_ALL_SRC
+// No implementation when building all-source
+#else
+#include "fs_stub.cpp.hpp"
+#endif
@@ -0,0 +1,131 @@
+#include "platforms/stub/fs_stub.h"
+
+#if FASTLED_STUB_MMAP_FS
+
+#include <fcntl.h>    // ok include
+#include <string.h>   // ok include
+#include <sys/mman.h> // ok include
+#include <sys/stat.h> // ok include
+#include <unistd.h>   // ok include
+
+#include "fl/namespace.h"
+#include "fl/str.h"
+#include "fl/unused.h"
+#include "fl/warn.h"
+
+namespace fl {
+
+FASTLED_SMART_PTR(MmapFileHandle);
+FASTLED_SMART_PTR(FsStub);
+
+// Read only view of a memory mapped file. Reads are memcpy's out of the
+// mapping and seeks are pointer arithmetic.
+class MmapFileHandle : public FileHandle {
+  public:
+    MmapFileHandle(const char *path, const fl::u8 *data, fl::size size)
+        : mPath(path), mData(data), mSize(size) {}
+    ~MmapFileHandle() override { close(); }
+
+    bool available() const override { return mPos < mSize; }
+    fl::size bytesLeft() const override {
+        return mPos < mSize ? mSize - mPos : 0;
+    }
+    fl::size size() const override { return mSize; }
+    fl::size read(fl::u8 *dst, fl::size bytesToRead) override {
+        fl::size n = bytesLeft();
+        if (bytesToRead < n) {
+            n = bytesToRead;
+        }
+        if (n) {
+            memcpy(dst, mData + mPos, n);
+            mPos += n;
+        }
+        return n;
+    }
+    fl::size pos() const override { return mPos; }
+    const char *path() const override { return mPath.c_str(); }
+    bool seek(fl::size pos) override {
+        mPos = pos;
+        return pos <= mSize;
+    }
+    void close() override {
+        if (mData) {
+            munmap(const_cast<fl::u8 *>(mData), mSize);
+        }
+        mData = nullptr;
+        mSize = 0;
+        mPos = 0;
+    }
+    bool valid() const override { return mData != nullptr || mSize == 0; }
+    fl::span<const fl::u8> mapping() const override {
+        return fl::span<const fl::u8>(mData, mSize);
+    }
+
+  private:
+    fl::string mPath;
+    const fl::u8 *mData;
+    fl::size mSize;
+    fl::size mPos = 0;
+};
+
+class FsStub : public FsImpl {
+  public:
+    explicit FsStub(const char *root) : mRoot(root ? root : "") {}
+    ~FsStub() override {}
+
+    bool begin() override { return true; }
+    void end() override {}
+    void close(FileHandlePtr file) override {
+        if (file) {
+            file->close();
+        }
+    }
+
+    FileHandlePtr openRead(const char *path) override {
+        fl::string fullPath = mRoot;
+        if (!fullPath.empty() && path[0] != '/') {
+            fullPath.append("/");
+        }
+        fullPath.append(path);
+        int fd = ::open(fullPath.c_str(), O_RDONLY);
+        if (fd < 0) {
+            FASTLED_WARN("FsStub: could not open " << fullPath.c_str());
+            return FileHandlePtr();
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            ::close(fd);
+            FASTLED_WARN("FsStub: not a regular file " << fullPath.c_str());
+            return FileHandlePtr();
+        }
+        const fl::size size = static_cast<fl::size>(st.st_size);
+        const fl::u8 *data = nullptr;
+        if (size) {
+            void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                FASTLED_WARN("FsStub: mmap failed for " << fullPath.c_str());
+                return FileHandlePtr();
+            }
+            data = static_cast<const fl::u8 *>(mapped);
+        }
+        ::close(fd); // The mapping stays valid without the descriptor.
+        return MmapFileHandlePtr::New(fullPath.c_str(), data, size);
+    }
+
+  private:
+    fl::string mRoot;
+};
+
+FsImplPtr make_mmap_filesystem(const char *root) {
+    return FsStubPtr::New(root);
+}
+
+FsImplPtr make_sdcard_filesystem(int cs_pin) {
+    FASTLED_UNUSED(cs_pin);
+    return make_mmap_filesystem("");
+}
+
+} // namespace fl
+
+#endif // FASTLED_STUB_MMAP_FS
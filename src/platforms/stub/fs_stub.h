@@ -0,0 +1,29 @@
+#pragma once
+
+#include "fl/has_define.h"
+#include "fl/file_system.h"
+
+// Host file system for the stub platform (linux/mac controllers and tests).
+// Files are memory mapped, so FileHandle::mapping() exposes their contents
+// and readers like PixelStream can use frames in place instead of copying.
+#ifndef FASTLED_STUB_MMAP_FS
+#if defined(FASTLED_STUB_IMPL) && !defined(__EMSCRIPTEN__) &&                 \
+    __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#define FASTLED_STUB_MMAP_FS 1
+#else
+#define FASTLED_STUB_MMAP_FS 0
+#endif
+#endif
+
+#if FASTLED_STUB_MMAP_FS
+
+namespace fl {
+
+// Paths passed to openRead() are resolved relative to root, which defaults to
+// the working directory. This is also what make_sdcard_filesystem() returns
+// on the stub platform, the cs pin is ignored.
+FsImplPtr make_mmap_filesystem(const char *root = "");
+
+} // namespace fl
+
+#endif // FASTLED_STUB_MMAP_FS
@@ -80,6 +80,17 @@ Str ActiveStripData::infoJsonString() {
     return jsonBuffer;
 }
 
+const fl::vector<uint32_t> &ActiveStripData::frameTable() {
+    mFrameTable.clear();
+    for (const auto &[stripIndex, stripData] : mStripMap) {
+        mFrameTable.push_back(static_cast<uint32_t>(stripIndex));
+        mFrameTable.push_back(static_cast<uint32_t>(
+            reinterpret_cast<uintptr_t>(stripData.data())));
+        mFrameTable.push_back(static_cast<uint32_t>(stripData.size()));
+    }
+    return mFrameTable;
+}
+
 /// WARNING: For some reason the following code must be here, when
 /// it was moved to embind.cpp frame data stopped being updated.
 // gcc constructor to get the
@@ -8,6 +8,7 @@
 #include "fl/screenmap.h"
 #include "fl/singleton.h"
 #include "fl/span.h"
+#include "fl/vector.h"
 #include "strip_id_map.h"
 
 
@@ -27,6 +28,11 @@ class ActiveStripData : public fl::EngineEvents::Listener {
 
     fl::string infoJsonString();
 
+    // Strips updated this frame as packed (strip_id, pixel pointer, byte
+    // count) triples, so JS can view the pixels in the wasm heap directly
+    // without a JSON round trip.
+    const fl::vector<uint32_t> &frameTable();
+
     const StripDataMap &getData() const { return mStripMap; }
 
     ~ActiveStripData() { fl::EngineEvents::removeListener(this); }
@@ -50,6 +56,7 @@ class ActiveStripData : public fl::EngineEvents::Listener {
 
     StripDataMap mStripMap;
     ScreenMapMap mScreenMap;
+    fl::vector<uint32_t> mFrameTable;
 };
 
 } // namespace fl
@@ -526,11 +526,16 @@ function FastLED_onFrame(frameData, uiUpdateCallback) {
 
 /**
  * Handles UI element addition events from FastLED
- * @param {Object} jsonData - UI element configuration data
+ * @param {Array<Object>|Object} jsonData - Full list of UI elements, or an
+ *   object of changed fields keyed by element id
  */
 function FastLED_onUiElementsAdded(jsonData) {
   // uses global variables.
-  uiManager.addUiElements(jsonData);
+  if (Array.isArray(jsonData)) {
+    uiManager.addUiElements(jsonData);
+  } else {
+    uiManager.updateUiComponents(jsonData);
+  }
 }
 
 /**
@@ -845,13 +845,14 @@ export class JsonUiManager {
   /**
    * Updates UI components from backend data (called by C++ backend)
    * Processes JSON updates and synchronizes UI element states
-   * @param {string} jsonString - JSON string containing UI element updates
+   * @param {string|Object} jsonString - JSON string or parsed object keyed by
+   *   element id, holding either the new value or the changed fields
    */
   updateUiComponents(jsonString) {
     // console.log('*** C++→JS: Backend update received:', jsonString);
 
     try {
-      const updates = JSON.parse(jsonString);
+      const updates = typeof jsonString === 'string' ? JSON.parse(jsonString) : jsonString;
 
       // Process each update
       for (const [elementId, updateData] of Object.entries(updates)) {
@@ -861,7 +862,12 @@ export class JsonUiManager {
         const element = this.uiElements[actualElementId];
         if (element) {
           // Extract value from update data
-          const value = updateData.value !== undefined ? updateData.value : updateData;
+          const isFields = updateData !== null && typeof updateData === 'object';
+          if (isFields && updateData.value === undefined) {
+            // Only non-value fields changed.
+            continue;
+          }
+          const value = isFields ? updateData.value : updateData;
 
           // Update the element based on its type
           if (element.type === 'checkbox') {
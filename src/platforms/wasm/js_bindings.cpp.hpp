@@ -45,9 +45,11 @@
 #include "fl/math.h"
 #include "fl/screenmap.h"
 #include "fl/json.h"
+#include "fl/vector.h"
 
 namespace fl {
 
+#if FASTLED_WASM_JSON_TRANSPORT
 static void jsSetCanvasSizeJson(const char* jsonString, size_t jsonSize) {
     // FASTLED_DBG("jsSetCanvasSize1");
     EM_ASM_({
@@ -59,7 +61,9 @@ static void jsSetCanvasSizeJson(const char* jsonString, size_t jsonSize) {
         globalThis.FastLED_onStripUpdate(jsonData);
     }, jsonString, jsonSize);
 }
+#endif
 
+#if FASTLED_WASM_JSON_TRANSPORT
 static void _jsSetCanvasSize(int cledcontoller_id, const fl::ScreenMap &screenmap) {
     // FASTLED_DBG("Begin jsSetCanvasSize json serialization");
     FLArduinoJson::JsonDocument doc;
@@ -84,6 +88,42 @@ static void _jsSetCanvasSize(int cledcontoller_id, const fl::ScreenMap &screenma
     // FASTLED_DBG("End jsSetCanvasSize json serialization");
     jsSetCanvasSizeJson(jsonBuffer.c_str(), jsonBuffer.size());
 }
+#else
+// Binary screen map: the x coordinates followed by the y coordinates as
+// float32, which JS copies out of the heap with two slice() calls. The
+// event object handed to FastLED_onStripUpdate() has the same shape as the
+// JSON one, with Float32Array in place of the coordinate arrays.
+static void _jsSetCanvasSize(int cledcontoller_id, const fl::ScreenMap &screenmap) {
+    const uint32_t length = screenmap.getLength();
+    fl::vector<float> planar;
+    planar.resize(length * 2);
+    for (uint32_t i = 0; i < length; i++) {
+        const vec2f &p = screenmap[i];
+        planar[i] = p.x;
+        planar[length + i] = p.y;
+    }
+    EM_ASM_({
+        globalThis.FastLED_onStripUpdate = globalThis.FastLED_onStripUpdate || function(jsonStr) {
+            console.log("Missing globalThis.FastLED_onStripUpdate(jsonStr) function");
+        };
+        var length = $2;
+        var start = $1 >> 2;
+        var data = {
+            strip_id: $0,
+            event: "set_canvas_map",
+            length: length,
+            map: {
+                x: HEAPF32.slice(start, start + length),
+                y: HEAPF32.slice(start + length, start + 2 * length)
+            }
+        };
+        if ($3 > 0) {
+            data.diameter = $3;
+        }
+        globalThis.FastLED_onStripUpdate(data);
+    }, cledcontoller_id, planar.data(), length, screenmap.getDiameter());
+}
+#endif
 
 
 void jsSetCanvasSize(int cledcontoller_id, const fl::ScreenMap &screenmap) {
@@ -143,11 +183,8 @@ EMSCRIPTEN_KEEPALIVE void jsFillInMissingScreenMaps(ActiveStripData &active_stri
 
 
 
-EMSCRIPTEN_KEEPALIVE void jsOnFrame(ActiveStripData& active_strips) {
-    jsFillInMissingScreenMaps(active_strips);
-    Str json_str = active_strips.infoJsonString();
-    EM_ASM_({
-
+static void jsInstallFrameCallbacks() {
+    EM_ASM({
         globalThis.FastLED_sendMessage = globalThis.FastLED_sendMessage || function(msg_tag, json_data_str) {
             console.log("Missing globalThis.FastLED_sendMessage() function");
             console.log("Message was mean for tag: " + msg_tag);
@@ -174,7 +211,15 @@ EMSCRIPTEN_KEEPALIVE void jsOnFrame(ActiveStripData& active_strips) {
                     console.error("*** JS→C++: Invalid jsonData received:", jsonString, "expected string but instead got:", typeof jsonString);
                 }
             };
+    });
+}
 
+EMSCRIPTEN_KEEPALIVE void jsOnFrame(ActiveStripData& active_strips) {
+    jsFillInMissingScreenMaps(active_strips);
+    jsInstallFrameCallbacks();
+#if FASTLED_WASM_JSON_TRANSPORT
+    Str json_str = active_strips.infoJsonString();
+    EM_ASM_({
        // ActiveStripData is now accessed via ccall mechanism only
             var jsonStr = UTF8ToString($0);
             var jsonData = JSON.parse(jsonStr);
@@ -195,6 +240,27 @@ EMSCRIPTEN_KEEPALIVE void jsOnFrame(ActiveStripData& active_strips) {
 
         globalThis.FastLED_onFrame(jsonData, globalThis.onFastLedUiUpdateFunction);
     }, json_str.c_str());
+#else
+    // Frame table of (strip_id, pixel pointer, byte count) triples, the
+    // pixels are handed to JS as views into the wasm heap.
+    const fl::vector<uint32_t> &table = active_strips.frameTable();
+    EM_ASM_({
+        var start = $0 >> 2;
+        var count = $1 / 3;
+        var frameData = new Array(count);
+        for (var i = 0; i < count; i++) {
+            var entry = start + i * 3;
+            var dataPtr = HEAPU32[entry + 1];
+            var size = HEAPU32[entry + 2];
+            frameData[i] = {
+                strip_id: HEAPU32[entry],
+                type: "r8g8b8",
+                pixel_data: dataPtr !== 0 ? HEAPU8.subarray(dataPtr, dataPtr + size) : null
+            };
+        }
+        globalThis.FastLED_onFrame(frameData, globalThis.onFastLedUiUpdateFunction);
+    }, table.data(), table.size());
+#endif
 }
 
 EMSCRIPTEN_KEEPALIVE void jsOnStripAdded(uintptr_t strip, uint32_t num_leds) {
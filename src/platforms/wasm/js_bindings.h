@@ -31,6 +31,12 @@
 
 #include "fl/stdint.h"
 
+// Strip pixels and screen maps go to JS as views into the wasm heap. Set to 1
+// to fall back to the JSON documents, e.g. when debugging the frontend.
+#ifndef FASTLED_WASM_JSON_TRANSPORT
+#define FASTLED_WASM_JSON_TRANSPORT 0
+#endif
+
 namespace fl {
 
 class ScreenMap;
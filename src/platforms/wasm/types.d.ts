@@ -11,8 +11,8 @@ export interface StripData {
   id: number;
   leds: number[];
   map?: {
-    x: number[];
-    y: number[];
+    x: number[] | Float32Array;
+    y: number[] | Float32Array;
   };
   min?: number[];
   max?: number[];
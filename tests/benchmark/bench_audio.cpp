@@ -0,0 +1,56 @@
+// Benchmarks for the audio analysis path. The block size is width * height
+// samples, so ns/pixel reads as ns/sample.
+
+#include <math.h>
+
+#include <memory>
+
+#include "fl/audio.h"
+#include "fl/audio_reactive.h"
+
+#include "benchmark.h"
+
+namespace {
+
+fl::AudioSample makeBlock(int samples) {
+    fl::vector<fl::i16> pcm;
+    for (int i = 0; i < samples; ++i) {
+        const float phase = 2.0f * 3.14159265f * 440.0f * i / 44100.0f;
+        pcm.push_back(fl::i16(8000.0f * sinf(phase) +
+                              2000.0f * sinf(phase * 7.3f)));
+    }
+    fl::AudioSampleImplPtr impl = fl::AudioSampleImplPtr::New();
+    impl->assign(pcm.begin(), pcm.end(), 0);
+    return fl::AudioSample(impl);
+}
+
+} // namespace
+
+FL_BENCHMARK(AudioReactive_float) {
+    auto audio = std::make_shared<fl::AudioReactive>();
+    audio->begin();
+    fl::AudioSample block = makeBlock(width * height);
+    return [=]() {
+        audio->processSample(block);
+        bench::doNotOptimize(&audio->getData());
+    };
+}
+
+FL_BENCHMARK(AudioReactive_fixed) {
+    auto audio = std::make_shared<fl::AudioReactiveFixed>();
+    audio->begin();
+    fl::AudioSample block = makeBlock(width * height);
+    return [=]() {
+        audio->processSample(block);
+        bench::doNotOptimize(&audio->getData());
+    };
+}
+
+FL_BENCHMARK(SoundLevelMeter) {
+    auto meter = std::make_shared<fl::SoundLevelMeter>();
+    fl::AudioSample block = makeBlock(width * height);
+    return [=]() {
+        meter->processBlock(block.pcm().data(), block.size());
+        bench::doNotOptimize(meter.get());
+    };
+}
@@ -0,0 +1,154 @@
+// Benchmarks for the heavier 2D effects.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FastLED.h"
+#include "fl/corkscrew.h"
+#include "fl/grid.h"
+#include "fl/leds.h"
+#include "fl/resampler.h"
+#include "fl/screenmap.h"
+#include "fl/wave_simulation.h"
+#include "fl/xypath.h"
+#include "fl/xymap.h"
+#include "fx/2d/animartrix.hpp"
+
+#include "benchmark.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+namespace {
+
+bench::Frame animartrix(int width, int height, fl::AnimartrixAnim anim,
+                        bool fixedPoint) {
+    fl::XYMap xymap = fl::XYMap::constructRectangularGrid(width, height);
+    auto fx = std::make_shared<fl::Animartrix>(xymap, anim);
+    fx->setFixedPoint(fixedPoint);
+    auto leds = std::make_shared<std::vector<CRGB>>(width * height);
+    auto now = std::make_shared<fl::u32>(0);
+    return [=]() {
+        *now += 16;
+        fx->draw(fl::Fx::DrawContext(*now, leds->data()));
+        bench::doNotOptimize(leds->data());
+    };
+}
+
+} // namespace
+
+FL_BENCHMARK(WaveSimulation2D_update) {
+    auto sim = std::make_shared<fl::WaveSimulation2D>(width, height);
+    auto frame = std::make_shared<int>(0);
+    return [=]() {
+        // Keep energy in the grid so the update never settles to zeros.
+        if ((*frame)++ % 8 == 0) {
+            sim->setf(width / 2, height / 2, 1.0f);
+        }
+        sim->update();
+        bench::doNotOptimize(sim.get());
+    };
+}
+
+FL_BENCHMARK(WaveSimulation2D_update_2x) {
+    auto sim = std::make_shared<fl::WaveSimulation2D>(
+        width, height, fl::SuperSample::SUPER_SAMPLE_2X);
+    auto frame = std::make_shared<int>(0);
+    return [=]() {
+        if ((*frame)++ % 8 == 0) {
+            sim->setf(width / 2, height / 2, 1.0f);
+        }
+        sim->update();
+        bench::doNotOptimize(sim.get());
+    };
+}
+
+FL_BENCHMARK(WaveSimulation2D_update_4x_parallel) {
+    auto sim = std::make_shared<fl::WaveSimulation2D>(
+        width, height, fl::SuperSample::SUPER_SAMPLE_4X);
+    sim->setParallel(true);
+    auto frame = std::make_shared<int>(0);
+    return [=]() {
+        if ((*frame)++ % 8 == 0) {
+            sim->setf(width / 2, height / 2, 1.0f);
+        }
+        sim->update();
+        bench::doNotOptimize(sim.get());
+    };
+}
+
+FL_BENCHMARK(XYPath_drawColor) {
+    auto path = fl::XYPath::NewHeartPath(width, height);
+    auto leds = std::make_shared<std::vector<CRGB>>(width * height);
+    auto target = std::make_shared<fl::Leds>(leds->data(), width, height);
+    return [=]() {
+        path->drawColor(CRGB::Red, 0.0f, 1.0f, target.get(), 2000);
+        bench::doNotOptimize(leds->data());
+    };
+}
+
+FL_BENCHMARK(XYPath_drawColor_lut) {
+    auto path = fl::XYPath::NewHeartPath(width, height);
+    path->setLutSize(1024);
+    auto leds = std::make_shared<std::vector<CRGB>>(width * height);
+    auto target = std::make_shared<fl::Leds>(leds->data(), width, height);
+    return [=]() {
+        path->drawColor(CRGB::Red, 0.0f, 1.0f, target.get(), 2000);
+        bench::doNotOptimize(leds->data());
+    };
+}
+
+// One LED per canvas pixel on a helix wrapped around the canvas.
+FL_BENCHMARK(Corkscrew_readFrom) {
+    auto corkscrew = std::make_shared<fl::Corkscrew>(
+        fl::Corkscrew::Input(float(height), fl::u16(width * height)));
+    auto grid = std::make_shared<fl::Grid<CRGB>>(corkscrew->cylinder_width(),
+                                                 corkscrew->cylinder_height());
+    for (fl::u32 i = 0; i < grid->size(); ++i) {
+        grid->data()[i] = CRGB(fl::u8(i), fl::u8(i >> 3), fl::u8(i * 7));
+    }
+    return [=]() {
+        corkscrew->readFrom(*grid);
+        bench::doNotOptimize(corkscrew->data());
+    };
+}
+
+// A ring of width * height LEDs sampled from the canvas.
+FL_BENCHMARK(CanvasResampler_ring) {
+    auto resampler = std::make_shared<fl::CanvasResampler>(
+        fl::CanvasResampler::fit(fl::ScreenMap::Circle(width * height), width,
+                                 height));
+    auto canvas = std::make_shared<std::vector<CRGB>>(width * height);
+    auto leds = std::make_shared<std::vector<CRGB>>(width * height);
+    return [=]() {
+        resampler->apply(canvas->data(), leds->data());
+        bench::doNotOptimize(leds->data());
+    };
+}
+
+namespace {
+
+// Every animation, Animartrix_RGB_BLOBS5, ..., and the fixed point engine
+// for the ones that have it, Animartrix_fixed_RGB_BLOBS5, ...
+struct AnimartrixBenchmarks {
+    AnimartrixBenchmarks() {
+        for (int i = 0; i < fl::NUM_ANIMATIONS; ++i) {
+            const fl::AnimartrixAnim anim = fl::AnimartrixAnim(i);
+            const std::string name = fl::getAnimartrixName(i).c_str();
+            bench::Registrar(std::string("Animartrix_") + name,
+                             [anim](int width, int height) {
+                                 return animartrix(width, height, anim, false);
+                             });
+            if (fl::Animartrix::hasFixedPoint(anim)) {
+                bench::Registrar(std::string("Animartrix_fixed_") + name,
+                                 [anim](int width, int height) {
+                                     return animartrix(width, height, anim,
+                                                       true);
+                                 });
+            }
+        }
+    }
+} animartrixBenchmarks;
+
+} // namespace
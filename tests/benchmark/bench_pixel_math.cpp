@@ -0,0 +1,225 @@
+// Benchmarks for the per pixel math used by most sketches.
+
+#include <memory>
+#include <vector>
+
+#include "FastLED.h"
+#include "fl/blur.h"
+#include "fl/downscale.h"
+#include "fl/upscale.h"
+#include "fl/xymap.h"
+#include "noise.h"
+#include "pixel_controller.h"
+
+#include "benchmark.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+namespace {
+
+struct Matrix {
+    Matrix(int width, int height)
+        : xymap(fl::XYMap::constructRectangularGrid(width, height)),
+          leds(width * height) {
+        for (size_t i = 0; i < leds.size(); ++i) {
+            leds[i] = CRGB(fl::u8(i * 7), fl::u8(i * 13), fl::u8(i * 29));
+        }
+    }
+    fl::XYMap xymap;
+    std::vector<CRGB> leds;
+};
+
+} // namespace
+
+FL_BENCHMARK(blur2d) {
+    auto m = std::make_shared<Matrix>(width, height);
+    return [=]() {
+        blur2d(m->leds.data(), fl::u8(width), fl::u8(height), 64, m->xymap);
+        bench::doNotOptimize(m->leds.data());
+    };
+}
+
+// A wide glow the old way: many 3-tap passes.
+FL_BENCHMARK(blur2d_8_passes) {
+    auto m = std::make_shared<Matrix>(width, height);
+    return [=]() {
+        for (int i = 0; i < 8; ++i) {
+            blur2d(m->leds.data(), fl::u8(width), fl::u8(height), 172,
+                   m->xymap);
+        }
+        bench::doNotOptimize(m->leds.data());
+    };
+}
+
+FL_BENCHMARK(boxBlur2d_r8) {
+    auto m = std::make_shared<Matrix>(width, height);
+    auto blur = std::make_shared<fl::BoxBlur2d>(8);
+    return [=]() {
+        blur->apply(m->leds.data(), m->xymap);
+        bench::doNotOptimize(m->leds.data());
+    };
+}
+
+FL_BENCHMARK(fill_2dnoise16) {
+    auto m = std::make_shared<Matrix>(width, height);
+    auto t = std::make_shared<fl::u32>(0);
+    return [=]() {
+        *t += 16;
+        fill_2dnoise16(m->leds.data(), width, height, false, 4, 0, 2000, 0,
+                       2000, *t, 2, 0, 400, 0, 400, fl::u16(*t), false);
+        bench::doNotOptimize(m->leds.data());
+    };
+}
+
+FL_BENCHMARK(hsv2rgb_rainbow) {
+    auto m = std::make_shared<Matrix>(width, height);
+    auto hsv = std::make_shared<std::vector<CHSV>>(m->leds.size());
+    for (size_t i = 0; i < hsv->size(); ++i) {
+        (*hsv)[i] = CHSV(fl::u8(i), fl::u8(255 - i / 3), fl::u8(128 + i));
+    }
+    return [=]() {
+        hsv2rgb_rainbow(hsv->data(), m->leds.data(), int(hsv->size()));
+        bench::doNotOptimize(m->leds.data());
+    };
+}
+
+FL_BENCHMARK(ColorFromPalette) {
+    auto m = std::make_shared<Matrix>(width, height);
+    auto palette = std::make_shared<CRGBPalette16>(RainbowColors_p);
+    auto offset = std::make_shared<fl::u8>(0);
+    return [=]() {
+        const fl::u8 base = (*offset)++;
+        for (size_t i = 0; i < m->leds.size(); ++i) {
+            m->leds[i] = ColorFromPalette(*palette, fl::u8(base + i),
+                                          fl::u8(255 - (i & 63)), LINEARBLEND);
+        }
+        bench::doNotOptimize(m->leds.data());
+    };
+}
+
+FL_BENCHMARK(ColorFromPalette_array) {
+    auto m = std::make_shared<Matrix>(width, height);
+    auto palette = std::make_shared<CRGBPalette16>(RainbowColors_p);
+    auto data = std::make_shared<std::vector<fl::u8>>(m->leds.size());
+    for (size_t i = 0; i < data->size(); ++i) {
+        (*data)[i] = fl::u8(i * 7);
+    }
+    return [=]() {
+        map_data_into_colors_through_palette(data->data(),
+                                             fl::u16(data->size()),
+                                             m->leds.data(), *palette, 200);
+        bench::doNotOptimize(m->leds.data());
+    };
+}
+
+FL_BENCHMARK(fill_palette) {
+    auto m = std::make_shared<Matrix>(width, height);
+    auto palette = std::make_shared<CRGBPalette16>(RainbowColors_p);
+    auto offset = std::make_shared<fl::u8>(0);
+    return [=]() {
+        fill_palette(m->leds.data(), fl::u16(m->leds.size()), (*offset)++, 3,
+                     *palette, 255, LINEARBLEND);
+        bench::doNotOptimize(m->leds.data());
+    };
+}
+
+FL_BENCHMARK(upscale_2x) {
+    auto m = std::make_shared<Matrix>(width, height);
+    auto input = std::make_shared<Matrix>(width / 2, height / 2);
+    return [=]() {
+        fl::upscale(input->leds.data(), m->leds.data(), fl::u16(width / 2),
+                    fl::u16(height / 2), m->xymap);
+        bench::doNotOptimize(m->leds.data());
+    };
+}
+
+FL_BENCHMARK(upscale_2x_serpentine) {
+    auto m = std::make_shared<Matrix>(width, height);
+    auto input = std::make_shared<Matrix>(width / 2, height / 2);
+    auto xymap = std::make_shared<fl::XYMap>(
+        fl::XYMap::constructSerpentine(width, height));
+    return [=]() {
+        fl::upscale(input->leds.data(), m->leds.data(), fl::u16(width / 2),
+                    fl::u16(height / 2), *xymap);
+        bench::doNotOptimize(m->leds.data());
+    };
+}
+
+// Rendered at twice the size and scaled down for anti-aliasing, so
+// --sizes 64 is 128x128 -> 64x64.
+FL_BENCHMARK(downscale_half) {
+    auto m = std::make_shared<Matrix>(width, height);
+    auto input = std::make_shared<Matrix>(width * 2, height * 2);
+    return [=]() {
+        fl::downscale(input->leds.data(), input->xymap, m->leds.data(),
+                      m->xymap);
+        bench::doNotOptimize(m->leds.data());
+    };
+}
+
+FL_BENCHMARK(downscale_half_serpentine) {
+    auto m = std::make_shared<Matrix>(width, height);
+    auto input = std::make_shared<Matrix>(width * 2, height * 2);
+    auto xymap = std::make_shared<fl::XYMap>(
+        fl::XYMap::constructSerpentine(width, height));
+    return [=]() {
+        fl::downscale(input->leds.data(), input->xymap, m->leds.data(),
+                      *xymap);
+        bench::doNotOptimize(m->leds.data());
+    };
+}
+
+// 3:2, through downscaleArbitrary.
+FL_BENCHMARK(downscale_arbitrary) {
+    auto m = std::make_shared<Matrix>(width, height);
+    auto input = std::make_shared<Matrix>(width * 3 / 2, height * 3 / 2);
+    return [=]() {
+        fl::downscale(input->leds.data(), input->xymap, m->leds.data(),
+                      m->xymap);
+        bench::doNotOptimize(m->leds.data());
+    };
+}
+
+namespace {
+
+ColorAdjustment encodeAdjustment() {
+    ColorAdjustment adj;
+    adj.premixed = CRGB(200, 180, 160);
+#if FASTLED_HD_COLOR_MIXING
+    adj.color = CRGB(255, 255, 255);
+    adj.brightness = 255;
+#endif
+    return adj;
+}
+
+} // namespace
+
+FL_BENCHMARK(encode_per_pixel) {
+    auto m = std::make_shared<Matrix>(width, height);
+    auto out = std::make_shared<std::vector<fl::u8>>(m->leds.size() * 3);
+    return [=]() {
+        PixelController<GRB> pixels(m->leds.data(), int(m->leds.size()),
+                                    encodeAdjustment(), BINARY_DITHER);
+        PixelIterator it = pixels.as_iterator(RgbwInvalid());
+        fl::u8 *dst = out->data();
+        while (it.has(1)) {
+            it.loadAndScaleRGB(dst, dst + 1, dst + 2);
+            dst += 3;
+            it.advanceData();
+            it.stepDithering();
+        }
+        bench::doNotOptimize(out->data());
+    };
+}
+
+FL_BENCHMARK(encode_batch) {
+    auto m = std::make_shared<Matrix>(width, height);
+    auto out = std::make_shared<std::vector<fl::u8>>(m->leds.size() * 3);
+    return [=]() {
+        PixelController<GRB> pixels(m->leds.data(), int(m->leds.size()),
+                                    encodeAdjustment(), BINARY_DITHER);
+        pixels.loadAndScaleBatch(RgbwInvalid(), out->data());
+        bench::doNotOptimize(out->data());
+    };
+}
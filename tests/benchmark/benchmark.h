@@ -0,0 +1,46 @@
+#pragma once
+
+// Minimal benchmark harness for the host build, see benchmark_main.cpp for
+// the runner and tests/CMakeLists.txt for how the target is built.
+//
+// A benchmark is a factory that sets up its state for a width x height matrix
+// and returns the work for one frame. The runner times that frame at several
+// matrix sizes and reports ns/pixel and frames/sec:
+//
+//   FL_BENCHMARK(my_effect) {
+//       auto leds = std::make_shared<std::vector<CRGB>>(width * height);
+//       return [=]() { drawMyEffect(leds->data(), width, height); };
+//   }
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+typedef std::function<void()> Frame;
+typedef std::function<Frame(int width, int height)> Factory;
+
+struct Registration {
+    std::string name;
+    Factory factory;
+};
+
+std::vector<Registration> &registry();
+
+// Also usable directly, to register a family of benchmarks in a loop.
+struct Registrar {
+    Registrar(std::string name, Factory factory) {
+        registry().push_back(Registration{name, factory});
+    }
+};
+
+// Keeps the optimizer from discarding a result that is never read.
+void doNotOptimize(const void *p);
+
+} // namespace bench
+
+#define FL_BENCHMARK(NAME)                                                     \
+    static bench::Frame bench_##NAME(int width, int height);                   \
+    static bench::Registrar bench_registrar_##NAME(#NAME, &bench_##NAME);      \
+    static bench::Frame bench_##NAME(int width, int height)
@@ -0,0 +1,166 @@
+// Runs every FL_BENCHMARK at several matrix sizes and writes the results as
+// JSON, one entry per benchmark and size. Compare two runs with
+// ci/benchmark_compare.py.
+//
+// Usage: benchmark [--quick] [--filter SUBSTR] [--sizes 16,32,64]
+//                  [--min-time-ms N] [--json PATH]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+
+namespace bench {
+
+std::vector<Registration> &registry() {
+    static std::vector<Registration> sRegistry;
+    return sRegistry;
+}
+
+void doNotOptimize(const void *p) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(p) : "memory");
+#else
+    static const void *volatile sSink;
+    sSink = p;
+#endif
+}
+
+} // namespace bench
+
+namespace {
+
+struct Options {
+    bool quick = false;
+    std::string filter;
+    std::vector<int> sizes = {16, 32, 64, 128};
+    double minTimeMs = 250.0;
+    std::string jsonPath;
+};
+
+struct Result {
+    std::string name;
+    int width;
+    int height;
+    long frames;
+    double nsPerFrame;
+};
+
+std::vector<int> parseSizes(const char *arg) {
+    std::vector<int> sizes;
+    for (const char *p = arg; *p;) {
+        int v = std::atoi(p);
+        if (v > 0) {
+            sizes.push_back(v);
+        }
+        const char *comma = std::strchr(p, ',');
+        if (!comma) {
+            break;
+        }
+        p = comma + 1;
+    }
+    return sizes;
+}
+
+bool parseArgs(int argc, char **argv, Options *opts) {
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--quick") == 0) {
+            opts->quick = true;
+        } else if (std::strcmp(arg, "--filter") == 0 && hasValue) {
+            opts->filter = argv[++i];
+        } else if (std::strcmp(arg, "--sizes") == 0 && hasValue) {
+            opts->sizes = parseSizes(argv[++i]);
+        } else if (std::strcmp(arg, "--min-time-ms") == 0 && hasValue) {
+            opts->minTimeMs = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--json") == 0 && hasValue) {
+            opts->jsonPath = argv[++i];
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s [--quick] [--filter SUBSTR] "
+                         "[--sizes 16,32,64] [--min-time-ms N] [--json PATH]\n",
+                         argv[0]);
+            return false;
+        }
+    }
+    if (opts->quick) {
+        // Smoke test: every benchmark runs a couple of frames at one size.
+        opts->sizes = {16};
+        opts->minTimeMs = 0.0;
+    }
+    return !opts->sizes.empty();
+}
+
+Result run(const bench::Registration &reg, int size, const Options &opts) {
+    typedef std::chrono::steady_clock Clock;
+    bench::Frame frame = reg.factory(size, size);
+    frame(); // Warm up caches and lazily built tables.
+    long frames = 0;
+    const Clock::time_point start = Clock::now();
+    double elapsedNs = 0.0;
+    // At least a few frames, then keep going until the time budget is spent.
+    while (frames < 3 || elapsedNs < opts.minTimeMs * 1e6) {
+        frame();
+        ++frames;
+        elapsedNs =
+            std::chrono::duration<double, std::nano>(Clock::now() - start)
+                .count();
+    }
+    return Result{reg.name, size, size, frames, elapsedNs / double(frames)};
+}
+
+void writeJson(FILE *out, const std::vector<Result> &results) {
+    std::fprintf(out, "{\n  \"version\": 1,\n  \"benchmarks\": [");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result &r = results[i];
+        const double pixels = double(r.width) * r.height;
+        std::fprintf(out,
+                     "%s\n    {\"name\": \"%s\", \"width\": %d, \"height\": %d, "
+                     "\"frames\": %ld, \"ns_per_frame\": %.1f, "
+                     "\"ns_per_pixel\": %.3f, \"fps\": %.1f}",
+                     i ? "," : "", r.name.c_str(), r.width, r.height, r.frames,
+                     r.nsPerFrame, r.nsPerFrame / pixels, 1e9 / r.nsPerFrame);
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opts;
+    if (!parseArgs(argc, argv, &opts)) {
+        return 2;
+    }
+    std::vector<Result> results;
+    for (const bench::Registration &reg : bench::registry()) {
+        if (!opts.filter.empty() &&
+            reg.name.find(opts.filter) == std::string::npos) {
+            continue;
+        }
+        for (int size : opts.sizes) {
+            Result r = run(reg, size, opts);
+            std::fprintf(stderr, "%-28s %4dx%-4d %10.3f ns/pixel %10.1f fps\n",
+                         r.name.c_str(), r.width, r.height,
+                         r.nsPerFrame / (double(r.width) * r.height),
+                         1e9 / r.nsPerFrame);
+            results.push_back(r);
+        }
+    }
+    if (opts.jsonPath.empty()) {
+        writeJson(stdout, results);
+        return 0;
+    }
+    FILE *out = std::fopen(opts.jsonPath.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "could not write %s\n", opts.jsonPath.c_str());
+        return 1;
+    }
+    writeJson(out, results);
+    std::fclose(out);
+    return 0;
+}
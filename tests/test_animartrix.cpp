@@ -0,0 +1,101 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include <math.h>
+
+#include "FastLED.h"
+#include "fl/vector.h"
+#include "fx/2d/animartrix.hpp"
+
+using namespace fl;
+
+namespace {
+
+// Column by column, so no two pixels of a row are next to each other.
+u16 columnMajor(u16 x, u16 y, u16 width, u16 height) {
+    (void)width;
+    return x * height + y;
+}
+
+} // namespace
+
+TEST_CASE("Animartrix writes rows through spans like the per pixel path") {
+    // The serpentine map is written through row spans. The column major map
+    // has only single pixel runs and goes through xyMap() per pixel.
+    const u16 w = 20;
+    const u16 h = 12;
+    XYMap serpentine = XYMap::constructSerpentine(w, h);
+    XYMap columns = XYMap::constructWithUserFunction(w, h, columnMajor);
+    CHECK_EQ((*serpentine.spans().begin()).length, w);
+    CHECK_EQ((*columns.spans().begin()).length, 1);
+    Animartrix bySpans(serpentine, RGB_BLOBS5);
+    Animartrix byPixel(columns, RGB_BLOBS5);
+    fl::vector<CRGB> a(w * h);
+    fl::vector<CRGB> b(w * h);
+    bySpans.draw(Fx::DrawContext(1000, a.data()));
+    byPixel.draw(Fx::DrawContext(1000, b.data()));
+    int lit = 0;
+    for (u16 y = 0; y < h; ++y) {
+        for (u16 x = 0; x < w; ++x) {
+            REQUIRE_EQ(a[serpentine(x, y)], b[columns(x, y)]);
+            lit += a[serpentine(x, y)] ? 1 : 0;
+        }
+    }
+    CHECK(lit > 0);
+}
+
+TEST_CASE("Animartrix fixed point animations match the float ones") {
+    const int w = 32;
+    const int h = 32;
+    XYMap xymap = XYMap::constructRectangularGrid(w, h);
+    int ported = 0;
+    for (int i = 0; i < NUM_ANIMATIONS; ++i) {
+        const AnimartrixAnim anim = AnimartrixAnim(i);
+        Animartrix byFloat(xymap, anim);
+        Animartrix byFixed(xymap, anim);
+        byFloat.setFixedPoint(false);
+        byFixed.setFixedPoint(true);
+        fl::vector<CRGB> a(w * h);
+        fl::vector<CRGB> b(w * h);
+        long total = 0;
+        int far = 0;
+        int lit = 0;
+        for (fl::u32 now = 1000; now <= 61000; now += 20000) {
+            byFloat.draw(Fx::DrawContext(now, a.data()));
+            byFixed.draw(Fx::DrawContext(now, b.data()));
+            for (int k = 0; k < w * h; ++k) {
+                for (int c = 0; c < 3; ++c) {
+                    const int d = a[k].raw[c] - b[k].raw[c];
+                    total += d < 0 ? -d : d;
+                    far += (d > 8 || d < -8) ? 1 : 0;
+                    lit += b[k].raw[c] ? 1 : 0;
+                }
+            }
+        }
+        if (!Animartrix::hasFixedPoint(anim)) {
+            // Falls back to the float engine.
+            CHECK_EQ(total, 0);
+            continue;
+        }
+        ++ported;
+        INFO(getAnimartrixName(i));
+        // Within a fraction of a step on average, a few steps at most.
+        CHECK(lit > 0);
+        CHECK(total < 4 * 3 * w * h / 4);
+        CHECK_EQ(far, 0);
+    }
+    CHECK_EQ(ported, 8);
+}
+
+TEST_CASE("Animartrix fixed point square root") {
+    for (double d = 1; d < 2e9; d = d * 1.25 + 1) {
+        const fl::u32 v = fl::u32(d);
+        const double expected = sqrt(double(v) / 65536) * 65536;
+        const double actual =
+            animartrix_detail::ANIMartRIX::sqrt_q16(fl::i32(v));
+        REQUIRE(fabs(actual - expected) <= expected * 0.0006 + 1);
+    }
+    CHECK_EQ(animartrix_detail::ANIMartRIX::sqrt_q16(0), 0);
+    CHECK_EQ(animartrix_detail::ANIMartRIX::sqrt_q16(4 << 16), 2 << 16);
+}
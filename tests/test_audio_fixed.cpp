@@ -0,0 +1,112 @@
+#include "test.h"
+
+#include <math.h>
+
+#include "fl/audio.h"
+#include "fl/audio_fixed.h"
+#include "fl/audio_reactive.h"
+#include "fl/vector.h"
+
+using namespace fl;
+
+namespace {
+
+AudioSample makeSample(const fl::vector<fl::i16> &pcm, fl::u32 timestamp) {
+    AudioSampleImplPtr impl = AudioSampleImplPtr::New();
+    impl->assign(pcm.begin(), pcm.end(), timestamp);
+    return AudioSample(impl);
+}
+
+// Frame f: a tone whose pitch and level change every frame, with a loud
+// burst every 8th frame for the beat detector.
+fl::vector<fl::i16> testFrame(int f) {
+    fl::vector<fl::i16> pcm;
+    const float freq = 200.0f + 150.0f * (f % 20);
+    const float level = (f % 8 == 0) ? 24000.0f : 2000.0f + 300.0f * (f % 5);
+    for (int i = 0; i < 512; ++i) {
+        const float phase = 2.0f * float(M_PI) * freq * i / 44100.0f;
+        pcm.push_back(fl::i16(level * sinf(phase) +
+                              0.1f * level * sinf(phase * 3.7f)));
+    }
+    return pcm;
+}
+
+bool close(float fixed, float ref) {
+    const float diff = fabsf(fixed - ref);
+    return diff <= 1.0f + 0.03f * fabsf(ref);
+}
+
+} // namespace
+
+TEST_CASE("Integer sqrt and log2") {
+    for (fl::u32 x = 0; x < 70000; ++x) {
+        const fl::u32 r = isqrt32(x);
+        REQUIRE(r * r <= x);
+        REQUIRE((r + 1) * (r + 1) > x);
+    }
+    const fl::u32 big[] = {0xffffffffu, 0xfffe0001u, 0x80000000u, 123456789u};
+    for (fl::u32 x : big) {
+        const fl::u64 r = isqrt32(x);
+        CHECK(r * r <= x);
+        CHECK((r + 1) * (r + 1) > x);
+    }
+    const fl::u64 x64 = (fl::u64(1) << 40) + 12345;
+    const fl::u64 r64 = isqrt64(x64);
+    CHECK(r64 * r64 <= x64);
+    CHECK((r64 + 1) * (r64 + 1) > x64);
+
+    for (fl::u32 x = 1; x < 0x40000000u; x = x * 3 + 1) {
+        const double exact = log2(double(x)) * 65536.0;
+        CHECK(fabs(double(log2Q16(x)) - exact) <= 2.0);
+    }
+}
+
+TEST_CASE("Integer RMS and dBFS") {
+    fl::vector<fl::i16> pcm = testFrame(3);
+    double sumSq = 0;
+    for (fl::i16 s : pcm) {
+        sumSq += double(s) * s;
+    }
+    const double rms = sqrt(sumSq / pcm.size());
+    CHECK(fabs(double(rmsI16(pcm.data(), pcm.size())) - rms) < 1.0);
+    const double dbfs = 10.0 * log10(sumSq / pcm.size() / (32768.0 * 32768.0));
+    CHECK(fabs(dbfsQ16(pcm.data(), pcm.size()) / 65536.0 - dbfs) < 0.01);
+
+    fl::vector<fl::i16> silence(256, 0);
+    CHECK_EQ(dbfsQ16(silence.data(), silence.size()), -120 * 65536);
+}
+
+TEST_CASE("AudioReactiveFixed tracks the float pipeline") {
+    const fl::u8 modes[] = {1, 2, 3};
+    for (fl::u8 mode : modes) {
+        AudioConfig config;
+        config.scalingMode = mode;
+        AudioReactive reference;
+        AudioReactiveFixed fixed;
+        reference.begin(config);
+        fixed.begin(config);
+        int beats = 0;
+        for (int f = 0; f < 40; ++f) {
+            AudioSample sample = makeSample(testFrame(f), 1000 + f * 23);
+            reference.processSample(sample);
+            fixed.processSample(sample);
+            const AudioData &a = fixed.getData();
+            const AudioData &b = reference.getData();
+            CHECK(close(a.volume, b.volume));
+            CHECK(close(a.volumeRaw, b.volumeRaw));
+            CHECK(close(a.peak, b.peak));
+            CHECK(close(a.magnitude, b.magnitude));
+            CHECK_EQ(a.dominantFrequency, doctest::Approx(b.dominantFrequency));
+            CHECK_EQ(a.beatDetected, b.beatDetected);
+            CHECK_EQ(a.timestamp, b.timestamp);
+            for (int i = 0; i < 16; ++i) {
+                INFO("mode " << int(mode) << " frame " << f << " bin " << i);
+                CHECK(close(a.frequencyBins[i], b.frequencyBins[i]));
+                CHECK(close(fixed.getSmoothedData().frequencyBins[i],
+                            reference.getSmoothedData().frequencyBins[i]));
+            }
+            beats += a.beatDetected ? 1 : 0;
+        }
+        CHECK(beats > 0);
+    }
+}
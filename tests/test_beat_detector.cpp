@@ -0,0 +1,153 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include <math.h>
+
+#include "fl/audio.h"
+#include "fl/audio_reactive.h"
+#include "fl/beat_detector.h"
+#include "fl/vector.h"
+
+using namespace fl;
+
+namespace {
+
+const fl::u32 kFrameMs = 23;
+
+// Q24.8 bands for the frame at time t: a steady bass tone in bands 0-1 and
+// a kick in bands 0-3 for the first frame after every multiple of periodMs.
+void kickFrame(fl::u32 t, fl::u32 periodMs, fl::u32 *bands) {
+    for (int i = 0; i < 16; ++i) {
+        bands[i] = (i < 2 ? 800 : 20) << 8;
+    }
+    if (t % periodMs < kFrameMs) {
+        for (int i = 0; i < 4; ++i) {
+            bands[i] += 6000 << 8;
+        }
+    }
+}
+
+AudioSample makeSample(const fl::vector<fl::i16> &pcm, fl::u32 timestamp) {
+    AudioSampleImplPtr impl = AudioSampleImplPtr::New();
+    impl->assign(pcm.begin(), pcm.end(), timestamp);
+    return AudioSample(impl);
+}
+
+} // namespace
+
+TEST_CASE("BeatDetector ignores a steady tone") {
+    BeatDetector detector;
+    fl::u32 bands[16];
+    int beats = 0;
+    for (fl::u32 f = 0; f < 200; ++f) {
+        for (int i = 0; i < 16; ++i) {
+            bands[i] = (i < 2 ? 800 : 20) << 8;
+        }
+        beats += detector.update(bands, 16, f * kFrameMs) ? 1 : 0;
+    }
+    CHECK_EQ(beats, 0);
+    CHECK_EQ(detector.bpmQ8(), 0u);
+    CHECK_EQ(detector.nextBeatTime(), 0u);
+}
+
+TEST_CASE("BeatDetector locks onto 120 BPM") {
+    BeatDetector detector;
+    fl::u32 bands[16];
+    int beats = 0;
+    int kicks = 0;
+    for (fl::u32 f = 0; f < 400; ++f) {
+        const fl::u32 t = f * kFrameMs;
+        kickFrame(t, 500, bands);
+        const bool kick = t % 500 < kFrameMs;
+        const bool beat = detector.update(bands, 16, t);
+        if (f > 8) {
+            // Every kick is a beat and nothing else is.
+            INFO("frame " << f);
+            CHECK_EQ(beat, kick);
+            kicks += kick ? 1 : 0;
+            beats += beat ? 1 : 0;
+        }
+    }
+    CHECK(kicks >= 17);
+    CHECK_EQ(beats, kicks);
+    CHECK(fabs(detector.bpm() - 120.0f) <= 3.0f);
+    CHECK(detector.beatPeriodMs() >= 488u);
+    CHECK(detector.beatPeriodMs() <= 512u);
+
+    // The prediction holds through silence within a frame of the real kicks.
+    fl::u32 t = 400 * kFrameMs;
+    for (fl::u32 i = 0; i < 16; ++i) {
+        bands[i] = 0;
+    }
+    for (int f = 0; f < 20; ++f, t += kFrameMs) {
+        detector.update(bands, 16, t);
+    }
+    const fl::u32 next = detector.nextBeatTime();
+    CHECK(next > t - kFrameMs);
+    const fl::u32 kick = ((next + 250) / 500) * 500;
+    const fl::u32 err = next > kick ? next - kick : kick - next;
+    CHECK(err <= kFrameMs + 10);
+}
+
+TEST_CASE("BeatDetector keeps the tempo with full scale onsets") {
+    // Silence to full scale in every band saturates the onset history, and
+    // a long run holds the autocorrelation at its bound.
+    BeatDetector detector;
+    fl::u32 bands[16];
+    for (fl::u32 f = 0; f < 3000; ++f) {
+        const fl::u32 t = f * kFrameMs;
+        const fl::u32 level = t % 500 < kFrameMs ? 0xffffff00u : 0;
+        for (int i = 0; i < 16; ++i) {
+            bands[i] = level;
+        }
+        detector.update(bands, 16, t);
+    }
+    CHECK(fabs(detector.bpm() - 120.0f) <= 3.0f);
+}
+
+TEST_CASE("BeatDetector hears hi-hats") {
+    BeatDetector detector;
+    fl::u32 bands[16];
+    int beats = 0;
+    for (fl::u32 f = 0; f < 300; ++f) {
+        const fl::u32 t = f * kFrameMs;
+        for (int i = 0; i < 16; ++i) {
+            bands[i] = (i < 2 ? 800 : 20) << 8;
+        }
+        if (t % 400 < kFrameMs) {
+            for (int i = 12; i < 16; ++i) {
+                bands[i] += 300 << 8;
+            }
+        }
+        beats += detector.update(bands, 16, t) ? 1 : 0;
+    }
+    CHECK(beats >= 15);
+    CHECK(fabs(detector.bpm() - 150.0f) <= 4.0f);
+}
+
+TEST_CASE("AudioReactive reports tempo") {
+    AudioReactive audio;
+    audio.begin(AudioConfig());
+    int beats = 0;
+    for (int f = 0; f < 300; ++f) {
+        const fl::u32 t = fl::u32(f) * kFrameMs;
+        // 110Hz bass throughout, a loud 60Hz thump on every 500ms.
+        const bool kick = t % 500 < kFrameMs;
+        fl::vector<fl::i16> pcm;
+        for (int i = 0; i < 512; ++i) {
+            const float s = i / 44100.0f;
+            float v = 3000.0f * sinf(2.0f * float(M_PI) * 110.0f * s);
+            if (kick) {
+                v += 20000.0f * sinf(2.0f * float(M_PI) * 60.0f * s);
+            }
+            pcm.push_back(fl::i16(v));
+        }
+        audio.processSample(makeSample(pcm, 1000 + t));
+        beats += audio.isBeat() ? 1 : 0;
+    }
+    CHECK(beats >= 10);
+    CHECK(fabs(audio.getBPM() - 120.0f) <= 3.0f);
+    CHECK(audio.getNextBeatTime() != 0u);
+    CHECK_EQ(audio.getSmoothedData().bpm, audio.getData().bpm);
+}
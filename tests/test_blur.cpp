@@ -0,0 +1,162 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "fl/blur.h"
+#include "fl/vector.h"
+#include "fl/xymap.h"
+
+using namespace fl;
+
+namespace {
+
+// Straightforward box average with the edge pixels repeated, rounded after
+// each direction like BoxBlur2d.
+void referenceBoxBlur(fl::vector<CRGB> *image, int width, int height,
+                      int radius) {
+    const int d = 2 * radius + 1;
+    auto clampi = [](int v, int hi) { return v < 0 ? 0 : (v > hi ? hi : v); };
+    fl::vector<CRGB> tmp(image->size());
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            for (int c = 0; c < 3; ++c) {
+                int sum = 0;
+                for (int k = -radius; k <= radius; ++k) {
+                    sum += (*image)[y * width + clampi(x + k, width - 1)][c];
+                }
+                tmp[y * width + x][c] = fl::u8((sum + radius) / d);
+            }
+        }
+    }
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            for (int c = 0; c < 3; ++c) {
+                int sum = 0;
+                for (int k = -radius; k <= radius; ++k) {
+                    sum += tmp[clampi(y + k, height - 1) * width + x][c];
+                }
+                (*image)[y * width + x][c] = fl::u8((sum + radius) / d);
+            }
+        }
+    }
+}
+
+fl::vector<CRGB> testImage(int width, int height) {
+    fl::vector<CRGB> out(width * height);
+    fl::u32 seed = 12345;
+    for (int i = 0; i < width * height; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        out[i] = CRGB(fl::u8(seed >> 24), fl::u8(seed >> 16), fl::u8(seed >> 8));
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("BoxBlur2d matches a direct box average") {
+    const int sizes[][2] = {{1, 1}, {7, 5}, {16, 16}, {33, 9}};
+    const int radii[] = {1, 2, 5, 40};
+    for (const auto &size : sizes) {
+        const int w = size[0];
+        const int h = size[1];
+        XYMap xymap = XYMap::constructRectangularGrid(w, h);
+        for (int radius : radii) {
+            fl::vector<CRGB> expected = testImage(w, h);
+            fl::vector<CRGB> actual = expected;
+            referenceBoxBlur(&expected, w, h, radius);
+            referenceBoxBlur(&expected, w, h, radius);
+            boxBlur2d(actual.data(), xymap, fl::u16(radius), 2);
+            for (int i = 0; i < w * h; ++i) {
+                REQUIRE_EQ(actual[i], expected[i]);
+            }
+        }
+    }
+}
+
+TEST_CASE("BoxBlur2d through a serpentine XYMap") {
+    const int w = 12;
+    const int h = 7;
+    fl::vector<CRGB> rowMajor = testImage(w, h);
+    XYMap serpentine = XYMap::constructSerpentine(w, h);
+    fl::vector<CRGB> leds(w * h);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            leds[serpentine.mapToIndex(x, y)] = rowMajor[y * w + x];
+        }
+    }
+    BoxBlur2d blur(3);
+    blur.apply(leds.data(), serpentine);
+    referenceBoxBlur(&rowMajor, w, h, 3);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            REQUIRE_EQ(leds[serpentine.mapToIndex(x, y)], rowMajor[y * w + x]);
+        }
+    }
+}
+
+TEST_CASE("BoxBlur2d conserves light") {
+    const int w = 64;
+    const int h = 64;
+    XYMap xymap = XYMap::constructRectangularGrid(w, h);
+    fl::vector<CRGB> leds(w * h, CRGB(200, 100, 3));
+    BoxBlur2d blur(20, 3);
+    blur.apply(leds.data(), xymap);
+    for (int i = 0; i < w * h; ++i) {
+        REQUIRE_EQ(leds[i], CRGB(200, 100, 3));
+    }
+
+    // A single dot spreads out but keeps (about) its total.
+    fl::vector<CRGB> dot(w * h);
+    dot[32 * w + 32] = CRGB(255, 255, 255);
+    blur.setRadius(0);
+    blur.apply(dot.data(), xymap);
+    CHECK_EQ(dot[32 * w + 32], CRGB(255, 255, 255));
+    blur.setRadius(2);
+    blur.setPasses(1);
+    for (int i = 0; i < w * h; ++i) {
+        dot[i] = CRGB::Black;
+    }
+    dot[32 * w + 32] = CRGB(250, 250, 250);
+    blur.apply(dot.data(), xymap);
+    int sum = 0;
+    for (int i = 0; i < w * h; ++i) {
+        sum += dot[i].r;
+    }
+    CHECK_EQ(dot[32 * w + 32].r, 10); // 250 / 25
+    CHECK_EQ(dot[30 * w + 34].r, 10);
+    CHECK_EQ(dot[29 * w + 32].r, 0);
+    CHECK_EQ(sum, 250);
+
+    // The widest blur of a flat image keeps it flat instead of wrapping.
+    fl::vector<CRGB> white(16 * 4, CRGB(255, 255, 255));
+    boxBlur2d(white.data(), XYMap::constructRectangularGrid(16, 4), 65535);
+    for (const CRGB &c : white) {
+        REQUIRE_EQ(c, CRGB(255, 255, 255));
+    }
+}
+
+TEST_CASE("blur2d by row spans matches the per pixel path") {
+    // Columns are blurred 32 at a time, 70 wide takes three passes.
+    const int widths[] = {13, 70};
+    const int h = 6;
+    for (int w : widths) {
+        const XYMap maps[] = {XYMap::constructSerpentine(w, h),
+                              XYMap::constructRectangularGrid(w, h)};
+        for (const XYMap &xymap : maps) {
+            // A look up table of the same layout takes the per pixel path.
+            XYMap lut = xymap;
+            lut.convertToLookUpTable();
+            const fract8 amounts[] = {0, 64, 172, 255};
+            for (fract8 amount : amounts) {
+                fl::vector<CRGB> expected = testImage(w, h);
+                fl::vector<CRGB> actual = expected;
+                blur2d(expected.data(), w, h, amount, lut);
+                blur2d(actual.data(), w, h, amount, xymap);
+                for (int i = 0; i < w * h; ++i) {
+                    REQUIRE_EQ(actual[i], expected[i]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,93 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "fl/vector.h"
+
+using namespace fl;
+
+namespace {
+
+CRGBPalette16 randomPalette(u32 *seed) {
+    CRGBPalette16 pal;
+    for (int i = 0; i < 16; ++i) {
+        *seed = *seed * 1664525u + 1013904223u;
+        pal[i] = CRGB(*seed >> 24, *seed >> 16, *seed >> 8);
+    }
+    return pal;
+}
+
+} // namespace
+
+TEST_CASE("hsv2rgb_rainbow array matches scalar for every input") {
+    // One hue per batch of all 65536 saturation and value pairs.
+    fl::vector<CHSV> hsv(65536);
+    fl::vector<CRGB> rgb(65536);
+    int mismatches = 0;
+    for (int hue = 0; hue < 256; ++hue) {
+        for (int i = 0; i < 65536; ++i) {
+            hsv[i] = CHSV(hue, i >> 8, i & 0xFF);
+        }
+        hsv2rgb_rainbow(hsv.data(), rgb.data(), 65536);
+        for (int i = 0; i < 65536; ++i) {
+            CRGB expected;
+            hsv2rgb_rainbow(hsv[i], expected);
+            if (!(rgb[i] == expected)) {
+                ++mismatches;
+            }
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+TEST_CASE("ColorFromPalette array matches scalar") {
+    const TBlendType blends[] = {NOBLEND, LINEARBLEND, LINEARBLEND_NOWRAP};
+    u8 indices[256];
+    for (int i = 0; i < 256; ++i) {
+        indices[i] = u8(i);
+    }
+    CRGB out[256];
+    u32 seed = 3;
+    for (int p = 0; p < 4; ++p) {
+        const CRGBPalette16 pal =
+            p == 0 ? CRGBPalette16(RainbowColors_p) : randomPalette(&seed);
+        for (TBlendType blend : blends) {
+            for (int brightness = 0; brightness < 256; ++brightness) {
+                ColorFromPalette(pal, indices, out, 256, u8(brightness), blend);
+                for (int i = 0; i < 256; ++i) {
+                    REQUIRE_EQ(out[i], ColorFromPalette(pal, u8(i),
+                                                        u8(brightness), blend));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("fill_palette and map_data_into_colors_through_palette") {
+    u32 seed = 11;
+    const CRGBPalette16 pal = randomPalette(&seed);
+    CRGB leds[150];
+    fill_palette(leds, 150, 200, 7, pal, 180, LINEARBLEND);
+    u8 index = 200;
+    for (int i = 0; i < 150; ++i, index += 7) {
+        REQUIRE_EQ(leds[i], ColorFromPalette(pal, index, 180, LINEARBLEND));
+    }
+
+    u8 data[150];
+    CRGB expected[150];
+    for (int i = 0; i < 150; ++i) {
+        data[i] = u8(i * 37);
+        leds[i] = CRGB(i, 255 - i, 3 * i);
+        expected[i] = leds[i];
+        CRGB rgb = ColorFromPalette(pal, data[i], 255, NOBLEND);
+        expected[i].nscale8(256 - 100);
+        rgb.nscale8_video(100);
+        expected[i] += rgb;
+    }
+    map_data_into_colors_through_palette(data, 150, leds, pal, 255, 100,
+                                         NOBLEND);
+    for (int i = 0; i < 150; ++i) {
+        REQUIRE_EQ(leds[i], expected[i]);
+    }
+}
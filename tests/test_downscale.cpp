@@ -5,10 +5,37 @@
 
 #include "fl/downscale.h"
 #include "fl/dbg.h"
+#include "fl/vector.h"
 #include "test.h"
 
 using namespace fl;
 
+namespace {
+
+fl::vector<CRGB> randomImage(u16 count, u32 seed) {
+    fl::vector<CRGB> image(count);
+    for (u16 i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        image[i] = CRGB(seed >> 24, seed >> 16, seed >> 8);
+    }
+    return image;
+}
+
+// The same layout as a look up table, which takes the per pixel path.
+XYMap asLookUpTable(const XYMap &map, fl::vector<u16> *table) {
+    const u16 width = map.getWidth();
+    const u16 height = map.getHeight();
+    table->resize(width * height);
+    for (u16 y = 0; y < height; ++y) {
+        for (u16 x = 0; x < width; ++x) {
+            (*table)[y * width + x] = map.mapToIndex(x, y);
+        }
+    }
+    return XYMap::constructWithLookUpTable(width, height, table->data());
+}
+
+} // namespace
+
 TEST_CASE("downscale 2x2 to 1x1") {
 
     CRGB red = CRGB(255, 0, 0);
@@ -124,4 +151,41 @@ TEST_CASE("downscale 11x11 to 2x2") {
         INFO("Dst[" << i << "]: " << dst[i]);
         CHECK(dst[i] == CRGB(129, 0, 0));  // Averaged color
     }
-}
\ No newline at end of file
+}
+TEST_CASE("downscale row kernels match the per pixel path") {
+    // Widths around the 8 pixel steps of the vector kernels.
+    const u16 widths[] = {1, 7, 8, 9, 17, 40};
+    for (u16 width : widths) {
+        for (int serpentine = 0; serpentine < 2; ++serpentine) {
+            INFO("width " << width << " serpentine " << serpentine);
+            const u16 height = 6;
+            const fl::vector<CRGB> src = randomImage(4 * width * height, width);
+            const XYMap srcMap(2 * width, 2 * height, serpentine != 0);
+            const XYMap dstMap(width, height, serpentine != 0);
+            fl::vector<u16> srcTable, dstTable;
+            const XYMap srcLut = asLookUpTable(srcMap, &srcTable);
+            const XYMap dstLut = asLookUpTable(dstMap, &dstTable);
+
+            fl::vector<CRGB> expected(width * height);
+            fl::vector<CRGB> actual(width * height);
+            downscaleHalf(src.data(), srcLut, expected.data(), dstLut);
+            downscale(src.data(), srcMap, actual.data(), dstMap);
+            for (u16 i = 0; i < width * height; ++i) {
+                REQUIRE_EQ(actual[i], expected[i]);
+            }
+
+            // 3:2 and other odd ratios, through downscaleArbitrary.
+            const u16 srcWidth = width * 3 / 2 + 1;
+            const u16 srcHeight = 11;
+            const fl::vector<CRGB> big =
+                randomImage(srcWidth * srcHeight, width + 99);
+            const XYMap bigMap(srcWidth, srcHeight, serpentine != 0);
+            const XYMap bigLut = asLookUpTable(bigMap, &srcTable);
+            downscaleArbitrary(big.data(), bigLut, expected.data(), dstLut);
+            downscaleArbitrary(big.data(), bigMap, actual.data(), dstMap);
+            for (u16 i = 0; i < width * height; ++i) {
+                REQUIRE_EQ(actual[i], expected[i]);
+            }
+        }
+    }
+}
@@ -7,6 +7,7 @@
 #include "FastLED.h"
 
 #include "fl/namespace.h"
+#include "fl/vector.h"
 FASTLED_USING_NAMESPACE
 
 #define NUM_LEDS 1000
@@ -19,3 +20,153 @@ TEST_CASE("Simple") {
     FastLED.addLeds<APA102, DATA_PIN, CLOCK_PIN, BGR>(leds, NUM_LEDS);
 }
 
+
+namespace {
+
+class CountingController : public CLEDController {
+  public:
+    int shows = 0;
+    void showColor(const CRGB &data, int nLeds, uint8_t brightness) override {
+        FASTLED_UNUSED(data);
+        FASTLED_UNUSED(nLeds);
+        FASTLED_UNUSED(brightness);
+    }
+    void show(const struct CRGB *data, int nLeds, uint8_t brightness) override {
+        FASTLED_UNUSED(data);
+        FASTLED_UNUSED(nLeds);
+        FASTLED_UNUSED(brightness);
+        shows++;
+    }
+    void init() override {}
+};
+
+} // namespace
+
+TEST_CASE("Skip unchanged frames") {
+    // Controllers stay linked into the global list, so keep this one alive.
+    static CountingController controller;
+    static CRGB data[16];
+    controller.setLeds(data, 16);
+    controller.setSkipUnchangedFrames(true);
+
+    FastLED.show();
+    CHECK_EQ(controller.shows, 1);
+    FastLED.show();
+    CHECK_EQ(controller.shows, 1);
+
+    data[3] = CRGB::Red;
+    FastLED.show();
+    CHECK_EQ(controller.shows, 2);
+    FastLED.show();
+    CHECK_EQ(controller.shows, 2);
+
+    // Output settings are part of the frame.
+    FastLED.show(FastLED.getBrightness() / 2);
+    CHECK_EQ(controller.shows, 3);
+    FastLED.show(FastLED.getBrightness() / 2);
+    CHECK_EQ(controller.shows, 3);
+    controller.setCorrection(CRGB(255, 200, 200));
+    FastLED.show(FastLED.getBrightness() / 2);
+    CHECK_EQ(controller.shows, 4);
+
+    // Showing the strip directly invalidates the cached frame.
+    controller.showLeds(255);
+    CHECK_EQ(controller.shows, 5);
+    FastLED.show(FastLED.getBrightness() / 2);
+    CHECK_EQ(controller.shows, 6);
+
+    controller.setSkipUnchangedFrames(false);
+    FastLED.show();
+    FastLED.show();
+    CHECK_EQ(controller.shows, 8);
+}
+
+TEST_CASE("Parallel show") {
+    static CountingController controllers[4];
+    static CRGB data[4][64];
+    for (int i = 0; i < 4; ++i) {
+        controllers[i].setLeds(data[i], 64);
+    }
+    controllers[2].setEnabled(false);
+
+    FastLED.setParallelShow(true);
+    CHECK(FastLED.getParallelShow());
+    for (int frame = 0; frame < 10; ++frame) {
+        FastLED.show();
+    }
+    FastLED.setParallelShow(false);
+    FastLED.show();
+
+    CHECK_EQ(controllers[0].shows, 11);
+    CHECK_EQ(controllers[1].shows, 11);
+    CHECK_EQ(controllers[2].shows, 0);
+    CHECK_EQ(controllers[3].shows, 11);
+    for (int i = 0; i < 4; ++i) {
+        controllers[i].setEnabled(false);
+    }
+}
+
+namespace {
+
+// Records the dithered bytes and dither signal of every frame it shows.
+class RecordingController : public CPixelLEDController<RGB> {
+  public:
+    fl::vector<fl::u8> bytes;
+    fl::vector<fl::u8> phases;
+    void init() override {}
+    void show(const CRGB *data, int nLeds, uint8_t brightness) override {
+        // FastLED.show() turns dithering off below 100 fps, keep it on.
+        setDither(BINARY_DITHER);
+        CPixelLEDController<RGB>::show(data, nLeds, brightness);
+    }
+    void showPixels(PixelController<RGB> &pixels) override {
+        phases.push_back(pixels.d[0]);
+        while (pixels.has(1)) {
+            pixels.stepDithering();
+            bytes.push_back(pixels.loadAndScale0());
+            bytes.push_back(pixels.loadAndScale1());
+            bytes.push_back(pixels.loadAndScale2());
+            pixels.advanceData();
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE("Parallel show matches the serial show") {
+    static RecordingController controllers[4];
+    static CRGB data[4][32];
+    for (int i = 0; i < 4; ++i) {
+        for (int k = 0; k < 32; ++k) {
+            data[i][k] = CRGB(i * 60 + k, k * 7, 255 - k * 3);
+        }
+        controllers[i].setLeds(data[i], 32);
+    }
+
+    // One full dither cycle each, so both runs start from the same phase.
+    const int frames = 1 << VIRTUAL_BITS;
+    for (int frame = 0; frame < frames; ++frame) {
+        FastLED.show(100);
+    }
+    fl::vector<fl::u8> serialBytes[4];
+    fl::vector<fl::u8> serialPhases[4];
+    for (int i = 0; i < 4; ++i) {
+        serialBytes[i].swap(controllers[i].bytes);
+        serialPhases[i].swap(controllers[i].phases);
+    }
+
+    FastLED.setParallelShow(true);
+    for (int frame = 0; frame < frames; ++frame) {
+        FastLED.show(100);
+    }
+    FastLED.setParallelShow(false);
+
+    for (int i = 0; i < 4; ++i) {
+        CHECK_EQ(serialPhases[i].size(), fl::size(frames));
+        CHECK(controllers[i].phases == serialPhases[i]);
+        CHECK(controllers[i].bytes == serialBytes[i]);
+        controllers[i].setEnabled(false);
+    }
+    // The dither signal actually moves from frame to frame.
+    CHECK(serialPhases[0][0] != serialPhases[0][1]);
+}
@@ -7,6 +7,7 @@
 
 #include "fl/fft.h"
 #include "fl/fft_impl.h"
+#include "fl/fft_stream.h"
 #include "fl/math.h"
 
 // // Proof of concept FFTImpl using KISS FFTImpl. Right now this is fixed sized blocks
@@ -140,3 +141,43 @@ TEST_CASE("fft tester 256 with 64 bands") {
     FASTLED_WARN("FFTImpl info: " << info);
     FASTLED_WARN("Done");
 }
+
+TEST_CASE("fft stream with overlapping windows") {
+    fl::vector<int16_t> pcm;
+    for (int i = 0; i < 2048; ++i) {
+        float rot = 2 * PI * 440.0f * i / 44100.0f;
+        pcm.push_back(int16_t(20000 * sin(rot) + 3000 * sin(rot * 5.3f)));
+    }
+    FFTImpl reference(512);
+    FFTStream stream(FFT_Args(512), 256);
+    CHECK_EQ(stream.hopSize(), 256u);
+    int windows = 0;
+    stream.setCallback([&](const FFTBins &bins) {
+        // Window k covers the 512 samples that end at 512 + 256 * k.
+        const int end = 512 + 256 * windows;
+        FFTBins expected(16);
+        reference.run(span<const int16_t>(pcm.data() + end - 512, 512),
+                      &expected);
+        REQUIRE_EQ(bins.bins_raw.size(), expected.bins_raw.size());
+        for (fl::size i = 0; i < expected.bins_raw.size(); ++i) {
+            CHECK_EQ(bins.bins_raw[i], expected.bins_raw[i]);
+        }
+        ++windows;
+    });
+
+    // Odd sized chunks so that windows end in the middle of a chunk.
+    fl::u32 completed = 0;
+    for (fl::size i = 0; i < pcm.size(); i += 100) {
+        fl::size n = pcm.size() - i < 100 ? pcm.size() - i : 100;
+        completed += stream.push(span<const int16_t>(pcm.data() + i, n));
+    }
+    CHECK_EQ(windows, 7);
+    CHECK_EQ(completed, 7u);
+    CHECK_EQ(stream.windowsCompleted(), 7u);
+
+    // After a reset the ring has to fill up again.
+    stream.setCallback(FFTStream::Callback());
+    stream.reset();
+    CHECK_EQ(stream.push(span<const int16_t>(pcm.data(), 511)), 0u);
+    CHECK_EQ(stream.push(span<const int16_t>(pcm.data(), 1)), 1u);
+}
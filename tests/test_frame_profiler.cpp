@@ -0,0 +1,193 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include <string.h>
+
+#include "FastLED.h"
+#include "fl/frame_profiler.h"
+#include "fx/fx.h"
+#include "fx/fx_engine.h"
+
+using namespace fl;
+
+namespace {
+
+class NullController : public CLEDController {
+  public:
+    void showColor(const CRGB &data, int nLeds, uint8_t brightness) override {
+        FASTLED_UNUSED(data);
+        FASTLED_UNUSED(nLeds);
+        FASTLED_UNUSED(brightness);
+    }
+    void show(const struct CRGB *data, int nLeds, uint8_t brightness) override {
+        FASTLED_UNUSED(data);
+        FASTLED_UNUSED(nLeds);
+        FASTLED_UNUSED(brightness);
+    }
+    void init() override {}
+};
+
+FASTLED_SMART_PTR(SolidFx);
+
+class SolidFx : public Fx {
+  public:
+    explicit SolidFx(uint16_t numLeds) : Fx(numLeds) {}
+    void draw(DrawContext ctx) override {
+        for (uint16_t i = 0; i < mNumLeds; ++i) {
+            ctx.leds[i] = CRGB::Red;
+        }
+    }
+    fl::string fxName() const override { return "SolidFx"; }
+};
+
+FASTLED_SMART_PTR(NamedFx);
+
+class NamedFx : public Fx {
+  public:
+    explicit NamedFx(const char *name) : Fx(1), mName(name) {}
+    void draw(DrawContext ctx) override { FASTLED_UNUSED(ctx); }
+    fl::string fxName() const override { return mName; }
+
+  private:
+    fl::string mName;
+};
+
+} // namespace
+
+TEST_CASE("FrameProfiler stats") {
+    FrameProfiler profiler;
+    CHECK_EQ(FrameProfiler::active(), &profiler);
+    CHECK_EQ(profiler.showStats().count, 0u);
+
+    for (fl::u32 i = 1; i <= 100; ++i) {
+        profiler.recordShow(101 - i);
+    }
+    FrameProfiler::Stats st = profiler.showStats();
+    CHECK_EQ(st.count, 100u);
+    CHECK_EQ(st.min, 1u);
+    CHECK_EQ(st.max, 100u);
+    CHECK_EQ(st.avg, 50u);
+    CHECK_EQ(st.p99, 99u);
+
+    // Only the last FASTLED_FRAME_PROFILER_HISTORY samples count.
+    profiler.reset();
+    const fl::u32 total = FASTLED_FRAME_PROFILER_HISTORY + 72;
+    for (fl::u32 i = 1; i <= total; ++i) {
+        profiler.recordRender(i);
+    }
+    st = profiler.stats("render");
+    CHECK_EQ(st.count, fl::u32(FASTLED_FRAME_PROFILER_HISTORY));
+    CHECK_EQ(st.min, 73u);
+    CHECK_EQ(st.max, total);
+
+    fl::string json;
+    profiler.toJson(&json);
+    CHECK(strstr(json.c_str(), "\"name\":\"render\",\"count\":128,\"min\":73"));
+    CHECK(strstr(json.c_str(), "\"name\":\"show\",\"count\":0"));
+}
+
+TEST_CASE("FrameProfiler series limit") {
+    FrameProfiler profiler;
+    // Controllers stay linked into the global list, so keep these alive.
+    static NullController strips[FASTLED_FRAME_PROFILER_MAX_SERIES];
+    for (NullController &strip : strips) {
+        profiler.recordStrip(&strip, 5);
+    }
+    // render and show take two of the slots.
+    CHECK_EQ(profiler.numSeries(), fl::u32(FASTLED_FRAME_PROFILER_MAX_SERIES));
+    CHECK_EQ(strcmp(profiler.seriesName(2), "strip0"), 0);
+    CHECK_EQ(profiler.stats("strip0").count, 1u);
+    for (NullController &strip : strips) {
+        strip.setEnabled(false);
+    }
+}
+
+TEST_CASE("FrameProfiler drops the series of removed strips") {
+    FrameProfiler profiler;
+    static NullController strips[2];
+    profiler.recordStrip(&strips[0], 5);
+    profiler.recordStrip(&strips[1], 7);
+    CHECK_EQ(profiler.numSeries(), 4u);
+    // What the destructor of strips[0] sends.
+    EngineEvents::onStripRemoved(&strips[0]);
+    CHECK_EQ(profiler.numSeries(), 3u);
+    CHECK_EQ(profiler.stats("strip0").count, 0u);
+    CHECK_EQ(strcmp(profiler.seriesName(2), "strip1"), 0);
+    CHECK_EQ(profiler.stats("strip1").max, 7u);
+    // A controller at the same address is a new strip.
+    profiler.recordStrip(&strips[0], 9);
+    CHECK_EQ(strcmp(profiler.seriesName(3), "strip2"), 0);
+    CHECK_EQ(profiler.stats("strip2").count, 1u);
+    for (NullController &strip : strips) {
+        strip.setEnabled(false);
+    }
+}
+
+TEST_CASE("FrameProfiler hooks") {
+    FrameProfiler outer;
+    static NullController controller;
+    static CRGB leds[16];
+    controller.setLeds(leds, 16);
+    {
+        FrameProfiler profiler;
+        FxEngine engine(16, false);
+        engine.addFx(SolidFxPtr::New(16));
+        for (int frame = 0; frame < 3; ++frame) {
+            engine.draw(frame * 10, leds);
+            FastLED.show();
+        }
+        CHECK_EQ(profiler.showStats().count, 3u);
+        // The first frame has no previous show() to measure from.
+        CHECK_EQ(profiler.renderStats().count, 2u);
+        CHECK_EQ(profiler.stats("strip0").count, 3u);
+        CHECK_EQ(profiler.stats("SolidFx").count, 3u);
+        CHECK(profiler.showStats().max >= profiler.stats("strip0").max);
+
+        fl::string json;
+        profiler.toJson(&json);
+        CHECK(strstr(json.c_str(), "\"name\":\"SolidFx\",\"count\":3"));
+    }
+    // Destroying the inner profiler hands the hooks back to the outer one.
+    CHECK_EQ(FrameProfiler::active(), &outer);
+    FastLED.show();
+    CHECK_EQ(outer.stats("strip0").count, 1u);
+    CHECK_EQ(outer.showStats().count, 4u);
+}
+
+TEST_CASE("FrameProfiler lifetimes in any order") {
+    FrameProfiler *a = new FrameProfiler();
+    FrameProfiler *b = new FrameProfiler();
+    FrameProfiler *c = new FrameProfiler();
+    CHECK_EQ(FrameProfiler::active(), c);
+    delete a;
+    CHECK_EQ(FrameProfiler::active(), c);
+    delete c;
+    CHECK_EQ(FrameProfiler::active(), b);
+    FrameProfiler *d = new FrameProfiler();
+    CHECK_EQ(FrameProfiler::active(), d);
+    delete b;
+    CHECK_EQ(FrameProfiler::active(), d);
+    delete d;
+    CHECK(FrameProfiler::active() == nullptr);
+}
+
+TEST_CASE("FrameProfiler Fx series") {
+    FrameProfiler profiler;
+    // Same name, different objects: one series each, also if the second one
+    // lands at the address of the first.
+    NamedFxPtr first = NamedFxPtr::New("quote\"d");
+    profiler.recordFx(first, 10);
+    profiler.recordFx(first, 20);
+    first.reset();
+    NamedFxPtr second = NamedFxPtr::New("quote\"d");
+    profiler.recordFx(second, 30);
+    CHECK_EQ(profiler.numSeries(), 4u);
+    CHECK_EQ(profiler.stats(2u).count, 2u);
+    CHECK_EQ(profiler.stats(3u).count, 1u);
+    CHECK_EQ(profiler.stats(3u).min, 30u);
+
+    fl::string json;
+    profiler.toJson(&json);
+    CHECK(strstr(json.c_str(), "\"name\":\"quote\\\"d\",\"count\":2"));
+}
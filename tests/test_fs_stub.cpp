@@ -0,0 +1,101 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include <stdio.h>
+
+#include "crgb.h"
+#include "fl/file_system.h"
+#include "fx/video.h"
+#include "fx/video/pixel_stream.h"
+#include "platforms/stub/fs_stub.h"
+
+using namespace fl;
+
+#if FASTLED_STUB_MMAP_FS
+
+namespace {
+
+const int kPixels = 16;
+const int kFrames = 4;
+const char *kPath = "test_fs_stub_video.rgb";
+
+// Frame f is every pixel set to CRGB(10 * (f + 1), f, 0).
+struct TempVideoFile {
+    TempVideoFile() {
+        FILE *f = fopen(kPath, "wb");
+        REQUIRE(f);
+        for (int frame = 0; frame < kFrames; ++frame) {
+            for (int i = 0; i < kPixels; ++i) {
+                fl::u8 rgb[3] = {fl::u8(10 * (frame + 1)), fl::u8(frame), 0};
+                fwrite(rgb, 1, 3, f);
+            }
+        }
+        fclose(f);
+    }
+    ~TempVideoFile() { remove(kPath); }
+};
+
+} // namespace
+
+TEST_CASE("mmap file handle") {
+    TempVideoFile file;
+    FileSystem fs;
+    REQUIRE(fs.begin(make_mmap_filesystem()));
+    CHECK_FALSE(fs.openRead("does_not_exist.rgb"));
+
+    FileHandlePtr handle = fs.openRead(kPath);
+    REQUIRE(handle);
+    REQUIRE_EQ(handle->size(), fl::size(kPixels * kFrames * 3));
+    fl::span<const fl::u8> mapping = handle->mapping();
+    REQUIRE_EQ(mapping.size(), handle->size());
+    CHECK_EQ(mapping.data()[0], 10);
+
+    fl::u8 buf[4] = {};
+    REQUIRE(handle->seek(kPixels * 3));
+    REQUIRE_EQ(handle->read(buf, 4), fl::size(4));
+    CHECK_EQ(buf[0], 20);
+    CHECK_EQ(buf[1], 1);
+    CHECK_EQ(handle->pos(), fl::size(kPixels * 3 + 4));
+    REQUIRE(handle->seek(handle->size() - 1));
+    CHECK_EQ(handle->read(buf, 4), fl::size(1));
+    CHECK_FALSE(handle->available());
+
+    // PixelStream hands out frames in place.
+    PixelStreamPtr stream = PixelStreamPtr::New(kPixels * 3);
+    REQUIRE(stream->begin(handle));
+    REQUIRE(stream->mapped());
+    CHECK_EQ(stream->frameCount(), kFrames);
+    const CRGB *frame2 = stream->frameAt(2);
+    REQUIRE(frame2);
+    CHECK_EQ(reinterpret_cast<const fl::u8 *>(frame2),
+             mapping.data() + 2 * kPixels * 3);
+    CHECK_EQ(frame2[kPixels - 1], CRGB(30, 2, 0));
+    CHECK_FALSE(stream->frameAt(kFrames));
+}
+
+TEST_CASE("video from mmap file system") {
+    TempVideoFile file;
+    FileSystem fs;
+    REQUIRE(fs.begin(make_mmap_filesystem()));
+    Video video = fs.openVideo(kPath, kPixels, 1); // One frame per second.
+    REQUIRE(video);
+    video.setFade(0, 0);
+    CHECK_EQ(video.durationMicros(), kFrames * 1000000);
+
+    CRGB leds[kPixels];
+    REQUIRE(video.draw(0, leds));
+    CHECK_EQ(leds[0], CRGB(10, 0, 0));
+    // Half way between frame 0 and 1, same blend as FrameInterpolator.
+    REQUIRE(video.draw(500, leds));
+    CHECK_EQ(leds[0], CRGB::blend(CRGB(10, 0, 0), CRGB(20, 1, 0), 127));
+    // Jumping ahead is just pointer arithmetic.
+    REQUIRE(video.draw(2000, leds));
+    CHECK_EQ(leds[kPixels - 1], CRGB(30, 2, 0));
+    // Playing backward works the same way.
+    video.setTimeScale(-1.0f);
+    REQUIRE(video.draw(3000, leds));
+    CHECK_EQ(leds[0], CRGB(20, 1, 0));
+}
+
+#endif // FASTLED_STUB_MMAP_FS
@@ -107,10 +107,119 @@ TEST_CASE("test_fx_engine") {
         }
     }
 
+    SUBCASE("Overlay layers") {
+        Ptr<MockFx> greenFx = MockFxPtr::New(NUM_LEDS, CRGB(0, 100, 0));
+        Ptr<MockFx> dimFx = MockFxPtr::New(NUM_LEDS, CRGB(128, 255, 255));
+        REQUIRE_EQ(0, engine.addLayer(greenFx, BLEND_MODE_ADD));
+        REQUIRE_EQ(1, engine.addLayer(dimFx, BLEND_MODE_MULTIPLY));
+
+        REQUIRE(engine.draw(0, leds));
+        for (uint16_t i = 0; i < NUM_LEDS; ++i) {
+            REQUIRE_EQ(leds[i], CRGB(128, 100, 0));
+        }
+
+        // Overlays keep running while the base fx transitions.
+        REQUIRE(engine.nextFx(1000));
+        REQUIRE(engine.draw(0, leds));
+        REQUIRE(engine.draw(1000, leds));
+        for (uint16_t i = 0; i < NUM_LEDS; ++i) {
+            REQUIRE_EQ(leds[i], CRGB(0, 100, 255));
+        }
+
+        REQUIRE(engine.setLayerBlend(0, BLEND_MODE_ADD, 0));
+        REQUIRE(engine.removeLayer(1));
+        CHECK_FALSE(engine.removeLayer(1));
+        REQUIRE(engine.draw(1001, leds));
+        for (uint16_t i = 0; i < NUM_LEDS; ++i) {
+            REQUIRE_EQ(leds[i], CRGB::Blue);
+        }
+    }
+
+    SUBCASE("Overlay must cover all leds") {
+        Ptr<MockFx> smallFx = MockFxPtr::New(NUM_LEDS - 1, CRGB::Green);
+        CHECK_EQ(-1, engine.addLayer(smallFx));
+    }
+
 }
 
 
 
+FASTLED_SMART_PTR(StaticFx);
+
+// Static fx that counts its draws and reports no change after the first.
+class StaticFx : public Fx {
+  public:
+    StaticFx(uint16_t numLeds, CRGB color) : Fx(numLeds), mColor(color) {}
+
+    void draw(DrawContext ctx) override {
+        mDraws++;
+        for (uint16_t i = 0; i < mNumLeds; ++i) {
+            ctx.leds[i] = mColor;
+        }
+    }
+
+    bool hasChangedSince(uint32_t lastDrawTime, uint32_t now) const override {
+        FASTLED_UNUSED(lastDrawTime);
+        FASTLED_UNUSED(now);
+        return mChanged;
+    }
+
+    Str fxName() const override { return "StaticFx"; }
+
+    CRGB mColor;
+    bool mChanged = false;
+    int mDraws = 0;
+};
+
+TEST_CASE("test_fx_engine change tracking") {
+    constexpr uint16_t NUM_LEDS = 10;
+    FxEngine engine(NUM_LEDS, false);
+    engine.setChangeTracking(true);
+    CRGB leds[NUM_LEDS];
+
+    Ptr<StaticFx> fx = StaticFxPtr::New(NUM_LEDS, CRGB::Red);
+    engine.addFx(fx);
+
+    REQUIRE(engine.draw(0, leds));
+    CHECK(engine.lastFrameChanged());
+    CHECK_EQ(fx->mDraws, 1);
+    CHECK_EQ(leds[0], CRGB::Red);
+
+    // Unchanged: neither the fx nor the output buffer are touched.
+    leds[0] = CRGB::Black;
+    REQUIRE(engine.draw(16, leds));
+    CHECK_FALSE(engine.lastFrameChanged());
+    CHECK_EQ(fx->mDraws, 1);
+    CHECK_EQ(leds[0], CRGB::Black);
+
+    fx->mChanged = true;
+    fx->mColor = CRGB::Blue;
+    REQUIRE(engine.draw(32, leds));
+    CHECK(engine.lastFrameChanged());
+    CHECK_EQ(fx->mDraws, 2);
+    CHECK_EQ(leds[0], CRGB::Blue);
+
+    // Changing the layer stack forces an output even for static fx.
+    fx->mChanged = false;
+    Ptr<StaticFx> overlay = StaticFxPtr::New(NUM_LEDS, CRGB(100, 0, 0));
+    REQUIRE_EQ(0, engine.addLayer(overlay, BLEND_MODE_ADD));
+    REQUIRE(engine.draw(48, leds));
+    CHECK(engine.lastFrameChanged());
+    CHECK_EQ(leds[0], CRGB(100, 0, 255));
+    REQUIRE(engine.draw(64, leds));
+    CHECK_FALSE(engine.lastFrameChanged());
+    CHECK_EQ(fx->mDraws, 2);
+    CHECK_EQ(overlay->mDraws, 1);
+
+    SUBCASE("disabled tracking always redraws") {
+        engine.setChangeTracking(false);
+        REQUIRE(engine.draw(80, leds));
+        REQUIRE(engine.draw(96, leds));
+        CHECK(engine.lastFrameChanged());
+        CHECK_EQ(fx->mDraws, 4);
+    }
+}
+
 TEST_CASE("test_transition") {
 
     SUBCASE("Initial state") {
@@ -0,0 +1,283 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "fl/json_stream.h"
+#include "fl/screenmap.h"
+#include "fl/str.h"
+
+using namespace fl;
+
+namespace {
+
+u32 bitsOf(float f) {
+    u32 bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+fl::string writeFloat(float f) {
+    fl::string out;
+    JsonWriter json(&out);
+    json.value(f);
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("JsonWriter nesting and escapes") {
+    char buf[128];
+    JsonWriter json(buf, sizeof(buf));
+    json.beginObject();
+    json.member("fps", 60).member("name", "a \"b\"\n\\");
+    json.key("list").beginArray();
+    json.value(-2147483647 - 1).value(u32(4294967295u)).value(true).null();
+    json.beginObject().endObject();
+    json.beginArray().endArray();
+    json.endArray();
+    json.member("ctl", "\x01");
+    json.endObject();
+    CHECK(json.ok());
+    CHECK_EQ(fl::string(buf),
+             fl::string("{\"fps\":60,\"name\":\"a \\\"b\\\"\\n\\\\\",\"list\":"
+                        "[-2147483648,4294967295,true,null,{},[]],"
+                        "\"ctl\":\"\\u0001\"}"));
+    CHECK_EQ(json.length(), strlen(buf));
+}
+
+TEST_CASE("JsonWriter buffer overflow and misuse") {
+    char buf[8];
+    JsonWriter json(buf, sizeof(buf));
+    json.beginArray().value(12345).value(67890).endArray();
+    CHECK_FALSE(json.ok());
+    CHECK_EQ(fl::string(buf), fl::string("[12345,"));
+    CHECK_EQ(json.length(), 13u);
+
+    fl::string out;
+    JsonWriter noKey(&out);
+    noKey.beginObject().value(1);
+    CHECK_FALSE(noKey.ok());
+
+    JsonWriter unbalanced(&out);
+    unbalanced.beginArray().endObject();
+    CHECK_FALSE(unbalanced.ok());
+}
+
+TEST_CASE("JsonWriter floats") {
+    CHECK_EQ(writeFloat(0.0f), fl::string("0"));
+    CHECK_EQ(writeFloat(1.0f), fl::string("1"));
+    CHECK_EQ(writeFloat(0.1f), fl::string("0.1"));
+    CHECK_EQ(writeFloat(-2.5f), fl::string("-2.5"));
+    CHECK_EQ(writeFloat(1234567.0f), fl::string("1234567"));
+    CHECK_EQ(writeFloat(0.00001f), fl::string("0.00001"));
+    CHECK_EQ(writeFloat(1e-7f), fl::string("1e-7"));
+    CHECK_EQ(writeFloat(3.4e38f), fl::string("3.4e38"));
+    CHECK_EQ(writeFloat(16777217.0f), fl::string("16777216"));
+    const float zero = 0.0f;
+    CHECK_EQ(writeFloat(zero / zero), fl::string("null"));
+    CHECK_EQ(writeFloat(1.0f / zero), fl::string("null"));
+
+    // Every float written reads back to the same bits.
+    u32 seed = 1;
+    for (int i = 0; i < 20000; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        u32 bits = seed;
+        if ((bits & 0x7f800000u) == 0x7f800000u) {
+            continue;
+        }
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        const fl::string text = writeFloat(f);
+        JsonReader in(text.c_str());
+        REQUIRE_EQ(in.next(), JsonReader::kNumber);
+        INFO(text.c_str());
+        // -0 is written as 0.
+        const u32 expected = (bits & 0x7fffffffu) ? bits : 0u;
+        REQUIRE_EQ(bitsOf(in.asFloat()), expected);
+    }
+}
+
+TEST_CASE("JsonWriter 64 bit integers and doubles") {
+    fl::string out;
+    JsonWriter json(&out);
+    json.beginArray();
+    json.value(i64(-9223372036854775807ll - 1));
+    json.value(u64(18446744073709551615ull));
+    json.value(i64(5000000000ll)).value(u8(200)).value(i16(-3));
+    json.value(0.1).value(1e300).value(-2.5e-320);
+    json.endArray();
+    CHECK_EQ(out, fl::string("[-9223372036854775808,18446744073709551615,"
+                             "5000000000,200,-3,0.1,1e300,-2.5e-320]"));
+
+    // Every double written reads back to the same bits.
+    u64 seed = 1;
+    for (int i = 0; i < 20000; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        const u64 bits = seed;
+        if ((bits & 0x7ff0000000000000ull) == 0x7ff0000000000000ull) {
+            continue;
+        }
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        fl::string text;
+        JsonWriter writer(&text);
+        writer.value(d);
+        JsonReader in(text.c_str());
+        REQUIRE_EQ(in.next(), JsonReader::kNumber);
+        INFO(text.c_str());
+        const double back = in.asDouble();
+        u64 backBits;
+        memcpy(&backBits, &back, sizeof(backBits));
+        const u64 expected = (bits << 1) ? bits : 0u;
+        REQUIRE_EQ(backBits, expected);
+    }
+}
+
+TEST_CASE("JsonWriter number formatting without a wide long double") {
+    // What targets without FASTLED_JSON_LONG_DOUBLE run: floats still get
+    // the shortest form, doubles a fixed 17 digits.
+    char text[32];
+    json_detail::formatFloat<double>(0.1f, text);
+    CHECK_EQ(fl::string(text), fl::string("0.1"));
+    json_detail::formatFloat<double>(-3.4e38f, text);
+    CHECK_EQ(fl::string(text), fl::string("-3.4e38"));
+    json_detail::formatDouble<double>(0.5, text);
+    CHECK_EQ(fl::string(text), fl::string("0.5"));
+    json_detail::formatDouble<double>(0.1, text);
+    CHECK_EQ(fl::string(text), fl::string("0.1"));
+
+    u32 seed = 1;
+    for (int i = 0; i < 20000; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const u32 bits = seed;
+        if ((bits & 0x7f800000u) == 0x7f800000u || (bits << 1) == 0) {
+            continue;
+        }
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        json_detail::formatFloat<double>(f, text);
+        INFO(text);
+        JsonReader in(text);
+        REQUIRE_EQ(in.next(), JsonReader::kNumber);
+        REQUIRE_EQ(bitsOf(in.asFloat()), bits);
+        // No more digits than the long double search finds.
+        char wide[32];
+        json_detail::formatFloat<long double>(f, wide);
+        REQUIRE(strlen(text) <= strlen(wide));
+    }
+
+    u64 seed64 = 1;
+    for (int i = 0; i < 20000; ++i) {
+        seed64 = seed64 * 6364136223846793005ull + 1442695040888963407ull;
+        const u64 bits = seed64;
+        if ((bits & 0x7ff0000000000000ull) == 0x7ff0000000000000ull ||
+            (bits << 1) == 0) {
+            continue;
+        }
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        json_detail::formatDouble<double>(d, text);
+        INFO(text);
+        // A few ulp from the exact value of the text, the scaling by powers
+        // of ten rounds in double.
+        const double back = strtod(text, nullptr);
+        u64 backBits;
+        memcpy(&backBits, &back, sizeof(backBits));
+        const u64 diff = backBits > bits ? backBits - bits : bits - backBits;
+        REQUIRE(diff <= 8);
+    }
+}
+
+TEST_CASE("JsonReader tokens") {
+    const char *json = " {\"a\": [1, -2.5e1, \"x\\u00e9\\n\"], \"b\": {\"c\": "
+                       "[[true]], \"d\": null}, \"e\": false} ";
+    JsonReader in(json);
+    CHECK_EQ(in.next(), JsonReader::kBeginObject);
+    CHECK_EQ(in.next(), JsonReader::kKey);
+    CHECK(in.keyIs("a"));
+    CHECK_FALSE(in.keyIs("ab"));
+    CHECK_EQ(in.next(), JsonReader::kBeginArray);
+    CHECK_EQ(in.next(), JsonReader::kNumber);
+    CHECK_EQ(in.asInt(), 1);
+    CHECK_EQ(in.next(), JsonReader::kNumber);
+    CHECK_EQ(in.asInt(), -25);
+    CHECK_EQ(in.next(), JsonReader::kString);
+    fl::string decoded;
+    in.decodeString(&decoded);
+    CHECK_EQ(decoded, fl::string("x\xc3\xa9\n"));
+
+    // A surrogate pair is one 4 byte code point, a lone half is malformed.
+    JsonReader pair("\"\\ud83d\\ude00 \\udc00\"");
+    REQUIRE_EQ(pair.next(), JsonReader::kString);
+    fl::string emoji;
+    pair.decodeString(&emoji);
+    CHECK_EQ(emoji, fl::string("\xf0\x9f\x98\x80 ?"));
+    CHECK_EQ(in.next(), JsonReader::kEndArray);
+    CHECK_EQ(in.next(), JsonReader::kKey);
+    CHECK(in.keyIs("b"));
+    CHECK(in.skip());
+    CHECK_EQ(in.depth(), 1);
+    CHECK_EQ(in.next(), JsonReader::kKey);
+    CHECK(in.keyIs("e"));
+    CHECK_EQ(in.next(), JsonReader::kBool);
+    CHECK_FALSE(in.asBool());
+    CHECK_EQ(in.next(), JsonReader::kEndObject);
+    CHECK_EQ(in.next(), JsonReader::kEnd);
+    CHECK_EQ(in.next(), JsonReader::kEnd);
+}
+
+TEST_CASE("JsonReader rejects bad input") {
+    const char *bad[] = {"[1,]",   "{\"a\" 1}", "{\"a\":1,}", "[1 2]",
+                         "\"abc",  "[01]",      "[1.]",      "[tru]",
+                         "{1: 2}", "[1]]",      "",          "[-]"};
+    for (const char *json : bad) {
+        JsonReader in(json);
+        JsonReader::Token t = in.next();
+        while (t != JsonReader::kEnd && t != JsonReader::kError) {
+            t = in.next();
+        }
+        INFO(json);
+        CHECK_EQ(t, JsonReader::kError);
+    }
+}
+
+TEST_CASE("ScreenMap streams json") {
+    fl::FixedMap<fl::string, ScreenMap, 16> maps;
+    maps.insert("ring", ScreenMap::Circle(24, 1.5f, 0.3f));
+    ScreenMap line(3);
+    line.set(0, {0.1f, -7.25f});
+    line.set(1, {1e-3f, 12345.5f});
+    line.set(2, {3.0f, 0.0f});
+    maps.insert("line", line);
+
+    fl::string json;
+    ScreenMap::toJsonStr(maps, &json);
+    fl::FixedMap<fl::string, ScreenMap, 16> parsed;
+    REQUIRE(ScreenMap::ParseJson(json.c_str(), &parsed));
+    REQUIRE_EQ(parsed.size(), 2u);
+    for (auto kv : maps) {
+        ScreenMap &copy = parsed[kv.first];
+        REQUIRE_EQ(copy.getLength(), kv.second.getLength());
+        for (u32 i = 0; i < copy.getLength(); ++i) {
+            CHECK_EQ(bitsOf(copy[i].x), bitsOf(kv.second[i].x));
+            CHECK_EQ(bitsOf(copy[i].y), bitsOf(kv.second[i].y));
+        }
+    }
+    CHECK_EQ(bitsOf(parsed["ring"].getDiameter()), bitsOf(0.3f));
+    CHECK_EQ(bitsOf(parsed["line"].getDiameter()), bitsOf(0.5f));
+
+    // The same text written into a fixed buffer.
+    char buf[2048];
+    JsonWriter out(buf, sizeof(buf));
+    ScreenMap::toJson(maps, &out);
+    CHECK(out.ok());
+    CHECK_EQ(fl::string(buf), json);
+
+    fl::string err;
+    CHECK_FALSE(ScreenMap::ParseJson("{\"map\": {\"a\": {\"x\": [1,}}}",
+                                     &parsed, &err));
+    CHECK(err.size() > 0);
+}
@@ -380,6 +380,89 @@ TEST_CASE("JsonUiManager executeUiUpdates") {
     setJsonUiHandlers(fl::function<void(const char*)>());
 }
 
+TEST_CASE("JsonUiManager sends only changed fields") {
+    fl::vector<fl::string> sent;
+    auto callback = [&](const char* json) { sent.push_back(json); };
+    auto updateEngineState = setJsonUiHandlers(callback);
+
+    JsonSliderImpl slider("delta_slider", 25.0f, 0.0f, 100.0f, 1.0f);
+    JsonCheckboxImpl checkbox("delta_checkbox", false);
+
+    // New components go out as the full list.
+    processJsonUiPendingUpdates();
+    REQUIRE_EQ(sent.size(), 1u);
+    FLArduinoJson::JsonDocument full;
+    deserializeJson(full, sent[0].c_str());
+    CHECK(full.is<FLArduinoJson::JsonArray>());
+    CHECK_EQ(full.as<FLArduinoJson::JsonArray>().size(), 2u);
+
+    // Nothing changed, nothing sent.
+    processJsonUiPendingUpdates();
+    CHECK_EQ(sent.size(), 1u);
+
+    // A value set from the sketch goes out as just that field.
+    slider.setValue(80.0f);
+    processJsonUiPendingUpdates();
+    REQUIRE_EQ(sent.size(), 2u);
+    FLArduinoJson::JsonDocument delta;
+    deserializeJson(delta, sent[1].c_str());
+    fl::string sliderId;
+    sliderId.append(slider.id());
+    auto obj = delta.as<FLArduinoJson::JsonObjectConst>();
+    CHECK_EQ(obj.size(), 1u);
+    auto fields = obj[sliderId.c_str()].as<FLArduinoJson::JsonObjectConst>();
+    CHECK_EQ(fields.size(), 1u);
+    CHECK_CLOSE(fields["value"].as<float>(), 80.0f, 0.001f);
+
+    // Updates from the frontend, by id and by name, are not echoed back.
+    fl::string update = "{\"" + sliderId + "\": 10, \"delta_checkbox\": true}";
+    updateEngineState(update.c_str());
+    processJsonUiPendingUpdates();
+    CHECK_CLOSE(slider.value(), 10.0f, 0.001f);
+    CHECK(checkbox.value());
+    CHECK_EQ(sent.size(), 2u);
+
+    // Setting it back to what the sketch sent before is still a change.
+    slider.setValue(80.0f);
+    processJsonUiPendingUpdates();
+    CHECK_EQ(sent.size(), 3u);
+
+    setJsonUiHandlers(fl::function<void(const char*)>());
+}
+
+TEST_CASE("JsonUiManager forgets the sent state of removed components") {
+    int sends = 0;
+    JsonUiManager manager([&](const char *) { ++sends; });
+    float value = 1.0f;
+    auto toJsonFunc = [&](FLArduinoJson::JsonObject &json) {
+        json["name"] = "removed";
+        json["value"] = value;
+    };
+    JsonUiInternalPtr internal = JsonUiInternalPtr::New(
+        "removed", JsonUiInternal::UpdateFunction(), toJsonFunc);
+    fl::WeakPtr<JsonUiInternal> weak = internal;
+    manager.addComponent(weak);
+    manager.processPendingUpdates();
+    CHECK_EQ(sends, 1);
+    CHECK_EQ(manager.sentStateSize(), 1u);
+
+    // Unchanged fields are compared against the remembered state.
+    internal->markChanged();
+    manager.processPendingUpdates();
+    CHECK_EQ(sends, 1);
+    value = 2.0f;
+    internal->markChanged();
+    manager.processPendingUpdates();
+    CHECK_EQ(sends, 2);
+
+    // Removed after the component is gone, as from its destructor.
+    internal->clearFunctions();
+    internal.reset();
+    CHECK_FALSE(weak.lock());
+    manager.removeComponent(weak);
+    CHECK_EQ(manager.sentStateSize(), 0u);
+}
+
 TEST_CASE("JsonUiManager multiple components basic") {
     bool callbackCalled = false;
     fl::string receivedJson;
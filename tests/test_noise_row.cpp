@@ -0,0 +1,67 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "fl/stdint.h"
+#include "noise.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+namespace {
+
+uint32_t nextRandom(uint32_t *seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return *seed;
+}
+
+} // namespace
+
+TEST_CASE("inoise16_row matches inoise16") {
+    // Steps from well inside one lattice cell per sample to several cells
+    // per sample, both directions, and counts that leave a partial batch.
+    const int32_t steps[] = {0, 1, 97, 2000, 8191, 65536, 300000, -2000, -70001};
+    uint32_t seed = 1;
+    uint16_t row[37];
+    for (int32_t dx : steps) {
+        for (int trial = 0; trial < 40; ++trial) {
+            const uint32_t x = nextRandom(&seed);
+            const uint32_t y = nextRandom(&seed);
+            const uint32_t z = nextRandom(&seed);
+            const int count = 1 + int(nextRandom(&seed) % 37);
+            inoise16_row(row, count, x, dx, y, z);
+            for (int i = 0; i < count; ++i) {
+                const uint32_t xi = x + uint32_t(i) * uint32_t(dx);
+                REQUIRE_EQ(row[i], inoise16(xi, y, z));
+            }
+        }
+    }
+}
+
+TEST_CASE("inoise8_row matches inoise8") {
+    const int16_t steps[] = {0, 1, 13, 100, 255, 256, 1000, -37, -300};
+    uint32_t seed = 7;
+    uint8_t row[37];
+    for (int16_t dx : steps) {
+        for (int trial = 0; trial < 40; ++trial) {
+            const uint16_t x = uint16_t(nextRandom(&seed) >> 16);
+            const uint16_t y = uint16_t(nextRandom(&seed) >> 16);
+            const uint16_t z = uint16_t(nextRandom(&seed) >> 16);
+            const int count = 1 + int(nextRandom(&seed) % 37);
+            inoise8_row(row, count, x, dx, y, z);
+            for (int i = 0; i < count; ++i) {
+                const uint16_t xi = uint16_t(x + i * dx);
+                REQUIRE_EQ(row[i], inoise8(xi, y, z));
+            }
+        }
+    }
+
+    // Every fractional x against the lattice corners of one cell.
+    uint8_t full[256];
+    for (uint16_t yz : {uint16_t(0), uint16_t(0x80ff), uint16_t(0x1234)}) {
+        inoise8_row(full, 256, 0x4200, 1, yz, uint16_t(~yz));
+        for (int i = 0; i < 256; ++i) {
+            REQUIRE_EQ(full[i], inoise8(uint16_t(0x4200 + i), yz, uint16_t(~yz)));
+        }
+    }
+}
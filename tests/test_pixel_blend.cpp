@@ -0,0 +1,128 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "fl/pixel_blend.h"
+#include "fl/vector.h"
+#include "lib8tion/math8.h"
+#include "lib8tion/scale8.h"
+
+using namespace fl;
+
+namespace {
+
+// Every (lower, upper) byte pair, laid out as flat pixel buffers so the
+// batched kernel sees the full range in both the vector body and the tail.
+struct AllPairs {
+    fl::vector<CRGB> lower;
+    fl::vector<CRGB> upper;
+    AllPairs() {
+        const fl::u32 numPixels = (256 * 256 + 2) / 3;
+        lower.resize(numPixels);
+        upper.resize(numPixels);
+        fl::u8 *lo = reinterpret_cast<fl::u8 *>(lower.data());
+        fl::u8 *up = reinterpret_cast<fl::u8 *>(upper.data());
+        for (fl::u32 i = 0; i < numPixels * 3; ++i) {
+            lo[i] = static_cast<fl::u8>(i >> 8);
+            up[i] = static_cast<fl::u8>(i & 0xff);
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE("blendChannel reference modes") {
+    CHECK_EQ(blendChannel(100, 200, BLEND_MODE_ALPHA, 255), 200);
+    CHECK_EQ(blendChannel(100, 200, BLEND_MODE_ADD, 255), 255);
+    CHECK_EQ(blendChannel(100, 20, BLEND_MODE_ADD, 255), 120);
+    CHECK_EQ(blendChannel(255, 255, BLEND_MODE_MULTIPLY, 255), 255);
+    CHECK_EQ(blendChannel(200, 0, BLEND_MODE_MULTIPLY, 255), 0);
+    CHECK_EQ(blendChannel(0, 0, BLEND_MODE_SCREEN, 255), 0);
+    CHECK_EQ(blendChannel(0, 255, BLEND_MODE_SCREEN, 255), 255);
+    CHECK_EQ(blendChannel(10, 200, BLEND_MODE_MAX, 255), 200);
+    CHECK_EQ(blendChannel(210, 200, BLEND_MODE_MAX, 255), 210);
+    // Opacity 0 leaves the lower value untouched for every mode.
+    CHECK_EQ(blendChannel(42, 200, BLEND_MODE_ADD, 0), 42);
+    CHECK_EQ(blendChannel(42, 200, BLEND_MODE_SCREEN, 0), 42);
+}
+
+TEST_CASE("blendPixels alpha matches CRGB::blend") {
+    AllPairs pairs;
+    const fl::u8 opacities[] = {1, 64, 128, 200, 254};
+    for (fl::u8 opacity : opacities) {
+        fl::vector<CRGB> out = pairs.lower;
+        blendPixels(out.data(), pairs.upper.data(), out.size(),
+                    BLEND_MODE_ALPHA, opacity);
+        for (fl::size i = 0; i < out.size(); ++i) {
+            CRGB expected =
+                CRGB::blend(pairs.lower[i], pairs.upper[i], opacity);
+            if (out[i] != expected) {
+                FAIL("pixel " << i << " opacity " << int(opacity));
+            }
+        }
+    }
+}
+
+TEST_CASE("blendPixels batched kernel is bit exact with blendChannel") {
+    AllPairs pairs;
+    const BlendMode modes[] = {BLEND_MODE_ALPHA, BLEND_MODE_ADD,
+                               BLEND_MODE_MULTIPLY, BLEND_MODE_SCREEN,
+                               BLEND_MODE_MAX};
+    const fl::u8 opacities[] = {0, 1, 77, 128, 254, 255};
+    for (BlendMode mode : modes) {
+        for (fl::u8 opacity : opacities) {
+            fl::vector<CRGB> out = pairs.lower;
+            blendPixels(out.data(), pairs.upper.data(), out.size(), mode,
+                        opacity);
+            const fl::u8 *lo =
+                reinterpret_cast<const fl::u8 *>(pairs.lower.data());
+            const fl::u8 *up =
+                reinterpret_cast<const fl::u8 *>(pairs.upper.data());
+            const fl::u8 *got = reinterpret_cast<const fl::u8 *>(out.data());
+            for (fl::size i = 0; i < out.size() * 3; ++i) {
+                fl::u8 expected = blendChannel(lo[i], up[i], mode, opacity);
+                if (got[i] != expected) {
+                    FAIL("mode " << int(mode) << " opacity " << int(opacity)
+                                 << " lower " << int(lo[i]) << " upper "
+                                 << int(up[i]) << " got " << int(got[i])
+                                 << " expected " << int(expected));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("compositeLayers stacks layers bottom to top") {
+    const fl::u32 kNumLeds = 37; // Not a multiple of the tile size.
+    fl::vector<CRGB> base(kNumLeds, CRGB(100, 0, 50));
+    fl::vector<CRGB> add(kNumLeds, CRGB(100, 10, 0));
+    fl::vector<CRGB> mul(kNumLeds, CRGB(128, 255, 0));
+    fl::vector<CRGB> out(kNumLeds, CRGB(1, 2, 3));
+
+    BlendLayer layers[3];
+    layers[0].pixels = base.data();
+    layers[1].pixels = add.data();
+    layers[1].mode = BLEND_MODE_ADD;
+    layers[2].pixels = mul.data();
+    layers[2].mode = BLEND_MODE_MULTIPLY;
+
+    compositeLayers(out.data(), layers, 3, kNumLeds);
+
+    CRGB expected = base[0];
+    for (int c = 0; c < 3; ++c) {
+        expected.raw[c] = qadd8(expected.raw[c], add[0].raw[c]);
+        expected.raw[c] = scale8(expected.raw[c], mul[0].raw[c]);
+    }
+    for (fl::u32 i = 0; i < kNumLeds; ++i) {
+        REQUIRE_EQ(out[i], expected);
+    }
+
+    SUBCASE("null and transparent layers are skipped") {
+        layers[1].pixels = nullptr;
+        layers[2].opacity = 0;
+        compositeLayers(out.data(), layers, 3, kNumLeds);
+        for (fl::u32 i = 0; i < kNumLeds; ++i) {
+            REQUIRE_EQ(out[i], base[i]);
+        }
+    }
+}
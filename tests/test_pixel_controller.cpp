@@ -0,0 +1,119 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "fl/vector.h"
+#include "pixel_controller.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+namespace {
+
+ColorAdjustment makeAdjustment(CRGB premixed) {
+    ColorAdjustment adj;
+    adj.premixed = premixed;
+#if FASTLED_HD_COLOR_MIXING
+    adj.color = CRGB(255, 255, 255);
+    adj.brightness = 255;
+#endif
+    return adj;
+}
+
+void fillPattern(fl::vector<CRGB> *leds) {
+    for (fl::size i = 0; i < leds->size(); ++i) {
+        (*leds)[i] = CRGB(fl::u8(i * 7), fl::u8(i * 13 + 1), fl::u8(255 - i));
+    }
+    (*leds)[0] = CRGB(0, 0, 0); // Zero stays zero under dither.
+}
+
+// The per pixel loop that drivers used before the batch API.
+template <typename PixelControllerT>
+void perPixelRGB(PixelControllerT &pixels, fl::u8 *out) {
+    while (pixels.has(1)) {
+        pixels.loadAndScaleRGB(out, out + 1, out + 2);
+        out += 3;
+        pixels.advanceData();
+        pixels.stepDithering();
+    }
+}
+
+template <EOrder ORDER> void checkBatchMatchesPerPixel(int numLeds) {
+    fl::vector<CRGB> leds(numLeds);
+    fillPattern(&leds);
+    const ColorAdjustment adj = makeAdjustment(CRGB(200, 100, 37));
+    PixelController<ORDER> a(leds.data(), numLeds, adj, BINARY_DITHER);
+    PixelController<ORDER> b(a); // Same dither phase.
+    fl::vector<fl::u8> expected(numLeds * 3);
+    fl::vector<fl::u8> actual(numLeds * 3);
+    perPixelRGB(a, expected.data());
+    REQUIRE_EQ(b.loadAndScaleRGBBatch(actual.data()), numLeds * 3);
+    for (int i = 0; i < numLeds * 3; ++i) {
+        REQUIRE_EQ(int(actual[i]), int(expected[i]));
+    }
+    // Same state as the loop, so a driver can keep going afterwards.
+    CHECK_FALSE(b.has(1));
+    CHECK_EQ(b.mData, a.mData);
+    for (int c = 0; c < 3; ++c) {
+        CHECK_EQ(b.d[c], a.d[c]);
+    }
+}
+
+} // namespace
+
+TEST_CASE("PixelController batch RGB matches per pixel output") {
+    checkBatchMatchesPerPixel<RGB>(1);
+    checkBatchMatchesPerPixel<RGB>(64);
+    checkBatchMatchesPerPixel<GRB>(257);
+    checkBatchMatchesPerPixel<BRG>(300);
+}
+
+TEST_CASE("PixelController batch RGBW matches per pixel output") {
+    const int numLeds = 33;
+    fl::vector<CRGB> leds(numLeds);
+    fillPattern(&leds);
+    const ColorAdjustment adj = makeAdjustment(CRGB(255, 240, 200));
+    Rgbw rgbw(kRGBWDefaultColorTemp, kRGBWExactColors, W3);
+    PixelController<GRB> a(leds.data(), numLeds, adj, BINARY_DITHER);
+    PixelController<GRB> b(a);
+    fl::vector<fl::u8> expected(numLeds * 4);
+    fl::vector<fl::u8> actual(numLeds * 4);
+    fl::u8 *out = expected.data();
+    while (a.has(1)) {
+        a.loadAndScaleRGBW(rgbw, out, out + 1, out + 2, out + 3);
+        out += 4;
+        a.advanceData();
+        a.stepDithering();
+    }
+    // The iterator goes through the same batch path.
+    PixelIterator it = b.as_iterator(rgbw);
+    REQUIRE_EQ(it.loadAndScaleBatch(actual.data()), numLeds * 4);
+    for (int i = 0; i < numLeds * 4; ++i) {
+        REQUIRE_EQ(int(actual[i]), int(expected[i]));
+    }
+    CHECK_FALSE(it.has(1));
+}
+
+TEST_CASE("PixelController batch RGB matches the scalar iterator") {
+    const int numLeds = 10000;
+    fl::vector<CRGB> leds(numLeds);
+    fillPattern(&leds);
+    const ColorAdjustment adj = makeAdjustment(CRGB(200, 180, 160));
+    PixelController<GRB> a(leds.data(), numLeds, adj, BINARY_DITHER);
+    PixelController<GRB> b(a);
+    fl::vector<fl::u8> expected(numLeds * 3);
+    fl::vector<fl::u8> actual(numLeds * 3);
+    PixelIterator it = a.as_iterator(RgbwInvalid());
+    fl::u8 *dst = expected.data();
+    while (it.has(1)) {
+        it.loadAndScaleRGB(dst, dst + 1, dst + 2);
+        dst += 3;
+        it.advanceData();
+        it.stepDithering();
+    }
+    REQUIRE_EQ(b.loadAndScaleRGBBatch(actual.data()), numLeds * 3);
+    for (int i = 0; i < numLeds * 3; ++i) {
+        REQUIRE_EQ(int(actual[i]), int(expected[i]));
+    }
+}
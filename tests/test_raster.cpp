@@ -4,6 +4,7 @@
 #include "test.h"
 
 #include "FastLED.h"
+#include "fl/draw_visitor.h"
 #include "fl/raster.h"
 #include "fl/tile2x2.h"
 #include "fl/xypath.h"
@@ -30,3 +31,153 @@ TEST_CASE("XYRasterU8SparseTest should match bounds of pixels draw area") {
     auto pixel_bounds = raster.bounds_pixels();
     REQUIRE_EQ(rect<uint16_t>(0, 0, 4, 4), pixel_bounds);
 }
+
+namespace {
+
+fl::vector<Tile2x2_u8> randomTiles(int count, int width, int height) {
+    fl::vector<Tile2x2_u8> tiles;
+    u32 seed = 7;
+    for (int i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        Tile2x2_u8 tile(vec2<i16>(i16((seed >> 8) % (width + 2)) - 1,
+                                  i16((seed >> 20) % (height + 2)) - 1));
+        for (int k = 0; k < 4; ++k) {
+            tile.at(k & 1, k >> 1) = u8(seed >> (k * 8));
+        }
+        tiles.push_back(tile);
+    }
+    return tiles;
+}
+
+} // namespace
+
+TEST_CASE("XYRasterU8Sparse dense storage keeps the max per pixel") {
+    const int w = 24;
+    const int h = 20;
+    fl::vector<Tile2x2_u8> tiles = randomTiles(400, w, h);
+
+    XYRasterU8Sparse raster(w, h);
+    REQUIRE(raster.isDense());
+    // Reference over the panel plus the border the tiles can reach.
+    u8 expected[h + 3][w + 3] = {};
+    for (const Tile2x2_u8 &tile : tiles) {
+        raster.rasterize(tile);
+        for (int k = 0; k < 4; ++k) {
+            const int x = tile.origin().x + (k & 1) + 1;
+            const int y = tile.origin().y + (k >> 1) + 1;
+            const u8 v = tile.at(k & 1, k >> 1);
+            if (v > expected[y][x]) {
+                expected[y][x] = v;
+            }
+        }
+    }
+    fl::size count = 0;
+    for (int y = 0; y < h + 3; ++y) {
+        for (int x = 0; x < w + 3; ++x) {
+            count += expected[y][x] ? 1 : 0;
+        }
+    }
+    CHECK_EQ(raster.size(), count);
+
+    // Splats hanging off the panel edges are kept sparse, iteration covers
+    // both.
+    fl::size visited = 0;
+    for (const auto &it : raster) {
+        CHECK_EQ(it.second, expected[it.first.y + 1][it.first.x + 1]);
+        ++visited;
+    }
+    CHECK_EQ(visited, count);
+
+    XYMap xymap = XYMap::constructRectangularGrid(w, h);
+    CRGB out[w * h];
+    CRGB ref[w * h];
+    fill_solid(out, w * h, CRGB::Black);
+    fill_solid(ref, w * h, CRGB::Black);
+    raster.draw(CRGB(255, 128, 0), xymap, out);
+    XYDrawComposited visitor(CRGB(255, 128, 0), xymap, ref);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            const u8 v = expected[y + 1][x + 1];
+            CHECK_EQ(raster.at(x, y).second, v);
+            if (v) {
+                visitor.draw(vec2<i16>(x, y), xymap(x, y), v);
+            }
+        }
+    }
+    for (int i = 0; i < w * h; ++i) {
+        CHECK_EQ(out[i], ref[i]);
+    }
+
+    raster.clear();
+    CHECK(raster.empty());
+    CHECK(raster.isDense());
+    CHECK_FALSE(raster.at(3, 3).first);
+}
+
+TEST_CASE("XYRasterU8Sparse goes dense for a covered footprint") {
+    XYRasterU8Sparse raster;
+    for (int y = 10; y < 30; ++y) {
+        for (int x = 5; x < 25; x += 2) {
+            raster.rasterize(vec2<i16>(x, y), u8(x + y));
+        }
+    }
+    CHECK(raster.isDense());
+    CHECK(raster.denseBounds().contains(5, 10));
+    CHECK_EQ(raster.size(), 200u);
+    CHECK_EQ(raster.bounds_pixels(), rect<i16>(5, 10, 24, 30));
+    CHECK_EQ(raster.at(7, 12).second, 19);
+    // A far away pixel is not worth growing the grid for.
+    raster.rasterize(vec2<i16>(500, 500), 9);
+    CHECK(raster.isDense());
+    CHECK_EQ(raster.at(500, 500).second, 9);
+    CHECK_EQ(raster.bounds_pixels(), rect<i16>(5, 10, 501, 501));
+
+    // Without fixed bounds the next frame starts over.
+    raster.clear();
+    CHECK_FALSE(raster.isDense());
+    raster.rasterize(vec2<i16>(0, 0), 1);
+    CHECK_EQ(raster.size(), 1u);
+
+    // Cleared bounds fall back to the pixels, and go sparse on reset.
+    raster.setSize(16, 16);
+    CHECK_EQ(raster.bounds(), rect<i16>(0, 0, 16, 16));
+    raster.clearBounds();
+    CHECK_EQ(raster.bounds(), rect<i16>(0, 0, 1, 1));
+    raster.clear();
+    CHECK_FALSE(raster.isDense());
+}
+
+TEST_CASE("XYRasterU8Sparse iterators write through and keep zeros") {
+    // One raster with a dense grid and a sparse pixel off the panel, one
+    // purely sparse.
+    XYRasterU8Sparse dense(8, 8);
+    XYRasterU8Sparse sparse;
+    XYRasterU8Sparse *rasters[] = {&dense, &sparse};
+    for (XYRasterU8Sparse *raster : rasters) {
+        raster->rasterize(vec2<i16>(2, 3), 0);
+        raster->rasterize(vec2<i16>(4, 5), 40);
+        raster->rasterize(vec2<i16>(20, 1), 60);
+        // Writing 0 counts as written, on the dense grid too.
+        CHECK_EQ(raster->size(), 3u);
+        CHECK(raster->at(2, 3).first);
+        CHECK_EQ(raster->at(2, 3).second, 0);
+        CHECK_FALSE(raster->at(2, 4).first);
+
+        for (auto &it : *raster) {
+            it.second = u8(it.second + 1);
+        }
+        CHECK_EQ(raster->at(2, 3).second, 1);
+        CHECK_EQ(raster->at(4, 5).second, 41);
+        CHECK_EQ(raster->at(20, 1).second, 61);
+
+        const XYRasterU8Sparse &view = *raster;
+        fl::size visited = 0;
+        for (const auto &it : view) {
+            CHECK(it.second > 0);
+            ++visited;
+        }
+        CHECK_EQ(visited, 3u);
+    }
+    CHECK(dense.isDense());
+    CHECK_FALSE(sparse.isDense());
+}
@@ -0,0 +1,171 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include <math.h>
+
+#include "FastLED.h"
+#include "fl/corkscrew.h"
+#include "fl/grid.h"
+#include "fl/resampler.h"
+#include "fl/screenmap.h"
+#include "fl/vector.h"
+
+using namespace fl;
+
+namespace {
+
+CRGB pixelAt(u16 x, u16 y) { return CRGB(x * 17 + y, y * 29 + 3, x ^ y); }
+
+fl::vector<CRGB> makeCanvas(u16 width, u16 height) {
+    fl::vector<CRGB> canvas(width * height);
+    for (u16 y = 0; y < height; ++y) {
+        for (u16 x = 0; x < width; ++x) {
+            canvas[y * width + x] = pixelAt(x, y);
+        }
+    }
+    return canvas;
+}
+
+// Float bilinear sample of one channel, the reference for apply().
+float sample(const fl::vector<CRGB> &canvas, u16 width, float x, float y,
+             int channel) {
+    const int x0 = int(floorf(x));
+    const int y0 = int(floorf(y));
+    const float fx = x - x0;
+    const float fy = y - y0;
+    auto at = [&](int px, int py) {
+        return float(canvas[py * width + px].raw[channel]);
+    };
+    return at(x0, y0) * (1 - fx) * (1 - fy) + at(x0 + 1, y0) * fx * (1 - fy) +
+           at(x0, y0 + 1) * (1 - fx) * fy + at(x0 + 1, y0 + 1) * fx * fy;
+}
+
+} // namespace
+
+TEST_CASE("CanvasResampler samples pixels and blends between them") {
+    const u16 w = 8;
+    const u16 h = 6;
+    const fl::vector<CRGB> canvas = makeCanvas(w, h);
+    ScreenMap map(5);
+    map.set(0, {3, 2});        // on a pixel
+    map.set(1, {3.5f, 2});     // between two
+    map.set(2, {1.5f, 4.5f});  // between four
+    map.set(3, {7.5f, 5});     // half off the right edge
+    map.set(4, {-3, 20});      // off the canvas
+    CanvasResampler resampler(map, w, h);
+    CHECK_EQ(resampler.size(), 5u);
+    CHECK_EQ(resampler.taps(), 1u + 2u + 4u + 1u);
+
+    CRGB leds[5];
+    resampler.apply(canvas.data(), leds);
+    CHECK_EQ(leds[0], pixelAt(3, 2));
+    for (int c = 0; c < 3; ++c) {
+        const int a = pixelAt(3, 2).raw[c];
+        const int b = pixelAt(4, 2).raw[c];
+        CHECK_EQ(leds[1].raw[c], (a + b + 1) / 2);
+    }
+    CHECK_EQ(leds[3], pixelAt(7, 5));
+    CHECK_EQ(leds[4], CRGB::Black);
+
+    // Wrapping joins the last column to the first.
+    CanvasResampler cylinder(map, w, h, true);
+    cylinder.apply(canvas.data(), leds);
+    for (int c = 0; c < 3; ++c) {
+        const int a = pixelAt(7, 5).raw[c];
+        const int b = pixelAt(0, 5).raw[c];
+        CHECK_EQ(leds[3].raw[c], (a + b + 1) / 2);
+    }
+}
+
+TEST_CASE("CanvasResampler matches float bilinear sampling") {
+    const u16 w = 20;
+    const u16 h = 13;
+    const fl::vector<CRGB> canvas = makeCanvas(w, h);
+    ScreenMap map(500);
+    u32 seed = 9;
+    for (u16 i = 0; i < 500; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const float x = float(seed >> 8) / float(1 << 24) * (w - 1);
+        seed = seed * 1664525u + 1013904223u;
+        const float y = float(seed >> 8) / float(1 << 24) * (h - 1);
+        map.set(i, {x, y});
+    }
+    CanvasResampler resampler(map, w, h);
+    CHECK(resampler.taps() <= 4 * 500u);
+    fl::vector<CRGB> leds(500);
+    resampler.apply(canvas.data(), leds.data());
+    for (u16 i = 0; i < 500; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            const float expected = sample(canvas, w, map[i].x, map[i].y, c);
+            REQUIRE(fabsf(leds[i].raw[c] - expected) <= 1.5f);
+        }
+    }
+}
+
+TEST_CASE("CanvasResampler fits a ring onto the canvas") {
+    const ScreenMap ring = ScreenMap::Circle(60);
+    CanvasResampler resampler = CanvasResampler::fit(ring, 32, 24);
+    CHECK_EQ(resampler.size(), 60u);
+    CHECK_EQ(resampler.width(), 32);
+    CHECK_EQ(resampler.height(), 24);
+
+    // A solid canvas comes out unchanged at every LED.
+    fl::vector<CRGB> canvas(32 * 24, CRGB(200, 10, 99));
+    CRGB leds[60];
+    resampler.apply(canvas.data(), leds);
+    for (const CRGB &led : leds) {
+        REQUIRE_EQ(led, CRGB(200, 10, 99));
+    }
+
+    // The ring spans the full height and is centered horizontally, so the
+    // top row and the middle columns are reached.
+    for (u16 y = 0; y < 24; ++y) {
+        for (u16 x = 0; x < 32; ++x) {
+            canvas[y * 32 + x] = CRGB(x * 8, y * 10, 0);
+        }
+    }
+    resampler.apply(canvas.data(), leds);
+    u8 minX = 255, maxX = 0, maxY = 0;
+    for (const CRGB &led : leds) {
+        minX = led.r < minX ? led.r : minX;
+        maxX = led.r > maxX ? led.r : maxX;
+        maxY = led.g > maxY ? led.g : maxY;
+    }
+    CHECK(maxY >= 225);
+    CHECK(minX >= 3 * 8);
+    CHECK(maxX <= 28 * 8);
+}
+
+TEST_CASE("Corkscrew readFrom goes through the resampler") {
+    Corkscrew::Input input(3.0f, 30);
+    Corkscrew corkscrew(input);
+    const u16 w = corkscrew.cylinder_width();
+    const u16 h = corkscrew.cylinder_height();
+    Grid<CRGB> grid(w, h);
+    for (u16 y = 0; y < h; ++y) {
+        for (u16 x = 0; x < w; ++x) {
+            grid(x, y) = pixelAt(x, y);
+        }
+    }
+    corkscrew.readFrom(grid);
+    fl::vector<CRGB> cached = corkscrew.getBuffer();
+
+    // Without caching the taps are worked out per LED, same result.
+    corkscrew.setCachingEnabled(false);
+    corkscrew.readFrom(grid);
+    for (u16 i = 0; i < 30; ++i) {
+        REQUIRE_EQ(corkscrew.getBuffer()[i], cached[i]);
+    }
+
+    // LEDs on whole pixels read that pixel, the first LED is always one.
+    int onPixel = 0;
+    for (u16 i = 0; i < 30; ++i) {
+        const vec2f p = corkscrew.at_exact(i);
+        if (p.x - floorf(p.x) <= 0.0f && p.y - floorf(p.y) <= 0.0f) {
+            CHECK_EQ(cached[i], pixelAt(u16(p.x), u16(p.y)));
+            ++onPixel;
+        }
+    }
+    CHECK(onPixel > 0);
+}
@@ -0,0 +1,24 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "fl/thread_pool.h"
+#include "fl/unused.h"
+
+TEST_CASE("Thread pool parallelFor") {
+    fl::ThreadPool pool(3);
+    int hits[100] = {};
+    for (int round = 0; round < 20; ++round) {
+        pool.parallelFor(100, [&](fl::u32 i) {
+            hits[i]++;
+            // Nested loops run inline on the calling worker.
+            pool.parallelFor(2, [&](fl::u32 j) { FASTLED_UNUSED(j); });
+        });
+    }
+    for (int i = 0; i < 100; ++i) {
+        CHECK_EQ(hits[i], 20);
+    }
+#if FASTLED_MULTITHREADED
+    CHECK_EQ(pool.numWorkers(), 3u);
+#endif
+}
@@ -0,0 +1,95 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "fl/upscale.h"
+#include "fl/vector.h"
+#include "fl/xymap.h"
+
+using namespace fl;
+
+namespace {
+
+fl::vector<CRGB> randomImage(u16 count, u32 seed) {
+    fl::vector<CRGB> image(count);
+    for (u16 i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        image[i] = CRGB(seed >> 24, seed >> 16, seed >> 8);
+    }
+    return image;
+}
+
+// The same layout as a look up table, which takes the per pixel path.
+XYMap asLookUpTable(const XYMap &map, fl::vector<u16> *table) {
+    const u16 width = map.getWidth();
+    const u16 height = map.getHeight();
+    table->resize(width * height);
+    for (u16 y = 0; y < height; ++y) {
+        for (u16 x = 0; x < width; ++x) {
+            (*table)[y * width + x] = map.mapToIndex(x, y);
+        }
+    }
+    return XYMap::constructWithLookUpTable(width, height, table->data());
+}
+
+} // namespace
+
+TEST_CASE("upscale row kernels match the per pixel path") {
+    struct Size {
+        u16 inputWidth, inputHeight, outputWidth, outputHeight;
+    };
+    // Input rows around the 16 byte steps of the vector kernels.
+    const Size sizes[] = {{2, 2, 5, 3},    {5, 6, 16, 16},  {6, 4, 11, 9},
+                          {16, 16, 32, 32}, {23, 7, 60, 20}, {3, 5, 3, 5}};
+    for (const Size &size : sizes) {
+        INFO(size.inputWidth << "x" << size.inputHeight << " -> "
+                             << size.outputWidth << "x" << size.outputHeight);
+        const fl::vector<CRGB> input =
+            randomImage(size.inputWidth * size.inputHeight, size.outputWidth);
+        const u16 total = size.outputWidth * size.outputHeight;
+        for (int serpentine = 0; serpentine < 2; ++serpentine) {
+            const XYMap map(size.outputWidth, size.outputHeight,
+                            serpentine != 0);
+            fl::vector<u16> table;
+            const XYMap lut = asLookUpTable(map, &table);
+            fl::vector<CRGB> expected(total);
+            fl::vector<CRGB> actual(total);
+            upscaleArbitrary(input.data(), expected.data(), size.inputWidth,
+                             size.inputHeight, lut);
+            upscaleArbitrary(input.data(), actual.data(), size.inputWidth,
+                             size.inputHeight, map);
+            for (u16 i = 0; i < total; ++i) {
+                REQUIRE_EQ(actual[i], expected[i]);
+            }
+            if (!serpentine) {
+                upscaleRectangular(input.data(), actual.data(),
+                                   size.inputWidth, size.inputHeight,
+                                   size.outputWidth, size.outputHeight);
+                for (u16 i = 0; i < total; ++i) {
+                    REQUIRE_EQ(actual[i], expected[i]);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("upscale keeps the corners and stays near the float version") {
+    const u16 inputWidth = 8;
+    const u16 inputHeight = 8;
+    const fl::vector<CRGB> input = randomImage(inputWidth * inputHeight, 5);
+    const XYMap map = XYMap::constructSerpentine(29, 17);
+    fl::vector<CRGB> fixed(map.getTotal());
+    fl::vector<CRGB> reference(map.getTotal());
+    upscale(input.data(), fixed.data(), inputWidth, inputHeight, map);
+    upscaleArbitraryFloat(input.data(), reference.data(), inputWidth,
+                          inputHeight, map);
+    CHECK_EQ(fixed[map.mapToIndex(0, 0)], input[0]);
+    CHECK_EQ(fixed[map.mapToIndex(28, 16)], input[inputWidth * inputHeight - 1]);
+    for (u16 i = 0; i < map.getTotal(); ++i) {
+        for (int c = 0; c < 3; ++c) {
+            const int diff = int(fixed[i].raw[c]) - int(reference[i].raw[c]);
+            REQUIRE(diff <= 2);
+            REQUIRE(diff >= -2);
+        }
+    }
+}
@@ -3,12 +3,17 @@
 
 #include "test.h"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <vector>
 
 #include "crgb.h"
 #include "fl/bytestreammemory.h"
 #include "fl/ptr.h"
 #include "fx/video.h"
+#include "fx/video/compressed_video.h"
+#include "fx/video/frame_prefetcher.h"
 #include "fx/video/pixel_stream.h"
 #include "lib8tion/intmap.h"
 #include "test.h"
@@ -229,4 +234,291 @@ TEST_CASE("video with end frame fadeout") {
         REQUIRE_EQ(leds[i], CRGB(4, 4, 4));
     }
     #endif  //
-}
\ No newline at end of file
+}
+
+namespace {
+
+// File with kFrames frames, every pixel of frame f is CRGB(10 * (f + 1), 0, 0).
+FakeFileHandlePtr makeNumberedFrames(uint32_t kFrames) {
+    FakeFileHandlePtr fileHandle = FakeFileHandlePtr::New();
+    CRGB led_frame[LEDS_PER_FRAME];
+    for (uint32_t f = 0; f < kFrames; f++) {
+        for (uint32_t i = 0; i < LEDS_PER_FRAME; i++) {
+            led_frame[i] = CRGB(10 * (f + 1), 0, 0);
+        }
+        fileHandle->writeCRGB(led_frame, LEDS_PER_FRAME);
+    }
+    return fileHandle;
+}
+
+} // namespace
+
+TEST_CASE("FramePrefetcher ring") {
+    const uint32_t kFrames = 8;
+    PixelStreamPtr stream = PixelStreamPtr::New(LEDS_PER_FRAME * 3);
+    stream->begin(makeNumberedFrames(kFrames));
+    // No worker, the test drives the reader with pump().
+    FramePrefetcherPtr prefetcher =
+        FramePrefetcherPtr::New(stream, LEDS_PER_FRAME, 3, false);
+    REQUIRE_EQ(kFrames, prefetcher->totalFrames());
+    CHECK_FALSE(prefetcher->threaded());
+
+    FramePtr frame;
+    CHECK_FALSE(prefetcher->take(0, true, &frame));
+    CHECK(prefetcher->pump());
+    CHECK(prefetcher->pump());
+    CHECK(prefetcher->pump());
+    CHECK_FALSE(prefetcher->pump()); // Ring is full.
+
+    REQUIRE(prefetcher->take(0, true, &frame));
+    CHECK_EQ(frame->rgb()[0].r, 10);
+    // Frame 1 is dropped on the way to frame 2.
+    REQUIRE(prefetcher->take(2, true, &frame));
+    CHECK_EQ(frame->rgb()[0].r, 30);
+
+    // Sequence numbers keep counting across loops, 9 is frame 1 again.
+    CHECK_FALSE(prefetcher->take(9, true, &frame));
+    CHECK(prefetcher->pump());
+    REQUIRE(prefetcher->take(9, true, &frame));
+    CHECK_EQ(frame->rgb()[0].r, 20);
+
+    // Reversing reads backward and stops at the first frame.
+    CHECK_FALSE(prefetcher->take(2, false, &frame));
+    CHECK(prefetcher->pump());
+    CHECK(prefetcher->pump());
+    CHECK(prefetcher->pump());
+    REQUIRE(prefetcher->take(2, false, &frame));
+    CHECK_EQ(frame->rgb()[0].r, 30);
+    REQUIRE(prefetcher->take(0, false, &frame));
+    CHECK_EQ(frame->rgb()[0].r, 10);
+    CHECK_FALSE(prefetcher->pump());
+}
+
+TEST_CASE("video with prefetch") {
+    const uint32_t kFrames = 4;
+    Video video(LEDS_PER_FRAME, 1); // One frame per second.
+    video.setFade(0, 0);
+    video.begin(makeNumberedFrames(kFrames));
+    video.setPrefetch(3);
+    REQUIRE_EQ(video.durationMicros(), int32_t(kFrames * 1000000));
+
+    // draw() never waits for the worker, a frame that isn't decoded yet
+    // leaves the leds alone.
+    const CRGB sentinel(1, 2, 3);
+    CRGB leds[LEDS_PER_FRAME];
+    auto drawFrame = [&](uint32_t now) {
+        for (int attempt = 0; attempt < 2000; ++attempt) {
+            leds[0] = sentinel;
+            REQUIRE(video.draw(now, leds));
+            if (leds[0] != sentinel) {
+                return leds[0].r;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return uint8_t(0);
+    };
+    CHECK_EQ(drawFrame(0), 10);
+    CHECK_EQ(drawFrame(1000), 20);
+    CHECK_EQ(drawFrame(2000), 30);
+    // Last frame, the video loops back to the start afterwards.
+    CHECK_EQ(drawFrame(3000), 40);
+    CHECK_EQ(drawFrame(3000), 10);
+    CHECK_EQ(drawFrame(4000), 20);
+    video.end();
+}
+
+#if FASTLED_MULTITHREADED
+FASTLED_SMART_PTR(GatedFileHandle);
+
+// Reads block while the gate is closed, so the worker can't decode ahead.
+class GatedFileHandle : public FakeFileHandle {
+  public:
+    std::atomic<bool> open{true};
+    size_t read(uint8_t *dst, size_t bytesToRead) override {
+        while (!open) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return FakeFileHandle::read(dst, bytesToRead);
+    }
+};
+
+TEST_CASE("video fades the last frame while the next one is decoding") {
+    GatedFileHandlePtr fileHandle = GatedFileHandlePtr::New();
+    CRGB led_frame[LEDS_PER_FRAME];
+    for (uint32_t f = 0; f < 8; f++) {
+        for (uint32_t i = 0; i < LEDS_PER_FRAME; i++) {
+            led_frame[i] = CRGB(10 * (f + 1), 0, 0);
+        }
+        fileHandle->writeCRGB(led_frame, LEDS_PER_FRAME);
+    }
+    Video video(LEDS_PER_FRAME, 1); // One frame per second.
+    video.setFade(10000, 0);
+    video.begin(fileHandle);
+    video.setPrefetch(1);
+
+    const CRGB sentinel(1, 2, 3);
+    CRGB leds[LEDS_PER_FRAME];
+    leds[0] = sentinel;
+    for (int attempt = 0; attempt < 2000 && leds[0] != CRGB::Black; ++attempt) {
+        leds[0] = sentinel;
+        REQUIRE(video.draw(0, leds));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE_EQ(leds[0], CRGB::Black); // Frame 0, fully faded in.
+
+    // Frame 6 is past the ring and can't be read, the newest decoded frame is
+    // shown at the fade-in brightness of 6000 ms instead of leaving the leds
+    // untouched.
+    fileHandle->open = false;
+    leds[0] = sentinel;
+    REQUIRE(video.draw(6000, leds));
+    CHECK_EQ(leds[0].g, 0);
+    CHECK_GT(leds[0].r, 0);
+    CHECK_LE(leds[0].r, 20 * 6000 / 10000);
+    fileHandle->open = true;
+    video.end();
+}
+#endif
+
+namespace {
+
+// A dot moving over a static gradient, typical of animation content where
+// only a few pixels change per frame.
+void movingDotFrame(uint32_t f, CRGB *out) {
+    for (uint32_t i = 0; i < LEDS_PER_FRAME; i++) {
+        out[i] = CRGB(i / 10 * 20, 0, 40);
+    }
+    out[f % LEDS_PER_FRAME] = CRGB::White;
+    out[(f + 1) % LEDS_PER_FRAME] = CRGB::White;
+}
+
+FakeFileHandlePtr compress(CompressedVideoEncoder &encoder) {
+    fl::vector<uint8_t> bytes;
+    encoder.finish(&bytes);
+    FakeFileHandlePtr fileHandle = FakeFileHandlePtr::New();
+    fileHandle->write(bytes.data(), bytes.size());
+    return fileHandle;
+}
+
+} // namespace
+
+TEST_CASE("compressed video round trip") {
+    const uint32_t kFrames = 20;
+    CompressedVideoEncoder encoder(LEDS_PER_FRAME, 8);
+    CRGB expected[kFrames][LEDS_PER_FRAME];
+    for (uint32_t f = 0; f < kFrames; f++) {
+        movingDotFrame(f, expected[f]);
+        encoder.addFrame(expected[f]);
+    }
+    FakeFileHandlePtr fileHandle = compress(encoder);
+    // Raw would be kFrames * LEDS_PER_FRAME * 3 = 6000 bytes.
+    CHECK_LT(fileHandle->size() * 5, kFrames * LEDS_PER_FRAME * 3);
+
+    PixelStreamPtr stream = PixelStreamPtr::New(LEDS_PER_FRAME * 3);
+    REQUIRE(stream->begin(fileHandle));
+    REQUIRE(stream->compressed());
+    CHECK_EQ(stream->framesRemaining(), int32_t(kFrames));
+
+    Frame frame(LEDS_PER_FRAME);
+    auto matches = [&](uint32_t f) {
+        for (uint32_t i = 0; i < LEDS_PER_FRAME; i++) {
+            if (frame.rgb()[i] != expected[f][i]) {
+                return false;
+            }
+        }
+        return true;
+    };
+    for (uint32_t f = 0; f < kFrames; f++) {
+        REQUIRE(stream->readFrame(&frame));
+        REQUIRE(matches(f));
+    }
+    CHECK(stream->atEnd());
+    CHECK_FALSE(stream->readFrame(&frame));
+
+    // Seeks go through the keyframe index, backward and across keyframes.
+    const uint32_t seeks[] = {15, 3, 19, 0, 9, 8, 7, 16};
+    for (uint32_t f : seeks) {
+        REQUIRE(stream->readFrameAt(f, &frame));
+        REQUIRE(matches(f));
+    }
+    CHECK_FALSE(stream->readFrameAt(kFrames, &frame));
+    REQUIRE(stream->rewind());
+    REQUIRE(stream->readFrame(&frame));
+    CHECK(matches(0));
+}
+
+TEST_CASE("compressed video rejects a frame size mismatch") {
+    CompressedVideoEncoder encoder(LEDS_PER_FRAME - 1);
+    CRGB pixels[LEDS_PER_FRAME] = {};
+    encoder.addFrame(pixels);
+    PixelStreamPtr stream = PixelStreamPtr::New(LEDS_PER_FRAME * 3);
+    CHECK_FALSE(stream->begin(compress(encoder)));
+    CHECK_FALSE(stream->compressed());
+}
+
+TEST_CASE("compressed video rejects corrupt sizes and offsets") {
+    CompressedVideoEncoder encoder(LEDS_PER_FRAME, 2);
+    CRGB pixels[LEDS_PER_FRAME];
+    for (uint32_t f = 0; f < 4; f++) {
+        movingDotFrame(f, pixels);
+        encoder.addFrame(pixels);
+    }
+    fl::vector<uint8_t> good;
+    encoder.finish(&good);
+    const uint32_t kIndexOffset = good[20] | (good[21] << 8) |
+                                  (good[22] << 16) | (good[23] << 24);
+    auto open = [](const fl::vector<uint8_t> &bytes) {
+        FakeFileHandlePtr fileHandle = FakeFileHandlePtr::New();
+        fileHandle->write(bytes.data(), bytes.size());
+        return fileHandle;
+    };
+    auto patchU32 = [](fl::vector<uint8_t> *bytes, uint32_t at, uint32_t v) {
+        for (int i = 0; i < 4; i++) {
+            (*bytes)[at + i] = uint8_t(v >> (8 * i));
+        }
+    };
+    Frame frame(LEDS_PER_FRAME);
+
+    // A huge payload, then one just over a frame of literal ops.
+    const uint32_t sizes[] = {0xfffffff0u, LEDS_PER_FRAME * 4 + 2};
+    for (uint32_t size : sizes) {
+        fl::vector<uint8_t> bytes = good;
+        patchU32(&bytes, CompressedVideoDecoder::kHeaderSize + 1, size);
+        PixelStreamPtr stream = PixelStreamPtr::New(LEDS_PER_FRAME * 3);
+        REQUIRE(stream->begin(open(bytes)));
+        CHECK_FALSE(stream->readFrame(&frame));
+    }
+
+    // A keyframe offset past the end of the file.
+    fl::vector<uint8_t> bytes = good;
+    patchU32(&bytes, kIndexOffset + 4, 0xfffffffbu);
+    PixelStreamPtr stream = PixelStreamPtr::New(LEDS_PER_FRAME * 3);
+    CHECK_FALSE(stream->begin(open(bytes)));
+
+    // A frame count whose index would run past the end of the file.
+    bytes = good;
+    patchU32(&bytes, 12, 0x7fffffffu);
+    stream = PixelStreamPtr::New(LEDS_PER_FRAME * 3);
+    CHECK_FALSE(stream->begin(open(bytes)));
+}
+
+TEST_CASE("video with compressed file") {
+    const uint32_t kFrames = 4;
+    CompressedVideoEncoder encoder(LEDS_PER_FRAME, 2);
+    CRGB pixels[LEDS_PER_FRAME];
+    for (uint32_t f = 0; f < kFrames; f++) {
+        for (uint32_t i = 0; i < LEDS_PER_FRAME; i++) {
+            pixels[i] = CRGB(10 * (f + 1), 0, 0);
+        }
+        encoder.addFrame(pixels);
+    }
+    Video video(LEDS_PER_FRAME, 1); // One frame per second.
+    video.setFade(0, 0);
+    REQUIRE(video.begin(compress(encoder)));
+    CHECK_EQ(video.durationMicros(), int32_t(kFrames * 1000000));
+    CRGB leds[LEDS_PER_FRAME];
+    REQUIRE(video.draw(0, leds));
+    CHECK_EQ(leds[0], CRGB(10, 0, 0));
+    REQUIRE(video.draw(2000, leds));
+    CHECK_EQ(leds[LEDS_PER_FRAME - 1], CRGB(30, 0, 0));
+}
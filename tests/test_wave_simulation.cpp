@@ -0,0 +1,181 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "fl/thread.h"
+#include "fl/vector.h"
+#include "fl/wave_simulation.h"
+#include "fl/wave_simulation_real.h"
+#include "fl/xymap.h"
+#include "fx/2d/wave.h"
+
+using namespace fl;
+
+namespace {
+
+// The original one cell at a time update, kept as the reference for the
+// vector and threaded paths.
+class ReferenceWave {
+  public:
+    ReferenceWave(u32 w, u32 h, i16 courant, int damp, bool halfDuplex,
+                  bool cylindrical)
+        : width(w), height(h), stride(w + 2), curr((w + 2) * (h + 2), 0),
+          next((w + 2) * (h + 2), 0), courant(courant), damp(damp),
+          halfDuplex(halfDuplex), cylindrical(cylindrical) {}
+
+    void set(u32 x, u32 y, i16 v) { curr[(y + 1) * stride + x + 1] = v; }
+    i16 get(u32 x, u32 y) const { return curr[(y + 1) * stride + x + 1]; }
+
+    void update() {
+        for (u32 j = 0; j < height + 2; ++j) {
+            if (cylindrical) {
+                curr[j * stride] = curr[j * stride + width];
+                curr[j * stride + width + 1] = curr[j * stride + 1];
+            } else {
+                curr[j * stride] = curr[j * stride + 1];
+                curr[j * stride + width + 1] = curr[j * stride + width];
+            }
+        }
+        for (u32 i = 0; i < width + 2; ++i) {
+            curr[i] = curr[stride + i];
+            curr[(height + 1) * stride + i] = curr[height * stride + i];
+        }
+        const i32 factor = 1 << damp;
+        for (u32 j = 1; j <= height; ++j) {
+            for (u32 i = 1; i <= width; ++i) {
+                const u32 index = j * stride + i;
+                const i32 lap = i32(curr[index + 1]) + curr[index - 1] +
+                                curr[index + stride] + curr[index - stride] -
+                                (i32(curr[index]) << 2);
+                const i32 term = i32(u32(i32(courant)) * u32(lap)) >> 15;
+                i32 f = -i32(next[index]) + (i32(curr[index]) << 1) + term;
+                f = f - (f / factor);
+                f = f > 32767 ? 32767 : (f < -32768 ? -32768 : f);
+                if (halfDuplex && f < 0) {
+                    f = 0;
+                }
+                next[index] = i16(f);
+            }
+        }
+        curr.swap(next);
+    }
+
+    u32 width, height, stride;
+    fl::vector<i16> curr, next;
+    i16 courant;
+    int damp;
+    bool halfDuplex, cylindrical;
+};
+
+u32 gSeed = 12345;
+i16 random16() {
+    gSeed = gSeed * 1664525u + 1013904223u;
+    return i16(gSeed >> 16);
+}
+
+void checkMatches(u32 w, u32 h, float speed, int damp, bool halfDuplex,
+                  bool cylindrical, bool parallel) {
+    WaveSimulation2D_Real sim(w, h, speed, float(damp));
+    sim.setHalfDuplex(halfDuplex);
+    sim.setXCylindrical(cylindrical);
+    sim.setParallel(parallel);
+    const i16 courant = wave_detail::float_to_fixed(speed);
+    ReferenceWave ref(w, h, courant, damp, halfDuplex, cylindrical);
+    for (int step = 0; step < 12; ++step) {
+        // Keep kicking random cells with full scale values so that the
+        // clamps and, for fast speeds, the wrapping multiply are exercised.
+        for (int k = 0; k < 8; ++k) {
+            const u32 x = u32(random16() & 0x7fff) % w;
+            const u32 y = u32(random16() & 0x7fff) % h;
+            const i16 v = random16();
+            sim.seti16(x, y, v);
+            ref.set(x, y, v);
+        }
+        sim.update();
+        ref.update();
+        for (u32 y = 0; y < h; ++y) {
+            for (u32 x = 0; x < w; ++x) {
+                if (sim.geti16(x, y) != ref.get(x, y)) {
+                    INFO("size " << w << "x" << h << " speed " << speed
+                                 << " damp " << damp << " step " << step);
+                    REQUIRE_EQ(sim.geti16(x, y), ref.get(x, y));
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("WaveSimulation2D_Real matches the scalar update") {
+    const u32 widths[] = {1, 3, 7, 8, 9, 16, 23, 40};
+    const float speeds[] = {0.16f, 0.5f, 1.0f, -0.3f};
+    const int damps[] = {0, 1, 6, 12};
+    for (u32 w : widths) {
+        for (float speed : speeds) {
+            for (int damp : damps) {
+                checkMatches(w, 5, speed, damp, true, false, false);
+                checkMatches(w, 4, speed, damp, false, true, false);
+            }
+        }
+    }
+}
+
+TEST_CASE("WaveSimulation2D_Real parallel update") {
+    // Above FASTLED_WAVE_PARALLEL_MIN_CELLS with a partial last band.
+    checkMatches(133, 130, 0.16f, 6, true, false, true);
+    checkMatches(131, 127, 0.7f, 3, false, true, true);
+}
+
+TEST_CASE("WaveSimulation2D supersampled parallel update") {
+    WaveSimulation2D serial(32, 32, SuperSample::SUPER_SAMPLE_4X);
+    WaveSimulation2D threaded(32, 32, SuperSample::SUPER_SAMPLE_4X);
+    threaded.setParallel(true);
+    for (int frame = 0; frame < 20; ++frame) {
+        if (frame % 5 == 0) {
+            serial.setf(frame % 32, 16, 1.0f);
+            threaded.setf(frame % 32, 16, 1.0f);
+        }
+        serial.update();
+        threaded.update();
+    }
+    for (u32 y = 0; y < 32; ++y) {
+        for (u32 x = 0; x < 32; ++x) {
+            REQUIRE_EQ(serial.geti16(x, y), threaded.geti16(x, y));
+        }
+    }
+    CHECK(serial.geti16(10, 16) != 0);
+}
+
+TEST_CASE("WaveCrgbMap writes every pixel through the XYMap") {
+    const u16 w = 11;
+    const u16 h = 6;
+    WaveSimulation2D sim(w, h);
+    sim.setf(3, 2, 1.0f);
+    sim.setf(9, 4, 0.5f);
+    for (int frame = 0; frame < 4; ++frame) {
+        sim.update();
+    }
+    XYMap serpentine = XYMap::constructSerpentine(w, h);
+    XYMap lut = serpentine;
+    lut.convertToLookUpTable();
+
+    WaveCrgbMapDefault grey;
+    fl::vector<CRGB> leds(w * h, CRGB(1, 2, 3));
+    grey.mapWaveToLEDs(serpentine, sim, leds.data());
+    for (u16 y = 0; y < h; ++y) {
+        for (u16 x = 0; x < w; ++x) {
+            const u8 v = sim.getu8(x, y);
+            REQUIRE_EQ(leds[serpentine.mapToIndex(x, y)], CRGB(v, v, v));
+        }
+    }
+
+    WaveCrgbGradientMap gradient(RainbowColors_p);
+    fl::vector<CRGB> bySpans(w * h);
+    fl::vector<CRGB> byTable(w * h);
+    gradient.mapWaveToLEDs(serpentine, sim, bySpans.data());
+    gradient.mapWaveToLEDs(lut, sim, byTable.data());
+    for (u16 i = 0; i < w * h; ++i) {
+        REQUIRE_EQ(bySpans[i], byTable[i]);
+    }
+}
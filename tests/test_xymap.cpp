@@ -0,0 +1,170 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "fl/vector.h"
+#include "fl/xymap.h"
+
+using namespace fl;
+
+namespace {
+
+// Rows alternate direction every two rows, with the columns in two halves.
+u16 oddLayout(u16 x, u16 y, u16 width, u16 height) {
+    (void)height;
+    const u16 half = width / 2;
+    if (x < half) {
+        return y * width + ((y / 2) & 1 ? half - 1 - x : x);
+    }
+    return y * width + x;
+}
+
+// Every pixel is visited once and each span matches mapToIndex().
+void checkSpans(const XYMap &xymap) {
+    const u16 w = xymap.getWidth();
+    const u16 h = xymap.getHeight();
+    fl::vector<int> seen(w * h, 0);
+    u16 expectedX = 0;
+    u16 expectedY = 0;
+    for (const XYSpan &span : xymap.spans()) {
+        REQUIRE_EQ(span.x, expectedX);
+        REQUIRE_EQ(span.y, expectedY);
+        REQUIRE(span.length > 0);
+        REQUIRE((span.step == 1 || span.step == -1));
+        for (u16 i = 0; i < span.length; ++i) {
+            const int index = int(span.index) + span.step * int(i);
+            REQUIRE_EQ(index, int(xymap.mapToIndex(u16(span.x + i), span.y)));
+            ++seen[span.y * w + span.x + i];
+        }
+        expectedX = span.x + span.length;
+        if (expectedX == w) {
+            expectedX = 0;
+            ++expectedY;
+        }
+    }
+    CHECK_EQ(expectedY, h);
+    for (int count : seen) {
+        REQUIRE_EQ(count, 1);
+    }
+}
+
+} // namespace
+
+TEST_CASE("XYMap spans") {
+    checkSpans(XYMap::constructRectangularGrid(7, 5));
+    checkSpans(XYMap::constructSerpentine(7, 5, 3));
+    checkSpans(XYMap::constructWithUserFunction(8, 6, oddLayout));
+
+    XYMap lut = XYMap::constructSerpentine(6, 4);
+    lut.convertToLookUpTable();
+    checkSpans(lut);
+
+    // Whole rows for the built in layouts, the function breaks the rows
+    // where its left half runs backwards.
+    int count = 0;
+    for (const XYSpan &span : XYMap::constructSerpentine(7, 5).spans()) {
+        CHECK_EQ(span.length, 7);
+        CHECK_EQ(span.step, (span.y & 1) ? -1 : 1);
+        ++count;
+    }
+    CHECK_EQ(count, 5);
+    count = 0;
+    for (const XYSpan &span :
+         XYMap::constructWithUserFunction(8, 6, oddLayout).spans()) {
+        CHECK_EQ(span.length, ((span.y / 2) & 1) ? 4 : 8);
+        ++count;
+    }
+    CHECK_EQ(count, 8);
+}
+
+TEST_CASE("XYMap spans stop at unmapped pixels") {
+    // 0xffff marks a pixel with no led, a run down from index 0 must not
+    // wrap around into it.
+    const u16 table[] = {1, 0, 0xffff, 3, 0xffff, 4, 5, 6};
+    XYMap xymap = XYMap::constructWithLookUpTable(4, 2, table);
+    const XYSpan first = xymap.spanAt(0, 0);
+    CHECK_EQ(first.length, 2);
+    CHECK_EQ(first.step, -1);
+    CHECK_EQ(xymap.spanAt(2, 0).length, 1);
+    const XYSpan last = xymap.spanAt(1, 1);
+    CHECK_EQ(last.length, 3);
+    CHECK_EQ(last.index, 4);
+}
+
+TEST_CASE("XYMap spans copy rows") {
+    XYMap xymap = XYMap::constructSerpentine(5, 4);
+    CRGB image[20];
+    for (int i = 0; i < 20; ++i) {
+        image[i] = CRGB(i, 0, 0);
+    }
+    CRGB leds[20];
+    for (const XYSpan &span : xymap.spans()) {
+        writeSpan(leds, span, image + span.y * 5 + span.x);
+    }
+    for (u16 y = 0; y < 4; ++y) {
+        for (u16 x = 0; x < 5; ++x) {
+            CHECK_EQ(leds[xymap(x, y)].r, y * 5 + x);
+        }
+    }
+    CRGB back[20];
+    xymap.mapPixels(leds, back);
+    for (int i = 0; i < 20; ++i) {
+        CHECK_EQ(back[i], image[i]);
+    }
+}
+
+TEST_CASE("XYMapT matches XYMap") {
+    using Serp = XYMapT<xy_layout::Serpentine, 9, 4>;
+    using Lines = XYMapT<xy_layout::LineByLine, 9, 4>;
+    static_assert(Serp::total() == 36, "constexpr dimensions");
+    static_assert(Serp(0).mapToIndex(0, 1) == 17, "constexpr index");
+
+    const Serp serp(2);
+    const Lines lines;
+    const XYMap serpRuntime = XYMap::constructSerpentine(9, 4, 2);
+    const XYMap linesRuntime = XYMap::constructRectangularGrid(9, 4);
+    for (u16 y = 0; y < 4; ++y) {
+        for (u16 x = 0; x < 9; ++x) {
+            CHECK_EQ(serp(x, y), serpRuntime(x, y));
+            CHECK_EQ(lines(x, y), linesRuntime(x, y));
+        }
+    }
+
+    // The rows are the runtime map's spans, in the same order.
+    fl::vector<XYSpan> rows;
+    serp.forEachRow([&](const XYSpan &row) { rows.push_back(row); });
+    fl::size i = 0;
+    for (const XYSpan &span : serpRuntime.spans()) {
+        REQUIRE(i < rows.size());
+        CHECK_EQ(rows[i].x, span.x);
+        CHECK_EQ(rows[i].y, span.y);
+        CHECK_EQ(rows[i].length, span.length);
+        CHECK_EQ(rows[i].index, span.index);
+        CHECK_EQ(rows[i].step, span.step);
+        ++i;
+    }
+    CHECK_EQ(i, rows.size());
+    i = 0;
+    for (const XYSpan &span : linesRuntime.spans()) {
+        const XYSpan row = lines.row(span.y);
+        CHECK_EQ(row.index, span.index);
+        CHECK_EQ(row.length, span.length);
+        CHECK_EQ(row.step, span.step);
+        ++i;
+    }
+    CHECK_EQ(i, 4u);
+
+    Serp converted;
+    CHECK(Serp::fromXYMap(serpRuntime, &converted));
+    CHECK_EQ(converted.getOffset(), 2);
+    CHECK_FALSE(Serp::fromXYMap(linesRuntime, &converted));
+    CHECK_FALSE(Serp::fromXYMap(XYMap::constructSerpentine(8, 4), &converted));
+    Lines convertedLines;
+    CHECK(Lines::fromXYMap(linesRuntime, &convertedLines));
+
+    const XYMap back = serp.toXYMap();
+    CHECK(back.isSerpentine());
+    CHECK_EQ(back.getOffset(), 2);
+    CHECK_EQ(back(3, 3), serp(3, 3));
+}
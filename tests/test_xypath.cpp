@@ -5,7 +5,9 @@
 
 #include "test.h"
 #include "lib8tion/intmap.h"
+#include "fl/raster.h"
 #include "fl/xypath.h"
+#include "fl/xypath_renderer.h"
 #include "fl/vector.h"
 #include "fl/unused.h"
 #include <string>
@@ -321,3 +323,77 @@ TEST_CASE("Check complex types") {
     }
 
 }
+
+TEST_CASE("XYPathRenderer batched evaluation and LUT") {
+    XYPathPtr circle = XYPath::NewCirclePath(32, 32);
+    XYPathRenderer renderer(CirclePathPtr::New());
+    renderer.setDrawBounds(32, 32);
+
+    fl::vector<float> alphas;
+    for (int i = 0; i <= 500; ++i) {
+        alphas.push_back(i / 500.0f);
+    }
+    alphas.push_back(1.25f); // Past the end, evaluated directly.
+    fl::vector<vec2f> points(alphas.size());
+
+    // Without a LUT the batch is exact.
+    renderer.at(alphas, points.data());
+    for (fl::size i = 0; i < alphas.size(); ++i) {
+        const vec2f expected = circle->at(alphas[i]);
+        REQUIRE_EQ(points[i].x, expected.x);
+        REQUIRE_EQ(points[i].y, expected.y);
+    }
+
+    // With one it is within a small fraction of a pixel.
+    renderer.setLutSize(1024);
+    renderer.at(alphas, points.data());
+    for (fl::size i = 0; i < alphas.size(); ++i) {
+        const vec2f expected = circle->at(alphas[i]);
+        REQUIRE(ABS(points[i].x - expected.x) < 0.01f);
+        REQUIRE(ABS(points[i].y - expected.y) < 0.01f);
+    }
+
+    // Changing the transform through the reference rebuilds the LUT.
+    renderer.transform().set_scale(0.5f);
+    circle->transform().set_scale(0.5f);
+    renderer.at(alphas, points.data());
+    for (fl::size i = 0; i < alphas.size(); ++i) {
+        const vec2f expected = circle->at(alphas[i]);
+        REQUIRE(ABS(points[i].x - expected.x) < 0.01f);
+        REQUIRE(ABS(points[i].y - expected.y) < 0.01f);
+    }
+}
+
+TEST_CASE("XYPath rasterize matches per step splats") {
+    XYPathPtr heart = XYPath::NewHeartPath(24, 24);
+    XYPath::AlphaFunction fade = [](float alpha) -> u8 {
+        return u8(alpha * 255.0f);
+    };
+    const int steps = 300;
+
+    XYRasterU8Sparse expected(24, 24);
+    for (int i = 0; i < steps; ++i) {
+        const float alpha = fl::map_range<int, float>(i, 0, steps - 1, 0.0f, 1.0f);
+        Tile2x2_u8 tile = heart->at_subpixel(alpha);
+        tile.scale(fade(alpha));
+        expected.rasterize(tile);
+    }
+
+    XYRasterU8Sparse batched(24, 24);
+    heart->rasterize(0.0f, 1.0f, steps, batched, &fade);
+    CHECK_EQ(batched.size(), expected.size());
+    for (const auto &it : expected) {
+        CHECK_EQ(batched.at(it.first.x, it.first.y).second, it.second);
+    }
+
+    // The LUT moves splats by far less than a pixel, most values survive.
+    heart->setLutSize(2048);
+    XYRasterU8Sparse lut(24, 24);
+    heart->rasterize(0.0f, 1.0f, steps, lut, &fade);
+    int close = 0;
+    for (const auto &it : expected) {
+        const int diff = int(lut.at(it.first.x, it.first.y).second) - it.second;
+        close += (diff >= -2 && diff <= 2) ? 1 : 0;
+    }
+    CHECK(close * 10 >= int(expected.size()) * 9);
+}